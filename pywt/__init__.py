@@ -20,6 +20,9 @@ from ._thresholding import *
 from ._wavelet_packets import *
 from ._dwt import *
 from ._swt import *
+from ._lifting import *
+from ._plan import *
+from ._wisdom import *
 
 from . import data
 
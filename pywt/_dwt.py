@@ -1,12 +1,15 @@
 import numpy as np
 
-from ._extensions._pywt import Wavelet, Modes, _check_dtype
+from ._extensions._pywt import (Wavelet, Modes, _check_dtype, _check_out,
+                                _method_from_object, _workers_from_object)
 from ._extensions._dwt import (dwt_single, dwt_axis, idwt_single, idwt_axis,
-                               upcoef as _upcoef, downcoef as _downcoef,
+                               cast_dtypes as _cast_dtypes, upcoef as _upcoef, downcoef as _downcoef,
                                dwt_max_level as _dwt_max_level,
-                               dwt_coeff_len as _dwt_coeff_len)
+                               dwt_coeff_len as _dwt_coeff_len,
+                               pad as _pad)
 
-__all__ = ["dwt", "idwt", "downcoef", "upcoef", "dwt_max_level", "dwt_coeff_len"]
+__all__ = ["dwt", "idwt", "downcoef", "upcoef", "dwt_max_level", "dwt_coeff_len",
+           "pad"]
 
 
 def dwt_max_level(data_len, filter_len):
@@ -79,9 +82,11 @@ def dwt_coeff_len(data_len, filter_len, mode):
     return _dwt_coeff_len(data_len, filter_len, Modes.from_object(mode))
 
 
-def dwt(data, wavelet, mode='symmetric', axis=-1):
+def dwt(data, wavelet, mode='symmetric', axis=-1, method='convolution',
+        workers=None, out=None):
     """
-    dwt(data, wavelet, mode='symmetric', axis=-1)
+    dwt(data, wavelet, mode='symmetric', axis=-1, method='convolution',
+        workers=None, out=None)
 
     Single level Discrete Wavelet Transform.
 
@@ -96,12 +101,33 @@ def dwt(data, wavelet, mode='symmetric', axis=-1):
     axis: int, optional
         Axis over which to compute the DWT. If not given, the
         last axis is used.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform. 'lifting' uses the lifting
+        scheme of the wavelet (see `Wavelet.lifting_scheme`), which agrees
+        with the convolution to between about 1e-15 and a few times 1e-8
+        (relative), depending on the wavelet. 'auto' selects the method
+        expected to be faster with the SIMD variant in use (see `set_simd`)
+        among those agreeing to within 1e-10.
+    workers : int, optional
+        Number of threads transforming the lines along `axis` of
+        n-dimensional data. Negative values count back from the number of
+        CPUs. If None (default), the value set by `set_workers` is used.
+    out : tuple of ndarray, optional
+        Arrays ``(cA, cD)`` the coefficients are written to and returned in,
+        instead of new arrays, e.g. to transform the same shapes repeatedly
+        without allocating. They must have the shape and dtype of the result,
+        be writeable and not overlap `data` or each other (ValueError is
+        raised otherwise). A None array is allocated.
 
 
     Returns
     -------
     (cA, cD) : tuple
-        Approximation and detail coefficients.
+        Approximation and detail coefficients, of dtype float32 or float64,
+        or complex64 or complex128 for complex data (both parts are
+        transformed in a single pass). float16 data gives float32 and integer
+        data float64 coefficients. uint8, int16, uint16, int32 and float16
+        data is converted as it is read, without a converted copy.
 
     Notes
     -----
@@ -124,37 +150,40 @@ def dwt(data, wavelet, mode='symmetric', axis=-1):
     array([-0.70710678, -0.70710678, -0.70710678])
 
     """
-    if np.iscomplexobj(data):
-        data = np.asarray(data)
-        cA_r, cD_r = dwt(data.real, wavelet, mode)
-        cA_i, cD_i = dwt(data.imag, wavelet, mode)
-        return (cA_r + 1j*cA_i, cD_r + 1j*cD_i)
-
-    # accept array_like input; make a copy to ensure a contiguous array
+    # accept array_like input, converted unless the C transforms read its
+    # dtype directly
+    data = np.asarray(data)
     dt = _check_dtype(data)
-    data = np.array(data, dtype=dt)
+    if data.dtype not in _cast_dtypes:
+        data = np.asarray(data, dtype=dt)
     mode = Modes.from_object(mode)
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
+    method = _method_from_object(wavelet, method)
+    workers = _workers_from_object(workers)
 
     if axis < 0:
         axis = axis + data.ndim
     if not 0 <= axis < data.ndim:
         raise ValueError("Axis greater than data dimensions")
 
-    if data.ndim == 1:
-        cA, cD = dwt_single(data, wavelet, mode)
-        # TODO: Check whether this makes a copy
-        cA, cD = np.asarray(cA, dt), np.asarray(cD, dt)
+    if (data.ndim == 1 and data.dtype in (np.float32, np.float64) and
+            (out is None or all(c is None or c.flags.c_contiguous
+                                for c in out))):
+        cA, cD = dwt_single(np.ascontiguousarray(data), wavelet, mode, method,
+                            out)
     else:
-        cA, cD = dwt_axis(data, wavelet, mode, axis=axis)
+        cA, cD = dwt_axis(data, wavelet, mode, axis=axis, method=method,
+                          workers=workers, out=out)
 
     return (cA, cD)
 
 
-def idwt(cA, cD, wavelet, mode='symmetric', axis=-1):
+def idwt(cA, cD, wavelet, mode='symmetric', axis=-1, method='convolution',
+         workers=None, out=None):
     """
-    idwt(cA, cD, wavelet, mode='symmetric', axis=-1)
+    idwt(cA, cD, wavelet, mode='symmetric', axis=-1, method='convolution',
+         workers=None, out=None)
 
     Single level Inverse Discrete Wavelet Transform.
 
@@ -173,6 +202,13 @@ def idwt(cA, cD, wavelet, mode='symmetric', axis=-1):
     axis: int, optional
         Axis over which to compute the inverse DWT. If not given, the
         last axis is used.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : ndarray, optional
+        Array the reconstruction is written to and returned in, see `dwt`.
+        It must not overlap `cA` or `cD`.
 
 
     Returns
@@ -181,64 +217,113 @@ def idwt(cA, cD, wavelet, mode='symmetric', axis=-1):
         Single level reconstruction of signal from given coefficients.
 
     """
-    # TODO: Lots of possible allocations to eliminate (zeros_like, asarray(rec))
-    # accept array_like input; make a copy to ensure a contiguous array
+    # accept array_like input, converted to a floating point dtype
 
     if cA is None and cD is None:
         raise ValueError("At least one coefficient parameter must be "
                          "specified.")
 
-    # for complex inputs: compute real and imaginary separately then combine
-    if np.iscomplexobj(cA) or np.iscomplexobj(cD):
-        if cA is None:
-            cD = np.asarray(cD)
-            cA = np.zeros_like(cD)
-        elif cD is None:
-            cA = np.asarray(cA)
-            cD = np.zeros_like(cA)
-        return (idwt(cA.real, cD.real, wavelet, mode) +
-                1j*idwt(cA.imag, cD.imag, wavelet, mode))
-
     if cA is not None:
         dt = _check_dtype(cA)
-        cA = np.array(cA, dtype=dt)
+        cA = np.asarray(cA, dtype=dt)
     if cD is not None:
         dt = _check_dtype(cD)
-        cD = np.array(cD, dtype=dt)
+        cD = np.asarray(cD, dtype=dt)
 
     if cA is not None and cD is not None:
         if cA.dtype != cD.dtype:
             # need to upcast to common type
-            cA = cA.astype(np.float64)
-            cD = cD.astype(np.float64)
-    elif cA is None:
-        cA = np.zeros_like(cD)
-    elif cD is None:
-        cD = np.zeros_like(cA)
+            dt = np.result_type(cA, cD)
+            cA = cA.astype(dt)
+            cD = cD.astype(dt)
 
-    # cA and cD should be same dimension by here
-    ndim = cA.ndim
+    # a missing array is skipped by idwt_axis (as zeros)
+    ndim = cA.ndim if cA is not None else cD.ndim
 
     mode = Modes.from_object(mode)
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
+    method = _method_from_object(wavelet, method, inverse=True)
+    workers = _workers_from_object(workers)
 
     if axis < 0:
         axis = axis + ndim
     if not 0 <= axis < ndim:
         raise ValueError("Axis greater than coefficient dimensions")
 
-    if ndim == 1:
-        rec = idwt_single(cA, cD, wavelet, mode)
+    if (ndim == 1 and cA is not None and cD is not None and
+            not np.iscomplexobj(cA) and
+            (out is None or out.flags.c_contiguous)):
+        rec = idwt_single(np.ascontiguousarray(cA), np.ascontiguousarray(cD),
+                          wavelet, mode, method, out)
     else:
-        rec = idwt_axis(cA, cD, wavelet, mode, axis=axis)
+        rec = idwt_axis(cA, cD, wavelet, mode, axis=axis, method=method,
+                        workers=workers, out=out)
 
     return rec
 
 
-def downcoef(part, data, wavelet, mode='symmetric', level=1):
+def pad(x, pad_widths, mode):
     """
-    downcoef(part, data, wavelet, mode='symmetric', level=1)
+    pad(x, pad_widths, mode)
+
+    Extend a signal with the given signal extension mode, as the transforms
+    do before convolving it with the filters.
+
+    Parameters
+    ----------
+    x : array_like
+        Input data.
+    pad_widths : int or sequence
+        Number of values added before and after each axis, as for `numpy.pad`:
+        ``((before_1, after_1), ... (before_N, after_N))`` for each axis,
+        ``(before, after)`` or a single int for all axes.
+    mode : str
+        Signal extension mode, see `Modes`. For ``'periodization'``, an axis
+        of odd length is extended with its last value before repeating it.
+
+    Returns
+    -------
+    xp : ndarray
+        The padded array, of dtype float32 or float64 (or the corresponding
+        complex types), as for `dwt`.
+
+    Notes
+    -----
+    The extension is computed in C, copying the data once.
+
+    Examples
+    --------
+    >>> import pywt
+    >>> pywt.pad([1, 2, 3], 2, 'symmetric')
+    array([ 2.,  1.,  1.,  2.,  3.,  3.,  2.])
+    >>> pywt.pad([1, 2, 3], (1, 3), 'smooth')
+    array([ 0.,  1.,  2.,  3.,  4.,  5.,  6.])
+    >>> pywt.pad([[1, 2], [3, 4]], ((0, 1), (1, 0)), 'periodic')
+    array([[ 2.,  1.,  2.],
+           [ 4.,  3.,  4.],
+           [ 2.,  1.,  2.]])
+    """
+    x = np.asarray(x)
+    if np.iscomplexobj(x):
+        return pad(x.real, pad_widths, mode) + 1j*pad(x.imag, pad_widths, mode)
+    if x.ndim < 1:
+        raise ValueError("Expected at least 1D input data.")
+    pad_widths = np.asarray(pad_widths)
+    if pad_widths.dtype.kind not in 'iu' or pad_widths.ndim > 2:
+        raise ValueError("pad_widths must be integers.")
+    pad_widths = np.broadcast_arrays(pad_widths, np.empty((x.ndim, 2)))[0]
+    if np.any(pad_widths < 0):
+        raise ValueError("pad_widths must be non-negative.")
+    mode = Modes.from_object(mode)
+
+    x = np.ascontiguousarray(x, dtype=_check_dtype(x))
+    return _pad(x, pad_widths.tolist(), mode)
+
+
+def downcoef(part, data, wavelet, mode='symmetric', level=1, out=None):
+    """
+    downcoef(part, data, wavelet, mode='symmetric', level=1, out=None)
 
     Partial Discrete Wavelet Transform data decomposition.
 
@@ -261,6 +346,9 @@ def downcoef(part, data, wavelet, mode='symmetric', level=1):
         Signal extension mode, see `Modes`.  Default is 'symmetric'.
     level : int, optional
         Decomposition level.  Default is 1.
+    out : ndarray, optional
+        C-contiguous array the coefficients are written to and returned in,
+        see `dwt`. For complex data, the result is copied into it.
 
     Returns
     -------
@@ -273,22 +361,23 @@ def downcoef(part, data, wavelet, mode='symmetric', level=1):
 
     """
     if np.iscomplexobj(data):
-        return (downcoef(part, data.real, wavelet, mode, level) +
-                1j*downcoef(part, data.imag, wavelet, mode, level))
-    # accept array_like input; make a copy to ensure a contiguous array
+        return _complex_out(downcoef(part, data.real, wavelet, mode, level) +
+                            1j*downcoef(part, data.imag, wavelet, mode, level),
+                            out)
+    # accept array_like input; converted to a contiguous array
     dt = _check_dtype(data)
-    data = np.array(data, dtype=dt)
+    data = np.ascontiguousarray(data, dtype=dt)
     if part not in 'ad':
         raise ValueError("Argument 1 must be 'a' or 'd', not '%s'." % part)
     mode = Modes.from_object(mode)
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
-    return np.asarray(_downcoef(part == 'a', data, wavelet, mode, level))
+    return np.asarray(_downcoef(part == 'a', data, wavelet, mode, level, out))
 
 
-def upcoef(part, coeffs, wavelet, level=1, take=0):
+def upcoef(part, coeffs, wavelet, level=1, take=0, out=None):
     """
-    upcoef(part, coeffs, wavelet, level=1, take=0)
+    upcoef(part, coeffs, wavelet, level=1, take=0, out=None)
 
     Direct reconstruction from coefficients.
 
@@ -307,6 +396,10 @@ def upcoef(part, coeffs, wavelet, level=1, take=0):
     take : int, optional
         Take central part of length equal to 'take' from the result.
         Default is 0.
+    out : ndarray, optional
+        C-contiguous array the reconstruction is written to and returned in,
+        see `dwt`. For complex data, or if `take` trims the reconstruction,
+        the result is copied into it.
 
     Returns
     -------
@@ -331,13 +424,26 @@ def upcoef(part, coeffs, wavelet, level=1, take=0):
 
     """
     if np.iscomplexobj(coeffs):
-        return (upcoef(part, coeffs.real, wavelet, level, take) +
-                1j*upcoef(part, coeffs.imag, wavelet, level, take))
-    # accept array_like input; make a copy to ensure a contiguous array
+        return _complex_out(upcoef(part, coeffs.real, wavelet, level, take) +
+                            1j*upcoef(part, coeffs.imag, wavelet, level, take),
+                            out)
+    # accept array_like input; converted to a contiguous array
     dt = _check_dtype(coeffs)
-    coeffs = np.array(coeffs, dtype=dt)
+    coeffs = np.ascontiguousarray(coeffs, dtype=dt)
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
     if part not in 'ad':
         raise ValueError("Argument 1 must be 'a' or 'd', not '%s'." % part)
-    return np.asarray(_upcoef(part == 'a', coeffs, wavelet, level, take))
+    return np.asarray(_upcoef(part == 'a', coeffs, wavelet, level, take, out))
+
+
+def _complex_out(c, out):
+    """
+    The complex result c of the transform of the real and imaginary parts,
+    copied into out if not None.
+    """
+    if out is None:
+        return c
+    out = _check_out(out, c.shape, c.dtype, True)
+    out[...] = c
+    return out
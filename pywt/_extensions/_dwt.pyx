@@ -1,11 +1,22 @@
 #cython: boundscheck=False, wraparound=False
-cimport common, c_wt
-from common cimport pywt_index_t, MODE
-from ._pywt cimport _check_dtype
+cimport common, c_wt, convolution, simd
+from common cimport pywt_index_t, MODE, METHOD, INPUT_TYPE
+from ._pywt cimport _check_dtype, _check_out, _check_out_overlap
+
+from libc.stdlib cimport malloc, free
+from itertools import product
 
 cimport numpy as np
 import numpy as np
 
+# Input dtypes the decompositions read directly (in native byte order),
+# converting them to the floating point dtype of _check_dtype as they go
+cast_dtypes = {np.dtype(np.uint8): common.INPUT_UINT8,
+               np.dtype(np.int16): common.INPUT_INT16,
+               np.dtype(np.uint16): common.INPUT_UINT16,
+               np.dtype(np.int32): common.INPUT_INT32,
+               np.dtype(np.float16): common.INPUT_FLOAT16}
+
 
 cpdef dwt_max_level(size_t data_len, size_t filter_len):
     return common.dwt_max_level(data_len, filter_len)
@@ -19,90 +30,116 @@ cpdef dwt_coeff_len(size_t data_len, size_t filter_len, MODE mode):
 
     return common.dwt_buffer_length(data_len, filter_len, mode)
 
-cpdef dwt_single(data_t[::1] data, Wavelet wavelet, MODE mode):
+cpdef dwt_single(data_t[::1] data, Wavelet wavelet, MODE mode,
+                 METHOD method=common.METHOD_CONVOLUTION, out=None):
+    # out is None or a (cA, cD) pair of C-contiguous arrays (or None)
     cdef size_t output_len = dwt_coeff_len(data.size, wavelet.dec_len, mode)
     cdef np.ndarray cA, cD
-    cdef int retval_a, retval_d
+    cdef int retval
     cdef size_t data_size = data.size
     if output_len < 1:
         raise RuntimeError("Invalid output length.")
+    out_a, out_d = out if out is not None else (None, None)
+    data_array = np.asarray(data) if out is not None else None
 
     if data_t is np.float64_t:
-        # TODO: Don't think these have to be 0-initialized
-        # TODO: Check other methods of allocating (e.g. Cython/CPython arrays)
-        cA = np.zeros(output_len, np.float64)
-        cD = np.zeros(output_len, np.float64)
+        cA = _check_out(out_a, (output_len, ), np.dtype(np.float64), True,
+                        (data_array, ))
+        cD = _check_out(out_d, (output_len, ), np.dtype(np.float64), True,
+                        (data_array, cA))
         with nogil:
-            retval_a = c_wt.double_dec_a(&data[0], data_size, wavelet.w,
-                                <double *>cA.data, output_len, mode)
-            retval_d = c_wt.double_dec_d(&data[0], data_size, wavelet.w,
-                            <double *>cD.data, output_len, mode)
-        if ( retval_a < 0 or retval_d < 0):
+            retval = c_wt.double_dec(&data[0], data_size, wavelet.w,
+                                     <double *>cA.data, <double *>cD.data,
+                                     output_len, mode, method)
+        if retval < 0:
             raise RuntimeError("C dwt failed.")
     elif data_t is np.float32_t:
-        cA = np.zeros(output_len, np.float32)
-        cD = np.zeros(output_len, np.float32)
-
+        cA = _check_out(out_a, (output_len, ), np.dtype(np.float32), True,
+                        (data_array, ))
+        cD = _check_out(out_d, (output_len, ), np.dtype(np.float32), True,
+                        (data_array, cA))
         with nogil:
-            retval_a = c_wt.float_dec_a(&data[0], data_size, wavelet.w,
-                               <float *>cA.data, output_len, mode)
-            retval_d = c_wt.float_dec_d(&data[0], data_size, wavelet.w,
-                           <float *>cD.data, output_len, mode)
-        if ( retval_a < 0 or retval_d < 0):
+            retval = c_wt.float_dec(&data[0], data_size, wavelet.w,
+                                    <float *>cA.data, <float *>cD.data,
+                                    output_len, mode, method)
+        if retval < 0:
             raise RuntimeError("C dwt failed.")
 
     return (cA, cD)
 
 
-cpdef dwt_axis(np.ndarray data, Wavelet wavelet, MODE mode, unsigned int axis=0):
+cpdef dwt_axis(np.ndarray data, Wavelet wavelet, MODE mode, unsigned int axis=0,
+               METHOD method=common.METHOD_CONVOLUTION, unsigned int workers=1,
+               out=None):
     # memory-views do not support n-dimensional arrays, use np.ndarray instead
-    cdef common.ArrayInfo data_info, output_info
+    # out is None or a (cA, cD) pair of arrays (or None), of any strides
+    cdef common.ArrayInfo data_info, a_info, d_info
     cdef np.ndarray cD, cA
     # Explicit input_shape necessary to prevent memory leak
     cdef size_t[::1] input_shape, output_shape
+    cdef np.dtype output_dtype = _check_dtype(data)
+    cdef INPUT_TYPE input_type = cast_dtypes.get(data.dtype, common.INPUT_NATIVE)
     cdef int retval
 
-    data = data.astype(_check_dtype(data), copy=False)
+    if input_type == common.INPUT_NATIVE:
+        data = data.astype(output_dtype, copy=False)
 
     input_shape = <size_t [:data.ndim]> <size_t *> data.shape
     output_shape = input_shape.copy()
     output_shape[axis] = common.dwt_buffer_length(data.shape[axis], wavelet.dec_len, mode)
 
-    cA = np.empty(output_shape, data.dtype)
-    cD = np.empty(output_shape, data.dtype)
+    out_a, out_d = out if out is not None else (None, None)
+    cA = _check_out(out_a, output_shape, output_dtype, False, (data, ))
+    cD = _check_out(out_d, output_shape, output_dtype, False, (data, cA))
 
     data_info.ndim = data.ndim
     data_info.strides = <pywt_index_t *> data.strides
     data_info.shape = <size_t *> data.shape
 
-    output_info.ndim = cA.ndim
-    output_info.strides = <pywt_index_t *> cA.strides
-    output_info.shape = <size_t *> cA.shape
+    a_info.ndim = cA.ndim
+    a_info.strides = <pywt_index_t *> cA.strides
+    a_info.shape = <size_t *> cA.shape
+
+    d_info.ndim = cD.ndim
+    d_info.strides = <pywt_index_t *> cD.strides
+    d_info.shape = <size_t *> cD.shape
 
-    if data.dtype == np.float64:
+    if output_dtype == np.float64:
         with nogil:
-            retval = c_wt.double_downcoef_axis(<double *> data.data, data_info,
-                                         <double *> cA.data, output_info,
-                                         wavelet.w, axis, common.COEF_APPROX, mode)
+            retval = c_wt.double_dwt_axis_cast(<void *> data.data, input_type,
+                                               data_info,
+                                               <double *> cA.data, a_info,
+                                               <double *> cD.data, d_info,
+                                               wavelet.w, axis, mode, method,
+                                               workers)
         if retval:
             raise RuntimeError("C wavelet transform failed")
+    elif output_dtype == np.float32:
         with nogil:
-            retval = c_wt.double_downcoef_axis(<double *> data.data, data_info,
-                                     <double *> cD.data, output_info,
-                                     wavelet.w, axis, common.COEF_DETAIL, mode)
+            retval = c_wt.float_dwt_axis_cast(<void *> data.data, input_type,
+                                              data_info,
+                                              <float *> cA.data, a_info,
+                                              <float *> cD.data, d_info,
+                                              wavelet.w, axis, mode, method,
+                                              workers)
         if retval:
             raise RuntimeError("C wavelet transform failed")
-    elif data.dtype == np.float32:
+    elif output_dtype == np.complex128:
         with nogil:
-            retval = c_wt.float_downcoef_axis(<float *> data.data, data_info,
-                                    <float *> cA.data, output_info,
-                                    wavelet.w, axis, common.COEF_APPROX, mode)
+            retval = c_wt.double_complex_dwt_axis(<double *> data.data, data_info,
+                                                  <double *> cA.data, a_info,
+                                                  <double *> cD.data, d_info,
+                                                  wavelet.w, axis, mode, method,
+                                                  workers)
         if retval:
             raise RuntimeError("C wavelet transform failed")
+    elif output_dtype == np.complex64:
         with nogil:
-            retval = c_wt.float_downcoef_axis(<float *> data.data, data_info,
-                                    <float *> cD.data, output_info,
-                                    wavelet.w, axis, common.COEF_DETAIL, mode)
+            retval = c_wt.float_complex_dwt_axis(<float *> data.data, data_info,
+                                                 <float *> cA.data, a_info,
+                                                 <float *> cD.data, d_info,
+                                                 wavelet.w, axis, mode, method,
+                                                 workers)
         if retval:
             raise RuntimeError("C wavelet transform failed")
     else:
@@ -111,7 +148,48 @@ cpdef dwt_axis(np.ndarray data, Wavelet wavelet, MODE mode, unsigned int axis=0)
     return (cA, cD)
 
 
-cpdef idwt_single(np.ndarray cA, np.ndarray cD, Wavelet wavelet, MODE mode):
+cpdef pad(np.ndarray data, pad_widths, MODE mode):
+    # data must be C-contiguous, pad_widths a (before, after) pair per axis
+    cdef np.ndarray output
+    cdef size_t *widths
+    cdef size_t ndim = data.ndim, d
+    cdef int retval
+
+    widths = <size_t *> malloc(2 * ndim * sizeof(size_t))
+    if widths == NULL:
+        raise MemoryError("Cannot allocate memory for pad widths.")
+    try:
+        for d in range(ndim):
+            widths[2*d] = pad_widths[d][0]
+            widths[2*d + 1] = pad_widths[d][1]
+        output = np.empty([data.shape[d] + widths[2*d] + widths[2*d + 1]
+                           for d in range(ndim)], data.dtype)
+
+        if data.dtype == np.float64:
+            with nogil:
+                retval = c_wt.double_pad(<double *> data.data, ndim,
+                                         <size_t *> data.shape,
+                                         <double *> output.data, widths, mode)
+        elif data.dtype == np.float32:
+            with nogil:
+                retval = c_wt.float_pad(<float *> data.data, ndim,
+                                        <size_t *> data.shape,
+                                        <float *> output.data, widths, mode)
+        else:
+            raise TypeError("Array must be floating point, not {}"
+                            .format(data.dtype))
+    finally:
+        free(widths)
+    if retval == 1:
+        raise ValueError("Cannot pad an empty axis.")
+    elif retval:
+        raise MemoryError("Cannot allocate memory for padding.")
+    return output
+
+
+cpdef idwt_single(np.ndarray cA, np.ndarray cD, Wavelet wavelet, MODE mode,
+                  METHOD method=common.METHOD_CONVOLUTION, out=None):
+    # cA, cD and out (if not None) must be C-contiguous
     cdef size_t input_len, rec_len
     cdef int retval
     cdef np.ndarray rec
@@ -135,21 +213,23 @@ cpdef idwt_single(np.ndarray cA, np.ndarray cD, Wavelet wavelet, MODE mode):
         # call idwt func.  one of cA/cD can be None, then only
     # reconstruction of non-null part will be performed
     if cA.dtype == np.float64:
-        rec = np.zeros(rec_len, dtype=np.float64)
+        rec = _check_out(out, (rec_len, ), np.dtype(np.float64), True,
+                         (cA, cD))
         with nogil:
             retval = c_wt.double_idwt(<double *>cA.data, input_len,
                             <double *>cD.data, input_len,
                             <double *>rec.data, rec_len,
-                            wavelet.w, mode)
+                            wavelet.w, mode, method)
         if retval < 0:
             raise RuntimeError("C idwt failed.")
     elif cA.dtype == np.float32:
-        rec = np.zeros(rec_len, dtype=np.float32)
+        rec = _check_out(out, (rec_len, ), np.dtype(np.float32), True,
+                         (cA, cD))
         with nogil:
             retval = c_wt.float_idwt(<float *>cA.data, input_len,
                            <float *>cD.data, input_len,
                            <float *>rec.data, rec_len,
-                           wavelet.w, mode)
+                           wavelet.w, mode, method)
         if retval < 0:
             raise RuntimeError("C idwt failed.")
 
@@ -157,7 +237,9 @@ cpdef idwt_single(np.ndarray cA, np.ndarray cD, Wavelet wavelet, MODE mode):
 
 
 cpdef idwt_axis(np.ndarray coefs_a, np.ndarray coefs_d,
-                Wavelet wavelet, MODE mode, unsigned int axis=0):
+                Wavelet wavelet, MODE mode, unsigned int axis=0,
+                METHOD method=common.METHOD_CONVOLUTION, unsigned int workers=1,
+                out=None):
     cdef common.ArrayInfo a_info, d_info, output_info
     cdef common.ArrayInfo *a_info_p = NULL
     cdef common.ArrayInfo *d_info_p = NULL
@@ -168,21 +250,26 @@ cpdef idwt_axis(np.ndarray coefs_a, np.ndarray coefs_d,
     # Explicit input_shape necessary to prevent memory leak
     cdef size_t[::1] input_shape, output_shape
 
+    # common type of real and complex, single and double precision inputs
+    if coefs_a is not None and coefs_d is not None:
+        output_dtype = np.result_type(_check_dtype(coefs_a),
+                                      _check_dtype(coefs_d))
+    elif coefs_a is not None:
+        output_dtype = _check_dtype(coefs_a)
+    elif coefs_d is not None:
+        output_dtype = _check_dtype(coefs_d)
+    else:
+        return None
+
     if coefs_a is not None:
-        if coefs_d is not None and coefs_d.dtype.itemsize > coefs_a.dtype.itemsize:
-            coefs_a = coefs_a.astype(_check_dtype(coefs_d), copy=False)
-        else:
-            coefs_a = coefs_a.astype(_check_dtype(coefs_a), copy=False)
+        coefs_a = coefs_a.astype(output_dtype, copy=False)
         a_info.ndim = coefs_a.ndim
         a_info.strides = <pywt_index_t *> coefs_a.strides
         a_info.shape = <size_t *> coefs_a.shape
         a_info_p = &a_info
         data_a = <void *> coefs_a.data
     if coefs_d is not None:
-        if coefs_a is not None and coefs_a.dtype.itemsize > coefs_d.dtype.itemsize:
-            coefs_d = coefs_d.astype(_check_dtype(coefs_a), copy=False)
-        else:
-            coefs_d = coefs_d.astype(_check_dtype(coefs_d), copy=False)
+        coefs_d = coefs_d.astype(output_dtype, copy=False)
         d_info.ndim = coefs_d.ndim
         d_info.strides = <pywt_index_t *> coefs_d.strides
         d_info.shape = <size_t *> coefs_d.shape
@@ -191,17 +278,14 @@ cpdef idwt_axis(np.ndarray coefs_a, np.ndarray coefs_d,
 
     if coefs_a is not None:
         input_shape = <size_t [:coefs_a.ndim]> <size_t *> coefs_a.shape
-        output_dtype = coefs_a.dtype
-    elif coefs_d is not None:
-        input_shape = <size_t [:coefs_d.ndim]> <size_t *> coefs_d.shape
-        output_dtype = coefs_d.dtype
     else:
-        return None
+        input_shape = <size_t [:coefs_d.ndim]> <size_t *> coefs_d.shape
 
     output_shape = input_shape.copy()
     output_shape[axis] = common.idwt_buffer_length(input_shape[axis],
                                                    wavelet.rec_len, mode)
-    output = np.empty(output_shape, output_dtype)
+    output = _check_out(out, output_shape, output_dtype, False,
+                        (coefs_a, coefs_d))
 
     output_info.ndim = output.ndim
     output_info.strides = <pywt_index_t *> output.strides
@@ -212,7 +296,7 @@ cpdef idwt_axis(np.ndarray coefs_a, np.ndarray coefs_d,
             retval = c_wt.double_idwt_axis(<double *> data_a, a_info_p,
                                  <double *> data_d, d_info_p,
                                  <double *> output.data, output_info,
-                                 wavelet.w, axis, mode)
+                                 wavelet.w, axis, mode, method, workers)
         if retval:
             raise RuntimeError("C inverse wavelet transform failed")
     elif output.dtype == np.float32:
@@ -220,7 +304,25 @@ cpdef idwt_axis(np.ndarray coefs_a, np.ndarray coefs_d,
             retval = c_wt.float_idwt_axis(<float *> data_a, a_info_p,
                                 <float *> data_d, d_info_p,
                                 <float *> output.data, output_info,
-                                wavelet.w, axis, mode)
+                                wavelet.w, axis, mode, method, workers)
+        if retval:
+            raise RuntimeError("C inverse wavelet transform failed")
+    elif output.dtype == np.complex128:
+        with nogil:
+            retval = c_wt.double_complex_idwt_axis(<double *> data_a, a_info_p,
+                                                   <double *> data_d, d_info_p,
+                                                   <double *> output.data, output_info,
+                                                   wavelet.w, axis, mode, method,
+                                                   workers)
+        if retval:
+            raise RuntimeError("C inverse wavelet transform failed")
+    elif output.dtype == np.complex64:
+        with nogil:
+            retval = c_wt.float_complex_idwt_axis(<float *> data_a, a_info_p,
+                                                  <float *> data_d, d_info_p,
+                                                  <float *> output.data, output_info,
+                                                  wavelet.w, axis, mode, method,
+                                                  workers)
         if retval:
             raise RuntimeError("C inverse wavelet transform failed")
     else:
@@ -229,10 +331,781 @@ cpdef idwt_axis(np.ndarray coefs_a, np.ndarray coefs_d,
 
     return output
 
-cpdef upcoef(bint do_rec_a, data_t[::1] coeffs, Wavelet wavelet, int level, int take):
+cpdef wavedec(np.ndarray data, Wavelet wavelet, MODE mode, unsigned int level,
+              METHOD method=common.METHOD_CONVOLUTION, unsigned int workers=1,
+              out=None):
+    """
+    Multilevel DWT along the last axis of a float32, float64, complex64 or
+    complex128 array (or one of `cast_dtypes`), all levels in a single call.
+    Returns [cA_n, cD_n, cD_n-1, ..., cD1], in the C-contiguous arrays of
+    `out` if not None.
+    """
+    cdef size_t input_len, n_rows, n, k
+    cdef size_t *lens = NULL
+    cdef void **coefs_ptrs = NULL
+    cdef np.dtype output_dtype = _check_dtype(data)
+    cdef INPUT_TYPE input_type = cast_dtypes.get(data.dtype, common.INPUT_NATIVE)
+    cdef int retval = -1
+
+    if input_type == common.INPUT_NATIVE and data.dtype != output_dtype:
+        raise TypeError("Array must be floating point, not {}"
+                        .format(data.dtype))
+    data = np.ascontiguousarray(data)
+    input_len = data.shape[data.ndim - 1]
+    if input_len < 1:
+        raise ValueError("Input data must not be empty.")
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    n_rows = data.size // input_len
+
+    try:
+        lens = <size_t *> malloc((level + 1) * sizeof(size_t))
+        coefs_ptrs = <void **> malloc((level + 1) * sizeof(void *))
+        if lens == NULL or coefs_ptrs == NULL:
+            raise MemoryError()
+
+        n = input_len
+        for k in range(level, 0, -1):
+            n = common.dwt_buffer_length(n, wavelet.dec_len, mode)
+            lens[k] = n
+        lens[0] = n
+
+        shape = (<object> data).shape[:data.ndim - 1]
+        if out is not None and len(out) != level + 1:
+            raise ValueError("out must have {} arrays.".format(level + 1))
+        coeffs = []
+        for k in range(level + 1):
+            coeffs.append(_check_out(out[k] if out is not None else None,
+                                     shape + (lens[k], ), output_dtype, True,
+                                     [data] + coeffs))
+        for k in range(level + 1):
+            coefs_ptrs[k] = (<np.ndarray> coeffs[k]).data
+
+        if output_dtype == np.float64:
+            with nogil:
+                retval = c_wt.double_wavedec_cast(<void *> data.data,
+                                                  input_type, n_rows,
+                                                  input_len, wavelet.w,
+                                                  <double **> coefs_ptrs, lens,
+                                                  level, mode, method, workers)
+        elif output_dtype == np.float32:
+            with nogil:
+                retval = c_wt.float_wavedec_cast(<void *> data.data,
+                                                 input_type, n_rows,
+                                                 input_len, wavelet.w,
+                                                 <float **> coefs_ptrs, lens,
+                                                 level, mode, method, workers)
+        elif output_dtype == np.complex128:
+            with nogil:
+                retval = c_wt.double_complex_wavedec(<double *> data.data,
+                                                     n_rows, input_len,
+                                                     wavelet.w,
+                                                     <double **> coefs_ptrs,
+                                                     lens, level, mode, method,
+                                                     workers)
+        elif output_dtype == np.complex64:
+            with nogil:
+                retval = c_wt.float_complex_wavedec(<float *> data.data,
+                                                    n_rows, input_len,
+                                                    wavelet.w,
+                                                    <float **> coefs_ptrs,
+                                                    lens, level, mode, method,
+                                                    workers)
+        else:
+            raise TypeError("Array must be floating point, not {}"
+                            .format(data.dtype))
+    finally:
+        free(lens)
+        free(coefs_ptrs)
+
+    if retval:
+        raise RuntimeError("C wavedec failed.")
+    return coeffs
+
+
+cpdef waverec(list coeffs, Wavelet wavelet, MODE mode,
+              METHOD method=common.METHOD_CONVOLUTION, unsigned int workers=1,
+              out=None):
+    """
+    Multilevel IDWT along the last axis, all levels in a single call, of
+    [cA_n, cD_n, cD_n-1, ..., cD1] as returned by `wavedec`. The arrays must
+    have the same (float32, float64, complex64 or complex128) dtype and the
+    same shape but for the last axis. The result is written to the
+    C-contiguous `out` if not None.
+    """
+    cdef size_t level = len(coeffs) - 1, n_rows, n, k
+    cdef size_t *lens = NULL
+    cdef void **coefs_ptrs = NULL
+    cdef np.ndarray c, output
+    cdef int retval = -1
+
+    if level < 1:
+        raise ValueError("Expected at least two coefficient arrays.")
+    coeffs = [np.ascontiguousarray(c) for c in coeffs]
+    c = coeffs[0]
+    dtype = c.dtype
+    shape = (<object> c).shape[:c.ndim - 1]
+    for c in coeffs:
+        if (c.dtype != dtype or c.ndim < 1 or
+                (<object> c).shape[:c.ndim - 1] != shape):
+            raise ValueError("Coefficient arrays must have the same dtype "
+                             "and shape but for the last axis.")
+
+    try:
+        lens = <size_t *> malloc((level + 1) * sizeof(size_t))
+        coefs_ptrs = <void **> malloc((level + 1) * sizeof(void *))
+        if lens == NULL or coefs_ptrs == NULL:
+            raise MemoryError()
+
+        for k in range(level + 1):
+            c = coeffs[k]
+            lens[k] = c.shape[c.ndim - 1]
+            coefs_ptrs[k] = c.data
+        n = lens[0]
+        for k in range(1, level + 1):
+            if n != lens[k] and n != lens[k] + 1:
+                raise ValueError("Coefficient arrays have incompatible "
+                                 "lengths.")
+            n = common.idwt_buffer_length(lens[k], wavelet.rec_len, mode)
+            if n < 1:
+                raise ValueError("Invalid coefficient arrays length for "
+                                 "specified wavelet. Wavelet and mode must be "
+                                 "the same as used for decomposition.")
+        n_rows = coeffs[0].size // lens[0] if lens[0] else 0
+
+        output = _check_out(out, shape + (n, ), dtype, True, coeffs)
+        if dtype == np.float64:
+            with nogil:
+                retval = c_wt.double_waverec(<const double **> coefs_ptrs, lens,
+                                             n_rows, wavelet.w,
+                                             <double *> output.data, n,
+                                             level, mode, method, workers)
+        elif dtype == np.float32:
+            with nogil:
+                retval = c_wt.float_waverec(<const float **> coefs_ptrs, lens,
+                                            n_rows, wavelet.w,
+                                            <float *> output.data, n,
+                                            level, mode, method, workers)
+        elif dtype == np.complex128:
+            with nogil:
+                retval = c_wt.double_complex_waverec(
+                    <const double **> coefs_ptrs, lens, n_rows, wavelet.w,
+                    <double *> output.data, n, level, mode, method, workers)
+        elif dtype == np.complex64:
+            with nogil:
+                retval = c_wt.float_complex_waverec(
+                    <const float **> coefs_ptrs, lens, n_rows, wavelet.w,
+                    <float *> output.data, n, level, mode, method, workers)
+        else:
+            raise TypeError("Array must be floating point, not {}"
+                            .format(dtype))
+    finally:
+        free(lens)
+        free(coefs_ptrs)
+
+    if retval:
+        raise RuntimeError("C waverec failed.")
+    return output
+
+
+cdef void _wavedecn_shapes(const size_t *input_shape, size_t ndim,
+                           size_t filter_len, MODE mode, unsigned int level,
+                           size_t *coefs_shapes):
+    # shapes of the coefficients of each level, coarsest first
+    cdef size_t d, n
+    cdef unsigned int l
+    for d in range(ndim):
+        n = input_shape[d]
+        for l in range(level, 0, -1):
+            n = common.dwt_buffer_length(n, filter_len, mode)
+            coefs_shapes[(l - 1) * ndim + d] = n
+
+
+cpdef wavedecn(np.ndarray data, Wavelet wavelet, MODE mode,
+               unsigned int level, unsigned int workers=1, out=None):
+    """
+    Multilevel DWT of all axes of a float32 or float64 array (or one of
+    `cast_dtypes`) with the convolutions, all levels in a single call.
+    Returns [cA_n, {details_n}, ..., {details_1}] as `pywt.wavedecn`, in the
+    C-contiguous arrays of `out` (in the same format) if not None, a new
+    array for each array or key missing from it.
+    """
+    cdef size_t ndim, n_subbands, d, k, l
+    cdef size_t *input_shape = NULL
+    cdef size_t *coefs_shapes = NULL
+    cdef void **coefs_ptrs = NULL
+    cdef np.ndarray c
+    cdef np.dtype output_dtype = _check_dtype(data)
+    cdef INPUT_TYPE input_type = cast_dtypes.get(data.dtype, common.INPUT_NATIVE)
+    cdef int retval = -1
+
+    data = np.ascontiguousarray(data)
+    ndim = data.ndim
+    if ndim < 1:
+        raise ValueError("Expected at least 1D input data.")
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    if ((input_type == common.INPUT_NATIVE and data.dtype != output_dtype) or
+            output_dtype.kind == 'c'):
+        raise TypeError("Array must be floating point, not {}"
+                        .format(data.dtype))
+    keys = [''.join(key) for key in product('ad', repeat=ndim)]
+    n_subbands = len(keys)
+
+    try:
+        input_shape = <size_t *> malloc(ndim * sizeof(size_t))
+        coefs_shapes = <size_t *> malloc(level * ndim * sizeof(size_t))
+        coefs_ptrs = <void **> malloc((1 + level * (n_subbands - 1)) *
+                                      sizeof(void *))
+        if input_shape == NULL or coefs_shapes == NULL or coefs_ptrs == NULL:
+            raise MemoryError()
+
+        for d in range(ndim):
+            input_shape[d] = data.shape[d]
+        _wavedecn_shapes(input_shape, ndim, wavelet.dec_len, mode, level,
+                         coefs_shapes)
+
+        if out is None:
+            out = [None] + [{}] * level
+        elif len(out) != level + 1:
+            raise ValueError("out must have {} levels.".format(level + 1))
+        # the arrays the outputs must not overlap
+        arrays = [data]
+        c = _check_out(out[0], [coefs_shapes[d] for d in range(ndim)],
+                       output_dtype, True, arrays)
+        coefs_ptrs[0] = c.data
+        coeffs = [c]
+        arrays.append(c)
+        for l in range(level):
+            shape = [coefs_shapes[l * ndim + d] for d in range(ndim)]
+            details = {}
+            for k in range(1, n_subbands):
+                c = _check_out(out[1 + l].get(keys[k]), shape, output_dtype,
+                               True, arrays)
+                coefs_ptrs[1 + l * (n_subbands - 1) + (k - 1)] = c.data
+                details[keys[k]] = c
+                arrays.append(c)
+            coeffs.append(details)
+
+        if output_dtype == np.float64:
+            with nogil:
+                retval = c_wt.double_wavedecn_cast(<void *> data.data,
+                                                   input_type, ndim,
+                                                   input_shape, wavelet.w,
+                                                   <double **> coefs_ptrs,
+                                                   coefs_shapes, level, mode,
+                                                   workers)
+        else:
+            with nogil:
+                retval = c_wt.float_wavedecn_cast(<void *> data.data,
+                                                  input_type, ndim,
+                                                  input_shape, wavelet.w,
+                                                  <float **> coefs_ptrs,
+                                                  coefs_shapes, level, mode,
+                                                  workers)
+    finally:
+        free(input_shape)
+        free(coefs_shapes)
+        free(coefs_ptrs)
+
+    if retval:
+        raise RuntimeError("C wavedecn failed.")
+    return coeffs
+
+
+cpdef waverecn(list coeffs, Wavelet wavelet, MODE mode,
+               unsigned int workers=1, out=None):
+    """
+    Multilevel IDWT of [cA_n, {details_n}, ..., {details_1}] as returned by
+    `wavedecn`, all levels in a single call. The arrays must have the same
+    (float32 or float64) dtype, and the details of each level the same shape.
+    cA_n may be None and details may be missing, for zeros, but every level
+    needs at least one array of details. The result is written to the
+    C-contiguous `out` if not None.
+    """
+    cdef size_t level = len(coeffs) - 1, ndim, n_subbands, d, k, l
+    cdef size_t *coefs_shapes = NULL
+    cdef size_t *output_shape = NULL
+    cdef void **coefs_ptrs = NULL
+    cdef np.ndarray c, output
+    cdef int retval = -1
+
+    if level < 1:
+        raise ValueError("Expected at least one level of details.")
+    for details in coeffs[1:]:
+        if not details:
+            raise ValueError("Every level needs at least one array of "
+                             "details.")
+    ndim = len(list(coeffs[1])[0])
+    if ndim < 1:
+        raise ValueError("Invalid detail coefficient keys.")
+    keys = [''.join(key) for key in product('ad', repeat=ndim)]
+    n_subbands = len(keys)
+
+    # contiguous arrays of the same dtype, in the order of the C function
+    arrays = [None] * (1 + level * (n_subbands - 1))
+    if coeffs[0] is not None:
+        arrays[0] = np.ascontiguousarray(coeffs[0])
+    for l in range(level):
+        for key, c in coeffs[1 + l].items():
+            if key not in keys[1:]:
+                raise ValueError("Invalid detail coefficient key "
+                                 "'{}'.".format(key))
+            arrays[1 + l * (n_subbands - 1) + keys.index(key) - 1] = \
+                np.ascontiguousarray(c)
+    level_arrays = [c for c in arrays if c is not None]
+    dtype = level_arrays[0].dtype
+    if dtype != np.float64 and dtype != np.float32:
+        raise TypeError("Array must be floating point, not {}".format(dtype))
+    for c in level_arrays:
+        if c.dtype != dtype or c.ndim != ndim:
+            raise ValueError("Coefficient arrays must have the same dtype "
+                             "and number of dimensions.")
+
+    try:
+        coefs_shapes = <size_t *> malloc(level * ndim * sizeof(size_t))
+        output_shape = <size_t *> malloc(ndim * sizeof(size_t))
+        coefs_ptrs = <void **> malloc(len(arrays) * sizeof(void *))
+        if coefs_shapes == NULL or output_shape == NULL or coefs_ptrs == NULL:
+            raise MemoryError()
+
+        for l in range(level):
+            level_arrays = [c for c in arrays[1 + l * (n_subbands - 1):
+                                              1 + (l + 1) * (n_subbands - 1)]
+                            if c is not None]
+            if l == 0 and arrays[0] is not None:
+                level_arrays.append(arrays[0])
+            shape = (<object> level_arrays[0]).shape
+            for c in level_arrays:
+                if (<object> c).shape != shape:
+                    raise ValueError("`coeffs` must all be of equal size "
+                                     "(or None)")
+            for d in range(ndim):
+                coefs_shapes[l * ndim + d] = shape[d]
+        for d in range(ndim):
+            output_shape[d] = common.idwt_buffer_length(
+                coefs_shapes[(level - 1) * ndim + d], wavelet.rec_len, mode)
+        for k in range(len(arrays)):
+            c = arrays[k]
+            coefs_ptrs[k] = c.data if c is not None else NULL
+
+        output = _check_out(out, [output_shape[d] for d in range(ndim)],
+                            dtype, True, arrays)
+        if dtype == np.float64:
+            with nogil:
+                retval = c_wt.double_waverecn(<const double **> coefs_ptrs,
+                                              ndim, coefs_shapes, wavelet.w,
+                                              <double *> output.data,
+                                              output_shape, level, mode,
+                                              workers)
+        else:
+            with nogil:
+                retval = c_wt.float_waverecn(<const float **> coefs_ptrs,
+                                             ndim, coefs_shapes, wavelet.w,
+                                             <float *> output.data,
+                                             output_shape, level, mode,
+                                             workers)
+    finally:
+        free(coefs_shapes)
+        free(output_shape)
+        free(coefs_ptrs)
+
+    if retval == 1:
+        raise ValueError("incompatible coefficient array sizes")
+    elif retval:
+        raise RuntimeError("C waverecn failed.")
+    return output
+
+
+cpdef dwtn_inplace(np.ndarray data, Wavelet wavelet, unsigned int level, axes,
+                   METHOD method=common.METHOD_CONVOLUTION, bint inverse=False,
+                   unsigned int workers=1):
+    """
+    Multilevel DWT along axes of a float32 or float64 array, in place in a
+    packed layout with the periodization mode (or, if `inverse`, its
+    reconstruction), see `pywt.wavedecn`.
+    """
+    cdef common.ArrayInfo info
+    cdef size_t *c_axes = NULL
+    cdef size_t n_axes = len(axes), k
+    cdef int retval = -1
+
+    if data.ndim < 1:
+        raise ValueError("Expected at least 1D input data.")
+    if not data.flags.writeable or not data.flags.aligned:
+        raise ValueError("Array must be writeable and aligned.")
+    if data.dtype != np.float64 and data.dtype != np.float32:
+        raise TypeError("Array must be float32 or float64, not {}"
+                        .format(data.dtype))
+
+    info.ndim = data.ndim
+    info.strides = <pywt_index_t *> data.strides
+    info.shape = <size_t *> data.shape
+
+    try:
+        c_axes = <size_t *> malloc(n_axes * sizeof(size_t))
+        if c_axes == NULL:
+            raise MemoryError()
+        for k in range(n_axes):
+            c_axes[k] = axes[k]
+
+        if data.dtype == np.float64:
+            with nogil:
+                if inverse:
+                    retval = c_wt.double_waverecn_inplace(
+                        <double *> data.data, info, c_axes, n_axes, wavelet.w,
+                        level, method, workers)
+                else:
+                    retval = c_wt.double_wavedecn_inplace(
+                        <double *> data.data, info, c_axes, n_axes, wavelet.w,
+                        level, method, workers)
+        else:
+            with nogil:
+                if inverse:
+                    retval = c_wt.float_waverecn_inplace(
+                        <float *> data.data, info, c_axes, n_axes, wavelet.w,
+                        level, method, workers)
+                else:
+                    retval = c_wt.float_wavedecn_inplace(
+                        <float *> data.data, info, c_axes, n_axes, wavelet.w,
+                        level, method, workers)
+    finally:
+        free(c_axes)
+
+    if retval == 1:
+        raise ValueError("Invalid arguments for the in-place transform.")
+    elif retval:
+        raise RuntimeError("C in-place transform failed.")
+
+
+# Reversible integer filter banks of `int_lifting`, by name
+int_liftings = {'5/3': c_wt.INT_LIFTING_53, '9/7-M': c_wt.INT_LIFTING_97M}
+
+
+cpdef int_lifting(np.ndarray data, c_wt.INT_LIFTING lifting, unsigned int level,
+                  bint inverse=False, unsigned int workers=1):
+    """
+    Multilevel reversible integer transform of all axes of an int16 or int32
+    array, in place in the packed layout of `pywt.int_wavedecn` (or, if
+    `inverse`, its reconstruction).
+    """
+    cdef common.ArrayInfo info
+    cdef int retval
+
+    if data.ndim < 1:
+        raise ValueError("Expected at least 1D input data.")
+    if not data.flags.writeable or not data.flags.aligned:
+        raise ValueError("Array must be writeable and aligned.")
+
+    info.ndim = data.ndim
+    info.strides = <pywt_index_t *> data.strides
+    info.shape = <size_t *> data.shape
+
+    if data.dtype == np.int16:
+        with nogil:
+            if inverse:
+                retval = c_wt.short_int_waverecn(<short *> data.data, info,
+                                                 lifting, level, workers)
+            else:
+                retval = c_wt.short_int_wavedecn(<short *> data.data, info,
+                                                 lifting, level, workers)
+    elif data.dtype == np.int32:
+        with nogil:
+            if inverse:
+                retval = c_wt.int_int_waverecn(<int *> data.data, info,
+                                               lifting, level, workers)
+            else:
+                retval = c_wt.int_int_wavedecn(<int *> data.data, info,
+                                               lifting, level, workers)
+    else:
+        raise TypeError("Array must be int16 or int32, not {}"
+                        .format(data.dtype))
+
+    if retval == 3:
+        raise OverflowError("Coefficients do not fit in {}, the array is "
+                            "left partially transformed.".format(data.dtype))
+    elif retval:
+        raise RuntimeError("C integer lifting failed.")
+
+
+cpdef size_t wavedecn_peak_memory(shape, Wavelet wavelet, MODE mode,
+                                  unsigned int level, size_t itemsize,
+                                  bint inverse=False, unsigned int workers=1):
+    """
+    Bytes of the arrays returned by `wavedecn` for data of shape and elements
+    of itemsize bytes (or by `waverecn` of its coefficients, if `inverse`),
+    plus the workspace of the transform.
+    """
+    cdef size_t ndim = len(shape), n_subbands, d, l, size, nbytes = 0
+    cdef size_t *input_shape = NULL
+    cdef size_t *coefs_shapes = NULL
+
+    if ndim < 1 or level < 1:
+        return 0
+    n_subbands = (<size_t> 1) << ndim
+    try:
+        input_shape = <size_t *> malloc(ndim * sizeof(size_t))
+        coefs_shapes = <size_t *> malloc(level * ndim * sizeof(size_t))
+        if input_shape == NULL or coefs_shapes == NULL:
+            raise MemoryError()
+        for d in range(ndim):
+            input_shape[d] = shape[d]
+        _wavedecn_shapes(input_shape, ndim, wavelet.dec_len, mode, level,
+                         coefs_shapes)
+
+        if inverse:
+            # the reconstruction of the coefficients of the finest level
+            size = 1
+            for d in range(ndim):
+                input_shape[d] = common.idwt_buffer_length(
+                    coefs_shapes[(level - 1) * ndim + d], wavelet.rec_len,
+                    mode)
+                size *= input_shape[d]
+            nbytes = size * itemsize
+        else:
+            for l in range(level):
+                size = 1
+                for d in range(ndim):
+                    size *= coefs_shapes[l * ndim + d]
+                nbytes += (n_subbands if l == 0 else n_subbands - 1) * size
+            nbytes *= itemsize
+        nbytes += c_wt.wavedecn_workspace(
+            ndim, input_shape, coefs_shapes, level,
+            wavelet.rec_len if inverse else wavelet.dec_len, itemsize,
+            inverse, workers)
+    finally:
+        free(input_shape)
+        free(coefs_shapes)
+    return nbytes
+
+
+cdef class WtnPlan:
+    """
+    The C plans of `wavedecn` and `waverecn` for data of a fixed shape and
+    dtype (float32, float64 or one of `cast_dtypes`), see `pywt.plan`. The
+    shapes, the filter taps of every level and the workspace are computed
+    and allocated once, so `forward` and `inverse` allocate no memory. A
+    plan must not be executed by several threads at once.
+    """
+    cdef c_wt.double_WtnPlan *double_dec
+    cdef c_wt.double_WtnPlan *double_rec
+    cdef c_wt.float_WtnPlan *float_dec
+    cdef c_wt.float_WtnPlan *float_rec
+    cdef void **coefs_ptrs
+    cdef size_t n_subbands
+    # referenced by the C plans
+    cdef readonly Wavelet wavelet
+    cdef readonly tuple shape
+    cdef readonly np.dtype dtype
+    cdef readonly np.dtype coeffs_dtype
+    cdef readonly list coeffs_shapes
+    cdef readonly tuple inverse_shape
+    cdef readonly list keys
+
+    def __cinit__(self, shape, dtype, Wavelet wavelet, MODE mode,
+                  unsigned int level, unsigned int workers=1):
+        cdef size_t ndim = len(shape), d, l
+        cdef size_t *sizes = NULL
+        cdef INPUT_TYPE input_type
+        cdef int retval = 0
+
+        self.wavelet = wavelet
+        self.shape = tuple(shape)
+        self.dtype = np.dtype(dtype)
+        self.coeffs_dtype = _check_dtype(np.empty(0, self.dtype))
+        input_type = cast_dtypes.get(self.dtype, common.INPUT_NATIVE)
+        if ndim < 1:
+            raise ValueError("Expected at least 1D input data.")
+        if level < 1:
+            raise ValueError("Level value must be greater than zero.")
+        if ((input_type == common.INPUT_NATIVE and
+                self.dtype != self.coeffs_dtype) or
+                self.coeffs_dtype.kind == 'c'):
+            raise TypeError("Array must be floating point, not {}"
+                            .format(self.dtype))
+        self.keys = [''.join(key) for key in product('ad', repeat=ndim)]
+        self.n_subbands = len(self.keys)
+
+        try:
+            # the data shape, the coefficients shapes and the reconstruction
+            # shape, one after the other
+            sizes = <size_t *> malloc((level + 2) * ndim * sizeof(size_t))
+            self.coefs_ptrs = <void **> malloc(
+                (1 + level * (self.n_subbands - 1)) * sizeof(void *))
+            if sizes == NULL or self.coefs_ptrs == NULL:
+                raise MemoryError()
+            for d in range(ndim):
+                sizes[d] = self.shape[d]
+            _wavedecn_shapes(sizes, ndim, wavelet.dec_len, mode, level,
+                             sizes + ndim)
+            for d in range(ndim):
+                sizes[(level + 1) * ndim + d] = common.idwt_buffer_length(
+                    sizes[level * ndim + d], wavelet.rec_len, mode)
+            self.coeffs_shapes = [tuple(sizes[(1 + l) * ndim + d]
+                                        for d in range(ndim))
+                                  for l in range(level)]
+            self.inverse_shape = tuple(sizes[(level + 1) * ndim + d]
+                                       for d in range(ndim))
+
+            # waverecn needs filters of even length
+            if self.coeffs_dtype == np.float64:
+                retval = c_wt.double_wtn_plan_create(
+                    ndim, sizes, sizes + ndim, wavelet.w, level, mode,
+                    input_type, 0, workers, &self.double_dec)
+                if retval == 0 and wavelet.rec_len % 2 == 0:
+                    retval = c_wt.double_wtn_plan_create(
+                        ndim, sizes + (level + 1) * ndim, sizes + ndim,
+                        wavelet.w, level, mode, common.INPUT_NATIVE, 1,
+                        workers, &self.double_rec)
+            else:
+                retval = c_wt.float_wtn_plan_create(
+                    ndim, sizes, sizes + ndim, wavelet.w, level, mode,
+                    input_type, 0, workers, &self.float_dec)
+                if retval == 0 and wavelet.rec_len % 2 == 0:
+                    retval = c_wt.float_wtn_plan_create(
+                        ndim, sizes + (level + 1) * ndim, sizes + ndim,
+                        wavelet.w, level, mode, common.INPUT_NATIVE, 1,
+                        workers, &self.float_rec)
+        finally:
+            free(sizes)
+
+        if retval == 1:
+            raise ValueError("Invalid shape {} for the transform."
+                             .format(self.shape))
+        elif retval:
+            raise MemoryError()
+
+    def __dealloc__(self):
+        c_wt.double_wtn_plan_free(self.double_dec)
+        c_wt.double_wtn_plan_free(self.double_rec)
+        c_wt.float_wtn_plan_free(self.float_dec)
+        c_wt.float_wtn_plan_free(self.float_rec)
+        free(self.coefs_ptrs)
+
+    def forward(self, np.ndarray data, list out):
+        """
+        `wavedecn` of data, of the shape and dtype of the plan, written to
+        the C-contiguous arrays of out, a complete list in its format.
+        """
+        cdef size_t level = len(self.coeffs_shapes), l, k
+        cdef np.ndarray c
+        cdef int retval
+
+        if data.dtype != self.dtype:
+            raise TypeError("Expected data of dtype {}, not {}."
+                            .format(self.dtype, data.dtype))
+        if (<object> data).shape != self.shape:
+            raise ValueError("Expected data of shape {}, not {}."
+                             .format(self.shape, (<object> data).shape))
+        if len(out) != level + 1:
+            raise ValueError("out must have {} levels.".format(level + 1))
+        data = np.ascontiguousarray(data)
+
+        arrays = []
+        c = _check_out(out[0], self.coeffs_shapes[0], self.coeffs_dtype, True)
+        self.coefs_ptrs[0] = c.data
+        arrays.append(c)
+        for l in range(level):
+            details = out[1 + l]
+            for k in range(1, self.n_subbands):
+                c = _check_out(details[self.keys[k]], self.coeffs_shapes[l],
+                               self.coeffs_dtype, True)
+                self.coefs_ptrs[1 + l * (self.n_subbands - 1) + (k - 1)] = \
+                    c.data
+                arrays.append(c)
+        _check_out_overlap(arrays, data)
+
+        if self.double_dec != NULL:
+            with nogil:
+                retval = c_wt.double_wavedecn_execute(
+                    self.double_dec, <void *> data.data,
+                    <double **> self.coefs_ptrs)
+        else:
+            with nogil:
+                retval = c_wt.float_wavedecn_execute(
+                    self.float_dec, <void *> data.data,
+                    <float **> self.coefs_ptrs)
+        if retval:
+            raise MemoryError()
+        return out
+
+    cdef np.ndarray _check_coeffs(self, c, size_t l, list copies):
+        # c as a C-contiguous array of the dtype and shape of level l
+        cdef np.ndarray a
+        if c is None:
+            return None
+        a = np.asarray(c)
+        if a.dtype != self.coeffs_dtype:
+            raise TypeError("Expected coefficients of dtype {}, not {}."
+                            .format(self.coeffs_dtype, a.dtype))
+        if (<object> a).shape != self.coeffs_shapes[l]:
+            raise ValueError("Expected coefficients of shape {}, not {}."
+                             .format(self.coeffs_shapes[l],
+                                     (<object> a).shape))
+        if not a.flags.c_contiguous:
+            a = np.ascontiguousarray(a)
+            copies.append(a)
+        return a
+
+    def inverse(self, list coeffs, np.ndarray out):
+        """
+        `waverecn` of coeffs, in the format of `forward` with arrays of the
+        dtype and shapes of the plan (copied unless C-contiguous), written
+        to the C-contiguous out of shape `inverse_shape`. cA_n may be None
+        and details may be missing, for zeros.
+        """
+        cdef size_t level = len(self.coeffs_shapes), l, k
+        cdef np.ndarray c
+        cdef int retval
+        cdef list copies = [], arrays = []
+
+        if self.double_rec == NULL and self.float_rec == NULL:
+            raise ValueError("waverecn needs filters of even length.")
+        if len(coeffs) != level + 1:
+            raise ValueError("Expected {} levels of coefficients, not {}."
+                             .format(level + 1, len(coeffs)))
+
+        c = self._check_coeffs(coeffs[0], 0, copies)
+        self.coefs_ptrs[0] = c.data if c is not None else NULL
+        arrays.append(c)
+        for l in range(level):
+            details = coeffs[1 + l]
+            for key in details:
+                if key == self.keys[0] or key not in self.keys:
+                    raise ValueError("Invalid detail coefficient key "
+                                     "'{}'.".format(key))
+            for k in range(1, self.n_subbands):
+                c = self._check_coeffs(details.get(self.keys[k]), l, copies)
+                self.coefs_ptrs[1 + l * (self.n_subbands - 1) + (k - 1)] = \
+                    c.data if c is not None else NULL
+                arrays.append(c)
+        _check_out(out, self.inverse_shape, self.coeffs_dtype, True, arrays)
+
+        if self.double_rec != NULL:
+            with nogil:
+                retval = c_wt.double_waverecn_execute(
+                    self.double_rec, <const double **> self.coefs_ptrs,
+                    <double *> out.data)
+        else:
+            with nogil:
+                retval = c_wt.float_waverecn_execute(
+                    self.float_rec, <const float **> self.coefs_ptrs,
+                    <float *> out.data)
+        if retval:
+            raise MemoryError()
+        return out
+
+
+cpdef upcoef(bint do_rec_a, data_t[::1] coeffs, Wavelet wavelet, int level, int take,
+             out=None):
+    # out (C-contiguous) receives the result, of length take if trimmed
     cdef data_t[::1] rec
+    cdef np.ndarray output
     cdef int i, retval
     cdef size_t rec_len, left_bound, right_bound, coeffs_size
+    cdef bint trim
+    cdef np.dtype dtype = np.dtype(np.float64 if data_t is np.float64_t
+                                   else np.float32)
 
 
     rec_len = 0
@@ -246,13 +1119,23 @@ cpdef upcoef(bint do_rec_a, data_t[::1] coeffs, Wavelet wavelet, int level, int
         rec_len = common.reconstruction_buffer_length(coeffs.size, wavelet.dec_len)
         if rec_len < 1:
             raise RuntimeError("Invalid output length.")
+        trim = take > 0 and take < rec_len
+
+        # The reconstruction adds to its (zeroed) output. The last level is
+        # written to out, unless only its central part is taken.
+        if i == level - 1 and not trim:
+            output = _check_out(out, (rec_len, ), dtype, True,
+                                (np.asarray(coeffs), ))
+        else:
+            output = np.empty(rec_len, dtype)
+        rec = output
+        rec[:] = 0
 
         # To mirror multi-level wavelet reconstruction behaviour, when detail
         # reconstruction is requested, the dec_d variant is only called at the
         # first level to generate the approximation coefficients at the second
         # level.  Subsequent levels apply the reconstruction filter.
         if data_t is np.float64_t:
-            rec = np.zeros(rec_len, dtype=np.float64)
             if do_rec_a or i > 0:
                 with nogil:
                     retval = c_wt.double_rec_a(&coeffs[0], coeffs_size, wavelet.w,
@@ -266,7 +1149,6 @@ cpdef upcoef(bint do_rec_a, data_t[::1] coeffs, Wavelet wavelet, int level, int
                 if retval < 0:
                     raise RuntimeError("C rec_d failed.")
         elif data_t is np.float32_t:
-            rec = np.zeros(rec_len, dtype=np.float32)
             if do_rec_a or i > 0:
                 with nogil:
                     retval = c_wt.float_rec_a(&coeffs[0], coeffs_size, wavelet.w,
@@ -282,21 +1164,30 @@ cpdef upcoef(bint do_rec_a, data_t[::1] coeffs, Wavelet wavelet, int level, int
         # TODO: this algorithm needs some explaining
         coeffs = rec
 
-    if take > 0 and take < rec_len:
+    if trim:
         left_bound = right_bound = (rec_len-take) // 2
         if (rec_len-take) % 2:
             # right_bound must never be zero for indexing to work
             right_bound = right_bound + 1
 
+        if out is not None:
+            output = _check_out(out, (take, ), dtype, True)
+            output[...] = rec[left_bound:-right_bound]
+            return output
         return rec[left_bound:-right_bound]
 
-    return rec
+    return output
 
 
-cpdef downcoef(bint do_dec_a, data_t[::1] data, Wavelet wavelet, MODE mode, int level):
+cpdef downcoef(bint do_dec_a, data_t[::1] data, Wavelet wavelet, MODE mode, int level,
+               out=None):
+    # out (C-contiguous) receives the coefficients of the last level
     cdef data_t[::1] coeffs
+    cdef np.ndarray output
     cdef int i, retval
     cdef size_t output_len, data_size
+    cdef np.dtype dtype = np.dtype(np.float64 if data_t is np.float64_t
+                                   else np.float32)
 
     if level < 1:
         raise ValueError("Value of level must be greater than 0.")
@@ -306,6 +1197,12 @@ cpdef downcoef(bint do_dec_a, data_t[::1] data, Wavelet wavelet, MODE mode, int
         output_len = common.dwt_buffer_length(data.size, wavelet.dec_len, mode)
         if output_len < 1:
             raise RuntimeError("Invalid output length.")
+        if i == level - 1:
+            output = _check_out(out, (output_len, ), dtype, True,
+                                (np.asarray(data), ))
+        else:
+            output = np.empty(output_len, dtype)
+        coeffs = output
 
         # To mirror multi-level wavelet decomposition behaviour, when detail
         # coefficients are requested, the dec_d variant is only called at the
@@ -313,7 +1210,6 @@ cpdef downcoef(bint do_dec_a, data_t[::1] data, Wavelet wavelet, MODE mode, int
         # coefficients at level n are those produced via the operation of the
         # detail filter on the approximation coefficients of level n-1.
         if data_t is np.float64_t:
-            coeffs = np.zeros(output_len, dtype=np.float64)
             if do_dec_a or (i < level - 1):
                 with nogil:
                     retval = c_wt.double_dec_a(&data[0], data_size, wavelet.w,
@@ -327,7 +1223,6 @@ cpdef downcoef(bint do_dec_a, data_t[::1] data, Wavelet wavelet, MODE mode, int
                 if retval < 0:
                     raise RuntimeError("C dec_d failed.")
         elif data_t is np.float32_t:
-            coeffs = np.zeros(output_len, dtype=np.float32)
             if do_dec_a or (i < level - 1):
                 with nogil:
                     retval = c_wt.float_dec_a(&data[0], data_size, wavelet.w,
@@ -342,4 +1237,12 @@ cpdef downcoef(bint do_dec_a, data_t[::1] data, Wavelet wavelet, MODE mode, int
                     raise RuntimeError("C dec_d failed.")
         data = coeffs
 
-    return coeffs
+    return output
+
+
+def _set_convolution_options(int simd_code, int boundary_code,
+                             size_t fft_threshold):
+    # see _pywt._sync_convolution_options
+    simd.simd_set(<simd.SIMD>simd_code)
+    convolution.boundary_set(<convolution.BOUNDARY>boundary_code)
+    convolution.fft_threshold_set(fft_threshold)
@@ -13,7 +13,17 @@ cdef public class Wavelet [type WaveletType, object WaveletObject]:
     cdef readonly name
     cdef readonly number
 
+    cdef object _lifting
+    cdef bint _lifting_checked
+
+    cdef _set_lifting(self, scheme)
+
 cpdef np.dtype _check_dtype(data)
 
+cpdef np.ndarray _check_out(out, shape, np.dtype dtype, bint contiguous=*,
+                            inputs=*)
+
+cpdef _check_out_overlap(outputs, inputs=*)
+
 # FIXME: To be removed
 cdef c_wavelet_from_object(wavelet)
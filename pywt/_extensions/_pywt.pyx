@@ -2,20 +2,31 @@
 # See COPYING for license details.
 
 __doc__ = """Pyrex wrapper for low-level C wavelet transform implementation."""
-__all__ = ['MODES', 'Modes', 'Wavelet', 'wavelist', 'families']
+__all__ = ['MODES', 'Modes', 'Wavelet', 'wavelist', 'families',
+           'get_simd', 'set_simd', 'simd_variants', 'get_boundary_strategy',
+           'set_boundary_strategy', 'get_fft_threshold', 'set_fft_threshold',
+           'get_workers', 'set_workers']
 
 ###############################################################################
 # imports
+import multiprocessing
+import operator
+import sys
 import warnings
 
 cimport c_wt
 cimport common
+cimport convolution
+cimport simd
 from ._dwt cimport upcoef
 
 from libc.math cimport pow, sqrt
+from libc.stdlib cimport malloc, free, qsort
 
 import numpy as np
 
+from .._lifting import lifting_scheme as _lifting_scheme, _lifting_error
+
 
 ###############################################################################
 # Modes
@@ -142,6 +153,300 @@ class _DeprecatedMODES(_Modes):
 
 MODES = _DeprecatedMODES()
 
+###############################################################################
+# SIMD
+
+_simd_names = ['none', 'sse2', 'avx2', 'avx512']
+
+
+def simd_variants():
+    """
+    simd_variants()
+
+    Instruction set variants of the convolution kernels that can be used on
+    this machine, ordered from least to most capable.
+
+    Returns
+    -------
+    variants : list of str
+        Always contains ``'none'`` (portable C code), followed by those of
+        ``'sse2'``, ``'avx2'`` (AVX2 with FMA) and ``'avx512'`` (AVX-512F)
+        supported by the CPU, operating system and compiler.
+    """
+    return [name for code, name in enumerate(_simd_names)
+            if simd.simd_supported(<simd.SIMD>code)]
+
+
+def get_simd():
+    """
+    get_simd()
+
+    Name of the instruction set variant currently used by the convolution
+    kernels. See `simd_variants` for possible values.
+    """
+    return _simd_names[simd.simd_get()]
+
+
+def set_simd(variant=None):
+    """
+    set_simd(variant=None)
+
+    Select the instruction set variant used by the convolution kernels.
+
+    The most capable variant supported by the machine is selected
+    automatically when pywt is imported. This function is mainly useful for
+    testing and benchmarking.
+
+    Parameters
+    ----------
+    variant : str or None, optional
+        One of the names returned by `simd_variants`. If None (default), the
+        variant is detected again.
+
+    Notes
+    -----
+    The ``'none'`` and ``'sse2'`` variants give bit-identical results. The
+    ``'avx2'`` and ``'avx512'`` variants use fused multiply-add instructions,
+    so results may differ in the last bits.
+    """
+    if variant is None:
+        code = simd.simd_detect()
+    elif variant in _simd_names:
+        code = _simd_names.index(variant)
+    else:
+        raise ValueError("Unknown SIMD variant '%s'." % (variant, ))
+    if simd.simd_set(<simd.SIMD>code) < 0:
+        raise ValueError("SIMD variant '%s' is not supported on this "
+                         "machine." % (variant, ))
+    _sync_convolution_options()
+
+
+def _convolution_options():
+    return (simd.simd_get(), convolution.boundary_get(),
+            convolution.fft_threshold_get())
+
+
+def _sync_convolution_options():
+    # The C library is linked statically into each extension module, each
+    # with its own copy of these settings: copy them to the other modules.
+    package = __name__.rpartition('.')[0]
+    for name in ['_dwt', '_swt']:
+        module = sys.modules.get(package + '.' + name)
+        if module is not None:
+            module._set_convolution_options(*_convolution_options())
+
+
+set_simd()
+
+###############################################################################
+# Boundary handling
+
+_boundary_names = ['inline', 'padded']
+
+
+def get_boundary_strategy():
+    """
+    get_boundary_strategy()
+
+    Name of the strategy used by the convolutions for the coefficients near
+    the signal boundaries, see `set_boundary_strategy`.
+    """
+    return _boundary_names[convolution.boundary_get()]
+
+
+def set_boundary_strategy(strategy):
+    """
+    set_boundary_strategy(strategy)
+
+    Select how the decimating convolutions of the discrete wavelet transform
+    compute the coefficients for which the filter extends past the signal.
+
+    Parameters
+    ----------
+    strategy : {'inline', 'padded'}
+        ``'inline'`` (default) evaluates the signal extension mode for each
+        filter tap. ``'padded'`` extends the samples near each boundary into
+        a small buffer once (see `pad`) and convolves it like the rest of
+        the signal, without branches or modular arithmetic in the inner
+        loops.
+
+    Notes
+    -----
+    Both strategies give the same coefficients up to rounding, as the
+    filter taps are summed in a different order. Filters longer than about
+    250 coefficients are always handled inline.
+    """
+    if strategy not in _boundary_names:
+        raise ValueError("Unknown boundary strategy '%s'." % (strategy, ))
+    code = _boundary_names.index(strategy)
+    convolution.boundary_set(<convolution.BOUNDARY>code)
+    _sync_convolution_options()
+
+###############################################################################
+# FFT convolution
+
+
+def get_fft_threshold():
+    """
+    get_fft_threshold()
+
+    Filter length from which the decimating convolutions use the FFT, see
+    `set_fft_threshold`.
+    """
+    return convolution.fft_threshold()
+
+
+def set_fft_threshold(taps=None):
+    """
+    set_fft_threshold(taps=None)
+
+    Select the filter length from which the decimating convolutions of the
+    discrete wavelet transform (`dwt`, `wavedec`, `downcoef`, ...) are
+    computed with the FFT rather than directly.
+
+    Parameters
+    ----------
+    taps : int or None, optional
+        Filters with at least this many coefficients use the FFT. If None
+        (default), the crossover measured for the selected SIMD variant (see
+        `set_simd`) is used. Use ``sys.maxsize`` to always convolve
+        directly.
+
+    Notes
+    -----
+    The FFT backend convolves overlapping blocks of the signal, extended
+    with the signal extension mode, with a radix-2 FFT bundled with
+    PyWavelets. Its cost per coefficient grows with the logarithm of the
+    filter length instead of linearly, but the coefficients only match those
+    of the direct convolution up to floating-point rounding (computed in
+    double precision, also for single precision input). Transforms along
+    non-contiguous axes and two tap filters are always computed directly.
+    """
+    if taps is None:
+        taps = 0
+    elif taps < 1:
+        raise ValueError("taps must be a positive integer.")
+    convolution.fft_threshold_set(taps)
+    _sync_convolution_options()
+
+###############################################################################
+# Threads
+
+_default_workers = 1
+
+
+def _cpu_count():
+    try:
+        return multiprocessing.cpu_count()
+    except NotImplementedError:
+        return 1
+
+
+def _workers_from_object(workers):
+    """
+    Number of threads for the ``workers`` argument of the transforms.
+
+    None selects the default set by `set_workers`, negative values count back
+    from the number of CPUs (-1 uses all of them).
+    """
+    if workers is None:
+        return _default_workers
+    workers = operator.index(workers)
+    if workers < 0:
+        workers += _cpu_count() + 1
+        if workers < 1:
+            raise ValueError("workers value out of range; got %d, must not "
+                             "be less than %d." % (workers - _cpu_count() - 1,
+                                                   -_cpu_count()))
+    elif workers == 0:
+        raise ValueError("workers must not be 0.")
+    return workers
+
+
+def get_workers():
+    """
+    get_workers()
+
+    Default number of threads of the transforms, see `set_workers`.
+    """
+    return _default_workers
+
+
+def set_workers(workers=1):
+    """
+    set_workers(workers=1)
+
+    Set the number of threads used by `dwt`, `idwt`, `dwtn`, `idwtn` and the
+    functions built on them when their ``workers`` argument is not given.
+
+    Parameters
+    ----------
+    workers : int, optional
+        Number of threads. Negative values count back from the number of
+        CPUs, i.e. -1 uses all of them. The default of 1 disables threading.
+
+    Notes
+    -----
+    The lines along the transformed axis of n-dimensional arrays are divided
+    between the threads, results do not depend on their number. 1D signals
+    are always transformed by a single thread. Threads are only used if
+    PyWavelets was built with OpenMP support.
+    """
+    global _default_workers
+    _default_workers = _workers_from_object(workers)
+
+###############################################################################
+# Transform methods
+
+_method_names = ['convolution', 'lifting']
+
+# Shortest filters for which method='auto' reconstructs with the lifting
+# scheme, which it only does with the scalar kernels (simd='none'): the
+# vectorized convolutions are faster than the lifting steps for all built-in
+# wavelets, in both directions. Decomposition always uses the convolution.
+_auto_lifting_min_rec_len = 24
+
+# Largest deviation of the lifting scheme from the filters (see
+# `_lifting_error`) for which method='auto' uses it. The reconstructions then
+# agree with the convolution to within about 1e-10 (relative); the lifting
+# schemes of e.g. db12 to db18 deviate more and are left to the convolution.
+_auto_lifting_max_error = 1e-12
+
+
+def _method_from_object(Wavelet wavelet, method, inverse=False):
+    """
+    Code of the transform method for wavelet.
+
+    ``'convolution'`` convolves the signal with the filters, ``'lifting'``
+    uses the lifting scheme of the wavelet (see `Wavelet.lifting_scheme`) and
+    raises ValueError if there is none. ``'auto'`` selects the method
+    expected to be faster with the current SIMD variant among those agreeing
+    with the convolution to within about 1e-10, for the inverse transform if
+    `inverse` is True.
+    Codes are returned unchanged after validation.
+    """
+    if isinstance(method, int):
+        if method <= common.METHOD_INVALID or method >= common.METHOD_MAX:
+            raise ValueError("Invalid transform method.")
+        if (method == common.METHOD_LIFTING and
+                wavelet.lifting_scheme is None):
+            raise ValueError("Wavelet '%s' has no lifting scheme." %
+                             wavelet.name)
+        return method
+    if method == 'auto':
+        if (inverse and simd.simd_get() == simd.SIMD_NONE and
+                wavelet.rec_len >= _auto_lifting_min_rec_len and
+                wavelet.lifting_scheme is not None and
+                _lifting_error(wavelet.filter_bank) <=
+                _auto_lifting_max_error):
+            return common.METHOD_LIFTING
+        return common.METHOD_CONVOLUTION
+    if method not in _method_names:
+        raise ValueError("Unknown transform method '%s'." % (method, ))
+    if method == 'lifting' and wavelet.lifting_scheme is None:
+        raise ValueError("Wavelet '%s' has no lifting scheme." % wavelet.name)
+    return _method_names.index(method)
+
 ###############################################################################
 # Wavelet
 
@@ -334,6 +639,7 @@ cdef public class Wavelet [type WaveletType, object WaveletObject]:
             copy_object_to_float64_array(dec_hi, self.w.dec_hi_double)
             copy_object_to_float64_array(rec_lo, self.w.rec_lo_double)
             copy_object_to_float64_array(rec_hi, self.w.rec_hi_double)
+            wavelet.wavelet_update_filters(self.w)
 
             self.name = name
 
@@ -430,6 +736,45 @@ cdef public class Wavelet [type WaveletType, object WaveletObject]:
         def __get__(self):
             return (self.dec_lo, self.dec_hi, self.rec_lo, self.rec_hi)
 
+    property lifting_scheme:
+        """Lifting factorization of the filter bank, as returned by
+        `lifting_scheme`, or None if the filters have none. Used by the
+        transforms with ``method='lifting'``.
+        """
+        def __get__(self):
+            if not self._lifting_checked:
+                scheme = _lifting_scheme(self.filter_bank)
+                if scheme is not None:
+                    self._set_lifting(scheme)
+                self._lifting = scheme
+                self._lifting_checked = True
+            return self._lifting
+
+    cdef _set_lifting(self, scheme):
+        cdef wavelet.LiftingScheme* c_scheme
+        cdef double[::1] coefs
+        cdef size_t i, k
+
+        c_scheme = wavelet.blank_lifting_scheme(len(scheme.steps))
+        if c_scheme is NULL:
+            raise MemoryError("Could not allocate memory for lifting scheme.")
+        for i, (target, offset, step_coefs) in enumerate(scheme.steps):
+            coefs = np.ascontiguousarray(step_coefs, dtype=np.float64)
+            if wavelet.set_lifting_step(c_scheme, i, target, offset,
+                                        &coefs[0], coefs.size) < 0:
+                wavelet.free_lifting_scheme(c_scheme)
+                raise MemoryError("Could not allocate memory for lifting "
+                                  "scheme.")
+        for k in range(2):
+            c_scheme.scale_double[k] = scheme.scales[k]
+            c_scheme.scale_float[k] = scheme.scales[k]
+            c_scheme.shift[k] = scheme.shifts[k]
+            c_scheme.source[k] = scheme.sources[k]
+        c_scheme.delay = scheme.delay
+
+        wavelet.free_lifting_scheme(self.w.lifting)
+        self.w.lifting = c_scheme
+
     def get_filters_coeffs(self):
         warnings.warn("The `get_filters_coeffs` method is deprecated. "
                       "Use `filter_bank` attribute instead.", DeprecationWarning)
@@ -612,7 +957,14 @@ cpdef np.dtype _check_dtype(data):
     cdef np.dtype dt
     try:
         dt = data.dtype
-        if dt not in (np.float64, np.float32):
+        if dt.kind == 'c':
+            # complex data, transformed with the real filters
+            if dt not in (np.complex128, np.complex64):
+                dt = np.dtype('complex128')
+        elif dt == np.float16:
+            # half precision is computed (and returned) in single precision
+            dt = np.dtype('float32')
+        elif dt not in (np.float64, np.float32):
             # integer input was always accepted; convert to float64
             dt = np.dtype('float64')
     except AttributeError:
@@ -620,6 +972,120 @@ cpdef np.dtype _check_dtype(data):
     return dt
 
 
+cpdef np.ndarray _check_out(out, shape, np.dtype dtype, bint contiguous=False,
+                            inputs=()):
+    """
+    The array to return a result of shape and dtype in: `out`, which must be
+    writeable and aligned (and C-contiguous if `contiguous`), or a new array
+    if `out` is None. `out` must not overlap any array of `inputs`, see
+    `_check_out_overlap`.
+    """
+    if out is None:
+        return np.empty(shape, dtype)
+    if not isinstance(out, np.ndarray):
+        raise TypeError("out must be an array, not {}"
+                        .format(type(out).__name__))
+    if out.dtype != dtype:
+        raise TypeError("out must have dtype {}, not {}"
+                        .format(dtype, out.dtype))
+    shape = tuple(shape)
+    if out.shape != shape:
+        raise ValueError("out must have shape {}, not {}"
+                         .format(shape, out.shape))
+    if not out.flags.writeable or not out.flags.aligned:
+        raise ValueError("out must be writeable and aligned.")
+    if contiguous and not out.flags.c_contiguous:
+        raise ValueError("out must be C-contiguous.")
+    _check_out_overlap((out, ), inputs)
+    return out
+
+
+cpdef _check_out_overlap(outputs, inputs=()):
+    """
+    Raises ValueError if an array of `outputs` overlaps an array of `inputs`
+    or another output, as the transforms would overwrite samples they have
+    not read yet. Both may be nested lists, tuples and dicts of arrays, other
+    items are skipped. Like `np.may_share_memory`, only the memory extents
+    of the arrays are compared.
+    """
+    cdef Py_ssize_t n, i
+    cdef Py_ssize_t end = 0, end_out = 0
+    cdef _Extent *extents
+    cdef bint overlap = False
+
+    n = _add_extents(NULL, 0, outputs, True)
+    if n == 0:
+        return
+    n = _add_extents(NULL, n, inputs, False)
+    extents = <_Extent *> malloc(n * sizeof(_Extent))
+    if extents == NULL:
+        raise MemoryError()
+    try:
+        _add_extents(extents, _add_extents(extents, 0, outputs, True),
+                     inputs, False)
+        # sorted by start, an array overlaps an earlier one iff it starts
+        # before the end of the furthest reaching one
+        qsort(extents, n, sizeof(_Extent), _compare_extents)
+        for i in range(n):
+            if extents[i].start < (end if extents[i].is_output else end_out):
+                overlap = True
+                break
+            if extents[i].stop > end:
+                end = extents[i].stop
+            if extents[i].is_output and extents[i].stop > end_out:
+                end_out = extents[i].stop
+    finally:
+        free(extents)
+    if overlap:
+        raise ValueError("out must not overlap the input or the other "
+                         "outputs.")
+
+
+ctypedef struct _Extent:
+    # the bytes spanned by an array
+    Py_ssize_t start
+    Py_ssize_t stop
+    bint is_output
+
+
+cdef int _compare_extents(const void *a, const void *b) noexcept nogil:
+    cdef Py_ssize_t start_a = (<const _Extent *> a).start
+    cdef Py_ssize_t start_b = (<const _Extent *> b).start
+    return (start_a > start_b) - (start_a < start_b)
+
+
+cdef Py_ssize_t _add_extents(_Extent *extents, Py_ssize_t n, c,
+                             bint is_output) except -1:
+    # Stores the extents of the non-empty arrays in c from extents[n] on, or
+    # only counts them if extents is NULL. Returns the new count.
+    cdef np.ndarray a
+    cdef Py_ssize_t start, stop, step
+    cdef int i
+    if isinstance(c, np.ndarray):
+        a = c
+        start = stop = <Py_ssize_t> a.data
+        for i in range(a.ndim):
+            if a.shape[i] == 0:
+                return n
+            step = (a.shape[i] - 1) * a.strides[i]
+            if step < 0:
+                start += step
+            else:
+                stop += step
+        if extents != NULL:
+            extents[n].start = start
+            extents[n].stop = stop + a.itemsize
+            extents[n].is_output = is_output
+        return n + 1
+    if isinstance(c, dict):
+        c = (<dict> c).values()
+    elif not isinstance(c, (list, tuple)):
+        return n
+    for x in c:
+        n = _add_extents(extents, n, x, is_output)
+    return n
+
+
 # TODO: Can this be replaced by the take parameter of upcoef? Or vice-versa?
 def keep(arr, keep_length):
     length = len(arr)
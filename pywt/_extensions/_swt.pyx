@@ -1,11 +1,17 @@
 #cython: boundscheck=False, wraparound=False
 cimport common
 cimport c_wt
+cimport convolution
+cimport simd
+from common cimport pywt_index_t
+from libc.stdlib cimport malloc, free
 
 import numpy as np
 cimport numpy as np
 
-from ._pywt cimport c_wavelet_from_object, data_t, Wavelet
+from ._pywt cimport (c_wavelet_from_object, data_t, Wavelet, _check_dtype,
+                    _check_out)
+from ._pywt import _convolution_options, _check_out_overlap
 
 
 def swt_max_level(size_t input_len):
@@ -29,12 +35,19 @@ def swt_max_level(size_t input_len):
     return common.swt_max_level(input_len)
 
 
-def swt(data_t[::1] data, Wavelet wavelet, size_t level, size_t start_level):
-    cdef data_t[::1] cA, cD
-    cdef Wavelet w
-    cdef int i, retval
+def swt(data_t[::1] data, Wavelet wavelet, size_t level, size_t start_level,
+        out=None):
+    """
+    Multilevel SWT, all levels in a single call. Returns a list of (cA, cD)
+    pairs, coarsest level first, which are views of a single (level, 2, N)
+    block, or the C-contiguous arrays of `out` (a list of pairs in the order
+    of the result) if not None.
+    """
     cdef size_t end_level = start_level + level
-    cdef size_t data_size, output_len
+    cdef size_t data_size = data.size, output_len, k
+    cdef void **coefs_ptrs = NULL
+    cdef np.ndarray block
+    cdef int retval = -1
 
     if data.size % 2:
         raise ValueError("Length of data must be even.")
@@ -54,43 +67,437 @@ def swt(data_t[::1] data, Wavelet wavelet, size_t level, size_t start_level):
     if output_len < 1:
         raise RuntimeError("Invalid output length.")
 
-    ret = []
-    for i in range(start_level+1, end_level+1):
-        data_size = data.size
-        # alloc memory, decompose D
+    if out is not None and len(out) != level:
+        raise ValueError("out must have {} pairs of arrays.".format(level))
+    dtype = np.dtype(np.float64 if data_t is np.float64_t else np.float32)
+
+    if out is None:
+        block = np.empty((level, 2, output_len), dtype)
+        ret = [(block[k, 0], block[k, 1]) for k in range(level)]
+    else:
+        ret = [tuple(_check_out(o, (output_len, ), dtype, True) for o in pair)
+               for pair in out]
+        _check_out_overlap(ret, np.asarray(data))
+
+    try:
+        coefs_ptrs = <void **> malloc(2 * level * sizeof(void *))
+        if coefs_ptrs == NULL:
+            raise MemoryError()
+        for k in range(level):
+            coefs_ptrs[k] = (<np.ndarray> ret[k][0]).data
+            coefs_ptrs[level + k] = (<np.ndarray> ret[k][1]).data
+
         if data_t is np.float64_t:
-            cD = np.zeros(output_len, dtype=np.float64)
             with nogil:
-                retval = c_wt.double_swt_d(&data[0], data_size, wavelet.w,
-                                 &cD[0], output_len, i)
-            if retval < 0:
-                raise RuntimeError("C swt failed.")
+                retval = c_wt.double_swt_multilevel(&data[0], data_size,
+                                                    wavelet.w,
+                                                    <double **> coefs_ptrs,
+                                                    <double **> coefs_ptrs + level,
+                                                    level, start_level)
         elif data_t is np.float32_t:
-            cD = np.zeros(output_len, dtype=np.float32)
             with nogil:
-                retval = c_wt.float_swt_d(&data[0], data_size, wavelet.w,
-                                &cD[0], output_len, i)
-            if retval < 0:
-                raise RuntimeError("C swt failed.")
+                retval = c_wt.float_swt_multilevel(&data[0], data_size,
+                                                   wavelet.w,
+                                                   <float **> coefs_ptrs,
+                                                   <float **> coefs_ptrs + level,
+                                                   level, start_level)
+    finally:
+        free(coefs_ptrs)
+
+    if retval:
+        raise RuntimeError("C swt failed.")
+    return ret
+
+
+def iswt(data_t[::1] cA, list details, Wavelet wavelet):
+    """
+    Multilevel inverse SWT, all levels in a single call, of the approximation
+    at the top level and the details [cD_n, ..., cD_1] as returned by `swt`
+    with start_level 0. The details must be C-contiguous arrays of the dtype
+    of `cA`.
+    """
+    cdef size_t level = len(details), data_size = cA.size, k
+    cdef void **coefs_ptrs = NULL
+    cdef np.ndarray cD, output
+    cdef int retval = -1
+
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    if data_size % 2:
+        raise ValueError("Length of coefficients must be even.")
+    if level > common.swt_max_level(data_size):
+        raise ValueError("Level value too high (max level for current data "
+                         "size is %d)." % common.swt_max_level(data_size))
+    dtype = np.dtype(np.float64 if data_t is np.float64_t else np.float32)
+
+    try:
+        coefs_ptrs = <void **> malloc(level * sizeof(void *))
+        if coefs_ptrs == NULL:
+            raise MemoryError()
+        for k in range(level):
+            cD = details[k]
+            if (cD.dtype != dtype or cD.ndim != 1 or cD.size != data_size or
+                    not cD.flags.c_contiguous):
+                raise ValueError("Approximation and detail coefficients must "
+                                 "have the same length.")
+            coefs_ptrs[k] = cD.data
 
-        # alloc memory, decompose A
+        output = np.empty(data_size, dtype)
         if data_t is np.float64_t:
-            cA = np.zeros(output_len, dtype=np.float64)
             with nogil:
-                retval = c_wt.double_swt_a(&data[0], data_size, wavelet.w,
-                                 &cA[0], output_len, i)
-            if retval < 0:
-                raise RuntimeError("C swt failed.")
+                retval = c_wt.double_iswt_multilevel(&cA[0],
+                                                     <const double **> coefs_ptrs,
+                                                     data_size, wavelet.w,
+                                                     <double *> output.data,
+                                                     level)
         elif data_t is np.float32_t:
-            cA = np.zeros(output_len, dtype=np.float32)
             with nogil:
-                retval = c_wt.float_swt_a(&data[0], data_size, wavelet.w,
-                                &cA[0], output_len, i)
-            if retval < 0:
-                raise RuntimeError("C swt failed.")
+                retval = c_wt.float_iswt_multilevel(&cA[0],
+                                                    <const float **> coefs_ptrs,
+                                                    data_size, wavelet.w,
+                                                    <float *> output.data,
+                                                    level)
+    finally:
+        free(coefs_ptrs)
+
+    if retval:
+        raise RuntimeError("C iswt failed.")
+    return output
+
+
+cdef common.ArrayInfo _array_info(np.ndarray a):
+    cdef common.ArrayInfo info
+    info.ndim = a.ndim
+    info.strides = <pywt_index_t *> a.strides
+    info.shape = <size_t *> a.shape
+    return info
+
+
+cpdef swt_axis(np.ndarray data, Wavelet wavelet, unsigned int level,
+               unsigned int axis=0, unsigned int workers=1, out=None):
+    """
+    Single level SWT along an axis of a float32, float64, complex64 or
+    complex128 array, at `level` (counted from 1). Returns (cA, cD) of the
+    shape of data, in the arrays of `out` (a pair of arrays, or None, of any
+    strides) if not None.
+    """
+    cdef common.ArrayInfo data_info, a_info, d_info
+    cdef np.ndarray cA, cD
+    cdef np.dtype dtype = _check_dtype(data)
+    cdef int retval = -1
+
+    if axis >= data.ndim:
+        raise ValueError("Axis greater than data dimensions")
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    if level > common.swt_max_level(data.shape[axis]):
+        raise ValueError("Level value too high (max level for current data "
+                         "size is %d)." %
+                         common.swt_max_level(data.shape[axis]))
+    data = data.astype(dtype, copy=False)
+    out_a, out_d = out if out is not None else (None, None)
+    cA = _check_out(out_a, (<object> data).shape, dtype, False, (data, ))
+    cD = _check_out(out_d, (<object> data).shape, dtype, False, (data, cA))
+    data_info = _array_info(data)
+    a_info = _array_info(cA)
+    d_info = _array_info(cD)
+
+    if dtype == np.float64:
+        with nogil:
+            retval = c_wt.double_swt_axis(<double *> data.data, data_info,
+                                          <double *> cA.data, a_info,
+                                          <double *> cD.data, d_info,
+                                          wavelet.w, axis, level, workers)
+    elif dtype == np.float32:
+        with nogil:
+            retval = c_wt.float_swt_axis(<float *> data.data, data_info,
+                                         <float *> cA.data, a_info,
+                                         <float *> cD.data, d_info,
+                                         wavelet.w, axis, level, workers)
+    elif dtype == np.complex128:
+        with nogil:
+            retval = c_wt.double_complex_swt_axis(<double *> data.data,
+                                                  data_info,
+                                                  <double *> cA.data, a_info,
+                                                  <double *> cD.data, d_info,
+                                                  wavelet.w, axis, level, workers)
+    elif dtype == np.complex64:
+        with nogil:
+            retval = c_wt.float_complex_swt_axis(<float *> data.data,
+                                                 data_info,
+                                                 <float *> cA.data, a_info,
+                                                 <float *> cD.data, d_info,
+                                                 wavelet.w, axis, level, workers)
+    if retval:
+        raise RuntimeError("C swt failed.")
+    return (cA, cD)
+
+
+cpdef iswt_axis(np.ndarray cA, np.ndarray cD, Wavelet wavelet,
+                unsigned int level, unsigned int axis=0, unsigned int workers=1,
+                out=None):
+    """
+    Single level inverse SWT along an axis, reconstructing the approximation
+    at level - 1 from the approximation and details at `level`, of the same
+    shape and (float32, float64, complex64 or complex128) dtype. The result
+    is written to `out` (of any strides) if not None.
+    """
+    cdef common.ArrayInfo a_info, d_info, output_info
+    cdef np.ndarray output
+    cdef np.dtype dtype = _check_dtype(cA)
+    cdef int retval = -1
+
+    if (<object> cA).shape != (<object> cD).shape:
+        raise ValueError("Approximation and detail coefficients must have "
+                         "the same shape.")
+    if axis >= cA.ndim:
+        raise ValueError("Axis greater than coefficient dimensions")
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    if level > common.swt_max_level(cA.shape[axis]):
+        raise ValueError("Level value too high (max level for current data "
+                         "size is %d)." % common.swt_max_level(cA.shape[axis]))
+    cA = cA.astype(dtype, copy=False)
+    cD = cD.astype(dtype, copy=False)
+    output = _check_out(out, (<object> cA).shape, dtype, False, (cA, cD))
+    a_info = _array_info(cA)
+    d_info = _array_info(cD)
+    output_info = _array_info(output)
+
+    if dtype == np.float64:
+        with nogil:
+            retval = c_wt.double_iswt_axis(<double *> cA.data, a_info,
+                                           <double *> cD.data, d_info,
+                                           <double *> output.data,
+                                           output_info,
+                                           wavelet.w, axis, level, workers)
+    elif dtype == np.float32:
+        with nogil:
+            retval = c_wt.float_iswt_axis(<float *> cA.data, a_info,
+                                          <float *> cD.data, d_info,
+                                          <float *> output.data,
+                                          output_info,
+                                          wavelet.w, axis, level, workers)
+    elif dtype == np.complex128:
+        with nogil:
+            retval = c_wt.double_complex_iswt_axis(<double *> cA.data,
+                                                   a_info,
+                                                   <double *> cD.data,
+                                                   d_info,
+                                                   <double *> output.data,
+                                                   output_info,
+                                                   wavelet.w, axis, level,
+                                                   workers)
+    elif dtype == np.complex64:
+        with nogil:
+            retval = c_wt.float_complex_iswt_axis(<float *> cA.data,
+                                                  a_info,
+                                                  <float *> cD.data,
+                                                  d_info,
+                                                  <float *> output.data,
+                                                  output_info,
+                                                  wavelet.w, axis, level,
+                                                  workers)
+    if retval:
+        raise RuntimeError("C iswt failed.")
+    return output
+
+
+def modwt_max_level(size_t input_len):
+    """
+    modwt_max_level(input_len)
+
+    Calculates the maximum level of the Maximal Overlap Discrete Wavelet
+    Transform for data of given length: the largest level such that
+    ``2**level <= input_len``.
+
+    Parameters
+    ----------
+    input_len : int
+        Input data length.
+
+    Returns
+    -------
+    max_level : int
+        Maximum level of MODWT for data of given length.
+
+    """
+    return common.modwt_max_level(input_len)
+
 
-        data = cA
-        ret.append((cA, cD))
+def modwt(np.ndarray data, Wavelet wavelet, unsigned int level,
+          unsigned int axis=0, unsigned int workers=1, out=None):
+    """
+    Multilevel MODWT along an axis of a float32, float64, complex64 or
+    complex128 array, all levels in a single call. Returns a list of (cA, cD)
+    pairs of the shape of data, coarsest level first, which are views of a
+    single (level, 2) + data.shape block, or the arrays of `out` (a list of
+    pairs in the order of the result, of any strides) if not None.
+    """
+    cdef size_t k
+    cdef void **coefs_ptrs = NULL
+    cdef common.ArrayInfo *coefs_infos = NULL
+    cdef common.ArrayInfo data_info
+    cdef np.ndarray block, c
+    cdef np.dtype dtype = _check_dtype(data)
+    cdef int retval = -1
+
+    if axis >= data.ndim:
+        raise ValueError("Axis greater than data dimensions")
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    if level > common.modwt_max_level(data.shape[axis]):
+        raise ValueError("Level value too high (max level for current data "
+                         "size is %d)." %
+                         common.modwt_max_level(data.shape[axis]))
+    if out is not None and len(out) != level:
+        raise ValueError("out must have {} pairs of arrays.".format(level))
+    data = data.astype(dtype, copy=False)
+    shape = (<object> data).shape
+
+    if out is None:
+        block = np.empty((level, 2) + shape, dtype)
+        ret = [(block[k, 0], block[k, 1]) for k in range(level)]
+    else:
+        ret = [tuple(_check_out(o, shape, dtype) for o in pair)
+               for pair in out]
+        _check_out_overlap(ret, data)
+    data_info = _array_info(data)
+
+    try:
+        coefs_ptrs = <void **> malloc(2 * level * sizeof(void *))
+        coefs_infos = <common.ArrayInfo *> malloc(2 * level *
+                                                  sizeof(common.ArrayInfo))
+        if coefs_ptrs == NULL or coefs_infos == NULL:
+            raise MemoryError()
+        for k in range(level):
+            for i in range(2):
+                c = ret[k][i]
+                coefs_ptrs[i * level + k] = c.data
+                coefs_infos[i * level + k] = _array_info(c)
+
+        if dtype == np.float64:
+            with nogil:
+                retval = c_wt.double_modwt_axis(<double *> data.data, data_info,
+                                                <double **> coefs_ptrs,
+                                                <double **> coefs_ptrs + level,
+                                                coefs_infos, wavelet.w, axis,
+                                                level, workers)
+        elif dtype == np.float32:
+            with nogil:
+                retval = c_wt.float_modwt_axis(<float *> data.data, data_info,
+                                               <float **> coefs_ptrs,
+                                               <float **> coefs_ptrs + level,
+                                               coefs_infos, wavelet.w, axis,
+                                               level, workers)
+        elif dtype == np.complex128:
+            with nogil:
+                retval = c_wt.double_complex_modwt_axis(
+                    <double *> data.data, data_info, <double **> coefs_ptrs,
+                    <double **> coefs_ptrs + level, coefs_infos, wavelet.w,
+                    axis, level, workers)
+        elif dtype == np.complex64:
+            with nogil:
+                retval = c_wt.float_complex_modwt_axis(
+                    <float *> data.data, data_info, <float **> coefs_ptrs,
+                    <float **> coefs_ptrs + level, coefs_infos, wavelet.w,
+                    axis, level, workers)
+    finally:
+        free(coefs_ptrs)
+        free(coefs_infos)
 
-    ret.reverse()
+    if retval:
+        raise RuntimeError("C modwt failed.")
     return ret
+
+
+def imodwt(np.ndarray cA, list details, Wavelet wavelet, unsigned int axis=0,
+           unsigned int workers=1, out=None):
+    """
+    Multilevel inverse MODWT along an axis, all levels in a single call, of
+    the approximation at the top level and the details [cD_n, ..., cD_1] as
+    returned by `modwt`, all of the same shape. The result is written to
+    `out` (of any strides) if not None.
+    """
+    cdef size_t level = len(details), k
+    cdef void **coefs_ptrs = NULL
+    cdef common.ArrayInfo *d_infos = NULL
+    cdef common.ArrayInfo a_info, output_info
+    cdef np.ndarray cD, output
+    cdef np.dtype dtype = _check_dtype(cA)
+    cdef int retval = -1
+
+    if axis >= cA.ndim:
+        raise ValueError("Axis greater than coefficient dimensions")
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    if level > common.modwt_max_level(cA.shape[axis]):
+        raise ValueError("Level value too high (max level for current data "
+                         "size is %d)." % common.modwt_max_level(cA.shape[axis]))
+    shape = (<object> cA).shape
+    for cD in details:
+        if (<object> cD).shape != shape:
+            raise ValueError("Approximation and detail coefficients must "
+                             "have the same shape.")
+    cA = cA.astype(dtype, copy=False)
+    details = [cD.astype(dtype, copy=False) for cD in details]
+    output = _check_out(out, shape, dtype, False, [cA] + details)
+    a_info = _array_info(cA)
+    output_info = _array_info(output)
+
+    try:
+        coefs_ptrs = <void **> malloc(level * sizeof(void *))
+        d_infos = <common.ArrayInfo *> malloc(level * sizeof(common.ArrayInfo))
+        if coefs_ptrs == NULL or d_infos == NULL:
+            raise MemoryError()
+        for k in range(level):
+            cD = details[k]
+            coefs_ptrs[k] = cD.data
+            d_infos[k] = _array_info(cD)
+
+        if dtype == np.float64:
+            with nogil:
+                retval = c_wt.double_imodwt_axis(<double *> cA.data, a_info,
+                                                 <const double **> coefs_ptrs,
+                                                 d_infos,
+                                                 <double *> output.data,
+                                                 output_info, wavelet.w, axis,
+                                                 level, workers)
+        elif dtype == np.float32:
+            with nogil:
+                retval = c_wt.float_imodwt_axis(<float *> cA.data, a_info,
+                                                <const float **> coefs_ptrs,
+                                                d_infos,
+                                                <float *> output.data,
+                                                output_info, wavelet.w, axis,
+                                                level, workers)
+        elif dtype == np.complex128:
+            with nogil:
+                retval = c_wt.double_complex_imodwt_axis(
+                    <double *> cA.data, a_info, <const double **> coefs_ptrs,
+                    d_infos, <double *> output.data, output_info, wavelet.w,
+                    axis, level, workers)
+        elif dtype == np.complex64:
+            with nogil:
+                retval = c_wt.float_complex_imodwt_axis(
+                    <float *> cA.data, a_info, <const float **> coefs_ptrs,
+                    d_infos, <float *> output.data, output_info, wavelet.w,
+                    axis, level, workers)
+    finally:
+        free(coefs_ptrs)
+        free(d_infos)
+
+    if retval:
+        raise RuntimeError("C imodwt failed.")
+    return output
+
+
+def _set_convolution_options(int simd_code, int boundary_code,
+                             size_t fft_threshold):
+    # see _pywt._sync_convolution_options
+    simd.simd_set(<simd.SIMD>simd_code)
+    convolution.boundary_set(<convolution.BOUNDARY>boundary_code)
+    convolution.fft_threshold_set(fft_threshold)
+
+
+_set_convolution_options(*_convolution_options())
@@ -3,6 +3,10 @@
 
 #include "common.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifdef PY_EXTENSION
 void *wtcalloc(size_t len, size_t size){
         void *p = wtmalloc(len*size);
@@ -12,6 +16,23 @@ void *wtcalloc(size_t len, size_t size){
 }
 #endif
 
+/* The pointer returned by wtmalloc is stored just before the aligned block */
+void *wtmalloc_aligned(size_t size){
+    char *base, *p;
+    base = wtmalloc(size + PYWT_ALIGNMENT + sizeof(void *));
+    if(base == NULL)
+        return NULL;
+    p = base + sizeof(void *);
+    p += (PYWT_ALIGNMENT - (size_t) p % PYWT_ALIGNMENT) % PYWT_ALIGNMENT;
+    ((void **) p)[-1] = base;
+    return p;
+}
+
+void wtfree_aligned(void *ptr){
+    if(ptr != NULL)
+        wtfree(((void **) ptr)[-1]);
+}
+
 /* Returns the floor of the base-2 log of it's input
  *
  * Undefined for x = 0
@@ -67,6 +88,130 @@ size_t swt_buffer_length(size_t input_len){
     return input_len;
 }
 
+size_t extended_indices(pywt_index_t idx, const size_t N, const MODE mode,
+                        pywt_index_t indices[2], pywt_index_t coefs[2]){
+    const pywt_index_t n = (pywt_index_t) N;
+    pywt_index_t period, t;
+
+    coefs[0] = 1;
+    if (idx >= 0 && idx < n){
+        indices[0] = idx;
+        return 1;
+    }
+
+    switch(mode){
+    case MODE_SYMMETRIC:
+        period = 2*n;
+        idx %= period;
+        if (idx < 0)
+            idx += period;
+        indices[0] = idx < n ? idx : period-1-idx;
+        return 1;
+    case MODE_REFLECT:
+        if (n == 1){
+            indices[0] = 0;
+            return 1;
+        }
+        period = 2*n - 2;
+        idx %= period;
+        if (idx < 0)
+            idx += period;
+        indices[0] = idx < n ? idx : period-idx;
+        return 1;
+    case MODE_CONSTANT_EDGE:
+        indices[0] = idx < 0 ? 0 : n-1;
+        return 1;
+    case MODE_SMOOTH:
+        if (n < 2){
+            indices[0] = idx < 0 ? 0 : n-1;
+            return 1;
+        }
+        // x[0] + t * (x[0] - x[1]) on the left, likewise on the right
+        t = idx < 0 ? -idx : idx - n + 1;
+        indices[0] = idx < 0 ? 0 : n-1;
+        indices[1] = idx < 0 ? 1 : n-2;
+        coefs[0] = 1 + t;
+        coefs[1] = -t;
+        return 2;
+    case MODE_PERIODIC:
+        idx %= n;
+        indices[0] = idx < 0 ? idx + n : idx;
+        return 1;
+    case MODE_PERIODIZATION:
+        period = n + n % 2;
+        idx %= period;
+        if (idx < 0)
+            idx += period;
+        indices[0] = idx < n ? idx : n-1;
+        return 1;
+    case MODE_ZEROPAD:
+    default:
+        return 0;
+    }
+}
+
+FilterSymmetry filter_symmetry(const double * filter, size_t F, size_t stride){
+    FilterSymmetry symmetry = {0, 0, 1};
+    size_t k;
+
+    while (F > 0 && filter[(F - 1) * stride] == 0)
+        --F;
+    while (symmetry.first < F && filter[symmetry.first * stride] == 0)
+        ++symmetry.first;
+    symmetry.len = F - symmetry.first;
+    filter += symmetry.first * stride;
+
+    for (k = 0; k < symmetry.len / 2 && symmetry.sign != 0; ++k){
+        const double a = filter[k * stride], b = filter[(symmetry.len - 1 - k) * stride];
+        if (symmetry.sign > 0 && a != b)
+            symmetry.sign = (k == 0 && a == -b) ? -1 : 0;
+        else if (symmetry.sign < 0 && a != -b)
+            symmetry.sign = 0;
+    }
+    /* the middle tap of an antisymmetric filter is zero */
+    if (symmetry.sign < 0 && symmetry.len % 2 && filter[symmetry.len / 2 * stride] != 0)
+        symmetry.sign = 0;
+    return symmetry;
+}
+
+size_t input_itemsize(INPUT_TYPE input_type, size_t native_size){
+    switch(input_type){
+        case INPUT_UINT8:
+            return sizeof(unsigned char);
+        case INPUT_INT16:
+            return sizeof(short);
+        case INPUT_UINT16:
+        case INPUT_FLOAT16:
+            return sizeof(unsigned short);
+        case INPUT_INT32:
+            return sizeof(int);
+        default:
+            return native_size;
+    }
+}
+
+float half_to_float(unsigned short h){
+    const unsigned int sign = (unsigned int) (h & 0x8000u) << 16;
+    const unsigned int exponent = (h >> 10) & 0x1fu, mantissa = h & 0x3ffu;
+    union {
+        unsigned int u;
+        float f;
+    } value;
+
+    if (exponent == 0x1f){
+        /* infinities and NaNs, keeping the payload */
+        value.u = sign | 0x7f800000u | (mantissa << 13);
+    } else if (exponent == 0){
+        /* zeros and subnormals, mantissa * 2**-24 */
+        value.f = (float) mantissa * 5.9604644775390625e-8f;
+        value.u |= sign;
+    } else {
+        /* rebias the exponent from 15 to 127 */
+        value.u = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    return value.f;
+}
+
 unsigned char dwt_max_level(size_t input_len, size_t filter_len){
     if(filter_len <= 1 || input_len < (filter_len-1))
         return 0;
@@ -85,3 +230,56 @@ unsigned char swt_max_level(size_t input_len){
     }
     return j;
 }
+
+unsigned char modwt_max_level(size_t input_len){
+    /* the largest level with 2**level <= input_len */
+    if (input_len == 0)
+        return 0;
+    return size_log2(input_len);
+}
+
+/* parallel loops */
+
+void parallel_range(size_t n, size_t * first, size_t * last){
+#ifdef _OPENMP
+    size_t thread = (size_t) omp_get_thread_num();
+    size_t n_threads = (size_t) omp_get_num_threads();
+    *first = n / n_threads * thread + (thread < n % n_threads ? thread : n % n_threads);
+    *last = *first + n / n_threads + (thread < n % n_threads ? 1 : 0);
+#else
+    *first = 0;
+    *last = n;
+#endif
+}
+
+size_t parallel_thread(void){
+#ifdef _OPENMP
+    return (size_t) omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+int parallel_threads(unsigned int max_threads, size_t n){
+    if (max_threads < 1 || n < 1)
+        return 1;
+    if (n < max_threads)
+        return (int) n;
+    return (int) max_threads;
+}
+
+
+pywt_index_t line_offset(size_t i, const size_t * const shape,
+                         const pywt_index_t * const strides, const size_t ndim,
+                         const size_t axis, const size_t inner){
+    pywt_index_t offset = 0;
+    size_t j;
+
+    for (j = ndim; j-- > 0; ){
+        if (j != axis && j != inner){
+            offset += (pywt_index_t) (i % shape[j]) * strides[j];
+            i /= shape[j];
+        }
+    }
+    return offset;
+}
@@ -42,6 +42,22 @@
     #include <intrin.h>
 #endif
 
+/* Functions always inlined, so that constant arguments (a filter length, an
+ * extension mode) produce code specialized for them */
+#if defined _MSC_VER
+    #define PYWT_INLINE static __forceinline
+#elif defined __GNUC__
+    #define PYWT_INLINE static inline __attribute__((always_inline))
+#else
+    #define PYWT_INLINE static inline
+#endif
+
+/* Allocation aligned to PYWT_ALIGNMENT bytes (a cache line, and the widest
+ * vector register), to be released with wtfree_aligned */
+#define PYWT_ALIGNMENT 64
+void *wtmalloc_aligned(size_t size);
+void wtfree_aligned(void *ptr);
+
 typedef struct {
     size_t * shape;
     pywt_index_t * strides;
@@ -74,6 +90,40 @@ typedef enum {
        MODE_MAX,
 } MODE;
 
+/* Methods of computing single level transforms */
+typedef enum {
+       METHOD_INVALID = -1,
+       METHOD_CONVOLUTION = 0, /* default, convolution with the filters */
+       METHOD_LIFTING,         /* lifting factorization of the filters, see
+                                * lifting.h. Only available if the wavelet
+                                * has a lifting scheme. */
+       METHOD_MAX,
+} METHOD;
+
+/* Element types of the input arrays the decompositions read directly,
+ * converting each element to the floating point type they compute in */
+typedef enum {
+       INPUT_NATIVE = 0,  /* that floating point type itself */
+       INPUT_UINT8,       /* unsigned char */
+       INPUT_INT16,       /* short */
+       INPUT_UINT16,      /* unsigned short */
+       INPUT_INT32,       /* int */
+       INPUT_FLOAT16,     /* IEEE 754 half precision, in an unsigned short */
+       INPUT_MAX,
+} INPUT_TYPE;
+
+/* The nonzero taps filter[first], ..., filter[first+len-1] of a filter (taps
+ * being stride elements apart) and their symmetry:
+ *   filter[first+k] == sign * filter[first+len-1-k]
+ * with sign = 1 (symmetric), -1 (antisymmetric) or 0 (neither). Convolutions
+ * skip the zero taps, and with symmetric filters add (subtract) the two inputs
+ * sharing a tap before multiplying. */
+typedef struct {
+    size_t first;
+    size_t len;
+    int sign;
+} FilterSymmetry;
+
 
 /* ##### Calculating buffer lengths for various operations ##### */
 
@@ -99,8 +149,52 @@ size_t idwt_buffer_length(size_t coeffs_len, size_t filter_len, MODE mode);
 /* Length of SWT coefficients for specified input signal length (== input_len) */
 size_t swt_buffer_length(size_t input_len);
 
+/*
+ * The value at index idx of the signal of length N extended with mode, as the
+ * combination sum(coefs[i] * x[indices[i]]) of at most two samples. Returns
+ * the number of terms.
+ */
+size_t extended_indices(pywt_index_t idx, const size_t N, const MODE mode,
+                        pywt_index_t indices[2], pywt_index_t coefs[2]);
+
+/* Symmetry of the F taps filter[0], filter[stride], ... */
+FilterSymmetry filter_symmetry(const double * filter, size_t F, size_t stride);
+
+/* Size in bytes of the elements of input_type, native_size for INPUT_NATIVE */
+size_t input_itemsize(INPUT_TYPE input_type, size_t native_size);
+
+/* The value of the half precision number with bits h */
+float half_to_float(unsigned short h);
+
 /* Maximum useful level of DWT decomposition. */
 unsigned char dwt_max_level(size_t input_len, size_t filter_len);
 
 /* Maximum useful level of SWT decomposition. */
 unsigned char swt_max_level(size_t input_len);
+
+/* Maximum level of MODWT decomposition. */
+unsigned char modwt_max_level(size_t input_len);
+
+
+/* ##### Parallel loops ##### */
+
+/*
+ * Share [*first, *last) of the items [0, n) to process by the calling thread:
+ * contiguous ranges of (nearly) equal size for the threads of the enclosing
+ * OpenMP parallel region, all items outside of one or without OpenMP.
+ */
+void parallel_range(size_t n, size_t * first, size_t * last);
+
+/* Index of the calling thread in the enclosing OpenMP parallel region, 0
+ * outside of one or without OpenMP */
+size_t parallel_thread(void);
+
+/* Number of threads to use for n items with at most max_threads threads */
+int parallel_threads(unsigned int max_threads, size_t n);
+
+/* Byte offset of the line with outer index i in an array of shape and
+ * strides (in bytes), enumerating all axes but axis and inner in C order.
+ * inner may be ndim, for none. */
+pywt_index_t line_offset(size_t i, const size_t * const shape,
+                         const pywt_index_t * const strides, const size_t ndim,
+                         const size_t axis, const size_t inner);
@@ -1,4 +1,49 @@
 #include "convolution.h"
+#include "simd.h"
+
+static BOUNDARY boundary_selected = BOUNDARY_INLINE;
+static size_t fft_threshold_selected = 0;
+
+/* Filter lengths from which the FFT backend is faster than the direct loops
+ * for each SIMD variant, between the crossovers measured for double and
+ * single precision (dwt of 65536 samples) */
+static const size_t fft_threshold_default[SIMD_MAX] = {
+    64,   /* SIMD_NONE */
+    160,  /* SIMD_SSE2 */
+    320,  /* SIMD_AVX2 */
+    384,  /* SIMD_AVX512 */
+};
+
+BOUNDARY boundary_get(void)
+{
+    return boundary_selected;
+}
+
+int boundary_set(BOUNDARY boundary)
+{
+    if (boundary <= BOUNDARY_INVALID || boundary >= BOUNDARY_MAX)
+        return -1;
+    boundary_selected = boundary;
+    return 0;
+}
+
+int fft_threshold_set(size_t taps)
+{
+    fft_threshold_selected = taps;
+    return 0;
+}
+
+size_t fft_threshold_get(void)
+{
+    return fft_threshold_selected;
+}
+
+size_t fft_threshold(void)
+{
+    if (fft_threshold_selected != 0)
+        return fft_threshold_selected;
+    return fft_threshold_default[simd_get()];
+}
 
 #ifdef TYPE
 #error TYPE should not be defined here.
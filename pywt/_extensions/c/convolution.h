@@ -2,6 +2,49 @@
 
 #include "common.h"
 
+/* How the decimating convolutions handle the outputs for which the filter
+ * extends past the signal */
+typedef enum {
+    BOUNDARY_INVALID = -1,
+    BOUNDARY_INLINE = 0,  /* extended values computed for each filter tap */
+    BOUNDARY_PADDED,      /* signal extended into a buffer, then convolved
+                             like the center */
+    BOUNDARY_MAX,
+} BOUNDARY;
+
+/* Strategy currently used by the convolution routines */
+BOUNDARY boundary_get(void);
+
+/* Select the strategy used by the convolution routines. Returns 0 on
+ * success, -1 for an invalid value. */
+int boundary_set(BOUNDARY boundary);
+
+/* Longest extended signal the padded strategy buffers, in elements. Longer
+ * boundary regions (filters of more than ~250 taps) are handled inline. */
+#define BOUNDARY_BUFFER_LEN 512
+
+/* Outputs per block when the two filters of _downsampling_convolution_dual
+ * are applied one after the other (symmetric filters), and of the even and
+ * odd sums of the symmetric reconstruction, so that the input of a block is
+ * still in cache for the second filter */
+#define DUAL_BLOCK_LEN 1024
+
+/* Filter length from which the decimating convolutions use the FFT
+ * (overlap-save) backend instead of the direct loops. 0 selects the
+ * crossover measured for the current SIMD variant (see convolution.c).
+ * Returns 0 on success. */
+int fft_threshold_set(size_t taps);
+
+/* The value given to fft_threshold_set */
+size_t fft_threshold_get(void);
+
+/* Filter length from which the FFT backend is currently used */
+size_t fft_threshold(void);
+
+/* The FFT backend transforms blocks of about FFT_BLOCK_FACTOR times the
+ * filter length (a power of two, less for short signals) */
+#define FFT_BLOCK_FACTOR 4
+
 #ifdef TYPE
 #error TYPE should not be defined here.
 #else
@@ -8,6 +8,8 @@
 #else
 
 #include "convolution.h"
+#include "fft.h"
+#include "simd.h"
 
 #if defined _MSC_VER
 #define restrict __restrict
@@ -30,11 +32,258 @@
  * MODE_PERIODIZATION produces different output lengths to other modes, so is
  * implemented as a separate function for each case.
  *
+ * With the BOUNDARY_PADDED strategy (see convolution.h), the decimating
+ * convolutions instead extend the few samples needed by steps 1, 3 and 4
+ * into a small buffer once, and compute these outputs like those of step 2.
+ * Results are the same up to rounding (the taps are summed in a different
+ * order).
+ *
+ * Given the symmetry of a filter (see FilterSymmetry), step 2 sums only its
+ * nonzero taps and, for symmetric and antisymmetric filters, adds (subtracts)
+ * the two inputs sharing a tap before multiplying, again changing rounding.
+ *
+ * Two tap filters (Haar) skip all of the above: output o is centered on
+ * input index 2*o + 1 in all modes, and only the last output for odd-length
+ * input reads the extension.
+ *
+ * Filters of at least fft_threshold() taps (see convolution.h) are instead
+ * applied in the frequency domain, to blocks of the extended signal
+ * (overlap-save), in double precision. Results then differ from the direct
+ * loops by a few multiples of the rounding error of the largest products.
+ *
  * See 'common.h' for descriptions of the extension modes.
  */
 
+/* sum(filter[k*stride] * x[-k] for k = [0..L)), x pointing into the input,
+ * for a filter symmetric (sign = 1), antisymmetric (sign = -1) or neither
+ * (sign = 0). Pairs of terms are folded in the order of the folded kernels
+ * of simd.h. */
+PYWT_INLINE TYPE CAT(TYPE, _folded_sum)(const TYPE * const restrict x,
+                                        const TYPE * const restrict filter,
+                                        const size_t stride, const size_t L,
+                                        const int sign)
+{
+    TYPE sum = 0;
+    size_t k;
+
+    if (sign == 0) {
+        for (k = 0; k < L; ++k)
+            sum += filter[k*stride] * *(x - k);
+        return sum;
+    }
+    for (k = 0; k < L/2; ++k) {
+        const TYPE v = (sign > 0) ? *(x - k) + *(x - (L-1-k)) : *(x - k) - *(x - (L-1-k));
+        sum += filter[k*stride] * v;
+    }
+    if (L % 2)
+        sum += filter[L/2*stride] * *(x - L/2);
+    return sum;
+}
+
+
+/* The n outputs output[o] = sum(filter[j] * input[i + 2*o - j] for j = [0..F))
+ * of step 2 where the filter lies within the input, as computed by the
+ * kernels of simd.h. Only the taps described by symmetry (if not NULL) are
+ * summed, folded for symmetric filters without vector instructions (with
+ * which results then match the dual kernels exactly). */
+static void CAT(TYPE, _downsampling_center)(const TYPE * const restrict input, const size_t N,
+                                            const TYPE * const restrict filter, const size_t F,
+                                            const FilterSymmetry * const symmetry,
+                                            TYPE * const restrict output, size_t i,
+                                            const size_t n)
+{
+    size_t o = 0;
+
+    if (symmetry == NULL) {
+        CAT(TYPE, _downsampling_kernel) kernel = CAT(TYPE, _simd_downsampling_kernel)(F);
+        if (kernel != NULL)
+            o = kernel(input, N, filter, F, output, i, n);
+        for (; o < n; ++o) {
+            TYPE sum = 0;
+            size_t j;
+            for (j = 0; j < F; ++j)
+                sum += input[i+2*o-j] * filter[j];
+            output[o] = sum;
+        }
+    } else {
+        const TYPE * const f = filter + symmetry->first;
+        const size_t L = symmetry->len;
+        // unfolded with vector instructions, see convolution_simd.c
+        const int sign = (simd_get() == SIMD_NONE) ? symmetry->sign : 0;
+
+        // input[i + 2*o - first] is multiplied by f[0]
+        i -= symmetry->first;
+        if (sign != 0) {
+            CAT(TYPE, _downsampling_kernel_folded) kernel = CAT(TYPE, _downsampling_kernel_folded_fixed)(L, sign);
+            if (kernel != NULL)
+                o = kernel(input, N, f, L, sign, output, i, n);
+        } else if (L > 0) {
+            CAT(TYPE, _downsampling_kernel) kernel = CAT(TYPE, _simd_downsampling_kernel)(L);
+            if (kernel != NULL)
+                o = kernel(input, N, f, L, output, i, n);
+        }
+        for (; o < n; ++o)
+            output[o] = CAT(TYPE, _folded_sum)(input + i + 2*o, f, 1, L, sign);
+    }
+}
+
+/* Decimating convolution with the two tap filters filter_a and filter_d (or
+ * filter_a only, output_d and filter_d being NULL), such as those of the
+ * Haar wavelet. Terms are summed as by the rows kernels. */
+static int CAT(TYPE, _haar_downsampling)(const TYPE * const restrict input, const size_t N,
+                                         const TYPE * const restrict filter_a,
+                                         const TYPE * const restrict filter_d,
+                                         TYPE * const restrict output_a,
+                                         TYPE * const restrict output_d, const MODE mode)
+{
+    const size_t n = N / 2;
+    CAT(TYPE, _haar_dec_kernel) kernel = CAT(TYPE, _simd_haar_dec_kernel)();
+    size_t o = 0;
+
+    if (kernel != NULL)
+        o = kernel(input, filter_a, filter_d, output_a, output_d, n);
+    for (; o < n; ++o) {
+        output_a[o] = filter_a[0] * input[2*o+1] + filter_a[1] * input[2*o];
+        if (output_d != NULL)
+            output_d[o] = filter_d[0] * input[2*o+1] + filter_d[1] * input[2*o];
+    }
+
+    // odd-length input: the last output reads input[N]
+    if (N % 2) {
+        const TYPE x = CAT(TYPE, _extended_value)(input, N, (pywt_index_t) N, mode);
+        output_a[n] = filter_a[0] * x + filter_a[1] * input[N-1];
+        if (output_d != NULL)
+            output_d[n] = filter_d[0] * x + filter_d[1] * input[N-1];
+    }
+    return 0;
+}
+
+/* Outputs [o_first, o_last) of a decimating convolution, where output o is
+ * centered on input index start + step*o, computed from the input extended
+ * into a buffer. filter_d and output_d are NULL for a single filter.
+ * Returns -1 (without writing any output) if the extended signal does not
+ * fit in the buffer.
+ */
+static int CAT(TYPE, _downsampling_convolution_padded)(const TYPE * const restrict input, const size_t N,
+                                                       const TYPE * const restrict filter_a,
+                                                       const TYPE * const restrict filter_d,
+                                                       const size_t F,
+                                                       TYPE * const restrict output_a,
+                                                       TYPE * const restrict output_d,
+                                                       const size_t start, const size_t step,
+                                                       const size_t o_first, const size_t o_last,
+                                                       const MODE mode)
+{
+    TYPE buffer[BOUNDARY_BUFFER_LEN];
+    size_t len, i, o = o_first;
+
+    if (o_last <= o_first)
+        return 0;
+    len = step * (o_last - 1 - o_first) + F;
+    if (len > BOUNDARY_BUFFER_LEN)
+        return -1;
+    CAT(TYPE, _extend)(input, N, 1,
+                       (pywt_index_t) (start + step*o_first) - (pywt_index_t) (F - 1),
+                       buffer, len, 1, mode);
+
+    // buffer[i] is the input at index start + step*o - (F - 1) + i
+    i = F - 1;
+    if (step == 2) {
+        size_t n = 0;
+        if (filter_d == NULL) {
+            CAT(TYPE, _downsampling_kernel) kernel = CAT(TYPE, _simd_downsampling_kernel)(F);
+            if (kernel != NULL)
+                n = kernel(buffer, len, filter_a, F, output_a + o, i, o_last - o);
+        } else {
+            CAT(TYPE, _downsampling_kernel_dual) kernel = CAT(TYPE, _simd_downsampling_kernel_dual)(F);
+            if (kernel != NULL)
+                n = kernel(buffer, len, filter_a, filter_d, F, output_a + o, output_d + o,
+                           i, o_last - o);
+        }
+        i += 2*n;
+        o += n;
+    }
+    for (; o < o_last; ++o, i += step) {
+        TYPE sum_a = 0, sum_d = 0;
+        size_t j;
+        if (filter_d == NULL) {
+            for (j = 0; j < F; ++j)
+                sum_a += filter_a[j] * buffer[i-j];
+        } else {
+            for (j = 0; j < F; ++j) {
+                const TYPE v = buffer[i-j];
+                sum_a += v * filter_a[j];
+                sum_d += v * filter_d[j];
+            }
+            output_d[o] = sum_d;
+        }
+        output_a[o] = sum_a;
+    }
+    return 0;
+}
+
+
+/* Number of outputs centered on input indices start + step*o < end */
+static size_t CAT(TYPE, _count_outputs)(const size_t start, const size_t step, const size_t end)
+{
+    return end > start ? (end - start + step - 1) / step : 0;
+}
+
+
+/* _downsampling_convolution with the BOUNDARY_PADDED strategy. Returns -1
+ * (without writing any output) if the boundary regions do not fit in the
+ * buffer. */
+static int CAT(TYPE, _downsampling_convolution_all_padded)(const TYPE * const restrict input, const size_t N,
+                                                           const TYPE * const restrict filter, const size_t F,
+                                                           const FilterSymmetry * const symmetry,
+                                                           TYPE * const restrict output,
+                                                           const size_t step, const MODE mode)
+{
+    const size_t start = (mode == MODE_PERIODIZATION) ? F/2 : step - 1;
+    const size_t end = (mode == MODE_PERIODIZATION) ? N + F/2 : N + F - 1;
+    const size_t O = CAT(TYPE, _count_outputs)(start, step, end);
+    // center outputs [o_lo, o_hi) have the filter within the input
+    size_t o_lo = CAT(TYPE, _count_outputs)(start, step, F - 1);
+    size_t o_hi = CAT(TYPE, _count_outputs)(start, step, N);
+    size_t i, o;
+
+    if (o_lo > O)
+        o_lo = O;
+    if (o_hi < o_lo)
+        o_hi = o_lo;
+    if (o_hi > O)
+        o_hi = O;
+    if ((o_lo > 0 && step * (o_lo - 1) + F > BOUNDARY_BUFFER_LEN) ||
+        (O > o_hi && step * (O - 1 - o_hi) + F > BOUNDARY_BUFFER_LEN))
+        return -1;
+
+    CAT(TYPE, _downsampling_convolution_padded)(input, N, filter, NULL, F, output, NULL,
+                                                start, step, 0, o_lo, mode);
+
+    o = o_lo;
+    i = start + step*o;
+    if (step == 2 && o < o_hi) {
+        CAT(TYPE, _downsampling_center)(input, N, filter, F, symmetry, output + o, i, o_hi - o);
+        i += 2*(o_hi - o);
+        o = o_hi;
+    }
+    for (; o < o_hi; ++o, i += step) {
+        TYPE sum = 0;
+        size_t j;
+        for (j = 0; j < F; ++j)
+            sum += input[i-j] * filter[j];
+        output[o] = sum;
+    }
+
+    CAT(TYPE, _downsampling_convolution_padded)(input, N, filter, NULL, F, output, NULL,
+                                                start, step, o_hi, O, mode);
+    return 0;
+}
+
+
 static int CAT(TYPE, _downsampling_convolution_periodization)(const TYPE * const restrict input, const size_t N,
                                                               const TYPE * const restrict filter, const size_t F,
+                                                              const FilterSymmetry * const symmetry,
                                                               TYPE * const restrict output, const size_t step)
 {
     size_t i = F/2, o = 0;
@@ -55,6 +304,12 @@ static int CAT(TYPE, _downsampling_convolution_periodization)(const TYPE * const
         output[o] = sum;
     }
 
+    if (step == 2 && i < N) {
+        const size_t n = (N - i + 1) / 2;
+        CAT(TYPE, _downsampling_center)(input, N, filter, F, symmetry, output + o, i, n);
+        i += 2*n;
+        o += n;
+    }
     for(; i < N; i+=step, ++o){
         TYPE sum = 0;
         size_t j;
@@ -104,8 +359,113 @@ static int CAT(TYPE, _downsampling_convolution_periodization)(const TYPE * const
 }
 
 
+/* _downsampling_convolution (filter_d and output_d NULL) or
+ * _downsampling_convolution_dual (step 2) with the FFT: the extended signal
+ * is cut into overlapping blocks of M samples, each giving the M - F + 1
+ * outputs of the full-rate convolution for which the filter lies within the
+ * block. Two consecutive blocks are transformed at once as the real and
+ * imaginary parts of a single complex signal, which the real filters do not
+ * mix. Returns -1 (without writing any output) if memory could not be
+ * allocated.
+ */
+static int CAT(TYPE, _downsampling_convolution_fft)(const TYPE * const restrict input, const size_t N,
+                                                    const TYPE * const restrict filter_a,
+                                                    const TYPE * const restrict filter_d,
+                                                    const size_t F,
+                                                    TYPE * const restrict output_a,
+                                                    TYPE * const restrict output_d,
+                                                    const size_t step, const MODE mode)
+{
+    const size_t start = (mode == MODE_PERIODIZATION) ? F/2 : step - 1;
+    const size_t end = (mode == MODE_PERIODIZATION) ? N + F/2 : N + F - 1;
+    const size_t O = CAT(TYPE, _count_outputs)(start, step, end);
+    const size_t n_filters = (filter_d == NULL) ? 1 : 2;
+    // extended signal, from input index start - (F - 1), the filter reaches
+    const size_t L = (O > 0) ? step * (O - 1) + F : 0;
+    const pywt_index_t first = (pywt_index_t) start - (pywt_index_t) (F - 1);
+    size_t M, n_block, o, f, j;
+    FFTPlan plan;
+    double *spectra = NULL, *work = NULL;
+    TYPE *block = NULL;
+    int retval = -1;
+
+    if (O == 0)
+        return 0;
+    M = fft_length(FFT_BLOCK_FACTOR * F);
+    if (M > fft_length(L))
+        M = fft_length(L);
+    // outputs of a block, at full-rate indices F - 1 + step*q
+    n_block = (M - F) / step + 1;
+
+    if (fft_plan_init(&plan, M) < 0)
+        return -1;
+    if ((spectra = malloc(n_filters * 2 * M * sizeof(double))) == NULL ||
+        (work = malloc(n_filters * 2 * M * sizeof(double))) == NULL ||
+        (block = malloc(M * sizeof(TYPE))) == NULL)
+        goto cleanup;
+
+    // filter spectra, scaled for the unnormalized inverse transform
+    for (f = 0; f < n_filters; ++f) {
+        const TYPE * const filter = (f == 0) ? filter_a : filter_d;
+        double * const spectrum = spectra + f * 2 * M;
+        for (j = 0; j < M; ++j) {
+            spectrum[2*j] = (j < F) ? (double) filter[j] / (double) M : 0;
+            spectrum[2*j+1] = 0;
+        }
+        fft_forward(&plan, spectrum);
+    }
+
+    for (o = 0; o < O; o += 2 * n_block) {
+        const size_t n_first = (O - o < n_block) ? O - o : n_block;
+        const size_t n_second = (O - o > n_block) ?
+            ((O - o - n_block < n_block) ? O - o - n_block : n_block) : 0;
+
+        CAT(TYPE, _extend)(input, N, 1, first + (pywt_index_t) (step * o), block, M, 1, mode);
+        for (j = 0; j < M; ++j)
+            work[2*j] = block[j];
+        if (n_second > 0) {
+            CAT(TYPE, _extend)(input, N, 1, first + (pywt_index_t) (step * (o + n_block)),
+                               block, M, 1, mode);
+            for (j = 0; j < M; ++j)
+                work[2*j+1] = block[j];
+        } else {
+            for (j = 0; j < M; ++j)
+                work[2*j+1] = 0;
+        }
+        fft_forward(&plan, work);
+
+        for (f = n_filters; f-- > 0; ) {
+            const double * const spectrum = spectra + f * 2 * M;
+            double * const product = work + f * 2 * M;
+            TYPE * const output = (f == 0) ? output_a : output_d;
+            // the product with the second filter is written after the signal
+            for (j = 0; j < M; ++j) {
+                const double xr = work[2*j], xi = work[2*j+1];
+                const double hr = spectrum[2*j], hi = spectrum[2*j+1];
+                product[2*j] = xr * hr - xi * hi;
+                product[2*j+1] = xr * hi + xi * hr;
+            }
+            fft_inverse(&plan, product);
+            for (j = 0; j < n_first; ++j)
+                output[o + j] = (TYPE) product[2*(F - 1 + step*j)];
+            for (j = 0; j < n_second; ++j)
+                output[o + n_block + j] = (TYPE) product[2*(F - 1 + step*j) + 1];
+        }
+    }
+    retval = 0;
+
+cleanup:
+    free(spectra);
+    free(work);
+    free(block);
+    fft_plan_free(&plan);
+    return retval;
+}
+
+
 int CAT(TYPE, _downsampling_convolution)(const TYPE * const restrict input, const size_t N,
                                          const TYPE * const restrict filter, const size_t F,
+                                         const FilterSymmetry * const symmetry,
                                          TYPE * const restrict output,
                                          const size_t step, MODE mode)
 {
@@ -116,10 +476,24 @@ int CAT(TYPE, _downsampling_convolution)(const TYPE * const restrict input, cons
 
     size_t i = step - 1, o = 0;
 
+    if (step == 2 && F == 2)
+        return CAT(TYPE, _haar_downsampling)(input, N, filter, NULL, output, NULL, mode);
+
+    if (F >= fft_threshold() &&
+        CAT(TYPE, _downsampling_convolution_fft)(input, N, filter, NULL, F, output, NULL,
+                                                 step, mode) == 0)
+        return 0;
+
+    if (boundary_get() == BOUNDARY_PADDED &&
+        CAT(TYPE, _downsampling_convolution_all_padded)(input, N, filter, F, symmetry,
+                                                        output, step, mode) == 0)
+        return 0;
+
     if(mode == MODE_PERIODIZATION)
-        return CAT(TYPE, _downsampling_convolution_periodization)(input, N, filter, F, output, step);
+        return CAT(TYPE, _downsampling_convolution_periodization)(input, N, filter, F, symmetry,
+                                                                  output, step);
 
-    if (mode == MODE_SMOOTH && N < 2)
+    if ((mode == MODE_SMOOTH || mode == MODE_REFLECT) && N < 2)
         mode = MODE_CONSTANT_EDGE;
 
     // left boundary overhang
@@ -173,6 +547,12 @@ int CAT(TYPE, _downsampling_convolution)(const TYPE * const restrict input, cons
     }
 
     // center (if input equal or wider than filter: N >= F)
+    if (step == 2 && i < N) {
+        const size_t n = (N - i + 1) / 2;
+        CAT(TYPE, _downsampling_center)(input, N, filter, F, symmetry, output + o, i, n);
+        i += 2*n;
+        o += n;
+    }
     for(; i < N; i+=step, ++o){
         TYPE sum = 0;
         size_t j;
@@ -331,8 +711,289 @@ int CAT(TYPE, _downsampling_convolution)(const TYPE * const restrict input, cons
     return 0;
 }
 
+/* Value of the input at index idx after (virtual) extension with mode.
+ * Inlined where mode is a constant, leaving only the code of that mode. */
+PYWT_INLINE TYPE CAT(TYPE, _extended_value_inline)(const TYPE * const restrict input,
+                                                   const size_t N,
+                                                   const pywt_index_t stride,
+                                                   pywt_index_t idx, const MODE mode)
+{
+    const pywt_index_t n = (pywt_index_t) N;
+    pywt_index_t period;
+
+#define X(k) input[(k) * stride]
+    if (idx >= 0 && idx < n)
+        return X(idx);
+
+    switch(mode) {
+    case MODE_SYMMETRIC:
+        period = 2*n;
+        idx %= period;
+        if (idx < 0)
+            idx += period;
+        return idx < n ? X(idx) : X(period-1-idx);
+    case MODE_REFLECT:
+        if (n == 1)
+            return X(0);
+        period = 2*n - 2;
+        idx %= period;
+        if (idx < 0)
+            idx += period;
+        return idx < n ? X(idx) : X(period-idx);
+    case MODE_CONSTANT_EDGE:
+        return idx < 0 ? X(0) : X(n-1);
+    case MODE_SMOOTH:
+        if (n < 2)
+            return idx < 0 ? X(0) : X(n-1);
+        if (idx < 0)
+            return X(0) + (size_t)(-idx) * (X(0) - X(1));
+        return X(n-1) + (size_t)(idx - n + 1) * (X(n-1) - X(n-2));
+    case MODE_PERIODIC:
+        idx %= n;
+        return X(idx < 0 ? idx + n : idx);
+    case MODE_PERIODIZATION:
+        /* odd-length input is padded with its last value */
+        period = n + n % 2;
+        idx %= period;
+        if (idx < 0)
+            idx += period;
+        return idx < n ? X(idx) : X(n-1);
+    case MODE_ZEROPAD:
+    default:
+        return 0;
+    }
+#undef X
+}
+
+
+/* Value of the input at index idx after (virtual) extension with mode. Only
+ * used for the few outputs where the filter overlaps the boundaries.
+ */
+TYPE CAT(TYPE, _extended_value)(const TYPE * const restrict input, const size_t N,
+                                pywt_index_t idx, const MODE mode)
+{
+    return CAT(TYPE, _extended_value_inline)(input, N, 1, idx, mode);
+}
+
+
+TYPE CAT(TYPE, _extended_value_strided)(const TYPE * const restrict input, const size_t N,
+                                        const pywt_index_t stride, pywt_index_t idx,
+                                        const MODE mode)
+{
+    return CAT(TYPE, _extended_value_inline)(input, N, stride, idx, mode);
+}
+
+
+PYWT_INLINE void CAT(TYPE, _extend_inline)(const TYPE * const restrict input, const size_t N,
+                                           const pywt_index_t input_stride,
+                                           const pywt_index_t first,
+                                           TYPE * const restrict output, const size_t len,
+                                           const pywt_index_t output_stride, const MODE mode)
+{
+    const pywt_index_t n = (pywt_index_t) N, end = first + (pywt_index_t) len;
+    pywt_index_t idx;
+
+    for (idx = first; idx < end && idx < 0; ++idx)
+        output[(idx - first) * output_stride] = CAT(TYPE, _extended_value_inline)(
+            input, N, input_stride, idx, mode);
+    if (input_stride == 1 && output_stride == 1) {
+        for (; idx < end && idx < n; ++idx)
+            output[idx - first] = input[idx];
+    } else {
+        for (; idx < end && idx < n; ++idx)
+            output[(idx - first) * output_stride] = input[idx * input_stride];
+    }
+    for (; idx < end; ++idx)
+        output[(idx - first) * output_stride] = CAT(TYPE, _extended_value_inline)(
+            input, N, input_stride, idx, mode);
+}
+
+
+void CAT(TYPE, _extend)(const TYPE * const restrict input, const size_t N,
+                        const pywt_index_t input_stride, const pywt_index_t first,
+                        TYPE * const restrict output, const size_t len,
+                        const pywt_index_t output_stride, const MODE mode)
+{
+    /* one copy of the loops per mode */
+#define EXTEND(m) CAT(TYPE, _extend_inline)(input, N, input_stride, first, output, len, \
+                                            output_stride, m)
+    switch (mode) {
+    case MODE_SYMMETRIC: EXTEND(MODE_SYMMETRIC); break;
+    case MODE_REFLECT: EXTEND(MODE_REFLECT); break;
+    case MODE_CONSTANT_EDGE: EXTEND(MODE_CONSTANT_EDGE); break;
+    case MODE_SMOOTH: EXTEND(MODE_SMOOTH); break;
+    case MODE_PERIODIC: EXTEND(MODE_PERIODIC); break;
+    case MODE_PERIODIZATION: EXTEND(MODE_PERIODIZATION); break;
+    default: EXTEND(MODE_ZEROPAD); break;
+    }
+#undef EXTEND
+}
+
+
+/* One output of _downsampling_convolution_dual near the boundaries */
+PYWT_INLINE void CAT(TYPE, _downsampling_convolution_dual_edge)(const TYPE * const restrict input, const size_t N,
+                                                               const TYPE * const restrict filter_a,
+                                                               const TYPE * const restrict filter_d,
+                                                               const size_t F,
+                                                               TYPE * const restrict output_a,
+                                                               TYPE * const restrict output_d,
+                                                               const size_t i, const MODE mode)
+{
+    TYPE sum_a = 0, sum_d = 0;
+    size_t j = 0;
+
+    /* Sum in the same order as _downsampling_convolution, so results are
+     * identical: for modes repeating the input, taps overlapping the right
+     * extension are processed from the boundary outwards first. */
+    if (i >= N && (mode == MODE_SYMMETRIC || mode == MODE_REFLECT ||
+                   mode == MODE_PERIODIC || mode == MODE_PERIODIZATION)) {
+        size_t m;
+        for (m = i - N + 1; m-- > 0; ) {
+            const TYPE v = CAT(TYPE, _extended_value_inline)(
+                input, N, 1, (pywt_index_t) i - (pywt_index_t) m, mode);
+            sum_a += v * filter_a[m];
+            sum_d += v * filter_d[m];
+        }
+        j = i - N + 1;
+    }
+    for (; j < F; ++j) {
+        const TYPE v = CAT(TYPE, _extended_value_inline)(
+            input, N, 1, (pywt_index_t) i - (pywt_index_t) j, mode);
+        sum_a += v * filter_a[j];
+        sum_d += v * filter_d[j];
+    }
+    *output_a = sum_a;
+    *output_d = sum_d;
+}
+
+
+/* Outputs [o_first, o_last) of _downsampling_convolution_dual near a boundary,
+ * with a copy of the loop for each mode */
+static void CAT(TYPE, _downsampling_convolution_dual_edges)(const TYPE * const restrict input, const size_t N,
+                                                           const TYPE * const restrict filter_a,
+                                                           const TYPE * const restrict filter_d,
+                                                           const size_t F,
+                                                           TYPE * const restrict output_a,
+                                                           TYPE * const restrict output_d,
+                                                           const size_t start, size_t o_first,
+                                                           const size_t o_last, const MODE mode)
+{
+#define EDGES(m) \
+    for (; o_first < o_last; ++o_first) \
+        CAT(TYPE, _downsampling_convolution_dual_edge)(input, N, filter_a, filter_d, F, \
+                                                       output_a + o_first, output_d + o_first, \
+                                                       start + 2*o_first, m)
+    switch (mode) {
+    case MODE_SYMMETRIC: EDGES(MODE_SYMMETRIC); break;
+    case MODE_REFLECT: EDGES(MODE_REFLECT); break;
+    case MODE_CONSTANT_EDGE: EDGES(MODE_CONSTANT_EDGE); break;
+    case MODE_SMOOTH: EDGES(MODE_SMOOTH); break;
+    case MODE_PERIODIC: EDGES(MODE_PERIODIC); break;
+    case MODE_PERIODIZATION: EDGES(MODE_PERIODIZATION); break;
+    default: EDGES(MODE_ZEROPAD); break;
+    }
+#undef EDGES
+}
+
+
+int CAT(TYPE, _downsampling_convolution_dual)(const TYPE * const restrict input, const size_t N,
+                                              const TYPE * const restrict filter_a,
+                                              const TYPE * const restrict filter_d,
+                                              const size_t F,
+                                              const FilterSymmetry * const symmetry_a,
+                                              const FilterSymmetry * const symmetry_d,
+                                              TYPE * const restrict output_a,
+                                              TYPE * const restrict output_d,
+                                              MODE mode)
+{
+    /* Output o is centered on input index i = start + 2*o. Outputs for which
+     * the filter lies within the input are computed by the center loop (or
+     * SIMD kernel), reading the input once for both filters. The few outputs
+     * near the boundaries read the extended input element-wise.
+     */
+    const size_t start = (mode == MODE_PERIODIZATION) ? F/2 : 1;
+    const size_t O = dwt_buffer_length(N, F, mode);
+    /* center outputs are [o_lo, o_hi), starting at the same input index as
+     * in _downsampling_convolution */
+    const size_t o_lo = (F > start) ? (F - start + 1) / 2 : 0;
+    size_t o_hi = (N > start) ? (N - 1 - start) / 2 + 1 : 0;
+    size_t o;
+    const int padded = boundary_get() == BOUNDARY_PADDED;
+
+    if (F == 2)
+        return CAT(TYPE, _haar_downsampling)(input, N, filter_a, filter_d,
+                                             output_a, output_d, mode);
+
+    if (F >= fft_threshold() &&
+        CAT(TYPE, _downsampling_convolution_fft)(input, N, filter_a, filter_d, F,
+                                                 output_a, output_d, 2, mode) == 0)
+        return 0;
+
+    if (o_hi > O)
+        o_hi = O;
+    if (o_hi < o_lo)
+        o_hi = o_lo;
+
+    // left boundary
+    o = 0;
+    if (padded && CAT(TYPE, _downsampling_convolution_padded)(input, N, filter_a, filter_d, F,
+                                                             output_a, output_d, start, 2,
+                                                             0, o_lo < O ? o_lo : O, mode) == 0)
+        o = o_lo;
+    CAT(TYPE, _downsampling_convolution_dual_edges)(input, N, filter_a, filter_d, F,
+                                                    output_a, output_d, start,
+                                                    o, o_lo < O ? o_lo : O, mode);
+
+    // center
+    o = o_lo;
+    if (symmetry_a != NULL && symmetry_d != NULL && simd_get() == SIMD_NONE &&
+        symmetry_a->sign != 0 && symmetry_d->sign != 0) {
+        /* symmetric filters: fewer multiplications with each filter on its
+         * own, in blocks still in cache for the second one. The vector
+         * kernels are bound by gathering the even inputs instead, which the
+         * dual kernel does once for both filters. */
+        for (; o < o_hi; o += DUAL_BLOCK_LEN) {
+            const size_t n = (o_hi - o < DUAL_BLOCK_LEN) ? o_hi - o : DUAL_BLOCK_LEN;
+            CAT(TYPE, _downsampling_center)(input, N, filter_a, F, symmetry_a,
+                                            output_a + o, start + 2*o, n);
+            CAT(TYPE, _downsampling_center)(input, N, filter_d, F, symmetry_d,
+                                            output_d + o, start + 2*o, n);
+        }
+        o = o_hi;
+    }
+    if (o < o_hi) {
+        CAT(TYPE, _downsampling_kernel_dual) kernel = CAT(TYPE, _simd_downsampling_kernel_dual)(F);
+        if (kernel != NULL)
+            o += kernel(input, N, filter_a, filter_d, F, output_a + o, output_d + o,
+                        start + 2*o, o_hi - o);
+    }
+    for (; o < o_hi; ++o) {
+        const size_t i = start + 2*o;
+        TYPE sum_a = 0, sum_d = 0;
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const TYPE v = input[i-j];
+            sum_a += v * filter_a[j];
+            sum_d += v * filter_d[j];
+        }
+        output_a[o] = sum_a;
+        output_d[o] = sum_d;
+    }
+
+    // right boundary
+    o = o_hi;
+    if (padded && CAT(TYPE, _downsampling_convolution_padded)(input, N, filter_a, filter_d, F,
+                                                             output_a, output_d, start, 2,
+                                                             o_hi, O, mode) == 0)
+        o = O;
+    CAT(TYPE, _downsampling_convolution_dual_edges)(input, N, filter_a, filter_d, F,
+                                                    output_a, output_d, start, o, O, mode);
+    return 0;
+}
+
 int CAT(TYPE, _upsampling_convolution_full)(const TYPE * const restrict input, const size_t N,
                                             const TYPE * const restrict filter, const size_t F,
+                                            const TYPE * const restrict polyphase,
                                             TYPE * const restrict output, const size_t O)
 {
     /* Performs a zero-padded convolution, using each input element for two
@@ -359,12 +1020,25 @@ int CAT(TYPE, _upsampling_convolution_full)(const TYPE * const restrict input, c
         }
     }
 
+    /* Each output of the center is only written once, so the terms can be
+     * summed before adding them (to the zeroed output) as the kernels do */
+    if (polyphase != NULL && i < N) {
+        CAT(TYPE, _upsampling_kernel) kernel = CAT(TYPE, _simd_upsampling_kernel)(F/2);
+        if (kernel != NULL) {
+            const size_t n = kernel(input, polyphase, F/2, output + o, i, N - i);
+            i += n;
+            o += 2*n;
+        }
+    }
     for(; i < N; ++i, o += 2){
+        TYPE sum_even = 0, sum_odd = 0;
         size_t j;
         for(j = 0; j < F/2; ++j){
-            output[o] += filter[j*2] * input[i-j];
-            output[o+1] += filter[j*2+1] * input[i-j];
+            sum_even += filter[j*2] * input[i-j];
+            sum_odd += filter[j*2+1] * input[i-j];
         }
+        output[o] += sum_even;
+        output[o+1] += sum_odd;
     }
 
     for(; i < F/2; ++i, o += 2){
@@ -388,6 +1062,7 @@ int CAT(TYPE, _upsampling_convolution_full)(const TYPE * const restrict input, c
 
 static int CAT(TYPE, _upsampling_convolution_valid_sf_periodization)(const TYPE * const restrict input, const size_t N,
                                                                      const TYPE * const restrict filter, const size_t F,
+                                                                     const TYPE * const restrict polyphase,
                                                                      TYPE * const restrict output, const size_t O)
 {
     // TODO? Allow for non-2 step
@@ -441,12 +1116,23 @@ static int CAT(TYPE, _upsampling_convolution_valid_sf_periodization)(const TYPE
         }
     }
 
+    if (polyphase != NULL && i < N) {
+        CAT(TYPE, _upsampling_kernel) kernel = CAT(TYPE, _simd_upsampling_kernel)(F/2);
+        if (kernel != NULL) {
+            const size_t n = kernel(input, polyphase, F/2, output + o, i, N - i);
+            i += n;
+            o += 2*n;
+        }
+    }
     for (; i < N; ++i, o += 2){
+        TYPE sum_even = 0, sum_odd = 0;
         size_t j;
         for(j = 0; j < F/2; ++j){
-            output[o] += filter[2*j] * input[i-j];
-            output[o+1] += filter[2*j+1] * input[i-j];
+            sum_even += filter[2*j] * input[i-j];
+            sum_odd += filter[2*j+1] * input[i-j];
         }
+        output[o] += sum_even;
+        output[o+1] += sum_odd;
     }
 
     for (; i < F/2 && i < end; ++i, o += 2){
@@ -490,6 +1176,44 @@ static int CAT(TYPE, _upsampling_convolution_valid_sf_periodization)(const TYPE
 }
 
 
+/* Both the even and odd taps of a reconstruction filter are (anti)symmetric */
+#define FOLDABLE(symmetry) \
+    ((symmetry) != NULL && (symmetry)[0].sign != 0 && (symmetry)[1].sign != 0)
+
+/* even[k] and odd[k] for k = [0..n), n <= DUAL_BLOCK_LEN: the sums of the
+ * even and odd taps of filter with input[i + k - j] (see
+ * _upsampling_convolution_valid_sf), summing only the taps described by
+ * symmetry[0] and symmetry[1], folded. */
+static void CAT(TYPE, _upsampling_folded_block)(const TYPE * const restrict input, const size_t N,
+                                                const TYPE * const restrict filter,
+                                                const FilterSymmetry * const symmetry,
+                                                const size_t i, const size_t n,
+                                                TYPE * const restrict even,
+                                                TYPE * const restrict odd)
+{
+    size_t p;
+
+    for (p = 0; p < 2; ++p) {
+        const FilterSymmetry sym = symmetry[p];
+        const TYPE * const f = filter + 2*sym.first + p;
+        TYPE * const restrict out = p ? odd : even;
+        CAT(TYPE, _convolution_kernel_folded) kernel = CAT(TYPE, _convolution_kernel_folded_fixed)(sym.len, sym.sign);
+        size_t k = 0;
+
+        if (kernel != NULL) {
+            // the kernels take contiguous taps
+            TYPE taps[PYWT_FIXED_FILTER_MAX];
+            size_t j;
+            for (j = 0; j < sym.len; ++j)
+                taps[j] = f[2*j];
+            k = kernel(input, N, taps, sym.len, sym.sign, out, i - sym.first, n);
+        }
+        for (; k < n; ++k)
+            out[k] = CAT(TYPE, _folded_sum)(input + i + k - sym.first, f, 2, sym.len, sym.sign);
+    }
+}
+
+
 /*
  * performs IDWT for all modes
  *
@@ -500,21 +1224,45 @@ static int CAT(TYPE, _upsampling_convolution_valid_sf_periodization)(const TYPE
 
 int CAT(TYPE, _upsampling_convolution_valid_sf)(const TYPE * const restrict input, const size_t N,
                                                 const TYPE * const restrict filter, const size_t F,
+                                                const FilterSymmetry * const symmetry,
+                                                const TYPE * const restrict polyphase,
                                                 TYPE * const restrict output, const size_t O,
                                                 MODE mode)
 {
     // TODO: Allow non-2 step?
 
     if(mode == MODE_PERIODIZATION)
-        return CAT(TYPE, _upsampling_convolution_valid_sf_periodization)(input, N, filter, F, output, O);
+        return CAT(TYPE, _upsampling_convolution_valid_sf_periodization)(input, N, filter, F, polyphase,
+                                                                         output, O);
 
     if((F%2) || (N < F/2))
         return -1;
 
     // Perform only stage 2 - all elements in the filter overlap an input element.
-    {
+    if (FOLDABLE(symmetry)) {
+        // the even and odd taps filter[2*j + p] are filters on their own
+        TYPE even[DUAL_BLOCK_LEN], odd[DUAL_BLOCK_LEN];
         size_t o, i;
-        for(o = 0, i = F/2 - 1; i < N; ++i, o += 2){
+        for(o = 0, i = F/2 - 1; i < N; i += DUAL_BLOCK_LEN){
+            const size_t n = (N - i < DUAL_BLOCK_LEN) ? N - i : DUAL_BLOCK_LEN;
+            size_t k;
+            CAT(TYPE, _upsampling_folded_block)(input, N, filter, symmetry, i, n, even, odd);
+            for (k = 0; k < n; ++k, o += 2) {
+                output[o] += even[k];
+                output[o+1] += odd[k];
+            }
+        }
+    } else {
+        size_t o = 0, i = F/2 - 1;
+        if (polyphase != NULL) {
+            CAT(TYPE, _upsampling_kernel) kernel = CAT(TYPE, _simd_upsampling_kernel)(F/2);
+            if (kernel != NULL) {
+                const size_t n = kernel(input, polyphase, F/2, output, i, N - i);
+                i += n;
+                o += 2*n;
+            }
+        }
+        for(; i < N; ++i, o += 2){
             TYPE sum_even = 0;
             TYPE sum_odd = 0;
             size_t j;
@@ -529,13 +1277,369 @@ int CAT(TYPE, _upsampling_convolution_valid_sf)(const TYPE * const restrict inpu
     return 0;
 }
 
-/* -> swt - todo */
-int CAT(TYPE, _upsampled_filter_convolution)(const TYPE* input, const size_t N,
-                                             const TYPE* filter, const size_t F,
-                                             TYPE* output,
-                                             const size_t step, MODE mode)
+/* Sums for the even and odd output of _upsampling_convolution_valid_sf near
+ * the boundaries in MODE_PERIODIZATION, added to *sum_even and *sum_odd.
+ * Coefficients are periodic with period N, terms are summed in the same order
+ * as in _upsampling_convolution_valid_sf_periodization.
+ */
+static void CAT(TYPE, _upsampling_periodization_edge)(const TYPE * const restrict input, const size_t N,
+                                                      const TYPE * const restrict filter, const size_t F,
+                                                      const size_t i, TYPE * const restrict sum_even,
+                                                      TYPE * const restrict sum_odd)
+{
+    TYPE even = *sum_even, odd = *sum_odd;
+    size_t j = 0;
+
+    if (i >= N) {
+        size_t m;
+        for (m = i - N + 1; m-- > 0; ) {
+            const TYPE v = input[(i - m) % N];
+            even += filter[2*m] * v;
+            odd += filter[2*m+1] * v;
+        }
+        j = i - N + 1;
+    }
+    for (; j < F/2; ++j) {
+        const TYPE v = (j <= i) ? input[(i - j) % N] : input[N - 1 - (j - i - 1) % N];
+        even += filter[2*j] * v;
+        odd += filter[2*j+1] * v;
+    }
+    *sum_even = even;
+    *sum_odd = odd;
+}
+
+
+/* Writes the outputs output[o], output[o+1], ... of the dual reconstruction
+ * centered on the n inputs from i, all filters lying within the inputs */
+static void CAT(TYPE, _upsampling_folded_dual)(const TYPE * const restrict input_a,
+                                               const TYPE * const restrict input_d,
+                                               const size_t N,
+                                               const TYPE * const restrict filter_a,
+                                               const TYPE * const restrict filter_d,
+                                               const FilterSymmetry * const symmetry_a,
+                                               const FilterSymmetry * const symmetry_d,
+                                               TYPE * const restrict output, size_t i,
+                                               const size_t n)
+{
+    TYPE even_a[DUAL_BLOCK_LEN], odd_a[DUAL_BLOCK_LEN];
+    TYPE even_d[DUAL_BLOCK_LEN], odd_d[DUAL_BLOCK_LEN];
+    const size_t end = i + n;
+    size_t o = 0;
+
+    for (; i < end; i += DUAL_BLOCK_LEN) {
+        const size_t m = (end - i < DUAL_BLOCK_LEN) ? end - i : DUAL_BLOCK_LEN;
+        size_t k;
+        CAT(TYPE, _upsampling_folded_block)(input_a, N, filter_a, symmetry_a, i, m, even_a, odd_a);
+        CAT(TYPE, _upsampling_folded_block)(input_d, N, filter_d, symmetry_d, i, m, even_d, odd_d);
+        for (k = 0; k < m; ++k, o += 2) {
+            output[o] = even_a[k] + even_d[k];
+            output[o+1] = odd_a[k] + odd_d[k];
+        }
+    }
+}
+
+
+/* _upsampling_convolution_valid_sf_dual for two tap filters, the same in all
+ * modes: each input gives one even and one odd output */
+static int CAT(TYPE, _haar_upsampling_dual)(const TYPE * const restrict input_a,
+                                            const TYPE * const restrict input_d,
+                                            const size_t N,
+                                            const TYPE * const restrict filter_a,
+                                            const TYPE * const restrict filter_d,
+                                            TYPE * const restrict output)
+{
+    CAT(TYPE, _haar_rec_kernel) kernel = CAT(TYPE, _simd_haar_rec_kernel)();
+    size_t o = 0;
+
+    if (kernel != NULL)
+        o = kernel(input_a, input_d, filter_a, filter_d, output, N);
+    for (; o < N; ++o) {
+        output[2*o] = filter_a[0] * input_a[o] + filter_d[0] * input_d[o];
+        output[2*o+1] = filter_a[1] * input_a[o] + filter_d[1] * input_d[o];
+    }
+    return 0;
+}
+
+
+static int CAT(TYPE, _upsampling_convolution_valid_sf_dual_periodization)(const TYPE * const restrict input_a,
+                                                                          const TYPE * const restrict input_d,
+                                                                          const size_t N,
+                                                                          const TYPE * const restrict filter_a,
+                                                                          const TYPE * const restrict filter_d,
+                                                                          const size_t F,
+                                                                          const FilterSymmetry * const symmetry_a,
+                                                                          const FilterSymmetry * const symmetry_d,
+                                                                          const TYPE * const restrict polyphase_a,
+                                                                          const TYPE * const restrict polyphase_d,
+                                                                          TYPE * const restrict output, const size_t O)
+{
+    /* Input index i contributes to outputs o and o+1, where the output is
+     * shifted by one element for (F/2)%2 == 0. The pair centered on
+     * i = N+start-1 then wraps around to output[2*N-1] and output[0].
+     *
+     * Terms are summed in the same order as by two calls to
+     * _upsampling_convolution_valid_sf_periodization on a zeroed output: the
+     * edges one term at a time, the center as the sums of each subband.
+     */
+    size_t const start = F/4;
+    int const shift = ((F/2)%2 == 0);
+    size_t const end = N + start - (shift ? 1 : 0);
+    size_t i, o = 0;
+    // used once, for the whole center
+    CAT(TYPE, _upsampling_kernel_dual) kernel = (polyphase_a != NULL && polyphase_d != NULL) ?
+        CAT(TYPE, _simd_upsampling_kernel_dual)(F/2) : NULL;
+
+    if(F%2) return -3; /* Filter must have even-length. */
+
+    if (shift) {
+        TYPE even = 0, odd = 0;
+        CAT(TYPE, _upsampling_periodization_edge)(input_a, N, filter_a, F, N+start-1, &even, &odd);
+        CAT(TYPE, _upsampling_periodization_edge)(input_d, N, filter_d, F, N+start-1, &even, &odd);
+        output[2*N-1] = even;
+        output[0] = odd;
+        o += 1;
+    }
+
+    for (i = start; i < end; ++i, o += 2) {
+        TYPE even = 0, odd = 0;
+        if (i >= F/2 - 1 && i < N && FOLDABLE(symmetry_a) && FOLDABLE(symmetry_d)) {
+            // the whole center at once
+            const size_t n = ((end < N) ? end : N) - i;
+            CAT(TYPE, _upsampling_folded_dual)(input_a, input_d, N, filter_a, filter_d,
+                                               symmetry_a, symmetry_d, output + o, i, n);
+            i += n - 1;
+            o += 2*(n - 1);
+            continue;
+        } else if (i >= F/2 - 1 && i < N) {
+            size_t j;
+            if (kernel != NULL) {
+                const size_t n = kernel(input_a, input_d, polyphase_a, polyphase_d, F/2, output + o,
+                                        i, ((end < N) ? end : N) - i);
+                kernel = NULL;
+                if (n > 0) {
+                    i += n - 1;
+                    o += 2*(n - 1);
+                    continue;
+                }
+            }
+            TYPE even_d = 0, odd_d = 0;
+            for (j = 0; j < F/2; ++j) {
+                even += filter_a[2*j] * input_a[i-j];
+                odd += filter_a[2*j+1] * input_a[i-j];
+            }
+            for (j = 0; j < F/2; ++j) {
+                even_d += filter_d[2*j] * input_d[i-j];
+                odd_d += filter_d[2*j+1] * input_d[i-j];
+            }
+            even += even_d;
+            odd += odd_d;
+        } else {
+            CAT(TYPE, _upsampling_periodization_edge)(input_a, N, filter_a, F, i, &even, &odd);
+            CAT(TYPE, _upsampling_periodization_edge)(input_d, N, filter_d, F, i, &even, &odd);
+        }
+        output[o] = even;
+        output[o+1] = odd;
+    }
+    return 0;
+}
+
+
+int CAT(TYPE, _upsampling_convolution_valid_sf_dual)(const TYPE * const restrict input_a,
+                                                     const TYPE * const restrict input_d,
+                                                     const size_t N,
+                                                     const TYPE * const restrict filter_a,
+                                                     const TYPE * const restrict filter_d,
+                                                     const size_t F,
+                                                     const FilterSymmetry * const symmetry_a,
+                                                     const FilterSymmetry * const symmetry_d,
+                                                     const TYPE * const restrict polyphase_a,
+                                                     const TYPE * const restrict polyphase_d,
+                                                     TYPE * const restrict output, const size_t O,
+                                                     MODE mode)
+{
+    size_t o = 0, i;
+
+    if(F == 2)
+        return CAT(TYPE, _haar_upsampling_dual)(input_a, input_d, N, filter_a, filter_d, output);
+
+    if(mode == MODE_PERIODIZATION)
+        return CAT(TYPE, _upsampling_convolution_valid_sf_dual_periodization)(input_a, input_d, N,
+                                                                              filter_a, filter_d, F,
+                                                                              symmetry_a, symmetry_d,
+                                                                              polyphase_a, polyphase_d,
+                                                                              output, O);
+
+    if((F%2) || (N < F/2))
+        return -1;
+
+    if (FOLDABLE(symmetry_a) && FOLDABLE(symmetry_d)) {
+        CAT(TYPE, _upsampling_folded_dual)(input_a, input_d, N, filter_a, filter_d,
+                                           symmetry_a, symmetry_d, output, F/2 - 1, N - (F/2 - 1));
+        return 0;
+    }
+
+    i = F/2 - 1;
+    if (polyphase_a != NULL && polyphase_d != NULL) {
+        CAT(TYPE, _upsampling_kernel_dual) kernel = CAT(TYPE, _simd_upsampling_kernel_dual)(F/2);
+        if (kernel != NULL) {
+            const size_t n = kernel(input_a, input_d, polyphase_a, polyphase_d, F/2, output, i,
+                                    N - i);
+            i += n;
+            o += 2*n;
+        }
+    }
+    for(; i < N; ++i, o += 2){
+        TYPE sum_even_a = 0, sum_odd_a = 0;
+        TYPE sum_even_d = 0, sum_odd_d = 0;
+        size_t j;
+        for(j = 0; j < F/2; ++j){
+            sum_even_a += filter_a[j*2] * input_a[i-j];
+            sum_odd_a += filter_a[j*2+1] * input_a[i-j];
+            sum_even_d += filter_d[j*2] * input_d[i-j];
+            sum_odd_d += filter_d[j*2+1] * input_d[i-j];
+        }
+        output[o] = sum_even_a + sum_even_d;
+        output[o+1] = sum_odd_a + sum_odd_d;
+    }
+    return 0;
+}
+
+#undef FOLDABLE
+
+/* Bounds [o_lo, o_hi) of the outputs of the upsampled filter convolutions
+ * for which all taps lie within the input, i.e.
+ * 0 <= o + offset - step*j < N for all j = [0..F). */
+static void CAT(TYPE, _upsampled_filter_bounds)(const size_t N, const size_t F,
+                                                const size_t step, const size_t offset,
+                                                size_t * const o_lo, size_t * const o_hi)
+{
+    const size_t reach = step * (F - 1);
+
+    *o_lo = (reach > offset) ? reach - offset : 0;
+    *o_hi = (N > offset) ? N - offset : 0;
+    if (*o_lo > N)
+        *o_lo = N;
+    if (*o_hi < *o_lo)
+        *o_hi = *o_lo;
+}
+
+
+/* One output of the upsampled filter convolutions near the boundaries, where
+ * the input index i wraps around (possibly several times, as the upsampled
+ * filter may be longer than the input). input_d and filter_d may be NULL. */
+static TYPE CAT(TYPE, _upsampled_filter_edge)(const TYPE * const restrict input_a,
+                                              const TYPE * const restrict input_d,
+                                              const size_t N,
+                                              const TYPE * const restrict filter_a,
+                                              const TYPE * const restrict filter_d,
+                                              const size_t F, const size_t step, size_t i)
+{
+    const size_t s = step % N;
+    TYPE sum = 0;
+    size_t j;
+
+    i %= N;
+    for (j = 0; j < F; ++j) {
+        sum += filter_a[j] * input_a[i];
+        if (input_d != NULL)
+            sum += filter_d[j] * input_d[i];
+        i = (i >= s) ? i - s : i + N - s;
+    }
+    return sum;
+}
+
+
+int CAT(TYPE, _upsampled_filter_convolution)(const TYPE * const restrict input, const size_t N,
+                                             const TYPE * const restrict filter, const size_t F,
+                                             TYPE * const restrict output,
+                                             const size_t step, const size_t offset,
+                                             MODE mode)
+{
+    /* Only the F nonzero taps of the upsampled filter are visited, output o
+     * is centered on input index o + offset. */
+    size_t o, o_lo, o_hi;
+
+    if (mode != MODE_PERIODIZATION || N == 0 || step == 0)
+        return -1;
+
+    CAT(TYPE, _upsampled_filter_bounds)(N, F, step, offset, &o_lo, &o_hi);
+
+    // left boundary
+    for (o = 0; o < o_lo; ++o)
+        output[o] = CAT(TYPE, _upsampled_filter_edge)(input, NULL, N, filter, NULL,
+                                                      F, step, o + offset);
+
+    // center, for two tap filters (Haar) the sum of two shifted rows
+    if (F == 2 && o < o_hi) {
+        const TYPE * const rows[2] = {input + o + offset, input + o + offset - step};
+        CAT(TYPE, _rows_kernel) kernel = CAT(TYPE, _simd_rows_kernel)();
+        if (kernel != NULL)
+            o += kernel(rows, filter, 2, output + o, o_hi - o);
+    }
+    for (; o < o_hi; ++o) {
+        const size_t i = o + offset;
+        TYPE sum = 0;
+        size_t j;
+        for (j = 0; j < F; ++j)
+            sum += filter[j] * input[i - step*j];
+        output[o] = sum;
+    }
+
+    // right boundary
+    for (; o < N; ++o)
+        output[o] = CAT(TYPE, _upsampled_filter_edge)(input, NULL, N, filter, NULL,
+                                                      F, step, o + offset);
+    return 0;
+}
+
+
+int CAT(TYPE, _upsampled_filter_convolution_dual)(const TYPE * const restrict input_a,
+                                                  const TYPE * const restrict input_d,
+                                                  const size_t N,
+                                                  const TYPE * const restrict filter_a,
+                                                  const TYPE * const restrict filter_d,
+                                                  const size_t F,
+                                                  TYPE * const restrict output,
+                                                  const size_t step, const size_t offset,
+                                                  MODE mode)
 {
-    return -1;
+    size_t o, o_lo, o_hi;
+
+    if (mode != MODE_PERIODIZATION || N == 0 || step == 0 || F < 2)
+        return -1;
+
+    CAT(TYPE, _upsampled_filter_bounds)(N, F, step, offset, &o_lo, &o_hi);
+
+    // left boundary
+    for (o = 0; o < o_lo; ++o)
+        output[o] = CAT(TYPE, _upsampled_filter_edge)(input_a, input_d, N, filter_a, filter_d,
+                                                      F, step, o + offset) / 2;
+
+    // center, for two tap filters (Haar) the sum of four shifted rows
+    if (F == 2 && o < o_hi) {
+        const TYPE * const rows[4] = {input_a + o + offset, input_d + o + offset,
+                                      input_a + o + offset - step, input_d + o + offset - step};
+        // the weights are halved rather than the sum, both exact
+        const TYPE weights[4] = {filter_a[0] / 2, filter_d[0] / 2,
+                                 filter_a[1] / 2, filter_d[1] / 2};
+        CAT(TYPE, _rows_kernel) kernel = CAT(TYPE, _simd_rows_kernel)();
+        if (kernel != NULL)
+            o += kernel(rows, weights, 4, output + o, o_hi - o);
+    }
+    for (; o < o_hi; ++o) {
+        const size_t i = o + offset;
+        TYPE sum = 0;
+        size_t j;
+        for (j = 0; j < F; ++j)
+            sum += filter_a[j] * input_a[i - step*j] + filter_d[j] * input_d[i - step*j];
+        output[o] = sum / 2;
+    }
+
+    // right boundary
+    for (; o < N; ++o)
+        output[o] = CAT(TYPE, _upsampled_filter_edge)(input_a, input_d, N, filter_a, filter_d,
+                                                      F, step, o + offset) / 2;
+    return 0;
 }
 
 #undef restrict
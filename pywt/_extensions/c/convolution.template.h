@@ -22,6 +22,8 @@
  * N        - input data length
  * filter   - filter data
  * F        - filter data length
+ * symmetry - nonzero taps and symmetry of the filter, used for step 2 (see
+ *            FilterSymmetry), or NULL
  * output   - output data
  * step     - decimation step
  * mode     - signal extension mode
@@ -31,9 +33,62 @@
 
 int CAT(TYPE, _downsampling_convolution)(const TYPE * const restrict input, const size_t N,
                                          const TYPE * const restrict filter, const size_t F,
+                                         const FilterSymmetry * const symmetry,
                                          TYPE * const restrict output, const size_t step,
                                          MODE mode);
 
+/* Performs decimating (step = 2) convolution of input with two filters of
+ * the same length in a single pass, e.g. the lowpass and highpass
+ * decomposition filters of a wavelet. Output lengths are the same as for
+ * _downsampling_convolution with step = 2.
+ *
+ * input    - input data
+ * N        - input data length
+ * filter_a - first filter data
+ * filter_d - second filter data
+ * F        - filter data length
+ * symmetry_a, symmetry_d - symmetry of the filters, or NULL. Without
+ *            vector instructions, the filters are applied separately if
+ *            both are symmetric or antisymmetric.
+ * output_a - output data for first filter
+ * output_d - output data for second filter
+ * mode     - signal extension mode
+ */
+
+int CAT(TYPE, _downsampling_convolution_dual)(const TYPE * const restrict input, const size_t N,
+                                              const TYPE * const restrict filter_a,
+                                              const TYPE * const restrict filter_d,
+                                              const size_t F,
+                                              const FilterSymmetry * const symmetry_a,
+                                              const FilterSymmetry * const symmetry_d,
+                                              TYPE * const restrict output_a,
+                                              TYPE * const restrict output_d,
+                                              MODE mode);
+
+/* Value of input at index idx, which may lie outside [0, N), after (virtual)
+ * extension with mode. MODE_PERIODIZATION extends odd-length input with its
+ * last value before repeating it.
+ */
+
+TYPE CAT(TYPE, _extended_value)(const TYPE * const restrict input, const size_t N,
+                                pywt_index_t idx, const MODE mode);
+
+/* As _extended_value, for input elements stride apart */
+
+TYPE CAT(TYPE, _extended_value_strided)(const TYPE * const restrict input, const size_t N,
+                                        const pywt_index_t stride, pywt_index_t idx,
+                                        const MODE mode);
+
+/* Writes the input extended with mode to output:
+ *   output[k * output_stride] = extended input at index first + k
+ * for k = [0..len). Strides are in elements.
+ */
+
+void CAT(TYPE, _extend)(const TYPE * const restrict input, const size_t N,
+                        const pywt_index_t input_stride, const pywt_index_t first,
+                        TYPE * const restrict output, const size_t len,
+                        const pywt_index_t output_stride, const MODE mode);
+
 /*
  * Performs normal (full) convolution of "upsampled" input coeffs array with
  * filter Requires zero-filled output buffer (adds values instead of
@@ -43,6 +98,10 @@ int CAT(TYPE, _downsampling_convolution)(const TYPE * const restrict input, cons
  * N        - input data length
  * filter   - filter data
  * F        - filter data length
+ * polyphase - the even taps of filter followed by its odd taps (see
+ *             Wavelet), or NULL. The outputs for which the filter lies
+ *             within the input are then computed by the upsampling kernels
+ *             of simd.h.
  * output   - output data
  * O        - output lenght (currently not used)
  * mode     - signal extension mode
@@ -50,23 +109,80 @@ int CAT(TYPE, _downsampling_convolution)(const TYPE * const restrict input, cons
 
 int CAT(TYPE, _upsampling_convolution_full)(const TYPE * const restrict input, const size_t N,
                                             const TYPE * const restrict filter, const size_t F,
+                                            const TYPE * const restrict polyphase,
                                             TYPE * const restrict output, const size_t O);
 
 /* Performs valid convolution (signals must overlap)
  * Extends (virtually) input for MODE_PERIODIZATION.
+ *
+ * symmetry - symmetry of the even and odd taps of the filter (see
+ *            FilterSymmetry), or NULL
+ * polyphase - as above
  */
 
 int CAT(TYPE, _upsampling_convolution_valid_sf)(const TYPE * const restrict input, const size_t N,
                                                 const TYPE * const restrict filter, const size_t F,
+                                                const FilterSymmetry * const symmetry,
+                                                const TYPE * const restrict polyphase,
                                                 TYPE * const restrict output, const size_t O,
                                                 MODE mode);
 
-/* TODO
- * for SWT
- * int upsampled_filter_convolution(const TYPE* input, const int N,
- *                                  const TYPE* filter, const int F,
- *                                  TYPE* output, int step, int mode);
+/* As _upsampling_convolution_valid_sf, but combining the contributions of
+ * two inputs (e.g. approximation and detail coefficients with the lowpass
+ * and highpass reconstruction filters) in a single pass. The output is
+ * written, not added to, so does not need to be zero-filled. symmetry_a,
+ * symmetry_d and polyphase_a, polyphase_d are as symmetry and polyphase
+ * above, for each filter (both polyphase components or neither).
+ */
+
+int CAT(TYPE, _upsampling_convolution_valid_sf_dual)(const TYPE * const restrict input_a,
+                                                     const TYPE * const restrict input_d,
+                                                     const size_t N,
+                                                     const TYPE * const restrict filter_a,
+                                                     const TYPE * const restrict filter_d,
+                                                     const size_t F,
+                                                     const FilterSymmetry * const symmetry_a,
+                                                     const FilterSymmetry * const symmetry_d,
+                                                     const TYPE * const restrict polyphase_a,
+                                                     const TYPE * const restrict polyphase_d,
+                                                     TYPE * const restrict output, const size_t O,
+                                                     MODE mode);
+
+/* Undecimated convolution with the filter upsampled by step (i.e. with
+ * step - 1 zeros inserted between its taps), as used by the stationary
+ * wavelet transforms. Only the nonzero taps are visited:
+ *   output[o] = sum(filter[j] * input[(o + offset - step*j) mod N]
+ *                   for j = [0..F))
+ * for o = [0..N), for any N. With offset = step*(F/2) this equals
+ * _downsampling_convolution with step 1 and the upsampled filter (the SWT),
+ * with offset = 0 it is the causal circular filtering of the MODWT. Only
+ * MODE_PERIODIZATION is supported, -1 is returned for other modes.
+ */
+
+int CAT(TYPE, _upsampled_filter_convolution)(const TYPE * const restrict input, const size_t N,
+                                             const TYPE * const restrict filter, const size_t F,
+                                             TYPE * const restrict output,
+                                             const size_t step, const size_t offset,
+                                             MODE mode);
+
+/* Inverse of _upsampled_filter_convolution for a pair of filters, combining
+ * the approximation and detail coefficients (the average of the
+ * reconstructions from the even and odd samples):
+ *   output[o] = sum(filter_a[j] * input_a[i] + filter_d[j] * input_d[i]
+ *                   for j = [0..F)) / 2
+ * with i = (o + offset - step*j) mod N, for o = [0..N). The inverse of the
+ * SWT has offset = step*(F/2 - 1).
  */
 
+int CAT(TYPE, _upsampled_filter_convolution_dual)(const TYPE * const restrict input_a,
+                                                  const TYPE * const restrict input_d,
+                                                  const size_t N,
+                                                  const TYPE * const restrict filter_a,
+                                                  const TYPE * const restrict filter_d,
+                                                  const size_t F,
+                                                  TYPE * const restrict output,
+                                                  const size_t step, const size_t offset,
+                                                  MODE mode);
+
 #undef restrict
 #endif /* TYPE */
@@ -0,0 +1,1563 @@
+/* See COPYING for license details. */
+
+/* Vectorized kernels for the center loop of the decimating convolution.
+ *
+ * Outputs are computed W at a time (W being the number of elements in a
+ * vector register). For each filter tap j, the 2*W consecutive inputs
+ * starting at input[i + 2*o - j] are loaded and their even elements gathered
+ * into one register, which is then multiplied by the broadcast tap. Two
+ * output vectors are computed per iteration to hide latency. The dual
+ * kernels apply two filters to each gathered register, so the input is only
+ * read once for both.
+ *
+ * The rows kernels compute weighted sums of rows, W lanes at a time, with
+ * no gathering needed: neighbouring lanes are contiguous in memory.
+ *
+ * The Haar kernels, for two tap filters, split 2*W inputs into their even
+ * and odd elements (or interleave W even and odd outputs) with shuffles.
+ *
+ * The upsampling kernels of the reconstruction take the even and odd taps of
+ * the filter as two contiguous filters (its polyphase components), each
+ * convolved with W contiguous inputs at a time without gathering. The even
+ * and odd outputs are then interleaved with shuffles.
+ *
+ * Vector loads may not read past the end of the input. Kernels return the
+ * number of outputs computed, the remaining ones are left to the portable
+ * loops of the caller. Scalar code is kept out of these functions, where the
+ * compiler may contract it to FMA instructions.
+ *
+ * The downsampling kernels are written as always inlined bodies, from which
+ * a generic kernel and kernels for each even filter length up to
+ * PYWT_FIXED_FILTER_MAX are instantiated. With a constant length the tap
+ * loops are fully unrolled and the taps kept in registers. Portable kernels
+ * of fixed length are provided as well, for use without vector instructions,
+ * among which folded kernels for filters symmetric about their middle: these
+ * add (or subtract) the two inputs sharing a tap before multiplying. With
+ * vector instructions the gathering of the even inputs dominates, which
+ * folding does not save.
+ */
+
+#include "simd.h"
+
+#define PYWT_FIXED_INDEX(F) ((F) % 2 == 0 && (F) >= 2 && (F) <= PYWT_FIXED_FILTER_MAX)
+
+#define PYWT_FIXED_KERNEL(type, name, target, F) \
+    target static size_t name##_f##F(const type * input, size_t N, \
+                                     const type * filter, size_t f, \
+                                     type * output, size_t i, size_t n) \
+    { \
+        (void) f; \
+        return name##_body(input, N, filter, F, output, i, n); \
+    }
+
+#define PYWT_FIXED_DUAL_KERNEL(type, name, target, F) \
+    target static size_t name##_f##F(const type * input, size_t N, \
+                                     const type * filter_a, const type * filter_d, \
+                                     size_t f, type * output_a, type * output_d, \
+                                     size_t i, size_t n) \
+    { \
+        (void) f; \
+        return name##_body(input, N, filter_a, filter_d, F, output_a, output_d, i, n); \
+    }
+
+#define PYWT_FIXED_TABLE(type, name) \
+    static const type name##_fixed[PYWT_FIXED_FILTER_MAX / 2 + 1] = { \
+        NULL, name##_f2, name##_f4, name##_f6, name##_f8, name##_f10, \
+        name##_f12, name##_f14, name##_f16, name##_f18, name##_f20}
+
+/* Fixed length kernels name_f2() ... name_f20() and the table name_fixed[F/2]
+ * of them, from name_body(). PYWT_KERNELS adds the generic kernel name(). */
+#define PYWT_FIXED_KERNELS(type, name, target) \
+    PYWT_FIXED_KERNEL(type, name, target, 2) PYWT_FIXED_KERNEL(type, name, target, 4) \
+    PYWT_FIXED_KERNEL(type, name, target, 6) PYWT_FIXED_KERNEL(type, name, target, 8) \
+    PYWT_FIXED_KERNEL(type, name, target, 10) PYWT_FIXED_KERNEL(type, name, target, 12) \
+    PYWT_FIXED_KERNEL(type, name, target, 14) PYWT_FIXED_KERNEL(type, name, target, 16) \
+    PYWT_FIXED_KERNEL(type, name, target, 18) PYWT_FIXED_KERNEL(type, name, target, 20) \
+    PYWT_FIXED_TABLE(type##_downsampling_kernel, name);
+
+#define PYWT_KERNELS(type, name, target) \
+    target static size_t name(const type * input, size_t N, \
+                              const type * filter, size_t F, \
+                              type * output, size_t i, size_t n) \
+    { \
+        return name##_body(input, N, filter, F, output, i, n); \
+    } \
+    PYWT_FIXED_KERNELS(type, name, target)
+
+#define PYWT_FIXED_DUAL_KERNELS(type, name, target) \
+    PYWT_FIXED_DUAL_KERNEL(type, name, target, 2) PYWT_FIXED_DUAL_KERNEL(type, name, target, 4) \
+    PYWT_FIXED_DUAL_KERNEL(type, name, target, 6) PYWT_FIXED_DUAL_KERNEL(type, name, target, 8) \
+    PYWT_FIXED_DUAL_KERNEL(type, name, target, 10) PYWT_FIXED_DUAL_KERNEL(type, name, target, 12) \
+    PYWT_FIXED_DUAL_KERNEL(type, name, target, 14) PYWT_FIXED_DUAL_KERNEL(type, name, target, 16) \
+    PYWT_FIXED_DUAL_KERNEL(type, name, target, 18) PYWT_FIXED_DUAL_KERNEL(type, name, target, 20) \
+    PYWT_FIXED_TABLE(type##_downsampling_kernel_dual, name);
+
+#define PYWT_DUAL_KERNELS(type, name, target) \
+    target static size_t name(const type * input, size_t N, \
+                              const type * filter_a, const type * filter_d, \
+                              size_t F, type * output_a, type * output_d, \
+                              size_t i, size_t n) \
+    { \
+        return name##_body(input, N, filter_a, filter_d, F, output_a, output_d, i, n); \
+    } \
+    PYWT_FIXED_DUAL_KERNELS(type, name, target)
+
+#define PYWT_FIXED_FOLDED_KERNEL(type, name, target, F) \
+    target static size_t name##_f##F##_a(const type * input, size_t N, \
+                                         const type * filter, size_t f, int sign, \
+                                         type * output, size_t i, size_t n) \
+    { \
+        (void) f; (void) sign; \
+        return name##_body(input, N, filter, F, -1, output, i, n); \
+    } \
+    target static size_t name##_f##F##_s(const type * input, size_t N, \
+                                         const type * filter, size_t f, int sign, \
+                                         type * output, size_t i, size_t n) \
+    { \
+        (void) f; (void) sign; \
+        return name##_body(input, N, filter, F, 1, output, i, n); \
+    }
+
+/* Folded kernels for each length up to PYWT_FIXED_FILTER_MAX (odd lengths
+ * included: the nonzero taps of symmetric filters often are) and sign, in
+ * the table name_fixed[F][sign > 0] */
+#define PYWT_FIXED_FOLDED_KERNELS(type, kernel_type, name, target) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 1) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 2) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 3) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 4) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 5) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 6) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 7) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 8) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 9) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 10) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 11) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 12) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 13) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 14) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 15) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 16) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 17) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 18) \
+    PYWT_FIXED_FOLDED_KERNEL(type, name, target, 19) PYWT_FIXED_FOLDED_KERNEL(type, name, target, 20) \
+    static const kernel_type name##_fixed[PYWT_FIXED_FILTER_MAX + 1][2] = { \
+        {NULL, NULL}, {name##_f1_a, name##_f1_s}, {name##_f2_a, name##_f2_s}, \
+        {name##_f3_a, name##_f3_s}, {name##_f4_a, name##_f4_s}, {name##_f5_a, name##_f5_s}, \
+        {name##_f6_a, name##_f6_s}, {name##_f7_a, name##_f7_s}, {name##_f8_a, name##_f8_s}, \
+        {name##_f9_a, name##_f9_s}, {name##_f10_a, name##_f10_s}, {name##_f11_a, name##_f11_s}, \
+        {name##_f12_a, name##_f12_s}, {name##_f13_a, name##_f13_s}, {name##_f14_a, name##_f14_s}, \
+        {name##_f15_a, name##_f15_s}, {name##_f16_a, name##_f16_s}, {name##_f17_a, name##_f17_s}, \
+        {name##_f18_a, name##_f18_s}, {name##_f19_a, name##_f19_s}, {name##_f20_a, name##_f20_s}};
+
+
+/* Kernel for filter length F: of fixed length if there is one */
+#define PYWT_SELECT(name, F) (PYWT_FIXED_INDEX(F) ? name##_fixed[(F) / 2] : name)
+
+#define PYWT_FIXED_UPSAMPLING_MAX (PYWT_FIXED_FILTER_MAX / 2)
+
+#define PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, L) \
+    target static size_t name##_l##L(const type * input, const type * polyphase, size_t l, \
+                                     type * output, size_t i, size_t n) \
+    { \
+        (void) l; \
+        return name##_body(input, NULL, polyphase, NULL, L, output, i, n); \
+    } \
+    target static size_t name##_dual_l##L(const type * input_a, const type * input_d, \
+                                          const type * polyphase_a, const type * polyphase_d, \
+                                          size_t l, type * output, size_t i, size_t n) \
+    { \
+        (void) l; \
+        return name##_body(input_a, input_d, polyphase_a, polyphase_d, L, output, i, n); \
+    }
+
+/* Single and dual upsampling kernels of fixed length name_l1() ... name_l10()
+ * and name_dual_l1() ... name_dual_l10(), in the tables name_fixed[L] and
+ * name_dual_fixed[L], from name_body() (called with input_d NULL for the
+ * single filter). PYWT_UPSAMPLING_KERNELS adds the generic name() and
+ * name_dual(). */
+#define PYWT_FIXED_UPSAMPLING_KERNELS(type, name, target) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 1) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 2) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 3) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 4) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 5) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 6) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 7) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 8) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 9) \
+    PYWT_FIXED_UPSAMPLING_KERNEL(type, name, target, 10) \
+    static const type##_upsampling_kernel name##_fixed[PYWT_FIXED_UPSAMPLING_MAX + 1] = { \
+        NULL, name##_l1, name##_l2, name##_l3, name##_l4, name##_l5, \
+        name##_l6, name##_l7, name##_l8, name##_l9, name##_l10}; \
+    static const type##_upsampling_kernel_dual name##_dual_fixed[PYWT_FIXED_UPSAMPLING_MAX + 1] = { \
+        NULL, name##_dual_l1, name##_dual_l2, name##_dual_l3, name##_dual_l4, name##_dual_l5, \
+        name##_dual_l6, name##_dual_l7, name##_dual_l8, name##_dual_l9, name##_dual_l10};
+
+#define PYWT_UPSAMPLING_KERNELS(type, name, target) \
+    target static size_t name(const type * input, const type * polyphase, size_t L, \
+                              type * output, size_t i, size_t n) \
+    { \
+        return name##_body(input, NULL, polyphase, NULL, L, output, i, n); \
+    } \
+    target static size_t name##_dual(const type * input_a, const type * input_d, \
+                                     const type * polyphase_a, const type * polyphase_d, \
+                                     size_t L, type * output, size_t i, size_t n) \
+    { \
+        return name##_body(input_a, input_d, polyphase_a, polyphase_d, L, output, i, n); \
+    } \
+    PYWT_FIXED_UPSAMPLING_KERNELS(type, name, target)
+
+#define PYWT_UPSAMPLING_FIXED_INDEX(L) ((L) >= 1 && (L) <= PYWT_FIXED_UPSAMPLING_MAX)
+#define PYWT_SELECT_UPSAMPLING(name, L) \
+    (PYWT_UPSAMPLING_FIXED_INDEX(L) ? name##_fixed[L] : name)
+
+/* Body of the upsampling kernels for vectors V of W elements, given the
+ * intrinsics of the instruction set: madd(x, f, acc) returns acc + x*f and
+ * store_pairs(output, even, odd, add) interleaves W even and odd outputs
+ * into output (adding them to it if add). 2*W inputs are processed per
+ * iteration to hide latency. */
+#define PYWT_UPSAMPLING_BODY(type, V, W, zero, set1, loadu, madd, add, store_pairs) \
+    { \
+        const int single = (input_d == NULL); \
+        size_t k = 0; \
+        for (; k + 2*W <= n; k += 2*W) { \
+            const type * const xa = input_a + i + k; \
+            V e0 = zero(), e1 = zero(), o0 = zero(), o1 = zero(); \
+            size_t j; \
+            for (j = 0; j < L; ++j) { \
+                const V fe = set1(polyphase_a[j]), fo = set1(polyphase_a[L + j]); \
+                const V x0 = loadu(xa - j), x1 = loadu(xa - j + W); \
+                e0 = madd(x0, fe, e0); \
+                e1 = madd(x1, fe, e1); \
+                o0 = madd(x0, fo, o0); \
+                o1 = madd(x1, fo, o1); \
+            } \
+            if (!single) { \
+                const type * const xd = input_d + i + k; \
+                V ed0 = zero(), ed1 = zero(), od0 = zero(), od1 = zero(); \
+                for (j = 0; j < L; ++j) { \
+                    const V fe = set1(polyphase_d[j]), fo = set1(polyphase_d[L + j]); \
+                    const V x0 = loadu(xd - j), x1 = loadu(xd - j + W); \
+                    ed0 = madd(x0, fe, ed0); \
+                    ed1 = madd(x1, fe, ed1); \
+                    od0 = madd(x0, fo, od0); \
+                    od1 = madd(x1, fo, od1); \
+                } \
+                e0 = add(e0, ed0); \
+                e1 = add(e1, ed1); \
+                o0 = add(o0, od0); \
+                o1 = add(o1, od1); \
+            } \
+            store_pairs(output + 2*k, e0, o0, single); \
+            store_pairs(output + 2*k + 2*W, e1, o1, single); \
+        } \
+        return k; \
+    }
+
+#if PYWT_HAVE_SIMD
+
+#include <immintrin.h>
+
+/* ##### SSE2 ##### */
+
+PYWT_TARGET("sse2")
+static __m128d double_even_sse2(const double * x)
+{
+    return _mm_unpacklo_pd(_mm_loadu_pd(x), _mm_loadu_pd(x + 2));
+}
+
+PYWT_TARGET("sse2")
+PYWT_INLINE size_t double_downsampling_kernel_sse2_body(const double * input, size_t N,
+                                                        const double * filter, size_t F,
+                                                        double * output, size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 4 <= n && i + 2*o + 7 < N; o += 4) {
+        const double * const x = input + i + 2*o;
+        __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m128d f = _mm_set1_pd(filter[j]);
+            acc0 = _mm_add_pd(acc0, _mm_mul_pd(double_even_sse2(x - j), f));
+            acc1 = _mm_add_pd(acc1, _mm_mul_pd(double_even_sse2(x - j + 4), f));
+        }
+        _mm_storeu_pd(output + o, acc0);
+        _mm_storeu_pd(output + o + 2, acc1);
+    }
+    return o;
+}
+
+PYWT_KERNELS(double, double_downsampling_kernel_sse2, PYWT_TARGET("sse2"))
+
+PYWT_TARGET("sse2")
+PYWT_INLINE size_t double_downsampling_kernel_dual_sse2_body(const double * input, size_t N,
+                                                             const double * filter_a, const double * filter_d,
+                                                             size_t F, double * output_a, double * output_d,
+                                                             size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 4 <= n && i + 2*o + 7 < N; o += 4) {
+        const double * const x = input + i + 2*o;
+        __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+        __m128d d0 = _mm_setzero_pd(), d1 = _mm_setzero_pd();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m128d fa = _mm_set1_pd(filter_a[j]);
+            const __m128d fd = _mm_set1_pd(filter_d[j]);
+            const __m128d x0 = double_even_sse2(x - j);
+            const __m128d x1 = double_even_sse2(x - j + 4);
+            a0 = _mm_add_pd(a0, _mm_mul_pd(x0, fa));
+            a1 = _mm_add_pd(a1, _mm_mul_pd(x1, fa));
+            d0 = _mm_add_pd(d0, _mm_mul_pd(x0, fd));
+            d1 = _mm_add_pd(d1, _mm_mul_pd(x1, fd));
+        }
+        _mm_storeu_pd(output_a + o, a0);
+        _mm_storeu_pd(output_a + o + 2, a1);
+        _mm_storeu_pd(output_d + o, d0);
+        _mm_storeu_pd(output_d + o + 2, d1);
+    }
+    return o;
+}
+
+PYWT_DUAL_KERNELS(double, double_downsampling_kernel_dual_sse2, PYWT_TARGET("sse2"))
+
+PYWT_TARGET("sse2")
+static __m128 float_even_sse2(const float * x)
+{
+    return _mm_shuffle_ps(_mm_loadu_ps(x), _mm_loadu_ps(x + 4), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+PYWT_TARGET("sse2")
+PYWT_INLINE size_t float_downsampling_kernel_sse2_body(const float * input, size_t N,
+                                                       const float * filter, size_t F,
+                                                       float * output, size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 8 <= n && i + 2*o + 15 < N; o += 8) {
+        const float * const x = input + i + 2*o;
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m128 f = _mm_set1_ps(filter[j]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(float_even_sse2(x - j), f));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(float_even_sse2(x - j + 8), f));
+        }
+        _mm_storeu_ps(output + o, acc0);
+        _mm_storeu_ps(output + o + 4, acc1);
+    }
+    return o;
+}
+
+PYWT_KERNELS(float, float_downsampling_kernel_sse2, PYWT_TARGET("sse2"))
+
+PYWT_TARGET("sse2")
+PYWT_INLINE size_t float_downsampling_kernel_dual_sse2_body(const float * input, size_t N,
+                                                            const float * filter_a, const float * filter_d,
+                                                            size_t F, float * output_a, float * output_d,
+                                                            size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 8 <= n && i + 2*o + 15 < N; o += 8) {
+        const float * const x = input + i + 2*o;
+        __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+        __m128 d0 = _mm_setzero_ps(), d1 = _mm_setzero_ps();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m128 fa = _mm_set1_ps(filter_a[j]);
+            const __m128 fd = _mm_set1_ps(filter_d[j]);
+            const __m128 x0 = float_even_sse2(x - j);
+            const __m128 x1 = float_even_sse2(x - j + 8);
+            a0 = _mm_add_ps(a0, _mm_mul_ps(x0, fa));
+            a1 = _mm_add_ps(a1, _mm_mul_ps(x1, fa));
+            d0 = _mm_add_ps(d0, _mm_mul_ps(x0, fd));
+            d1 = _mm_add_ps(d1, _mm_mul_ps(x1, fd));
+        }
+        _mm_storeu_ps(output_a + o, a0);
+        _mm_storeu_ps(output_a + o + 4, a1);
+        _mm_storeu_ps(output_d + o, d0);
+        _mm_storeu_ps(output_d + o + 4, d1);
+    }
+    return o;
+}
+
+PYWT_DUAL_KERNELS(float, float_downsampling_kernel_dual_sse2, PYWT_TARGET("sse2"))
+
+PYWT_TARGET("sse2")
+static size_t double_rows_kernel_sse2(const double * const * rows, const double * weights,
+                                       size_t K, double * output, size_t n)
+{
+    size_t l = 0;
+
+    for (; l + 4 <= n; l += 4) {
+        __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+        size_t k;
+        for (k = 0; k < K; ++k) {
+            const __m128d w = _mm_set1_pd(weights[k]);
+            acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(rows[k] + l), w));
+            acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(rows[k] + l + 2), w));
+        }
+        _mm_storeu_pd(output + l, acc0);
+        _mm_storeu_pd(output + l + 2, acc1);
+    }
+    return l;
+}
+
+PYWT_TARGET("sse2")
+static size_t float_rows_kernel_sse2(const float * const * rows, const float * weights,
+                                      size_t K, float * output, size_t n)
+{
+    size_t l = 0;
+
+    for (; l + 8 <= n; l += 8) {
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+        size_t k;
+        for (k = 0; k < K; ++k) {
+            const __m128 w = _mm_set1_ps(weights[k]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(rows[k] + l), w));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(rows[k] + l + 4), w));
+        }
+        _mm_storeu_ps(output + l, acc0);
+        _mm_storeu_ps(output + l + 4, acc1);
+    }
+    return l;
+}
+
+PYWT_TARGET("sse2")
+static size_t double_haar_dec_kernel_sse2(const double * input, const double * filter_a,
+                                          const double * filter_d, double * output_a,
+                                          double * output_d, size_t n)
+{
+    const __m128d fa0 = _mm_set1_pd(filter_a[0]), fa1 = _mm_set1_pd(filter_a[1]);
+    const __m128d fd0 = (output_d != NULL) ? _mm_set1_pd(filter_d[0]) : _mm_setzero_pd();
+    const __m128d fd1 = (output_d != NULL) ? _mm_set1_pd(filter_d[1]) : _mm_setzero_pd();
+    size_t o = 0;
+
+    for (; o + 2 <= n; o += 2) {
+        const __m128d x0 = _mm_loadu_pd(input + 2*o), x1 = _mm_loadu_pd(input + 2*o + 2);
+        const __m128d even = _mm_unpacklo_pd(x0, x1), odd = _mm_unpackhi_pd(x0, x1);
+        _mm_storeu_pd(output_a + o, _mm_add_pd(_mm_mul_pd(odd, fa0), _mm_mul_pd(even, fa1)));
+        if (output_d != NULL)
+            _mm_storeu_pd(output_d + o, _mm_add_pd(_mm_mul_pd(odd, fd0), _mm_mul_pd(even, fd1)));
+    }
+    return o;
+}
+
+PYWT_TARGET("sse2")
+static size_t double_haar_rec_kernel_sse2(const double * input_a, const double * input_d,
+                                          const double * filter_a, const double * filter_d,
+                                          double * output, size_t n)
+{
+    const __m128d fa0 = _mm_set1_pd(filter_a[0]), fa1 = _mm_set1_pd(filter_a[1]);
+    const __m128d fd0 = _mm_set1_pd(filter_d[0]), fd1 = _mm_set1_pd(filter_d[1]);
+    size_t o = 0;
+
+    for (; o + 2 <= n; o += 2) {
+        const __m128d a = _mm_loadu_pd(input_a + o), d = _mm_loadu_pd(input_d + o);
+        const __m128d even = _mm_add_pd(_mm_mul_pd(a, fa0), _mm_mul_pd(d, fd0));
+        const __m128d odd = _mm_add_pd(_mm_mul_pd(a, fa1), _mm_mul_pd(d, fd1));
+        _mm_storeu_pd(output + 2*o, _mm_unpacklo_pd(even, odd));
+        _mm_storeu_pd(output + 2*o + 2, _mm_unpackhi_pd(even, odd));
+    }
+    return o;
+}
+
+PYWT_TARGET("sse2")
+static size_t float_haar_dec_kernel_sse2(const float * input, const float * filter_a,
+                                         const float * filter_d, float * output_a,
+                                         float * output_d, size_t n)
+{
+    const __m128 fa0 = _mm_set1_ps(filter_a[0]), fa1 = _mm_set1_ps(filter_a[1]);
+    const __m128 fd0 = (output_d != NULL) ? _mm_set1_ps(filter_d[0]) : _mm_setzero_ps();
+    const __m128 fd1 = (output_d != NULL) ? _mm_set1_ps(filter_d[1]) : _mm_setzero_ps();
+    size_t o = 0;
+
+    for (; o + 4 <= n; o += 4) {
+        const __m128 x0 = _mm_loadu_ps(input + 2*o), x1 = _mm_loadu_ps(input + 2*o + 4);
+        const __m128 even = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 odd = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(output_a + o, _mm_add_ps(_mm_mul_ps(odd, fa0), _mm_mul_ps(even, fa1)));
+        if (output_d != NULL)
+            _mm_storeu_ps(output_d + o, _mm_add_ps(_mm_mul_ps(odd, fd0), _mm_mul_ps(even, fd1)));
+    }
+    return o;
+}
+
+PYWT_TARGET("sse2")
+static size_t float_haar_rec_kernel_sse2(const float * input_a, const float * input_d,
+                                         const float * filter_a, const float * filter_d,
+                                         float * output, size_t n)
+{
+    const __m128 fa0 = _mm_set1_ps(filter_a[0]), fa1 = _mm_set1_ps(filter_a[1]);
+    const __m128 fd0 = _mm_set1_ps(filter_d[0]), fd1 = _mm_set1_ps(filter_d[1]);
+    size_t o = 0;
+
+    for (; o + 4 <= n; o += 4) {
+        const __m128 a = _mm_loadu_ps(input_a + o), d = _mm_loadu_ps(input_d + o);
+        const __m128 even = _mm_add_ps(_mm_mul_ps(a, fa0), _mm_mul_ps(d, fd0));
+        const __m128 odd = _mm_add_ps(_mm_mul_ps(a, fa1), _mm_mul_ps(d, fd1));
+        _mm_storeu_ps(output + 2*o, _mm_unpacklo_ps(even, odd));
+        _mm_storeu_ps(output + 2*o + 4, _mm_unpackhi_ps(even, odd));
+    }
+    return o;
+}
+
+PYWT_TARGET("sse2")
+static void double_store_pairs_sse2(double * output, __m128d even, __m128d odd, int add)
+{
+    __m128d lo = _mm_unpacklo_pd(even, odd), hi = _mm_unpackhi_pd(even, odd);
+    if (add) {
+        lo = _mm_add_pd(_mm_loadu_pd(output), lo);
+        hi = _mm_add_pd(_mm_loadu_pd(output + 2), hi);
+    }
+    _mm_storeu_pd(output, lo);
+    _mm_storeu_pd(output + 2, hi);
+}
+
+#define DOUBLE_MADD_SSE2(x, f, acc) _mm_add_pd(acc, _mm_mul_pd(x, f))
+
+PYWT_TARGET("sse2")
+PYWT_INLINE size_t double_upsampling_kernel_sse2_body(const double * input_a, const double * input_d,
+                                                      const double * polyphase_a, const double * polyphase_d,
+                                                      size_t L, double * output, size_t i, size_t n)
+{
+    PYWT_UPSAMPLING_BODY(double, __m128d, 2, _mm_setzero_pd, _mm_set1_pd, _mm_loadu_pd, DOUBLE_MADD_SSE2,
+                         _mm_add_pd, double_store_pairs_sse2)
+}
+
+#undef DOUBLE_MADD_SSE2
+
+PYWT_UPSAMPLING_KERNELS(double, double_upsampling_kernel_sse2, PYWT_TARGET("sse2"))
+
+PYWT_TARGET("sse2")
+static void float_store_pairs_sse2(float * output, __m128 even, __m128 odd, int add)
+{
+    __m128 lo = _mm_unpacklo_ps(even, odd), hi = _mm_unpackhi_ps(even, odd);
+    if (add) {
+        lo = _mm_add_ps(_mm_loadu_ps(output), lo);
+        hi = _mm_add_ps(_mm_loadu_ps(output + 4), hi);
+    }
+    _mm_storeu_ps(output, lo);
+    _mm_storeu_ps(output + 4, hi);
+}
+
+#define FLOAT_MADD_SSE2(x, f, acc) _mm_add_ps(acc, _mm_mul_ps(x, f))
+
+PYWT_TARGET("sse2")
+PYWT_INLINE size_t float_upsampling_kernel_sse2_body(const float * input_a, const float * input_d,
+                                                     const float * polyphase_a, const float * polyphase_d,
+                                                     size_t L, float * output, size_t i, size_t n)
+{
+    PYWT_UPSAMPLING_BODY(float, __m128, 4, _mm_setzero_ps, _mm_set1_ps, _mm_loadu_ps, FLOAT_MADD_SSE2,
+                         _mm_add_ps, float_store_pairs_sse2)
+}
+
+#undef FLOAT_MADD_SSE2
+
+PYWT_UPSAMPLING_KERNELS(float, float_upsampling_kernel_sse2, PYWT_TARGET("sse2"))
+
+/* ##### AVX2 + FMA ##### */
+
+PYWT_TARGET("avx2,fma")
+static __m256d double_even_avx2(const double * x)
+{
+    /* [x0 x4 x2 x6] -> [x0 x2 x4 x6] */
+    const __m256d e = _mm256_unpacklo_pd(_mm256_loadu_pd(x), _mm256_loadu_pd(x + 4));
+    return _mm256_permute4x64_pd(e, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+PYWT_TARGET("avx2,fma")
+PYWT_INLINE size_t double_downsampling_kernel_avx2_body(const double * input, size_t N,
+                                                        const double * filter, size_t F,
+                                                        double * output, size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 8 <= n && i + 2*o + 15 < N; o += 8) {
+        const double * const x = input + i + 2*o;
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m256d f = _mm256_set1_pd(filter[j]);
+            acc0 = _mm256_fmadd_pd(double_even_avx2(x - j), f, acc0);
+            acc1 = _mm256_fmadd_pd(double_even_avx2(x - j + 8), f, acc1);
+        }
+        _mm256_storeu_pd(output + o, acc0);
+        _mm256_storeu_pd(output + o + 4, acc1);
+    }
+    return o;
+}
+
+PYWT_KERNELS(double, double_downsampling_kernel_avx2, PYWT_TARGET("avx2,fma"))
+
+PYWT_TARGET("avx2,fma")
+PYWT_INLINE size_t double_downsampling_kernel_dual_avx2_body(const double * input, size_t N,
+                                                             const double * filter_a, const double * filter_d,
+                                                             size_t F, double * output_a, double * output_d,
+                                                             size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 8 <= n && i + 2*o + 15 < N; o += 8) {
+        const double * const x = input + i + 2*o;
+        __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+        __m256d d0 = _mm256_setzero_pd(), d1 = _mm256_setzero_pd();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m256d fa = _mm256_set1_pd(filter_a[j]);
+            const __m256d fd = _mm256_set1_pd(filter_d[j]);
+            const __m256d x0 = double_even_avx2(x - j);
+            const __m256d x1 = double_even_avx2(x - j + 8);
+            a0 = _mm256_fmadd_pd(x0, fa, a0);
+            a1 = _mm256_fmadd_pd(x1, fa, a1);
+            d0 = _mm256_fmadd_pd(x0, fd, d0);
+            d1 = _mm256_fmadd_pd(x1, fd, d1);
+        }
+        _mm256_storeu_pd(output_a + o, a0);
+        _mm256_storeu_pd(output_a + o + 4, a1);
+        _mm256_storeu_pd(output_d + o, d0);
+        _mm256_storeu_pd(output_d + o + 4, d1);
+    }
+    return o;
+}
+
+PYWT_DUAL_KERNELS(double, double_downsampling_kernel_dual_avx2, PYWT_TARGET("avx2,fma"))
+
+PYWT_TARGET("avx2,fma")
+static __m256 float_even_avx2(const float * x)
+{
+    /* [x0 x2 x8 x10 x4 x6 x12 x14] -> [x0 x2 x4 x6 x8 x10 x12 x14] */
+    const __m256 e = _mm256_shuffle_ps(_mm256_loadu_ps(x), _mm256_loadu_ps(x + 8),
+                                       _MM_SHUFFLE(2, 0, 2, 0));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(e),
+                                                  _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+PYWT_TARGET("avx2,fma")
+PYWT_INLINE size_t float_downsampling_kernel_avx2_body(const float * input, size_t N,
+                                                       const float * filter, size_t F,
+                                                       float * output, size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 16 <= n && i + 2*o + 31 < N; o += 16) {
+        const float * const x = input + i + 2*o;
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m256 f = _mm256_set1_ps(filter[j]);
+            acc0 = _mm256_fmadd_ps(float_even_avx2(x - j), f, acc0);
+            acc1 = _mm256_fmadd_ps(float_even_avx2(x - j + 16), f, acc1);
+        }
+        _mm256_storeu_ps(output + o, acc0);
+        _mm256_storeu_ps(output + o + 8, acc1);
+    }
+    return o;
+}
+
+PYWT_KERNELS(float, float_downsampling_kernel_avx2, PYWT_TARGET("avx2,fma"))
+
+PYWT_TARGET("avx2,fma")
+PYWT_INLINE size_t float_downsampling_kernel_dual_avx2_body(const float * input, size_t N,
+                                                            const float * filter_a, const float * filter_d,
+                                                            size_t F, float * output_a, float * output_d,
+                                                            size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 16 <= n && i + 2*o + 31 < N; o += 16) {
+        const float * const x = input + i + 2*o;
+        __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+        __m256 d0 = _mm256_setzero_ps(), d1 = _mm256_setzero_ps();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m256 fa = _mm256_set1_ps(filter_a[j]);
+            const __m256 fd = _mm256_set1_ps(filter_d[j]);
+            const __m256 x0 = float_even_avx2(x - j);
+            const __m256 x1 = float_even_avx2(x - j + 16);
+            a0 = _mm256_fmadd_ps(x0, fa, a0);
+            a1 = _mm256_fmadd_ps(x1, fa, a1);
+            d0 = _mm256_fmadd_ps(x0, fd, d0);
+            d1 = _mm256_fmadd_ps(x1, fd, d1);
+        }
+        _mm256_storeu_ps(output_a + o, a0);
+        _mm256_storeu_ps(output_a + o + 8, a1);
+        _mm256_storeu_ps(output_d + o, d0);
+        _mm256_storeu_ps(output_d + o + 8, d1);
+    }
+    return o;
+}
+
+PYWT_DUAL_KERNELS(float, float_downsampling_kernel_dual_avx2, PYWT_TARGET("avx2,fma"))
+
+PYWT_TARGET("avx2,fma")
+static size_t double_rows_kernel_avx2(const double * const * rows, const double * weights,
+                                       size_t K, double * output, size_t n)
+{
+    size_t l = 0;
+
+    for (; l + 8 <= n; l += 8) {
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        size_t k;
+        for (k = 0; k < K; ++k) {
+            const __m256d w = _mm256_set1_pd(weights[k]);
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(rows[k] + l), w, acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(rows[k] + l + 4), w, acc1);
+        }
+        _mm256_storeu_pd(output + l, acc0);
+        _mm256_storeu_pd(output + l + 4, acc1);
+    }
+    return l;
+}
+
+PYWT_TARGET("avx2,fma")
+static size_t float_rows_kernel_avx2(const float * const * rows, const float * weights,
+                                      size_t K, float * output, size_t n)
+{
+    size_t l = 0;
+
+    for (; l + 16 <= n; l += 16) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        size_t k;
+        for (k = 0; k < K; ++k) {
+            const __m256 w = _mm256_set1_ps(weights[k]);
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(rows[k] + l), w, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(rows[k] + l + 8), w, acc1);
+        }
+        _mm256_storeu_ps(output + l, acc0);
+        _mm256_storeu_ps(output + l + 8, acc1);
+    }
+    return l;
+}
+
+PYWT_TARGET("avx2,fma")
+static size_t double_haar_dec_kernel_avx2(const double * input, const double * filter_a,
+                                          const double * filter_d, double * output_a,
+                                          double * output_d, size_t n)
+{
+    const __m256d fa0 = _mm256_set1_pd(filter_a[0]), fa1 = _mm256_set1_pd(filter_a[1]);
+    const __m256d fd0 = (output_d != NULL) ? _mm256_set1_pd(filter_d[0]) : _mm256_setzero_pd();
+    const __m256d fd1 = (output_d != NULL) ? _mm256_set1_pd(filter_d[1]) : _mm256_setzero_pd();
+    size_t o = 0;
+
+    for (; o + 4 <= n; o += 4) {
+        /* [x0 x4 x2 x6] and [x1 x5 x3 x7] -> outputs [0 2 1 3], reordered */
+        const __m256d x0 = _mm256_loadu_pd(input + 2*o), x1 = _mm256_loadu_pd(input + 2*o + 4);
+        const __m256d even = _mm256_unpacklo_pd(x0, x1), odd = _mm256_unpackhi_pd(x0, x1);
+        _mm256_storeu_pd(output_a + o, _mm256_permute4x64_pd(
+            _mm256_fmadd_pd(even, fa1, _mm256_mul_pd(odd, fa0)), _MM_SHUFFLE(3, 1, 2, 0)));
+        if (output_d != NULL)
+            _mm256_storeu_pd(output_d + o, _mm256_permute4x64_pd(
+                _mm256_fmadd_pd(even, fd1, _mm256_mul_pd(odd, fd0)), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx2,fma")
+static size_t double_haar_rec_kernel_avx2(const double * input_a, const double * input_d,
+                                          const double * filter_a, const double * filter_d,
+                                          double * output, size_t n)
+{
+    const __m256d fa0 = _mm256_set1_pd(filter_a[0]), fa1 = _mm256_set1_pd(filter_a[1]);
+    const __m256d fd0 = _mm256_set1_pd(filter_d[0]), fd1 = _mm256_set1_pd(filter_d[1]);
+    size_t o = 0;
+
+    for (; o + 4 <= n; o += 4) {
+        const __m256d a = _mm256_loadu_pd(input_a + o), d = _mm256_loadu_pd(input_d + o);
+        const __m256d even = _mm256_fmadd_pd(d, fd0, _mm256_mul_pd(a, fa0));
+        const __m256d odd = _mm256_fmadd_pd(d, fd1, _mm256_mul_pd(a, fa1));
+        /* [e0 o0 e2 o2] and [e1 o1 e3 o3] */
+        const __m256d lo = _mm256_unpacklo_pd(even, odd), hi = _mm256_unpackhi_pd(even, odd);
+        _mm256_storeu_pd(output + 2*o, _mm256_permute2f128_pd(lo, hi, 0x20));
+        _mm256_storeu_pd(output + 2*o + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx2,fma")
+static size_t float_haar_dec_kernel_avx2(const float * input, const float * filter_a,
+                                         const float * filter_d, float * output_a,
+                                         float * output_d, size_t n)
+{
+    const __m256 fa0 = _mm256_set1_ps(filter_a[0]), fa1 = _mm256_set1_ps(filter_a[1]);
+    const __m256 fd0 = (output_d != NULL) ? _mm256_set1_ps(filter_d[0]) : _mm256_setzero_ps();
+    const __m256 fd1 = (output_d != NULL) ? _mm256_set1_ps(filter_d[1]) : _mm256_setzero_ps();
+    size_t o = 0;
+
+    for (; o + 8 <= n; o += 8) {
+        /* outputs [0 1 4 5 2 3 6 7], reordered as pairs */
+        const __m256 x0 = _mm256_loadu_ps(input + 2*o), x1 = _mm256_loadu_ps(input + 2*o + 8);
+        const __m256 even = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 odd = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm256_storeu_ps(output_a + o, _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_fmadd_ps(even, fa1, _mm256_mul_ps(odd, fa0))),
+            _MM_SHUFFLE(3, 1, 2, 0))));
+        if (output_d != NULL)
+            _mm256_storeu_ps(output_d + o, _mm256_castpd_ps(_mm256_permute4x64_pd(
+                _mm256_castps_pd(_mm256_fmadd_ps(even, fd1, _mm256_mul_ps(odd, fd0))),
+                _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx2,fma")
+static size_t float_haar_rec_kernel_avx2(const float * input_a, const float * input_d,
+                                         const float * filter_a, const float * filter_d,
+                                         float * output, size_t n)
+{
+    const __m256 fa0 = _mm256_set1_ps(filter_a[0]), fa1 = _mm256_set1_ps(filter_a[1]);
+    const __m256 fd0 = _mm256_set1_ps(filter_d[0]), fd1 = _mm256_set1_ps(filter_d[1]);
+    size_t o = 0;
+
+    for (; o + 8 <= n; o += 8) {
+        const __m256 a = _mm256_loadu_ps(input_a + o), d = _mm256_loadu_ps(input_d + o);
+        const __m256 even = _mm256_fmadd_ps(d, fd0, _mm256_mul_ps(a, fa0));
+        const __m256 odd = _mm256_fmadd_ps(d, fd1, _mm256_mul_ps(a, fa1));
+        /* [e0 o0 e1 o1 e4 o4 e5 o5] and [e2 o2 e3 o3 e6 o6 e7 o7] */
+        const __m256 lo = _mm256_unpacklo_ps(even, odd), hi = _mm256_unpackhi_ps(even, odd);
+        _mm256_storeu_ps(output + 2*o, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(output + 2*o + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx2,fma")
+static void double_store_pairs_avx2(double * output, __m256d even, __m256d odd, int add)
+{
+    /* [e0 o0 e2 o2] and [e1 o1 e3 o3] */
+    const __m256d lo = _mm256_unpacklo_pd(even, odd), hi = _mm256_unpackhi_pd(even, odd);
+    __m256d first = _mm256_permute2f128_pd(lo, hi, 0x20);
+    __m256d second = _mm256_permute2f128_pd(lo, hi, 0x31);
+    if (add) {
+        first = _mm256_add_pd(_mm256_loadu_pd(output), first);
+        second = _mm256_add_pd(_mm256_loadu_pd(output + 4), second);
+    }
+    _mm256_storeu_pd(output, first);
+    _mm256_storeu_pd(output + 4, second);
+}
+
+#define DOUBLE_MADD_AVX2(x, f, acc) _mm256_fmadd_pd(x, f, acc)
+
+PYWT_TARGET("avx2,fma")
+PYWT_INLINE size_t double_upsampling_kernel_avx2_body(const double * input_a, const double * input_d,
+                                                      const double * polyphase_a, const double * polyphase_d,
+                                                      size_t L, double * output, size_t i, size_t n)
+{
+    PYWT_UPSAMPLING_BODY(double, __m256d, 4, _mm256_setzero_pd, _mm256_set1_pd, _mm256_loadu_pd, DOUBLE_MADD_AVX2,
+                         _mm256_add_pd, double_store_pairs_avx2)
+}
+
+#undef DOUBLE_MADD_AVX2
+
+PYWT_UPSAMPLING_KERNELS(double, double_upsampling_kernel_avx2, PYWT_TARGET("avx2,fma"))
+
+PYWT_TARGET("avx2,fma")
+static void float_store_pairs_avx2(float * output, __m256 even, __m256 odd, int add)
+{
+    /* [e0 o0 e1 o1 e4 o4 e5 o5] and [e2 o2 e3 o3 e6 o6 e7 o7] */
+    const __m256 lo = _mm256_unpacklo_ps(even, odd), hi = _mm256_unpackhi_ps(even, odd);
+    __m256 first = _mm256_permute2f128_ps(lo, hi, 0x20);
+    __m256 second = _mm256_permute2f128_ps(lo, hi, 0x31);
+    if (add) {
+        first = _mm256_add_ps(_mm256_loadu_ps(output), first);
+        second = _mm256_add_ps(_mm256_loadu_ps(output + 8), second);
+    }
+    _mm256_storeu_ps(output, first);
+    _mm256_storeu_ps(output + 8, second);
+}
+
+#define FLOAT_MADD_AVX2(x, f, acc) _mm256_fmadd_ps(x, f, acc)
+
+PYWT_TARGET("avx2,fma")
+PYWT_INLINE size_t float_upsampling_kernel_avx2_body(const float * input_a, const float * input_d,
+                                                     const float * polyphase_a, const float * polyphase_d,
+                                                     size_t L, float * output, size_t i, size_t n)
+{
+    PYWT_UPSAMPLING_BODY(float, __m256, 8, _mm256_setzero_ps, _mm256_set1_ps, _mm256_loadu_ps, FLOAT_MADD_AVX2,
+                         _mm256_add_ps, float_store_pairs_avx2)
+}
+
+#undef FLOAT_MADD_AVX2
+
+PYWT_UPSAMPLING_KERNELS(float, float_upsampling_kernel_avx2, PYWT_TARGET("avx2,fma"))
+
+/* ##### AVX-512 ##### */
+
+PYWT_TARGET("avx512f")
+static __m512d double_even_avx512(const double * x)
+{
+    const __m512i even = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    return _mm512_permutex2var_pd(_mm512_loadu_pd(x), even, _mm512_loadu_pd(x + 8));
+}
+
+PYWT_TARGET("avx512f")
+PYWT_INLINE size_t double_downsampling_kernel_avx512_body(const double * input, size_t N,
+                                                          const double * filter, size_t F,
+                                                          double * output, size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 16 <= n && i + 2*o + 31 < N; o += 16) {
+        const double * const x = input + i + 2*o;
+        __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m512d f = _mm512_set1_pd(filter[j]);
+            acc0 = _mm512_fmadd_pd(double_even_avx512(x - j), f, acc0);
+            acc1 = _mm512_fmadd_pd(double_even_avx512(x - j + 16), f, acc1);
+        }
+        _mm512_storeu_pd(output + o, acc0);
+        _mm512_storeu_pd(output + o + 8, acc1);
+    }
+    return o;
+}
+
+PYWT_KERNELS(double, double_downsampling_kernel_avx512, PYWT_TARGET("avx512f"))
+
+PYWT_TARGET("avx512f")
+PYWT_INLINE size_t double_downsampling_kernel_dual_avx512_body(const double * input, size_t N,
+                                                               const double * filter_a, const double * filter_d,
+                                                               size_t F, double * output_a, double * output_d,
+                                                               size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 16 <= n && i + 2*o + 31 < N; o += 16) {
+        const double * const x = input + i + 2*o;
+        __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd();
+        __m512d d0 = _mm512_setzero_pd(), d1 = _mm512_setzero_pd();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m512d fa = _mm512_set1_pd(filter_a[j]);
+            const __m512d fd = _mm512_set1_pd(filter_d[j]);
+            const __m512d x0 = double_even_avx512(x - j);
+            const __m512d x1 = double_even_avx512(x - j + 16);
+            a0 = _mm512_fmadd_pd(x0, fa, a0);
+            a1 = _mm512_fmadd_pd(x1, fa, a1);
+            d0 = _mm512_fmadd_pd(x0, fd, d0);
+            d1 = _mm512_fmadd_pd(x1, fd, d1);
+        }
+        _mm512_storeu_pd(output_a + o, a0);
+        _mm512_storeu_pd(output_a + o + 8, a1);
+        _mm512_storeu_pd(output_d + o, d0);
+        _mm512_storeu_pd(output_d + o + 8, d1);
+    }
+    return o;
+}
+
+PYWT_DUAL_KERNELS(double, double_downsampling_kernel_dual_avx512, PYWT_TARGET("avx512f"))
+
+PYWT_TARGET("avx512f")
+static __m512 float_even_avx512(const float * x)
+{
+    const __m512i even = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16,
+                                          14, 12, 10, 8, 6, 4, 2, 0);
+    return _mm512_permutex2var_ps(_mm512_loadu_ps(x), even, _mm512_loadu_ps(x + 16));
+}
+
+PYWT_TARGET("avx512f")
+PYWT_INLINE size_t float_downsampling_kernel_avx512_body(const float * input, size_t N,
+                                                         const float * filter, size_t F,
+                                                         float * output, size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 32 <= n && i + 2*o + 63 < N; o += 32) {
+        const float * const x = input + i + 2*o;
+        __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m512 f = _mm512_set1_ps(filter[j]);
+            acc0 = _mm512_fmadd_ps(float_even_avx512(x - j), f, acc0);
+            acc1 = _mm512_fmadd_ps(float_even_avx512(x - j + 32), f, acc1);
+        }
+        _mm512_storeu_ps(output + o, acc0);
+        _mm512_storeu_ps(output + o + 16, acc1);
+    }
+    return o;
+}
+
+PYWT_KERNELS(float, float_downsampling_kernel_avx512, PYWT_TARGET("avx512f"))
+
+PYWT_TARGET("avx512f")
+PYWT_INLINE size_t float_downsampling_kernel_dual_avx512_body(const float * input, size_t N,
+                                                              const float * filter_a, const float * filter_d,
+                                                              size_t F, float * output_a, float * output_d,
+                                                              size_t i, size_t n)
+{
+    size_t o = 0;
+
+    for (; o + 32 <= n && i + 2*o + 63 < N; o += 32) {
+        const float * const x = input + i + 2*o;
+        __m512 a0 = _mm512_setzero_ps(), a1 = _mm512_setzero_ps();
+        __m512 d0 = _mm512_setzero_ps(), d1 = _mm512_setzero_ps();
+        size_t j;
+        for (j = 0; j < F; ++j) {
+            const __m512 fa = _mm512_set1_ps(filter_a[j]);
+            const __m512 fd = _mm512_set1_ps(filter_d[j]);
+            const __m512 x0 = float_even_avx512(x - j);
+            const __m512 x1 = float_even_avx512(x - j + 32);
+            a0 = _mm512_fmadd_ps(x0, fa, a0);
+            a1 = _mm512_fmadd_ps(x1, fa, a1);
+            d0 = _mm512_fmadd_ps(x0, fd, d0);
+            d1 = _mm512_fmadd_ps(x1, fd, d1);
+        }
+        _mm512_storeu_ps(output_a + o, a0);
+        _mm512_storeu_ps(output_a + o + 16, a1);
+        _mm512_storeu_ps(output_d + o, d0);
+        _mm512_storeu_ps(output_d + o + 16, d1);
+    }
+    return o;
+}
+
+PYWT_DUAL_KERNELS(float, float_downsampling_kernel_dual_avx512, PYWT_TARGET("avx512f"))
+
+PYWT_TARGET("avx512f")
+static size_t double_rows_kernel_avx512(const double * const * rows, const double * weights,
+                                         size_t K, double * output, size_t n)
+{
+    size_t l = 0;
+
+    for (; l + 16 <= n; l += 16) {
+        __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+        size_t k;
+        for (k = 0; k < K; ++k) {
+            const __m512d w = _mm512_set1_pd(weights[k]);
+            acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(rows[k] + l), w, acc0);
+            acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(rows[k] + l + 8), w, acc1);
+        }
+        _mm512_storeu_pd(output + l, acc0);
+        _mm512_storeu_pd(output + l + 8, acc1);
+    }
+    return l;
+}
+
+PYWT_TARGET("avx512f")
+static size_t float_rows_kernel_avx512(const float * const * rows, const float * weights,
+                                        size_t K, float * output, size_t n)
+{
+    size_t l = 0;
+
+    for (; l + 32 <= n; l += 32) {
+        __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+        size_t k;
+        for (k = 0; k < K; ++k) {
+            const __m512 w = _mm512_set1_ps(weights[k]);
+            acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(rows[k] + l), w, acc0);
+            acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(rows[k] + l + 16), w, acc1);
+        }
+        _mm512_storeu_ps(output + l, acc0);
+        _mm512_storeu_ps(output + l + 16, acc1);
+    }
+    return l;
+}
+
+PYWT_TARGET("avx512f")
+static size_t double_haar_dec_kernel_avx512(const double * input, const double * filter_a,
+                                            const double * filter_d, double * output_a,
+                                            double * output_d, size_t n)
+{
+    const __m512i odd_index = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+    const __m512d fa0 = _mm512_set1_pd(filter_a[0]), fa1 = _mm512_set1_pd(filter_a[1]);
+    const __m512d fd0 = (output_d != NULL) ? _mm512_set1_pd(filter_d[0]) : _mm512_setzero_pd();
+    const __m512d fd1 = (output_d != NULL) ? _mm512_set1_pd(filter_d[1]) : _mm512_setzero_pd();
+    size_t o = 0;
+
+    for (; o + 8 <= n; o += 8) {
+        const __m512d even = double_even_avx512(input + 2*o);
+        const __m512d odd = _mm512_permutex2var_pd(_mm512_loadu_pd(input + 2*o), odd_index,
+                                                   _mm512_loadu_pd(input + 2*o + 8));
+        _mm512_storeu_pd(output_a + o, _mm512_fmadd_pd(even, fa1, _mm512_mul_pd(odd, fa0)));
+        if (output_d != NULL)
+            _mm512_storeu_pd(output_d + o, _mm512_fmadd_pd(even, fd1, _mm512_mul_pd(odd, fd0)));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx512f")
+static size_t double_haar_rec_kernel_avx512(const double * input_a, const double * input_d,
+                                            const double * filter_a, const double * filter_d,
+                                            double * output, size_t n)
+{
+    const __m512i lo_index = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+    const __m512i hi_index = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+    const __m512d fa0 = _mm512_set1_pd(filter_a[0]), fa1 = _mm512_set1_pd(filter_a[1]);
+    const __m512d fd0 = _mm512_set1_pd(filter_d[0]), fd1 = _mm512_set1_pd(filter_d[1]);
+    size_t o = 0;
+
+    for (; o + 8 <= n; o += 8) {
+        const __m512d a = _mm512_loadu_pd(input_a + o), d = _mm512_loadu_pd(input_d + o);
+        const __m512d even = _mm512_fmadd_pd(d, fd0, _mm512_mul_pd(a, fa0));
+        const __m512d odd = _mm512_fmadd_pd(d, fd1, _mm512_mul_pd(a, fa1));
+        _mm512_storeu_pd(output + 2*o, _mm512_permutex2var_pd(even, lo_index, odd));
+        _mm512_storeu_pd(output + 2*o + 8, _mm512_permutex2var_pd(even, hi_index, odd));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx512f")
+static size_t float_haar_dec_kernel_avx512(const float * input, const float * filter_a,
+                                           const float * filter_d, float * output_a,
+                                           float * output_d, size_t n)
+{
+    const __m512i odd_index = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17,
+                                               15, 13, 11, 9, 7, 5, 3, 1);
+    const __m512 fa0 = _mm512_set1_ps(filter_a[0]), fa1 = _mm512_set1_ps(filter_a[1]);
+    const __m512 fd0 = (output_d != NULL) ? _mm512_set1_ps(filter_d[0]) : _mm512_setzero_ps();
+    const __m512 fd1 = (output_d != NULL) ? _mm512_set1_ps(filter_d[1]) : _mm512_setzero_ps();
+    size_t o = 0;
+
+    for (; o + 16 <= n; o += 16) {
+        const __m512 even = float_even_avx512(input + 2*o);
+        const __m512 odd = _mm512_permutex2var_ps(_mm512_loadu_ps(input + 2*o), odd_index,
+                                                  _mm512_loadu_ps(input + 2*o + 16));
+        _mm512_storeu_ps(output_a + o, _mm512_fmadd_ps(even, fa1, _mm512_mul_ps(odd, fa0)));
+        if (output_d != NULL)
+            _mm512_storeu_ps(output_d + o, _mm512_fmadd_ps(even, fd1, _mm512_mul_ps(odd, fd0)));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx512f")
+static size_t float_haar_rec_kernel_avx512(const float * input_a, const float * input_d,
+                                           const float * filter_a, const float * filter_d,
+                                           float * output, size_t n)
+{
+    const __m512i lo_index = _mm512_set_epi32(23, 7, 22, 6, 21, 5, 20, 4,
+                                              19, 3, 18, 2, 17, 1, 16, 0);
+    const __m512i hi_index = _mm512_set_epi32(31, 15, 30, 14, 29, 13, 28, 12,
+                                              27, 11, 26, 10, 25, 9, 24, 8);
+    const __m512 fa0 = _mm512_set1_ps(filter_a[0]), fa1 = _mm512_set1_ps(filter_a[1]);
+    const __m512 fd0 = _mm512_set1_ps(filter_d[0]), fd1 = _mm512_set1_ps(filter_d[1]);
+    size_t o = 0;
+
+    for (; o + 16 <= n; o += 16) {
+        const __m512 a = _mm512_loadu_ps(input_a + o), d = _mm512_loadu_ps(input_d + o);
+        const __m512 even = _mm512_fmadd_ps(d, fd0, _mm512_mul_ps(a, fa0));
+        const __m512 odd = _mm512_fmadd_ps(d, fd1, _mm512_mul_ps(a, fa1));
+        _mm512_storeu_ps(output + 2*o, _mm512_permutex2var_ps(even, lo_index, odd));
+        _mm512_storeu_ps(output + 2*o + 16, _mm512_permutex2var_ps(even, hi_index, odd));
+    }
+    return o;
+}
+
+PYWT_TARGET("avx512f")
+static void double_store_pairs_avx512(double * output, __m512d even, __m512d odd, int add)
+{
+    const __m512i lo_index = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+    const __m512i hi_index = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+    __m512d first = _mm512_permutex2var_pd(even, lo_index, odd);
+    __m512d second = _mm512_permutex2var_pd(even, hi_index, odd);
+    if (add) {
+        first = _mm512_add_pd(_mm512_loadu_pd(output), first);
+        second = _mm512_add_pd(_mm512_loadu_pd(output + 8), second);
+    }
+    _mm512_storeu_pd(output, first);
+    _mm512_storeu_pd(output + 8, second);
+}
+
+#define DOUBLE_MADD_AVX512(x, f, acc) _mm512_fmadd_pd(x, f, acc)
+
+PYWT_TARGET("avx512f")
+PYWT_INLINE size_t double_upsampling_kernel_avx512_body(const double * input_a, const double * input_d,
+                                                        const double * polyphase_a, const double * polyphase_d,
+                                                        size_t L, double * output, size_t i, size_t n)
+{
+    PYWT_UPSAMPLING_BODY(double, __m512d, 8, _mm512_setzero_pd, _mm512_set1_pd, _mm512_loadu_pd, DOUBLE_MADD_AVX512,
+                         _mm512_add_pd, double_store_pairs_avx512)
+}
+
+#undef DOUBLE_MADD_AVX512
+
+PYWT_UPSAMPLING_KERNELS(double, double_upsampling_kernel_avx512, PYWT_TARGET("avx512f"))
+
+PYWT_TARGET("avx512f")
+static void float_store_pairs_avx512(float * output, __m512 even, __m512 odd, int add)
+{
+    const __m512i lo_index = _mm512_set_epi32(23, 7, 22, 6, 21, 5, 20, 4,
+                                              19, 3, 18, 2, 17, 1, 16, 0);
+    const __m512i hi_index = _mm512_set_epi32(31, 15, 30, 14, 29, 13, 28, 12,
+                                              27, 11, 26, 10, 25, 9, 24, 8);
+    __m512 first = _mm512_permutex2var_ps(even, lo_index, odd);
+    __m512 second = _mm512_permutex2var_ps(even, hi_index, odd);
+    if (add) {
+        first = _mm512_add_ps(_mm512_loadu_ps(output), first);
+        second = _mm512_add_ps(_mm512_loadu_ps(output + 16), second);
+    }
+    _mm512_storeu_ps(output, first);
+    _mm512_storeu_ps(output + 16, second);
+}
+
+#define FLOAT_MADD_AVX512(x, f, acc) _mm512_fmadd_ps(x, f, acc)
+
+PYWT_TARGET("avx512f")
+PYWT_INLINE size_t float_upsampling_kernel_avx512_body(const float * input_a, const float * input_d,
+                                                       const float * polyphase_a, const float * polyphase_d,
+                                                       size_t L, float * output, size_t i, size_t n)
+{
+    PYWT_UPSAMPLING_BODY(float, __m512, 16, _mm512_setzero_ps, _mm512_set1_ps, _mm512_loadu_ps, FLOAT_MADD_AVX512,
+                         _mm512_add_ps, float_store_pairs_avx512)
+}
+
+#undef FLOAT_MADD_AVX512
+
+PYWT_UPSAMPLING_KERNELS(float, float_upsampling_kernel_avx512, PYWT_TARGET("avx512f"))
+
+#endif /* PYWT_HAVE_SIMD */
+
+/* ##### Portable ##### */
+
+/* Same loops as in the caller, only instantiated for fixed lengths (there is
+ * nothing to gain from a generic one) */
+
+#define PYWT_PORTABLE_BODIES(type) \
+    PYWT_INLINE size_t type##_downsampling_kernel_portable_body( \
+        const type * input, size_t N, const type * filter, size_t F, \
+        type * output, size_t i, size_t n) \
+    { \
+        size_t o, j; \
+        (void) N; \
+        for (o = 0; o < n; ++o, i += 2) { \
+            type sum = 0; \
+            for (j = 0; j < F; ++j) \
+                sum += filter[j] * input[i-j]; \
+            output[o] = sum; \
+        } \
+        return n; \
+    } \
+    PYWT_INLINE size_t type##_downsampling_kernel_dual_portable_body( \
+        const type * input, size_t N, const type * filter_a, const type * filter_d, \
+        size_t F, type * output_a, type * output_d, size_t i, size_t n) \
+    { \
+        size_t o, j; \
+        (void) N; \
+        for (o = 0; o < n; ++o, i += 2) { \
+            type sum_a = 0, sum_d = 0; \
+            for (j = 0; j < F; ++j) { \
+                const type v = input[i-j]; \
+                sum_a += v * filter_a[j]; \
+                sum_d += v * filter_d[j]; \
+            } \
+            output_a[o] = sum_a; \
+            output_d[o] = sum_d; \
+        } \
+        return n; \
+    } \
+    PYWT_INLINE size_t type##_folded_kernel_portable_body( \
+        const type * input, const type * filter, size_t F, int sign, \
+        type * output, size_t i, size_t n, size_t step) \
+    { \
+        size_t o, j; \
+        for (o = 0; o < n; ++o, i += step) { \
+            const type * const x = input + i; \
+            type sum = 0; \
+            for (j = 0; j < F/2; ++j) \
+                sum += filter[j] * ((sign > 0) ? *(x - j) + *(x - (F-1-j)) \
+                                               : *(x - j) - *(x - (F-1-j))); \
+            if (F % 2) \
+                sum += filter[F/2] * *(x - F/2); \
+            output[o] = sum; \
+        } \
+        return n; \
+    } \
+    PYWT_INLINE size_t type##_upsampling_kernel_portable_body( \
+        const type * input_a, const type * input_d, const type * polyphase_a, \
+        const type * polyphase_d, size_t L, type * output, size_t i, size_t n) \
+    { \
+        size_t k, j; \
+        for (k = 0; k < n; ++k) { \
+            type even_a = 0, odd_a = 0, even_d = 0, odd_d = 0; \
+            for (j = 0; j < L; ++j) { \
+                even_a += polyphase_a[j] * input_a[i+k-j]; \
+                odd_a += polyphase_a[L+j] * input_a[i+k-j]; \
+            } \
+            if (input_d == NULL) { \
+                output[2*k] += even_a; \
+                output[2*k+1] += odd_a; \
+                continue; \
+            } \
+            for (j = 0; j < L; ++j) { \
+                even_d += polyphase_d[j] * input_d[i+k-j]; \
+                odd_d += polyphase_d[L+j] * input_d[i+k-j]; \
+            } \
+            output[2*k] = even_a + even_d; \
+            output[2*k+1] = odd_a + odd_d; \
+        } \
+        return n; \
+    } \
+    PYWT_INLINE size_t type##_downsampling_kernel_folded_portable_body( \
+        const type * input, size_t N, const type * filter, size_t F, int sign, \
+        type * output, size_t i, size_t n) \
+    { \
+        (void) N; \
+        return type##_folded_kernel_portable_body(input, filter, F, sign, output, i, n, 2); \
+    } \
+    PYWT_INLINE size_t type##_convolution_kernel_folded_portable_body( \
+        const type * input, size_t N, const type * filter, size_t F, int sign, \
+        type * output, size_t i, size_t n) \
+    { \
+        (void) N; \
+        return type##_folded_kernel_portable_body(input, filter, F, sign, output, i, n, 1); \
+    }
+
+#define PYWT_NO_TARGET
+
+PYWT_PORTABLE_BODIES(float)
+PYWT_PORTABLE_BODIES(double)
+PYWT_FIXED_KERNELS(float, float_downsampling_kernel_portable, PYWT_NO_TARGET)
+PYWT_FIXED_DUAL_KERNELS(float, float_downsampling_kernel_dual_portable, PYWT_NO_TARGET)
+PYWT_FIXED_KERNELS(double, double_downsampling_kernel_portable, PYWT_NO_TARGET)
+PYWT_FIXED_DUAL_KERNELS(double, double_downsampling_kernel_dual_portable, PYWT_NO_TARGET)
+PYWT_FIXED_UPSAMPLING_KERNELS(float, float_upsampling_kernel_portable, PYWT_NO_TARGET)
+PYWT_FIXED_UPSAMPLING_KERNELS(double, double_upsampling_kernel_portable, PYWT_NO_TARGET)
+PYWT_FIXED_FOLDED_KERNELS(float, float_downsampling_kernel_folded,
+                          float_downsampling_kernel_folded_portable, PYWT_NO_TARGET)
+PYWT_FIXED_FOLDED_KERNELS(double, double_downsampling_kernel_folded,
+                          double_downsampling_kernel_folded_portable, PYWT_NO_TARGET)
+PYWT_FIXED_FOLDED_KERNELS(float, float_convolution_kernel_folded,
+                          float_convolution_kernel_folded_portable, PYWT_NO_TARGET)
+PYWT_FIXED_FOLDED_KERNELS(double, double_convolution_kernel_folded,
+                          double_convolution_kernel_folded_portable, PYWT_NO_TARGET)
+
+float_downsampling_kernel float_simd_downsampling_kernel(size_t F)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT(float_downsampling_kernel_sse2, F);
+    case SIMD_AVX2:
+        return PYWT_SELECT(float_downsampling_kernel_avx2, F);
+    case SIMD_AVX512:
+        return PYWT_SELECT(float_downsampling_kernel_avx512, F);
+#endif
+    default:
+        return PYWT_FIXED_INDEX(F) ? float_downsampling_kernel_portable_fixed[F / 2] : NULL;
+    }
+}
+
+float_downsampling_kernel_dual float_simd_downsampling_kernel_dual(size_t F)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT(float_downsampling_kernel_dual_sse2, F);
+    case SIMD_AVX2:
+        return PYWT_SELECT(float_downsampling_kernel_dual_avx2, F);
+    case SIMD_AVX512:
+        return PYWT_SELECT(float_downsampling_kernel_dual_avx512, F);
+#endif
+    default:
+        return PYWT_FIXED_INDEX(F) ? float_downsampling_kernel_dual_portable_fixed[F / 2] : NULL;
+    }
+}
+
+double_downsampling_kernel double_simd_downsampling_kernel(size_t F)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT(double_downsampling_kernel_sse2, F);
+    case SIMD_AVX2:
+        return PYWT_SELECT(double_downsampling_kernel_avx2, F);
+    case SIMD_AVX512:
+        return PYWT_SELECT(double_downsampling_kernel_avx512, F);
+#endif
+    default:
+        return PYWT_FIXED_INDEX(F) ? double_downsampling_kernel_portable_fixed[F / 2] : NULL;
+    }
+}
+
+double_downsampling_kernel_dual double_simd_downsampling_kernel_dual(size_t F)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT(double_downsampling_kernel_dual_sse2, F);
+    case SIMD_AVX2:
+        return PYWT_SELECT(double_downsampling_kernel_dual_avx2, F);
+    case SIMD_AVX512:
+        return PYWT_SELECT(double_downsampling_kernel_dual_avx512, F);
+#endif
+    default:
+        return PYWT_FIXED_INDEX(F) ? double_downsampling_kernel_dual_portable_fixed[F / 2] : NULL;
+    }
+}
+
+float_rows_kernel float_simd_rows_kernel(void)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return float_rows_kernel_sse2;
+    case SIMD_AVX2:
+        return float_rows_kernel_avx2;
+    case SIMD_AVX512:
+        return float_rows_kernel_avx512;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+double_rows_kernel double_simd_rows_kernel(void)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return double_rows_kernel_sse2;
+    case SIMD_AVX2:
+        return double_rows_kernel_avx2;
+    case SIMD_AVX512:
+        return double_rows_kernel_avx512;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+float_downsampling_kernel_folded float_downsampling_kernel_folded_fixed(size_t F, int sign)
+{
+    return (F >= 1 && F <= PYWT_FIXED_FILTER_MAX) ?
+        float_downsampling_kernel_folded_portable_fixed[F][sign > 0] : NULL;
+}
+
+float_convolution_kernel_folded float_convolution_kernel_folded_fixed(size_t F, int sign)
+{
+    return (F >= 1 && F <= PYWT_FIXED_FILTER_MAX) ?
+        float_convolution_kernel_folded_portable_fixed[F][sign > 0] : NULL;
+}
+
+double_downsampling_kernel_folded double_downsampling_kernel_folded_fixed(size_t F, int sign)
+{
+    return (F >= 1 && F <= PYWT_FIXED_FILTER_MAX) ?
+        double_downsampling_kernel_folded_portable_fixed[F][sign > 0] : NULL;
+}
+
+double_convolution_kernel_folded double_convolution_kernel_folded_fixed(size_t F, int sign)
+{
+    return (F >= 1 && F <= PYWT_FIXED_FILTER_MAX) ?
+        double_convolution_kernel_folded_portable_fixed[F][sign > 0] : NULL;
+}
+
+float_haar_dec_kernel float_simd_haar_dec_kernel(void)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return float_haar_dec_kernel_sse2;
+    case SIMD_AVX2:
+        return float_haar_dec_kernel_avx2;
+    case SIMD_AVX512:
+        return float_haar_dec_kernel_avx512;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+float_haar_rec_kernel float_simd_haar_rec_kernel(void)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return float_haar_rec_kernel_sse2;
+    case SIMD_AVX2:
+        return float_haar_rec_kernel_avx2;
+    case SIMD_AVX512:
+        return float_haar_rec_kernel_avx512;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+double_haar_dec_kernel double_simd_haar_dec_kernel(void)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return double_haar_dec_kernel_sse2;
+    case SIMD_AVX2:
+        return double_haar_dec_kernel_avx2;
+    case SIMD_AVX512:
+        return double_haar_dec_kernel_avx512;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+double_haar_rec_kernel double_simd_haar_rec_kernel(void)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return double_haar_rec_kernel_sse2;
+    case SIMD_AVX2:
+        return double_haar_rec_kernel_avx2;
+    case SIMD_AVX512:
+        return double_haar_rec_kernel_avx512;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+float_upsampling_kernel float_simd_upsampling_kernel(size_t L)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT_UPSAMPLING(float_upsampling_kernel_sse2, L);
+    case SIMD_AVX2:
+        return PYWT_SELECT_UPSAMPLING(float_upsampling_kernel_avx2, L);
+    case SIMD_AVX512:
+        return PYWT_SELECT_UPSAMPLING(float_upsampling_kernel_avx512, L);
+#endif
+    default:
+        return PYWT_UPSAMPLING_FIXED_INDEX(L) ? float_upsampling_kernel_portable_fixed[L] : NULL;
+    }
+}
+
+float_upsampling_kernel_dual float_simd_upsampling_kernel_dual(size_t L)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT_UPSAMPLING(float_upsampling_kernel_sse2_dual, L);
+    case SIMD_AVX2:
+        return PYWT_SELECT_UPSAMPLING(float_upsampling_kernel_avx2_dual, L);
+    case SIMD_AVX512:
+        return PYWT_SELECT_UPSAMPLING(float_upsampling_kernel_avx512_dual, L);
+#endif
+    default:
+        return PYWT_UPSAMPLING_FIXED_INDEX(L) ? float_upsampling_kernel_portable_dual_fixed[L] : NULL;
+    }
+}
+
+double_upsampling_kernel double_simd_upsampling_kernel(size_t L)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT_UPSAMPLING(double_upsampling_kernel_sse2, L);
+    case SIMD_AVX2:
+        return PYWT_SELECT_UPSAMPLING(double_upsampling_kernel_avx2, L);
+    case SIMD_AVX512:
+        return PYWT_SELECT_UPSAMPLING(double_upsampling_kernel_avx512, L);
+#endif
+    default:
+        return PYWT_UPSAMPLING_FIXED_INDEX(L) ? double_upsampling_kernel_portable_fixed[L] : NULL;
+    }
+}
+
+double_upsampling_kernel_dual double_simd_upsampling_kernel_dual(size_t L)
+{
+    switch (simd_get()) {
+#if PYWT_HAVE_SIMD
+    case SIMD_SSE2:
+        return PYWT_SELECT_UPSAMPLING(double_upsampling_kernel_sse2_dual, L);
+    case SIMD_AVX2:
+        return PYWT_SELECT_UPSAMPLING(double_upsampling_kernel_avx2_dual, L);
+    case SIMD_AVX512:
+        return PYWT_SELECT_UPSAMPLING(double_upsampling_kernel_avx512_dual, L);
+#endif
+    default:
+        return PYWT_UPSAMPLING_FIXED_INDEX(L) ? double_upsampling_kernel_portable_dual_fixed[L] : NULL;
+    }
+}
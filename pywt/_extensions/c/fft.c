@@ -0,0 +1,135 @@
+/* See COPYING for license details. */
+
+#include <math.h>
+
+#include "fft.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+size_t fft_length(size_t n)
+{
+    size_t len = 1;
+    while (len < n)
+        len <<= 1;
+    return len;
+}
+
+
+int fft_plan_init(FFTPlan *plan, size_t n)
+{
+    size_t i, j, k;
+
+    plan->n = n;
+    plan->twiddles = NULL;
+    plan->swaps = NULL;
+    plan->n_swaps = 0;
+    if (n == 0 || (n & (n - 1)) != 0)
+        return -1;
+    if ((plan->twiddles = malloc((n/2 + 1) * 2 * sizeof(double))) == NULL ||
+        (plan->swaps = malloc((n/2 + 1) * 2 * sizeof(size_t))) == NULL) {
+        fft_plan_free(plan);
+        return -1;
+    }
+    for (k = 0; k < n/2; ++k) {
+        const double angle = 2 * M_PI * (double) k / (double) n;
+        plan->twiddles[2*k] = cos(angle);
+        plan->twiddles[2*k+1] = -sin(angle);
+    }
+    // j is the bit reversal of i
+    for (i = 0, j = 0; i < n; ++i) {
+        if (i < j) {
+            plan->swaps[2*plan->n_swaps] = i;
+            plan->swaps[2*plan->n_swaps+1] = j;
+            ++plan->n_swaps;
+        }
+        for (k = n >> 1; k > 0 && (j & k); k >>= 1)
+            j ^= k;
+        j |= k;
+    }
+    return 0;
+}
+
+
+void fft_plan_free(FFTPlan *plan)
+{
+    free(plan->twiddles);
+    free(plan->swaps);
+    plan->twiddles = NULL;
+    plan->swaps = NULL;
+}
+
+
+/* Iterative radix-2 decimation in time, the first two stages merged into a
+ * radix-4 one. sign = -1 for the forward transform, 1 for the inverse. */
+PYWT_INLINE void fft_transform(const FFTPlan *plan, double *data, const int sign)
+{
+    const size_t n = plan->n;
+    const double *tw = plan->twiddles;
+    size_t i, k, len;
+
+    for (i = 0; i < plan->n_swaps; ++i) {
+        const size_t a = 2*plan->swaps[2*i], b = 2*plan->swaps[2*i+1];
+        double t = data[a];
+        data[a] = data[b];
+        data[b] = t;
+        t = data[a+1];
+        data[a+1] = data[b+1];
+        data[b+1] = t;
+    }
+
+    if (n == 2) {
+        const double r = data[0] - data[2], m = data[1] - data[3];
+        data[0] += data[2];
+        data[1] += data[3];
+        data[2] = r;
+        data[3] = m;
+        return;
+    }
+    for (i = 0; i + 4 <= n; i += 4) {
+        double * const x = data + 2*i;
+        const double ar = x[0] + x[2], ai = x[1] + x[3];
+        const double br = x[0] - x[2], bi = x[1] - x[3];
+        const double cr = x[4] + x[6], ci = x[5] + x[7];
+        // (x[2] - x[3]) times -i (forward) or i (inverse)
+        const double dr = sign * (x[7] - x[5]), di = sign * (x[4] - x[6]);
+        x[0] = ar + cr;
+        x[1] = ai + ci;
+        x[4] = ar - cr;
+        x[5] = ai - ci;
+        x[2] = br + dr;
+        x[3] = bi + di;
+        x[6] = br - dr;
+        x[7] = bi - di;
+    }
+
+    for (len = 8; len <= n; len <<= 1) {
+        const size_t half = len / 2, tw_step = n / len;
+        for (i = 0; i < n; i += len) {
+            double * const x = data + 2*i;
+            double * const y = x + 2*half;
+            for (k = 0; k < half; ++k) {
+                const double wr = tw[2*k*tw_step], wi = sign * -tw[2*k*tw_step+1];
+                const double tr = y[2*k] * wr - y[2*k+1] * wi;
+                const double ti = y[2*k] * wi + y[2*k+1] * wr;
+                y[2*k] = x[2*k] - tr;
+                y[2*k+1] = x[2*k+1] - ti;
+                x[2*k] += tr;
+                x[2*k+1] += ti;
+            }
+        }
+    }
+}
+
+
+void fft_forward(const FFTPlan *plan, double *data)
+{
+    fft_transform(plan, data, -1);
+}
+
+
+void fft_inverse(const FFTPlan *plan, double *data)
+{
+    fft_transform(plan, data, 1);
+}
@@ -0,0 +1,33 @@
+/* See COPYING for license details. */
+
+/* Small complex FFT used by the FFT convolution backend (see convolution.h),
+ * so that no external library is needed */
+
+#pragma once
+
+#include "common.h"
+
+/* Precomputed factors for transforms of n points, n a power of two */
+typedef struct {
+    size_t n;
+    double *twiddles;  /* cos(2*pi*k/n), -sin(2*pi*k/n) for k = [0..n/2) */
+    size_t *swaps;     /* pairs of indices exchanged by the bit reversal */
+    size_t n_swaps;
+} FFTPlan;
+
+/* Prepares plan for transforms of n points. Returns 0 on success, -1 if n
+ * is not a power of two or memory could not be allocated. */
+int fft_plan_init(FFTPlan *plan, size_t n);
+
+void fft_plan_free(FFTPlan *plan);
+
+/* In place transform of plan->n complex values, stored as interleaved real
+ * and imaginary parts:
+ *   X[k] = sum(x[j] * exp(-2*pi*i*j*k/n) for j = [0..n))
+ * fft_inverse uses exp(+2*pi*i*j*k/n) and is not normalized (the result is n
+ * times the inverse transform). */
+void fft_forward(const FFTPlan *plan, double *data);
+void fft_inverse(const FFTPlan *plan, double *data);
+
+/* Smallest power of two >= n */
+size_t fft_length(size_t n);
@@ -0,0 +1,46 @@
+/* See COPYING for license details. */
+
+#include <limits.h>
+
+#include "int_lifting.h"
+
+/* Index of sample k of a signal of N >= 2 samples, extended symmetrically
+ * about its first and last samples. The parity of k is kept, so even
+ * samples map to the even channel and odd ones to the odd channel. */
+static size_t reflect_index(pywt_index_t k, const size_t N){
+    const pywt_index_t period = 2 * (pywt_index_t) N - 2;
+    k %= period;
+    if (k < 0)
+        k += period;
+    return (size_t) (k < (pywt_index_t) N ? k : period - k);
+}
+
+
+/* The lifting steps are computed in WIDE, wider than TYPE, and the rounding
+ * divisions by powers of two are arithmetic right shifts */
+
+#ifdef TYPE
+#error TYPE should not be defined here.
+#else
+
+#define TYPE short
+#define WIDE int
+#define TYPE_MIN SHRT_MIN
+#define TYPE_MAX SHRT_MAX
+#include "int_lifting.template.c"
+#undef TYPE
+#undef WIDE
+#undef TYPE_MIN
+#undef TYPE_MAX
+
+#define TYPE int
+#define WIDE long long
+#define TYPE_MIN INT_MIN
+#define TYPE_MAX INT_MAX
+#include "int_lifting.template.c"
+#undef TYPE
+#undef WIDE
+#undef TYPE_MIN
+#undef TYPE_MAX
+
+#endif /* TYPE */
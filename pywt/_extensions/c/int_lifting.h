@@ -0,0 +1,49 @@
+/* See COPYING for license details. */
+
+/* Reversible integer-to-integer wavelet transforms
+ *
+ * The lifting steps of these filter banks round their updates to integers,
+ * so integer data is transformed into integer coefficients, from which it is
+ * reconstructed exactly by applying the steps in reverse (Calderbank,
+ * Daubechies, Sweldens and Yeo, 1998). With the even and odd samples
+ * E[m] = x[2m] and D[m] = x[2m + 1] of a signal x:
+ *
+ * INT_LIFTING_53 - LeGall 5/3, the reversible filter bank of JPEG 2000
+ *   D[m] -= floor((E[m] + E[m + 1]) / 2)
+ *   E[m] += floor((D[m - 1] + D[m] + 2) / 4)
+ *
+ * INT_LIFTING_97M - the 9/7-M filter bank (9/7 analysis filters with integer
+ * lifting steps, adopted in JPEG 2000 part 2)
+ *   D[m] -= floor((9 (E[m] + E[m + 1]) - (E[m - 1] + E[m + 2]) + 8) / 16)
+ *   E[m] += floor((D[m - 1] + D[m] + 2) / 4)
+ *
+ * after which E holds the approximation and D the detail coefficients. The
+ * signal is extended symmetrically about its first and last samples
+ * (MODE_REFLECT), so N samples give ceil(N/2) approximation and floor(N/2)
+ * detail coefficients.
+ */
+
+#pragma once
+
+#include "common.h"
+#include "wt.h"
+
+typedef enum {
+    INT_LIFTING_53 = 0,
+    INT_LIFTING_97M,
+    INT_LIFTING_MAX
+} INT_LIFTING;
+
+#ifdef TYPE
+#error TYPE should not be defined here.
+#else
+
+#define TYPE short
+#include "int_lifting.template.h"
+#undef TYPE
+
+#define TYPE int
+#include "int_lifting.template.h"
+#undef TYPE
+
+#endif /* TYPE */
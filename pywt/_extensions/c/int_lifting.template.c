@@ -0,0 +1,264 @@
+/* See COPYING for license details. */
+
+#include "templating.h"
+
+#ifndef TYPE
+#error TYPE must be defined here.
+#else
+
+#include "int_lifting.h"
+
+#if defined _MSC_VER
+#define restrict __restrict
+#elif defined __GNUC__
+#define restrict __restrict__
+#endif
+
+/* The steps are applied to tiles of w lines, stored one channel row after
+ * the other: row m of a channel holds sample m of the channel of every line
+ * of the tile. Rows before the first and after the last are the symmetric
+ * extension of the channel, filled in by _int_extend before each step that
+ * reads the channel. */
+
+/* Fill margin rows before and after the n rows of channel (0 - even, 1 -
+ * odd) of signals of N >= 2 samples */
+static void CAT(TYPE, _int_extend)(TYPE * const rows, const size_t n, const size_t channel,
+                                   const size_t N, const size_t margin, const size_t w){
+    size_t j;
+
+    for (j = 1; j <= margin; ++j){
+        const pywt_index_t before = -2 * (pywt_index_t) j + (pywt_index_t) channel;
+        const pywt_index_t after = 2 * (pywt_index_t) (n - 1 + j) + (pywt_index_t) channel;
+        memcpy(rows - j * w, rows + reflect_index(before, N) / 2 * w, w * sizeof(TYPE));
+        memcpy(rows + (n - 1 + j) * w, rows + reflect_index(after, N) / 2 * w,
+               w * sizeof(TYPE));
+    }
+}
+
+
+/* D[m] += sign * prediction from E, for m = [0..nD). The rows of a channel
+ * are consecutive, so the steps run over all their elements at once, with
+ * the neighbouring rows w elements apart. Returns 1 if a result does not
+ * fit in TYPE. */
+static int CAT(TYPE, _int_predict)(const TYPE * const restrict E, TYPE * const restrict D,
+                                   const size_t nD, const size_t w,
+                                   const INT_LIFTING lifting, const WIDE sign){
+    const size_t n = nD * w;
+    int overflow = 0;
+    size_t i;
+
+    if (lifting == INT_LIFTING_97M){
+        for (i = 0; i < n; ++i){
+            const WIDE v = D[i] + sign * ((9 * ((WIDE) E[i] + E[i + w])
+                                           - ((WIDE) E[i - w] + E[i + 2 * w]) + 8) >> 4);
+            overflow |= (v < TYPE_MIN) | (v > TYPE_MAX);
+            D[i] = (TYPE) v;
+        }
+    } else {
+        for (i = 0; i < n; ++i){
+            const WIDE v = D[i] + sign * (((WIDE) E[i] + E[i + w]) >> 1);
+            overflow |= (v < TYPE_MIN) | (v > TYPE_MAX);
+            D[i] = (TYPE) v;
+        }
+    }
+    return overflow;
+}
+
+
+/* E[m] += sign * update from D, for m = [0..nE), the same for both filter
+ * banks */
+static int CAT(TYPE, _int_update)(TYPE * const restrict E, const TYPE * const restrict D,
+                                  const size_t nE, const size_t w, const WIDE sign){
+    const size_t n = nE * w;
+    int overflow = 0;
+    size_t i;
+
+    for (i = 0; i < n; ++i){
+        const WIDE v = E[i] + sign * (((WIDE) D[i - w] + D[i] + 2) >> 2);
+        overflow |= (v < TYPE_MIN) | (v > TYPE_MAX);
+        E[i] = (TYPE) v;
+    }
+    return overflow;
+}
+
+
+PYWT_INLINE void CAT(TYPE, _int_copy_line)(TYPE * const restrict line,
+                                           const pywt_index_t stride,
+                                           TYPE * const restrict buffer, const size_t n,
+                                           const int load){
+    size_t k;
+
+    if (load)
+        for (k = 0; k < n; ++k)
+            buffer[k] = line[(pywt_index_t) k * stride];
+    else
+        for (k = 0; k < n; ++k)
+            line[(pywt_index_t) k * stride] = buffer[k];
+}
+
+
+/* Copy rows [0..n) of w elements, the rows stride elements apart in lines,
+ * to or (if load is 0) from consecutive rows in buffer */
+static void CAT(TYPE, _int_copy_rows)(TYPE * const lines, const pywt_index_t stride,
+                                      TYPE * const buffer, const size_t n, const size_t w,
+                                      const int load){
+    size_t k, l;
+
+    if (w == 1){
+        // the strides of contiguous lines, as constants for vectorization
+        if (stride == 1)
+            CAT(TYPE, _int_copy_line)(lines, 1, buffer, n, load);
+        else if (stride == 2)
+            CAT(TYPE, _int_copy_line)(lines, 2, buffer, n, load);
+        else
+            CAT(TYPE, _int_copy_line)(lines, stride, buffer, n, load);
+        return;
+    }
+    for (k = 0; k < n; ++k){
+        TYPE * const line = lines + (pywt_index_t) k * stride;
+        if (load)
+            for (l = 0; l < w; ++l)
+                buffer[k * w + l] = line[l];
+        else
+            for (l = 0; l < w; ++l)
+                line[l] = buffer[k * w + l];
+    }
+}
+
+
+/* One level along axis of all lines of the block of shape at data, or its
+ * inverse, in tiles of up to AXIS_TILE_SIZE lines along the contiguous axis
+ * inner (single lines if inner == ndim) */
+static int CAT(TYPE, _int_lift_axis)(TYPE * const data, const size_t * const shape,
+                                     const pywt_index_t * const strides, const size_t ndim,
+                                     const size_t axis, const size_t inner,
+                                     const INT_LIFTING lifting, const int inverse,
+                                     const unsigned int workers){
+    const size_t N = shape[axis], nE = (N + 1) / 2, nD = N / 2;
+    const size_t W = (inner < ndim) ? shape[inner] : 1;
+    const size_t n_tiles = (W + AXIS_TILE_SIZE - 1) / AXIS_TILE_SIZE;
+    const size_t tile_len = (W < AXIS_TILE_SIZE) ? W : AXIS_TILE_SIZE;
+    const pywt_index_t stride = strides[axis] / (pywt_index_t) sizeof(TYPE);
+    size_t i, num_loops = 1;
+    int retval = 0, overflow = 0;
+
+    for (i = 0; i < ndim; ++i){
+        if (i != axis && i != inner)
+            num_loops *= shape[i];
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops * n_tiles)) \
+    if (workers > 1) reduction(|:retval) reduction(|:overflow)
+#endif
+    {
+        TYPE * const buffer = malloc((nE + nD + 6) * tile_len * sizeof(TYPE));
+        size_t q, q_first, q_last;
+
+        parallel_range(num_loops * n_tiles, &q_first, &q_last);
+        if (buffer == NULL)
+            retval = 2;
+        else
+            for (q = q_first; q < q_last; ++q){
+                const size_t t = (q % n_tiles) * AXIS_TILE_SIZE;
+                const size_t w = (W - t < AXIS_TILE_SIZE) ? W - t : AXIS_TILE_SIZE;
+                TYPE * const lines = (TYPE *) ((char *) data
+                    + line_offset(q / n_tiles, shape, strides, ndim, axis, inner)) + t;
+                // E with 2 rows of extension on each side, then D with 1
+                TYPE * const E = buffer + 2 * tile_len, * const D = E + (nE + 3) * tile_len;
+
+                // the channels are interleaved, or packed for the inverse
+                CAT(TYPE, _int_copy_rows)(lines, inverse ? stride : 2 * stride, E, nE, w, 1);
+                CAT(TYPE, _int_copy_rows)(lines + (inverse ? (pywt_index_t) nE * stride : stride),
+                                          inverse ? stride : 2 * stride, D, nD, w, 1);
+
+                if (!inverse){
+                    CAT(TYPE, _int_extend)(E, nE, 0, N, 2, w);
+                    overflow |= CAT(TYPE, _int_predict)(E, D, nD, w, lifting, -1);
+                    CAT(TYPE, _int_extend)(D, nD, 1, N, 1, w);
+                    overflow |= CAT(TYPE, _int_update)(E, D, nE, w, 1);
+                } else {
+                    CAT(TYPE, _int_extend)(D, nD, 1, N, 1, w);
+                    overflow |= CAT(TYPE, _int_update)(E, D, nE, w, -1);
+                    CAT(TYPE, _int_extend)(E, nE, 0, N, 2, w);
+                    overflow |= CAT(TYPE, _int_predict)(E, D, nD, w, lifting, 1);
+                }
+
+                CAT(TYPE, _int_copy_rows)(lines, inverse ? 2 * stride : stride, E, nE, w, 0);
+                CAT(TYPE, _int_copy_rows)(lines + (inverse ? stride : (pywt_index_t) nE * stride),
+                                          inverse ? 2 * stride : stride, D, nD, w, 0);
+            }
+        free(buffer);
+    }
+
+    if (retval)
+        return retval;
+    return overflow ? 3 : 0;
+}
+
+
+static int CAT(TYPE, _int_lifting_levels)(TYPE * const data, const ArrayInfo info,
+                                          const INT_LIFTING lifting,
+                                          const unsigned int level, const int inverse,
+                                          const unsigned int workers){
+    size_t * shape;
+    size_t d, a, c, k;
+    unsigned int l;
+    int retval = 0;
+
+    if (info.ndim < 1 || lifting < INT_LIFTING_53 || lifting >= INT_LIFTING_MAX)
+        return 1;
+    for (d = 0; d < info.ndim; ++d){
+        if (info.shape[d] == 0)
+            return 0;
+        if (info.strides[d] % (pywt_index_t) sizeof(TYPE))
+            return 1;
+    }
+    if ((shape = malloc(info.ndim * sizeof(size_t))) == NULL)
+        return 2;
+
+    /* The block of each level is transformed along every axis, the inverse
+     * undoes the levels and axes in reverse order */
+    for (l = 0; l < level && retval == 0; ++l){
+        const unsigned int j = inverse ? level - 1 - l : l;
+        for (d = 0; d < info.ndim; ++d){
+            shape[d] = info.shape[d];
+            for (k = 0; k < j; ++k)
+                shape[d] = (shape[d] + 1) / 2;
+        }
+        for (d = 0; d < info.ndim && retval == 0; ++d){
+            a = inverse ? info.ndim - 1 - d : d;
+            if (shape[a] < 2)
+                continue;
+            // last axes first, being contiguous for C-ordered arrays
+            for (c = info.ndim; c-- > 0; )
+                if (c != a && shape[c] >= AXIS_TILE_MIN_WIDTH &&
+                    info.strides[c] == (pywt_index_t) sizeof(TYPE))
+                    break;
+            if (c > info.ndim)
+                c = info.ndim;
+            retval = CAT(TYPE, _int_lift_axis)(data, shape, info.strides, info.ndim, a, c,
+                                               lifting, inverse, workers);
+        }
+    }
+
+    free(shape);
+    return retval;
+}
+
+
+int CAT(TYPE, _int_wavedecn)(TYPE * const data, const ArrayInfo info,
+                             const INT_LIFTING lifting, const unsigned int level,
+                             const unsigned int workers){
+    return CAT(TYPE, _int_lifting_levels)(data, info, lifting, level, 0, workers);
+}
+
+
+int CAT(TYPE, _int_waverecn)(TYPE * const data, const ArrayInfo info,
+                             const INT_LIFTING lifting, const unsigned int level,
+                             const unsigned int workers){
+    return CAT(TYPE, _int_lifting_levels)(data, info, lifting, level, 1, workers);
+}
+
+#undef restrict
+#endif /* TYPE */
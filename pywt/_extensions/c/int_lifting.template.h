@@ -0,0 +1,35 @@
+/* See COPYING for license details. */
+
+#include "templating.h"
+
+#ifndef TYPE
+#error TYPE must be defined here.
+#else
+
+#include "common.h"
+
+/* Multilevel transform of all axes of data, in place, in the packed (Mallat)
+ * layout: at each level, every line along each axis of the approximation
+ * block left by the previous level (the whole array at the first level) is
+ * replaced by its ceil(n/2) approximation coefficients followed by its
+ * floor(n/2) detail coefficients, so the approximation block of the next
+ * level is the first ceil(n/2) elements along every axis. Axes of length 1
+ * are left as they are.
+ *
+ * The strides of info are in bytes. Up to workers threads are used if built
+ * with OpenMP; the results do not depend on their number.
+ *
+ * Returns 1 for invalid arguments, 2 if memory could not be allocated and 3
+ * if a coefficient does not fit in TYPE, in which case data is left
+ * partially transformed.
+ */
+int CAT(TYPE, _int_wavedecn)(TYPE * const data, const ArrayInfo info,
+                             const INT_LIFTING lifting, const unsigned int level,
+                             const unsigned int workers);
+
+/* The inverse of _int_wavedecn, in place, with the same return values */
+int CAT(TYPE, _int_waverecn)(TYPE * const data, const ArrayInfo info,
+                             const INT_LIFTING lifting, const unsigned int level,
+                             const unsigned int workers);
+
+#endif /* TYPE */
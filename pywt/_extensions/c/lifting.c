@@ -0,0 +1,161 @@
+/* See COPYING for license details. */
+
+#include "lifting.h"
+#include "convolution.h"
+
+LiftingScheme* blank_lifting_scheme(size_t n_steps){
+    LiftingScheme* scheme;
+
+    scheme = wtmalloc(sizeof(LiftingScheme));
+    if(scheme == NULL)
+        return NULL;
+
+    scheme->n_steps = n_steps;
+    scheme->steps = NULL;
+    if(n_steps > 0){
+        scheme->steps = wtcalloc(n_steps, sizeof(LiftingStep));
+        if(scheme->steps == NULL){
+            wtfree(scheme);
+            return NULL;
+        }
+    }
+
+    scheme->scale_double[0] = scheme->scale_double[1] = 1;
+    scheme->scale_float[0] = scheme->scale_float[1] = 1;
+    scheme->shift[0] = scheme->shift[1] = 0;
+    scheme->source[0] = 0;
+    scheme->source[1] = 1;
+    scheme->delay = 0;
+    return scheme;
+}
+
+
+int set_lifting_step(LiftingScheme* scheme, size_t i, size_t target,
+                     pywt_index_t offset, const double* coefs, size_t len){
+    LiftingStep* step = scheme->steps + i;
+    size_t k;
+
+    wtfree(step->coefs_double);
+    wtfree(step->coefs_float);
+    step->coefs_double = wtmalloc(len * sizeof(double));
+    step->coefs_float = wtmalloc(len * sizeof(float));
+    if(step->coefs_double == NULL || step->coefs_float == NULL){
+        wtfree(step->coefs_double);
+        wtfree(step->coefs_float);
+        step->coefs_double = NULL;
+        step->coefs_float = NULL;
+        step->len = 0;
+        return -1;
+    }
+
+    for(k = 0; k < len; ++k){
+        step->coefs_double[k] = coefs[k];
+        step->coefs_float[k] = (float) coefs[k];
+    }
+    step->target = target;
+    step->offset = offset;
+    step->len = len;
+    return 0;
+}
+
+
+void free_lifting_scheme(LiftingScheme* scheme){
+    size_t i;
+
+    if(scheme == NULL)
+        return;
+    for(i = 0; i < scheme->n_steps; ++i){
+        wtfree(scheme->steps[i].coefs_double);
+        wtfree(scheme->steps[i].coefs_float);
+    }
+    wtfree(scheme->steps);
+    wtfree(scheme);
+}
+
+
+/* Extend the range of channel c by [a, b) */
+static void add_range(pywt_index_t lo[2], pywt_index_t hi[2], size_t c,
+                      pywt_index_t a, pywt_index_t b){
+    if(a >= b)
+        return;
+    if(lo[c] >= hi[c]){
+        lo[c] = a;
+        hi[c] = b;
+        return;
+    }
+    if(a < lo[c])
+        lo[c] = a;
+    if(b > hi[c])
+        hi[c] = b;
+}
+
+
+/* Step i reads the source channel at [lo - offset - (len - 1), hi - offset)
+ * to update the target channel at [lo, hi). */
+static void add_step_range(const LiftingScheme* scheme, size_t i,
+                           pywt_index_t lo[2], pywt_index_t hi[2],
+                           pywt_index_t* step_lo, pywt_index_t* step_hi){
+    const LiftingStep* step = scheme->steps + i;
+    const size_t t = step->target;
+
+    step_lo[i] = lo[t];
+    step_hi[i] = hi[t];
+    if(lo[t] < hi[t])
+        add_range(lo, hi, 1 - t,
+                  lo[t] - step->offset - (pywt_index_t) step->len + 1,
+                  hi[t] - step->offset);
+}
+
+
+void lifting_dec_ranges(const LiftingScheme* scheme, size_t O,
+                        pywt_index_t lo[2], pywt_index_t hi[2],
+                        pywt_index_t* step_lo, pywt_index_t* step_hi){
+    size_t i, k;
+
+    lo[0] = lo[1] = hi[0] = hi[1] = 0;
+    for(k = 0; k < 2; ++k)
+        add_range(lo, hi, scheme->source[k], -scheme->shift[k],
+                  (pywt_index_t) O - scheme->shift[k]);
+
+    // steps are applied in order, so needed ranges propagate backwards
+    for(i = scheme->n_steps; i-- > 0; )
+        add_step_range(scheme, i, lo, hi, step_lo, step_hi);
+}
+
+
+/* Smallest m with 2*m >= a */
+static pywt_index_t ceil_half(pywt_index_t a){
+    return a >= 0 ? (a + 1) / 2 : -((-a) / 2);
+}
+
+
+void lifting_rec_ranges(const LiftingScheme* scheme, pywt_index_t first, size_t O,
+                        pywt_index_t lo[2], pywt_index_t hi[2],
+                        pywt_index_t* step_lo, pywt_index_t* step_hi){
+    const pywt_index_t last = first + (pywt_index_t) O;
+    size_t i;
+
+    lo[0] = lo[1] = hi[0] = hi[1] = 0;
+    // sample n is element n/2 of the even or (n-1)/2 of the odd channel
+    add_range(lo, hi, 0, ceil_half(first), ceil_half(last));
+    add_range(lo, hi, 1, ceil_half(first - 1), ceil_half(last - 1));
+
+    // inverse steps are applied in reverse order
+    for(i = 0; i < scheme->n_steps; ++i)
+        add_step_range(scheme, i, lo, hi, step_lo, step_hi);
+}
+
+
+#ifdef TYPE
+#error TYPE should not be defined here.
+#else
+
+#define TYPE float
+#include "lifting.template.c"
+#undef TYPE
+
+#define TYPE double
+#include "lifting.template.c"
+#undef TYPE
+
+#endif /* TYPE */
@@ -0,0 +1,81 @@
+/* See COPYING for license details. */
+
+/* Wavelet transforms using a lifting factorization of the filter bank */
+
+#pragma once
+
+#include "common.h"
+
+/* A lifting step updates one channel (the even or odd samples) of the signal
+ * with a filter applied to the other:
+ *   channel[target][m] += sum(coefs[i] * channel[1 - target][m - offset - i]
+ *                             for i = [0..len))
+ */
+typedef struct {
+    size_t target;          /* updated channel: 0 - even, 1 - odd */
+    pywt_index_t offset;
+    size_t len;
+    double* coefs_double;
+    float* coefs_float;
+} LiftingStep;
+
+/* Lifting factorization of the polyphase matrix of a filter bank, computed
+ * by pywt/_lifting.py (see there for the conventions).
+ *
+ * After the steps, the approximation and detail coefficients are
+ *   output[k][o] = scale[k] * channel[source[k]][o - shift[k]]
+ * for k = 0 (approximation) and k = 1 (detail).
+ */
+typedef struct LiftingScheme {
+    LiftingStep* steps;
+    size_t n_steps;
+
+    double scale_double[2];
+    float scale_float[2];
+    pywt_index_t shift[2];
+    size_t source[2];
+
+    /* Delay of the reconstruction filters relative to the inverse steps */
+    pywt_index_t delay;
+} LiftingScheme;
+
+/* Number of outputs of each channel computed at a time, so the channel
+ * buffers stay in cache while the steps are applied */
+#define LIFTING_BLOCK_SIZE 256
+
+/* Allocate LiftingScheme with n_steps empty steps */
+LiftingScheme* blank_lifting_scheme(size_t n_steps);
+
+/* Set step i of scheme, copying len coefs. Returns 0 on success, -1 if
+ * memory could not be allocated. */
+int set_lifting_step(LiftingScheme* scheme, size_t i, size_t target,
+                     pywt_index_t offset, const double* coefs, size_t len);
+
+void free_lifting_scheme(LiftingScheme* scheme);
+
+/* Ranges of the even and odd channels, [lo[c], hi[c]), needed to compute
+ * outputs [0, O) of the decomposition, and the range [step_lo[i],
+ * step_hi[i]) of its target channel updated by each step. */
+void lifting_dec_ranges(const LiftingScheme* scheme, size_t O,
+                        pywt_index_t lo[2], pywt_index_t hi[2],
+                        pywt_index_t* step_lo, pywt_index_t* step_hi);
+
+/* As lifting_dec_ranges, for the reconstruction of signal samples
+ * [first, first + O). */
+void lifting_rec_ranges(const LiftingScheme* scheme, pywt_index_t first, size_t O,
+                        pywt_index_t lo[2], pywt_index_t hi[2],
+                        pywt_index_t* step_lo, pywt_index_t* step_hi);
+
+#ifdef TYPE
+#error TYPE should not be defined here.
+#else
+
+#define TYPE float
+#include "lifting.template.h"
+#undef TYPE
+
+#define TYPE double
+#include "lifting.template.h"
+#undef TYPE
+
+#endif /* TYPE */
@@ -0,0 +1,323 @@
+/* See COPYING for license details. */
+
+#include "templating.h"
+
+#ifndef TYPE
+#error TYPE must be defined here.
+#else
+
+#include "lifting.h"
+
+#if defined _MSC_VER
+#define restrict __restrict
+#elif defined __GNUC__
+#define restrict __restrict__
+#endif
+
+/* The signal is split into its even and odd samples (the two channels), which
+ * are updated in turn by the lifting steps. Each channel is held in a buffer
+ * covering the range of indices needed for the requested outputs, as given by
+ * lifting_dec_ranges and lifting_rec_ranges. Signal extension is done once,
+ * when filling the buffers, so the steps themselves need no boundary
+ * handling.
+ */
+
+/* target[j] += sum(coefs[i] * source[j-i] for i = [0..len)), j = [0..n) */
+static void CAT(TYPE, _lifting_step)(TYPE * const restrict target,
+                                     const TYPE * const restrict source, const size_t n,
+                                     const TYPE * const restrict coefs, const size_t len)
+{
+    pywt_index_t j;
+    size_t i;
+
+    switch(len){
+    case 1: {
+        const TYPE c0 = coefs[0];
+        for(j = 0; j < (pywt_index_t) n; ++j)
+            target[j] += c0 * source[j];
+        break;
+    }
+    case 2: {
+        const TYPE c0 = coefs[0], c1 = coefs[1];
+        for(j = 0; j < (pywt_index_t) n; ++j)
+            target[j] += c0 * source[j] + c1 * source[j-1];
+        break;
+    }
+    default:
+        for(j = 0; j < (pywt_index_t) n; ++j){
+            TYPE sum = 0;
+            for(i = 0; i < len; ++i)
+                sum += coefs[i] * source[j - (pywt_index_t) i];
+            target[j] += sum;
+        }
+    }
+}
+
+
+/* dest[m - m_lo] = y[2*m + c] for m = [m_lo..m_hi), where y[n] is the input
+ * sample n + start - 1 after extension with mode for n = [y_lo..y_hi), and
+ * zero otherwise */
+static void CAT(TYPE, _lifting_fill_dec)(const TYPE * const restrict input, const size_t N,
+                                         const MODE mode, const pywt_index_t start,
+                                         const pywt_index_t y_lo, const pywt_index_t y_hi,
+                                         TYPE * const restrict dest, const pywt_index_t m_lo,
+                                         const pywt_index_t m_hi, const pywt_index_t c)
+{
+    // samples [a, b) are read directly from the input
+    pywt_index_t a = ceil_half(y_lo - c), b = ceil_half(y_hi - c), m;
+    const pywt_index_t a_in = ceil_half(1 - start - c);
+    const pywt_index_t b_in = ceil_half((pywt_index_t) N + 1 - start - c);
+    const TYPE * src;
+
+    if(a < a_in) a = a_in;
+    if(a < m_lo) a = m_lo;
+    if(b > b_in) b = b_in;
+    if(b > m_hi) b = m_hi;
+    if(b < a) b = a;
+    if(a > m_hi) a = b = m_hi;
+
+    for(m = m_lo; m < a; ++m){
+        const pywt_index_t n = 2*m + c;
+        dest[m - m_lo] = (n >= y_lo && n < y_hi) ?
+            CAT(TYPE, _extended_value)(input, N, n + start - 1, mode) : 0;
+    }
+    src = input + (2*a + c + start - 1);
+    for(m = 0; m < b - a; ++m)
+        dest[a - m_lo + m] = src[2*m];
+    for(m = b; m < m_hi; ++m){
+        const pywt_index_t n = 2*m + c;
+        dest[m - m_lo] = (n >= y_lo && n < y_hi) ?
+            CAT(TYPE, _extended_value)(input, N, n + start - 1, mode) : 0;
+    }
+}
+
+
+/* dest[m - m_lo] = input[m + shift] / scale for m = [m_lo..m_hi), where the
+ * input is zero outside [0, N), or periodic for periodization */
+static void CAT(TYPE, _lifting_fill_rec)(const TYPE * const restrict input, const size_t N,
+                                         const TYPE scale, const int periodization,
+                                         const pywt_index_t shift,
+                                         TYPE * const restrict dest, const pywt_index_t m_lo,
+                                         const pywt_index_t m_hi)
+{
+    // samples [a, b) are read directly from the input
+    pywt_index_t a = -shift, b = (pywt_index_t) N - shift, m;
+
+    if(input == NULL){
+        for(m = m_lo; m < m_hi; ++m)
+            dest[m - m_lo] = 0;
+        return;
+    }
+
+    if(a < m_lo) a = m_lo;
+    if(b > m_hi) b = m_hi;
+    if(b < a) b = a;
+    if(a > m_hi) a = b = m_hi;
+
+    for(m = m_lo; m < m_hi; ){
+        if(m == a){
+            for(; m < b; ++m)
+                dest[m - m_lo] = input[m + shift] / scale;
+            if(m == m_hi)
+                break;
+        }
+        if(periodization){
+            pywt_index_t idx = (m + shift) % (pywt_index_t) N;
+            if(idx < 0)
+                idx += (pywt_index_t) N;
+            dest[m - m_lo] = input[idx] / scale;
+        } else {
+            dest[m - m_lo] = 0;
+        }
+        ++m;
+    }
+}
+
+
+int CAT(TYPE, _lifting_dec)(const TYPE * const restrict input, const size_t N,
+                            const LiftingScheme * const restrict scheme, const size_t F,
+                            TYPE * const restrict output_a, TYPE * const restrict output_d,
+                            const size_t O, const MODE mode)
+{
+    /* Sample n of the signal y split into channels is input sample
+     * n + start - 1 (as in _downsampling_convolution_dual). The outputs only
+     * depend on n in [2 - F, 2*O - 1]; samples outside of this are set to
+     * zero, as their contributions cancel out.
+     *
+     * Outputs are computed in blocks of B, for which the channel ranges
+     * differ only by an offset. */
+    const pywt_index_t start = (mode == MODE_PERIODIZATION) ? (pywt_index_t) F/2 : 1;
+    const pywt_index_t y_lo = 2 - (pywt_index_t) F;
+    const pywt_index_t y_hi = 2 * (pywt_index_t) O;
+    const size_t B = (O < LIFTING_BLOCK_SIZE) ? O : LIFTING_BLOCK_SIZE;
+    TYPE * const outputs[2] = {output_a, output_d};
+    pywt_index_t lo[2], hi[2];
+    pywt_index_t *step_lo, *step_hi;
+    TYPE *buffer, *channel[2];
+    size_t i, c, o, o0;
+
+    if(O == 0)
+        return 0;
+    if(N == 0 || F == 0)
+        return -1;
+
+    step_lo = malloc(2 * (scheme->n_steps + 1) * sizeof(pywt_index_t));
+    if(step_lo == NULL)
+        return -2;
+    step_hi = step_lo + scheme->n_steps + 1;
+    lifting_dec_ranges(scheme, B, lo, hi, step_lo, step_hi);
+
+    buffer = malloc((size_t)((hi[0] - lo[0]) + (hi[1] - lo[1])) * sizeof(TYPE));
+    if(buffer == NULL){
+        free(step_lo);
+        return -2;
+    }
+    channel[0] = buffer;
+    channel[1] = buffer + (hi[0] - lo[0]);
+
+    for(o0 = 0; o0 < O; o0 += B){
+        const size_t n_out = (O - o0 < B) ? O - o0 : B;
+
+        for(c = 0; c < 2; ++c)
+            CAT(TYPE, _lifting_fill_dec)(input, N, mode, start, y_lo, y_hi, channel[c],
+                                         lo[c] + (pywt_index_t) o0,
+                                         hi[c] + (pywt_index_t) o0, (pywt_index_t) c);
+
+        for(i = 0; i < scheme->n_steps; ++i){
+            const LiftingStep * const step = scheme->steps + i;
+            const size_t t = step->target;
+            if(step_lo[i] >= step_hi[i])
+                continue;
+            CAT(TYPE, _lifting_step)(channel[t] + (step_lo[i] - lo[t]),
+                                     channel[1-t] + (step_lo[i] - step->offset - lo[1-t]),
+                                     (size_t)(step_hi[i] - step_lo[i]),
+                                     step->CAT(coefs_, TYPE), step->len);
+        }
+
+        for(c = 0; c < 2; ++c){
+            const size_t s = scheme->source[c];
+            const TYPE scale = scheme->CAT(scale_, TYPE)[c];
+            const TYPE * const src = channel[s] + (-scheme->shift[c] - lo[s]);
+            TYPE * const out = outputs[c] + o0;
+            for(o = 0; o < n_out; ++o)
+                out[o] = scale * src[o];
+        }
+    }
+
+    free(buffer);
+    free(step_lo);
+    return 0;
+}
+
+
+int CAT(TYPE, _lifting_rec)(const TYPE * const restrict input_a,
+                            const TYPE * const restrict input_d, const size_t N,
+                            const LiftingScheme * const restrict scheme, const size_t F,
+                            TYPE * const restrict output, const size_t O,
+                            const MODE mode)
+{
+    /* Output q is sample first + q of the inverse of the steps. In
+     * MODE_PERIODIZATION this is the inverse of _lifting_dec on the periodic
+     * signal, with the coefficients indexed modulo N. Otherwise it is the
+     * (cropped) full reconstruction from coefficients that are zero outside
+     * [0, N), which is delayed with respect to the inverse of the steps.
+     *
+     * Outputs are computed in blocks of B (even, so the channel ranges
+     * differ only by an offset of B/2). */
+    const TYPE * const inputs[2] = {input_a, input_d};
+    const int periodization = (mode == MODE_PERIODIZATION);
+    const size_t B = (O < 2*LIFTING_BLOCK_SIZE) ? O + O%2 : 2*LIFTING_BLOCK_SIZE;
+    pywt_index_t first, lo[2], hi[2];
+    pywt_index_t *step_lo, *step_hi;
+    TYPE *buffer, *coefs, *channel[2];
+    size_t i, c, q, q0, n_coefs = 0;
+
+    if(O == 0)
+        return 0;
+    if(N == 0 || (F%2))
+        return -1;
+    if(periodization){
+        first = 1 - (pywt_index_t) F/2;
+    } else {
+        if(N < F/2)
+            return -1;
+        first = (pywt_index_t) F - 2 - scheme->delay;
+    }
+
+    for(i = 0; i < scheme->n_steps; ++i)
+        n_coefs += scheme->steps[i].len;
+
+    step_lo = malloc(2 * (scheme->n_steps + 1) * sizeof(pywt_index_t));
+    if(step_lo == NULL)
+        return -2;
+    step_hi = step_lo + scheme->n_steps + 1;
+    lifting_rec_ranges(scheme, first, B, lo, hi, step_lo, step_hi);
+
+    buffer = malloc(((size_t)((hi[0] - lo[0]) + (hi[1] - lo[1])) + n_coefs) * sizeof(TYPE));
+    if(buffer == NULL){
+        free(step_lo);
+        return -2;
+    }
+    channel[0] = buffer;
+    channel[1] = buffer + (hi[0] - lo[0]);
+
+    // the steps are undone by adding the negated coefficients
+    coefs = channel[1] + (hi[1] - lo[1]);
+    for(i = 0, q = 0; i < scheme->n_steps; ++i){
+        size_t k;
+        for(k = 0; k < scheme->steps[i].len; ++k, ++q)
+            coefs[q] = -scheme->steps[i].CAT(coefs_, TYPE)[k];
+    }
+
+    for(q0 = 0; q0 < O; q0 += B){
+        const size_t n_out = (O - q0 < B) ? O - q0 : B;
+        const pywt_index_t m0 = (pywt_index_t) q0 / 2;
+        const TYPE *coefs_i = coefs + n_coefs;
+        const TYPE *even, *odd;
+        pywt_index_t n = first;
+
+        // undo the scaling and shift of the outputs
+        for(c = 0; c < 2; ++c){
+            const size_t s = scheme->source[c];
+            CAT(TYPE, _lifting_fill_rec)(inputs[c], N, scheme->CAT(scale_, TYPE)[c],
+                                         periodization, scheme->shift[c], channel[s],
+                                         lo[s] + m0, hi[s] + m0);
+        }
+
+        // undo the steps, in reverse order
+        for(i = scheme->n_steps; i-- > 0; ){
+            const LiftingStep * const step = scheme->steps + i;
+            const size_t t = step->target;
+            coefs_i -= step->len;
+            if(step_lo[i] >= step_hi[i])
+                continue;
+            CAT(TYPE, _lifting_step)(channel[t] + (step_lo[i] - lo[t]),
+                                     channel[1-t] + (step_lo[i] - step->offset - lo[1-t]),
+                                     (size_t)(step_hi[i] - step_lo[i]),
+                                     coefs_i, step->len);
+        }
+
+        // interleave the channels
+        q = 0;
+        if(n & 1){
+            output[q0] = channel[1][(n - 1)/2 - lo[1]];
+            ++q;
+            ++n;
+        }
+        even = channel[0] + (n/2 - lo[0]);
+        odd = channel[1] + (n/2 - lo[1]);
+        for(i = 0; q + 1 < n_out; ++i, q += 2){
+            output[q0 + q] = even[i];
+            output[q0 + q + 1] = odd[i];
+        }
+        if(q < n_out)
+            output[q0 + q] = even[i];
+    }
+
+    free(buffer);
+    free(step_lo);
+    return 0;
+}
+
+#undef restrict
+#endif /* TYPE */
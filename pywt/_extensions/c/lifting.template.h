@@ -0,0 +1,63 @@
+/* See COPYING for license details. */
+
+#include "templating.h"
+
+#ifndef TYPE
+#error TYPE must be defined here.
+#else
+
+#include "common.h"
+
+#if defined _MSC_VER
+#define restrict __restrict
+#elif defined __GNUC__
+#define restrict __restrict__
+#endif
+
+/* Decomposition of input into approximation and detail coefficients with a
+ * lifting scheme. Results equal those of _downsampling_convolution_dual with
+ * the decomposition filters of the scheme, up to rounding.
+ *
+ * input    - input data
+ * N        - input data length
+ * scheme   - lifting factorization of the filters
+ * F        - decomposition filter length
+ * output_a - approximation coefficients
+ * output_d - detail coefficients
+ * O        - output length, as given by dwt_buffer_length
+ * mode     - signal extension mode
+ *
+ * Returns 0 on success, -1 on invalid arguments and -2 if memory could not be
+ * allocated.
+ */
+
+int CAT(TYPE, _lifting_dec)(const TYPE * const restrict input, const size_t N,
+                            const LiftingScheme * const restrict scheme, const size_t F,
+                            TYPE * const restrict output_a, TYPE * const restrict output_d,
+                            const size_t O, const MODE mode);
+
+/* Reconstruction from approximation and detail coefficients with a lifting
+ * scheme, either of which may be NULL. Results equal those of
+ * _upsampling_convolution_valid_sf_dual with the reconstruction filters of
+ * the scheme, up to rounding. The output is overwritten.
+ *
+ * input_a  - approximation coefficients
+ * input_d  - detail coefficients
+ * N        - coefficients length
+ * scheme   - lifting factorization of the filters
+ * F        - reconstruction filter length
+ * output   - output data
+ * O        - output length, as given by idwt_buffer_length
+ * mode     - signal extension mode
+ *
+ * Return values are as for _lifting_dec.
+ */
+
+int CAT(TYPE, _lifting_rec)(const TYPE * const restrict input_a,
+                            const TYPE * const restrict input_d, const size_t N,
+                            const LiftingScheme * const restrict scheme, const size_t F,
+                            TYPE * const restrict output, const size_t O,
+                            const MODE mode);
+
+#undef restrict
+#endif /* TYPE */
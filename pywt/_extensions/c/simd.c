@@ -0,0 +1,98 @@
+/* See COPYING for license details. */
+
+#include "simd.h"
+
+#if PYWT_HAVE_SIMD && !defined _MSC_VER
+#include <cpuid.h>
+#endif
+
+static SIMD simd_selected = SIMD_INVALID;
+
+#if PYWT_HAVE_SIMD
+
+static void simd_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4])
+{
+#if defined _MSC_VER
+    int r[4];
+    __cpuidex(r, (int) leaf, (int) subleaf);
+    regs[0] = r[0]; regs[1] = r[1]; regs[2] = r[2]; regs[3] = r[3];
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    if (__get_cpuid_max(0, NULL) >= leaf)
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/* Register state enabled by the OS (XCR0), only valid if OSXSAVE is set */
+static unsigned long long simd_xgetbv(void)
+{
+#if defined _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" /* xgetbv */
+                          : "=a" (eax), "=d" (edx) : "c" (0));
+    return ((unsigned long long) edx << 32) | eax;
+#endif
+}
+
+SIMD simd_detect(void)
+{
+    unsigned int regs[4];
+    unsigned long long xcr0;
+    SIMD simd = SIMD_NONE;
+
+    simd_cpuid(1, 0, regs);
+    if (!(regs[3] & (1u << 26)))              /* SSE2 */
+        return simd;
+    simd = SIMD_SSE2;
+
+    if (!(regs[2] & (1u << 27)) ||            /* OSXSAVE */
+        !(regs[2] & (1u << 28)) ||            /* AVX */
+        !(regs[2] & (1u << 12)))              /* FMA */
+        return simd;
+    xcr0 = simd_xgetbv();
+    if ((xcr0 & 0x6) != 0x6)                  /* XMM and YMM state */
+        return simd;
+
+    simd_cpuid(7, 0, regs);
+    if (!(regs[1] & (1u << 5)))               /* AVX2 */
+        return simd;
+    simd = SIMD_AVX2;
+
+    if (!(regs[1] & (1u << 16)) ||            /* AVX-512F */
+        (xcr0 & 0xe6) != 0xe6)                /* opmask and ZMM state */
+        return simd;
+    return SIMD_AVX512;
+}
+
+#else
+
+SIMD simd_detect(void)
+{
+    return SIMD_NONE;
+}
+
+#endif /* PYWT_HAVE_SIMD */
+
+int simd_supported(SIMD simd)
+{
+    if (simd <= SIMD_INVALID || simd >= SIMD_MAX)
+        return 0;
+    return simd <= simd_detect();
+}
+
+SIMD simd_get(void)
+{
+    if (simd_selected == SIMD_INVALID)
+        simd_selected = simd_detect();
+    return simd_selected;
+}
+
+int simd_set(SIMD simd)
+{
+    if (!simd_supported(simd))
+        return -1;
+    simd_selected = simd;
+    return 0;
+}
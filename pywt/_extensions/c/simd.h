@@ -0,0 +1,205 @@
+/* See COPYING for license details. */
+
+/* Runtime selection of vectorized kernels */
+
+#pragma once
+
+#include "common.h"
+
+/* SIMD kernels are only built for x86 with compilers supporting per-function
+ * target attributes (GCC, clang) or always-available intrinsics (MSVC). */
+#if (defined __x86_64__ || defined __i386__) && \
+    (defined __clang__ || (defined __GNUC__ && \
+     (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+    #define PYWT_HAVE_SIMD 1
+    #define PYWT_TARGET(isa) __attribute__((target(isa)))
+#elif defined _MSC_VER && _MSC_VER >= 1900 && (defined _M_X64 || defined _M_IX86)
+    #define PYWT_HAVE_SIMD 1
+    #define PYWT_TARGET(isa)
+#else
+    #define PYWT_HAVE_SIMD 0
+#endif
+
+/* Instruction set variants, in increasing order of capability */
+typedef enum {
+    SIMD_INVALID = -1,
+    SIMD_NONE = 0,  /* portable C loops */
+    SIMD_SSE2,      /* 128-bit vectors */
+    SIMD_AVX2,      /* 256-bit vectors, requires FMA as well */
+    SIMD_AVX512,    /* 512-bit vectors (AVX-512F) */
+    SIMD_MAX,
+} SIMD;
+
+/* Most capable variant supported by both the CPU and the operating system */
+SIMD simd_detect(void);
+
+/* Whether variant can be used on this machine (compiled in and supported) */
+int simd_supported(SIMD simd);
+
+/* Variant currently used by the convolution routines */
+SIMD simd_get(void);
+
+/* Select the variant used by the convolution routines. Returns 0 on success,
+ * -1 if the variant is not supported. */
+int simd_set(SIMD simd);
+
+/* Vectorized center loop of the decimating (step = 2) convolution, where the
+ * filter lies completely within the input:
+ *   output[o] = sum(filter[j] * input[i + 2*o - j] for j = [0..F))
+ * for o = [0..n), with i >= F - 1 and i + 2*(n-1) < N.
+ *
+ * Kernels return the number of leading outputs computed, which may be less
+ * than n (vector loads do not read past the end of the input). The caller
+ * computes the rest.
+ *
+ * Accumulation is done in the same order as the scalar loop. The SSE2
+ * variant is bit-identical to it, the FMA variants differ by rounding only.
+ *
+ * The *_simd_* functions return the kernel for filters of length F, which
+ * is specialized for that length when F is even and at most
+ * PYWT_FIXED_FILTER_MAX. They return NULL if no kernel is available for the
+ * selected variant: without vector instructions only the specialized
+ * kernels are provided, which compute the same sums as the scalar loop.
+ */
+#define PYWT_FIXED_FILTER_MAX 20
+
+typedef size_t (*float_downsampling_kernel)(const float * input, size_t N,
+                                            const float * filter, size_t F,
+                                            float * output, size_t i, size_t n);
+typedef size_t (*double_downsampling_kernel)(const double * input, size_t N,
+                                             const double * filter, size_t F,
+                                             double * output, size_t i, size_t n);
+
+float_downsampling_kernel float_simd_downsampling_kernel(size_t F);
+double_downsampling_kernel double_simd_downsampling_kernel(size_t F);
+
+/* As above, but applying two filters of the same length in a single pass:
+ *   output_a[o] = sum(filter_a[j] * input[i + 2*o - j] for j = [0..F))
+ *   output_d[o] = sum(filter_d[j] * input[i + 2*o - j] for j = [0..F))
+ */
+typedef size_t (*float_downsampling_kernel_dual)(const float * input, size_t N,
+                                                 const float * filter_a,
+                                                 const float * filter_d, size_t F,
+                                                 float * output_a, float * output_d,
+                                                 size_t i, size_t n);
+typedef size_t (*double_downsampling_kernel_dual)(const double * input, size_t N,
+                                                  const double * filter_a,
+                                                  const double * filter_d, size_t F,
+                                                  double * output_a, double * output_d,
+                                                  size_t i, size_t n);
+
+float_downsampling_kernel_dual float_simd_downsampling_kernel_dual(size_t F);
+double_downsampling_kernel_dual double_simd_downsampling_kernel_dual(size_t F);
+
+/* Portable kernels as the single filter ones, for a filter symmetric (sign = 1) or
+ * antisymmetric (sign = -1) about its middle, filter[j] == sign * filter[F-1-j],
+ * with the inputs sharing a tap folded before multiplying:
+ *   output[o] = sum(filter[j] * (input[i + 2*o - j] + sign * input[i + 2*o - (F-1-j)])
+ *                   for j = [0..F/2))
+ *             + filter[F/2] * input[i + 2*o - F/2]   (if F is odd)
+ * summed in this order. These are specialized for each length up to
+ * PYWT_FIXED_FILTER_MAX and sign, even and odd lengths alike, NULL is
+ * returned for longer filters. All n outputs are computed.
+ */
+typedef size_t (*float_downsampling_kernel_folded)(const float * input, size_t N,
+                                                   const float * filter, size_t F, int sign,
+                                                   float * output, size_t i, size_t n);
+typedef size_t (*double_downsampling_kernel_folded)(const double * input, size_t N,
+                                                    const double * filter, size_t F, int sign,
+                                                    double * output, size_t i, size_t n);
+
+float_downsampling_kernel_folded float_downsampling_kernel_folded_fixed(size_t F, int sign);
+double_downsampling_kernel_folded double_downsampling_kernel_folded_fixed(size_t F, int sign);
+
+/* As the folded kernels, with step 1 (as used for each of the even and odd
+ * taps of the reconstruction filters):
+ *   output[o] = sum(filter[j] * (input[i + o - j] + sign * input[i + o - (F-1-j)])
+ *                   for j = [0..F/2))
+ *             + filter[F/2] * input[i + o - F/2]   (if F is odd)
+ */
+typedef float_downsampling_kernel_folded float_convolution_kernel_folded;
+typedef double_downsampling_kernel_folded double_convolution_kernel_folded;
+
+float_convolution_kernel_folded float_convolution_kernel_folded_fixed(size_t F, int sign);
+double_convolution_kernel_folded double_convolution_kernel_folded_fixed(size_t F, int sign);
+
+/* Center loop of the reconstruction (upsampling) convolution, where the
+ * filter lies completely within the input, for a filter of 2*L taps given as
+ * its polyphase components: polyphase[j] = filter[2*j] and
+ * polyphase[L + j] = filter[2*j + 1] for j = [0..L). The single filter
+ * kernels add to the output:
+ *   output[2*k]     += sum(polyphase[j] * input[i + k - j] for j = [0..L))
+ *   output[2*k + 1] += sum(polyphase[L + j] * input[i + k - j] for j = [0..L))
+ * the dual kernels write the sum of the contributions of two inputs:
+ *   output[2*k]     = sum(polyphase_a[j] * input_a[i + k - j] for j = [0..L))
+ *                   + sum(polyphase_d[j] * input_d[i + k - j] for j = [0..L))
+ *   output[2*k + 1] = (the same with polyphase_a[L + j], polyphase_d[L + j])
+ * for k = [0..n), with i >= L - 1 and i + n <= N. The outputs for W
+ * consecutive inputs are computed in vectors, from contiguous loads of the
+ * inputs and broadcast taps, then interleaved.
+ *
+ * Kernels are specialized for L up to PYWT_FIXED_FILTER_MAX / 2. Rounding and
+ * return values are as for the downsampling kernels; NULL is returned
+ * without vector instructions for longer filters.
+ */
+typedef size_t (*float_upsampling_kernel)(const float * input, const float * polyphase,
+                                          size_t L, float * output, size_t i, size_t n);
+typedef size_t (*double_upsampling_kernel)(const double * input, const double * polyphase,
+                                           size_t L, double * output, size_t i, size_t n);
+typedef size_t (*float_upsampling_kernel_dual)(const float * input_a, const float * input_d,
+                                               const float * polyphase_a,
+                                               const float * polyphase_d, size_t L,
+                                               float * output, size_t i, size_t n);
+typedef size_t (*double_upsampling_kernel_dual)(const double * input_a, const double * input_d,
+                                                const double * polyphase_a,
+                                                const double * polyphase_d, size_t L,
+                                                double * output, size_t i, size_t n);
+
+float_upsampling_kernel float_simd_upsampling_kernel(size_t L);
+double_upsampling_kernel double_simd_upsampling_kernel(size_t L);
+float_upsampling_kernel_dual float_simd_upsampling_kernel_dual(size_t L);
+double_upsampling_kernel_dual double_simd_upsampling_kernel_dual(size_t L);
+
+/* Weighted sum of K rows of contiguous elements, used to transform a tile of
+ * neighbouring rows along a non-contiguous axis at once, with the rows
+ * selected by the caller:
+ *   output[l] = sum(weights[k] * rows[k][l] for k = [0..K))
+ * for l = [0..n). Return values are as for the kernels above.
+ */
+typedef size_t (*float_rows_kernel)(const float * const * rows, const float * weights,
+                                    size_t K, float * output, size_t n);
+typedef size_t (*double_rows_kernel)(const double * const * rows, const double * weights,
+                                     size_t K, double * output, size_t n);
+
+float_rows_kernel float_simd_rows_kernel(void);
+double_rows_kernel double_simd_rows_kernel(void);
+
+/* Haar kernels, for two tap filters (the Haar wavelet and others), without
+ * the boundary handling of the general kernels. The decomposition computes
+ *   output_a[o] = filter_a[0] * input[2*o + 1] + filter_a[1] * input[2*o]
+ *   output_d[o] = filter_d[0] * input[2*o + 1] + filter_d[1] * input[2*o]
+ * for o = [0..n) (output_d and filter_d may be NULL), the reconstruction
+ *   output[2*o]     = filter_a[0] * input_a[o] + filter_d[0] * input_d[o]
+ *   output[2*o + 1] = filter_a[1] * input_a[o] + filter_d[1] * input_d[o]
+ * for o = [0..n), rounded as by the rows kernels (which transform the
+ * non-contiguous axes) so that results do not depend on the memory layout.
+ * Return values are as for the kernels above, NULL is returned without
+ * vector instructions.
+ */
+typedef size_t (*float_haar_dec_kernel)(const float * input, const float * filter_a,
+                                        const float * filter_d, float * output_a,
+                                        float * output_d, size_t n);
+typedef size_t (*double_haar_dec_kernel)(const double * input, const double * filter_a,
+                                         const double * filter_d, double * output_a,
+                                         double * output_d, size_t n);
+typedef size_t (*float_haar_rec_kernel)(const float * input_a, const float * input_d,
+                                        const float * filter_a, const float * filter_d,
+                                        float * output, size_t n);
+typedef size_t (*double_haar_rec_kernel)(const double * input_a, const double * input_d,
+                                         const double * filter_a, const double * filter_d,
+                                         double * output, size_t n);
+
+float_haar_dec_kernel float_simd_haar_dec_kernel(void);
+double_haar_dec_kernel double_simd_haar_dec_kernel(void);
+float_haar_rec_kernel float_simd_haar_rec_kernel(void);
+double_haar_rec_kernel double_simd_haar_rec_kernel(void);
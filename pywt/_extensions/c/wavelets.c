@@ -50,6 +50,7 @@ Wavelet* wavelet(char name, unsigned int order)
 
         w->family_name = "Reverse biorthogonal";
         w->short_name = "rbio";
+        wavelet_update_filters(w);
 
         return w;
     }
@@ -320,6 +321,7 @@ Wavelet* wavelet(char name, unsigned int order)
         default:
             return NULL;
     }
+    wavelet_update_filters(w);
     return w;
 }
 
@@ -339,6 +341,7 @@ Wavelet* blank_wavelet(size_t filters_length)
     if(w == NULL) return NULL;
 
     w->dec_len = w->rec_len = filters_length;
+    w->lifting = NULL;
 
     w->dec_lo_float = wtcalloc(filters_length, sizeof(float));
     w->dec_hi_float = wtcalloc(filters_length, sizeof(float));
@@ -350,10 +353,17 @@ Wavelet* blank_wavelet(size_t filters_length)
     w->rec_lo_double = wtcalloc(filters_length, sizeof(double));
     w->rec_hi_double = wtcalloc(filters_length, sizeof(double));
 
+    w->rec_lo_polyphase_float = wtmalloc_aligned(filters_length * sizeof(float));
+    w->rec_hi_polyphase_float = wtmalloc_aligned(filters_length * sizeof(float));
+    w->rec_lo_polyphase_double = wtmalloc_aligned(filters_length * sizeof(double));
+    w->rec_hi_polyphase_double = wtmalloc_aligned(filters_length * sizeof(double));
+
     if(w->dec_lo_float == NULL || w->dec_hi_float == NULL ||
        w->rec_lo_float == NULL || w->rec_hi_float == NULL ||
        w->dec_lo_double == NULL || w->dec_hi_double == NULL ||
-       w->rec_lo_double == NULL || w->rec_hi_double == NULL){
+       w->rec_lo_double == NULL || w->rec_hi_double == NULL ||
+       w->rec_lo_polyphase_float == NULL || w->rec_hi_polyphase_float == NULL ||
+       w->rec_lo_polyphase_double == NULL || w->rec_hi_polyphase_double == NULL){
         free_wavelet(w);
         return NULL;
     }
@@ -368,11 +378,32 @@ Wavelet* blank_wavelet(size_t filters_length)
     w->compact_support = 0;
     w->family_name = "";
     w->short_name = "";
+    wavelet_update_filters(w);
 
     return w;
 }
 
 
+void wavelet_update_filters(Wavelet* w)
+{
+    const size_t half = w->rec_len / 2;
+    size_t p, j;
+
+    w->dec_lo_symmetry = filter_symmetry(w->dec_lo_double, w->dec_len, 1);
+    w->dec_hi_symmetry = filter_symmetry(w->dec_hi_double, w->dec_len, 1);
+    for(p = 0; p < 2; ++p){
+        w->rec_lo_symmetry[p] = filter_symmetry(w->rec_lo_double + p, w->rec_len / 2, 2);
+        w->rec_hi_symmetry[p] = filter_symmetry(w->rec_hi_double + p, w->rec_len / 2, 2);
+        for(j = 0; j < half; ++j){
+            w->rec_lo_polyphase_double[p*half + j] = w->rec_lo_double[2*j + p];
+            w->rec_hi_polyphase_double[p*half + j] = w->rec_hi_double[2*j + p];
+            w->rec_lo_polyphase_float[p*half + j] = w->rec_lo_float[2*j + p];
+            w->rec_hi_polyphase_float[p*half + j] = w->rec_hi_float[2*j + p];
+        }
+    }
+}
+
+
 Wavelet* copy_wavelet(Wavelet* base)
 {
     Wavelet* w;
@@ -386,6 +417,9 @@ Wavelet* copy_wavelet(Wavelet* base)
     if(w == NULL) return NULL;
 
     memcpy(w, base, sizeof(Wavelet));
+    w->lifting = NULL;
+    w->rec_lo_polyphase_float = w->rec_hi_polyphase_float = NULL;
+    w->rec_lo_polyphase_double = w->rec_hi_polyphase_double = NULL;
 
     w->dec_lo_float = wtmalloc(w->dec_len * sizeof(float));
     w->dec_hi_float = wtmalloc(w->dec_len * sizeof(float));
@@ -395,11 +429,17 @@ Wavelet* copy_wavelet(Wavelet* base)
     w->dec_hi_double = wtmalloc(w->dec_len * sizeof(double));
     w->rec_lo_double = wtmalloc(w->rec_len * sizeof(double));
     w->rec_hi_double = wtmalloc(w->rec_len * sizeof(double));
+    w->rec_lo_polyphase_float = wtmalloc_aligned(w->rec_len * sizeof(float));
+    w->rec_hi_polyphase_float = wtmalloc_aligned(w->rec_len * sizeof(float));
+    w->rec_lo_polyphase_double = wtmalloc_aligned(w->rec_len * sizeof(double));
+    w->rec_hi_polyphase_double = wtmalloc_aligned(w->rec_len * sizeof(double));
 
     if(w->dec_lo_float == NULL || w->dec_hi_float == NULL ||
        w->rec_lo_float == NULL || w->rec_hi_float == NULL ||
        w->dec_lo_double == NULL || w->dec_hi_double == NULL ||
-       w->rec_lo_double == NULL || w->rec_hi_double == NULL){
+       w->rec_lo_double == NULL || w->rec_hi_double == NULL ||
+       w->rec_lo_polyphase_float == NULL || w->rec_hi_polyphase_float == NULL ||
+       w->rec_lo_polyphase_double == NULL || w->rec_hi_polyphase_double == NULL){
       free_wavelet(w);
       return NULL;
     }
@@ -413,6 +453,7 @@ Wavelet* copy_wavelet(Wavelet* base)
     memcpy(w->dec_hi_double, base->dec_hi_double, w->dec_len * sizeof(double));
     memcpy(w->rec_lo_double, base->rec_lo_double, w->rec_len * sizeof(double));
     memcpy(w->rec_hi_double, base->rec_hi_double, w->rec_len * sizeof(double));
+    wavelet_update_filters(w);
 
     return w;
 }
@@ -430,6 +471,13 @@ void free_wavelet(Wavelet *w){
     wtfree(w->rec_lo_double);
     wtfree(w->rec_hi_double);
 
+    wtfree_aligned(w->rec_lo_polyphase_float);
+    wtfree_aligned(w->rec_hi_polyphase_float);
+    wtfree_aligned(w->rec_lo_polyphase_double);
+    wtfree_aligned(w->rec_hi_polyphase_double);
+
+    free_lifting_scheme(w->lifting);
+
     /* finally free struct */
     wtfree(w);
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "common.h"
+#include "lifting.h"
 
 /* Wavelet symmetry properties */
 typedef enum {
@@ -42,6 +43,22 @@ typedef struct {
     char* family_name;
     char* short_name;
 
+    /* Symmetry of the decomposition filters and of the even and odd taps of
+     * the reconstruction filters, set by wavelet_update_filters */
+    FilterSymmetry dec_lo_symmetry, dec_hi_symmetry;
+    FilterSymmetry rec_lo_symmetry[2], rec_hi_symmetry[2];
+
+    /* Polyphase components of the reconstruction filters, set by
+     * wavelet_update_filters: the even taps rec_*[0::2] followed by the odd
+     * taps rec_*[1::2], rec_len/2 of each, in aligned storage */
+    double* rec_lo_polyphase_double;
+    double* rec_hi_polyphase_double;
+    float* rec_lo_polyphase_float;
+    float* rec_hi_polyphase_float;
+
+    /* Lifting factorization of the filters, NULL if not available */
+    LiftingScheme* lifting;
+
 } Wavelet;
 
 
@@ -60,6 +77,10 @@ Wavelet* blank_wavelet(size_t filters_length);
 /* Deep copy Wavelet */
 Wavelet* copy_wavelet(Wavelet* base);
 
+/* Detect the symmetry of the filters and split the reconstruction filters
+ * into their polyphase components, after setting the filters */
+void wavelet_update_filters(Wavelet* w);
+
 /* 
  * Free wavelet struct. Use this to free Wavelet allocated with
  * wavelet(...) or blank_wavelet(...) functions.
@@ -2,8 +2,17 @@
 
 #include "common.h"
 #include "convolution.h"
+#include "lifting.h"
+#include "simd.h"
 #include "wavelets.h"
 
+/* Number of neighbouring rows transformed at a time along a non-contiguous
+ * axis, see _dwt_axis */
+#define AXIS_TILE_SIZE 64
+/* Narrower tiles (such as the real and imaginary parts of complex values)
+ * are slower than copying each row */
+#define AXIS_TILE_MIN_WIDTH 8
+
 #ifdef TYPE
 #error TYPE should not be defined here.
 #else
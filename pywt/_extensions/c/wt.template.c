@@ -8,6 +8,7 @@
 #else
 
 #include "wt.h"
+#include "simd.h"
 
 #if defined _MSC_VER
 #define restrict __restrict
@@ -15,15 +16,385 @@
 #define restrict __restrict__
 #endif
 
+/* Transforms along a non-contiguous axis
+ *
+ * Copying each row along a non-contiguous axis to a temporary buffer reads a
+ * separate cache line for every element. When another ("inner") axis is
+ * contiguous, a tile of up to AXIS_TILE_SIZE neighbouring rows along it is
+ * transformed at once instead: every output row of the tile is a weighted
+ * sum of input rows, computed across the contiguous elements of the tile.
+ */
+
+/* Select an inner axis for the tiled transforms: an axis other than axis, of
+ * length >= AXIS_TILE_MIN_WIDTH, along which all arrays are contiguous. The
+ * elements of infos[0] are first_size bytes, those of the others
+ * sizeof(TYPE). Returns 0 if there is none or the strides along axis are not
+ * multiples of the element sizes. */
+static int CAT(TYPE, _tile_axis)(const ArrayInfo * const * const infos, const size_t n_infos,
+                                 const size_t first_size, const size_t axis,
+                                 size_t * const inner){
+    size_t c, k;
+
+    for (k = 0; k < n_infos; ++k){
+        const pywt_index_t size = (pywt_index_t) ((k == 0) ? first_size : sizeof(TYPE));
+        if (infos[k]->strides[axis] % size)
+            return 0;
+    }
+
+    // last axes first, being contiguous for C-ordered arrays
+    for (c = infos[0]->ndim; c-- > 0; ){
+        if (c == axis || infos[0]->shape[c] < AXIS_TILE_MIN_WIDTH)
+            continue;
+        for (k = 0; k < n_infos; ++k)
+            if (infos[k]->strides[c] != (pywt_index_t) ((k == 0) ? first_size : sizeof(TYPE)))
+                break;
+        if (k == n_infos){
+            *inner = c;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+/* Byte offsets into the arrays for outer index i, enumerating all axes but
+ * axis and inner in C order. The arrays have the same shape (that of
+ * infos[0]) along these axes. */
+static void CAT(TYPE, _tile_offsets)(size_t i, const ArrayInfo * const * const infos,
+                                     const size_t n_infos, const size_t axis,
+                                     const size_t inner, pywt_index_t * const offsets){
+    size_t j, k;
+
+    for (k = 0; k < n_infos; ++k)
+        offsets[k] = 0;
+    for (j = infos[0]->ndim; j-- > 0; ){
+        if (j != axis && j != inner){
+            size_t axis_idx = i % infos[0]->shape[j];
+            i /= infos[0]->shape[j];
+            for (k = 0; k < n_infos; ++k)
+                offsets[k] += (pywt_index_t) axis_idx * infos[k]->strides[j];
+        }
+    }
+}
+
+
+void CAT(TYPE, _sum_rows)(const TYPE * const * const rows, const TYPE * const weights,
+                          const size_t K, TYPE * const restrict output, const size_t n,
+                          const CAT(TYPE, _rows_kernel) kernel){
+    size_t k, l = 0;
+
+    if (kernel != NULL)
+        l = kernel(rows, weights, K, output, n);
+    if (l == n)
+        return;
+    for (k = 0; k < K; ++k){
+        const TYPE * const restrict row = rows[k];
+        const TYPE w = weights[k];
+        size_t m;
+        if (k == 0)
+            for (m = l; m < n; ++m)
+                output[m] = w * row[m];
+        else
+            for (m = l; m < n; ++m)
+                output[m] += w * row[m];
+    }
+}
+
+
+void CAT(TYPE, _cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                      const pywt_index_t stride, TYPE * const restrict output, const size_t n){
+    size_t i;
+
+    // a contiguous loop of each type, for the compiler to vectorize
+#define CAST_LOOP(T, CONVERT)                                                   \
+    if (stride == (pywt_index_t) sizeof(T)){                                    \
+        const T * const restrict in = (const T *) input;                        \
+        for (i = 0; i < n; ++i)                                                 \
+            output[i] = (TYPE) CONVERT(in[i]);                                  \
+    } else {                                                                    \
+        for (i = 0; i < n; ++i)                                                 \
+            output[i] = (TYPE) CONVERT(*(const T *)((const char *) input        \
+                                                    + (pywt_index_t) i * stride)); \
+    }
+#define CAST_VALUE(x) (x)
+
+    switch (input_type){
+    case INPUT_UINT8:
+        CAST_LOOP(unsigned char, CAST_VALUE)
+        break;
+    case INPUT_INT16:
+        CAST_LOOP(short, CAST_VALUE)
+        break;
+    case INPUT_UINT16:
+        CAST_LOOP(unsigned short, CAST_VALUE)
+        break;
+    case INPUT_INT32:
+        CAST_LOOP(int, CAST_VALUE)
+        break;
+    case INPUT_FLOAT16:
+        CAST_LOOP(unsigned short, half_to_float)
+        break;
+    default:
+        CAST_LOOP(TYPE, CAST_VALUE)
+        break;
+    }
+
+#undef CAST_VALUE
+#undef CAST_LOOP
+}
+
+
+/* Decimating convolution along axis with filter_a (and filter_d, if output_d
+ * is not NULL), as _downsampling_convolution_dual does for a single row.
+ * Input other than INPUT_NATIVE is converted a tile at a time. */
+static int CAT(TYPE, _dec_axis_tiled)(const void * const input, const INPUT_TYPE input_type,
+                                      const ArrayInfo * const input_info,
+                                      TYPE * const output_a, const ArrayInfo * const a_info,
+                                      TYPE * const output_d, const ArrayInfo * const d_info,
+                                      const TYPE * const filter_a, const TYPE * const filter_d,
+                                      const size_t F, const size_t axis, const size_t inner,
+                                      const MODE mode, const unsigned int workers){
+    const ArrayInfo * const infos[3] = {input_info, a_info, d_info};
+    const size_t n_infos = (output_d != NULL) ? 3 : 2;
+    const pywt_index_t N = (pywt_index_t) input_info->shape[axis];
+    const size_t O = a_info->shape[axis], W = input_info->shape[inner];
+    const size_t n_tiles = (W + AXIS_TILE_SIZE - 1) / AXIS_TILE_SIZE;
+    const size_t in_size = input_itemsize(input_type, sizeof(TYPE));
+    // converted tiles are stored with a stride of tile_len elements
+    const size_t tile_len = (W < AXIS_TILE_SIZE) ? W : AXIS_TILE_SIZE;
+    const pywt_index_t in_stride = (input_type != INPUT_NATIVE) ? (pywt_index_t) tile_len
+        : input_info->strides[axis] / (pywt_index_t) sizeof(TYPE);
+    const pywt_index_t a_stride = a_info->strides[axis] / (pywt_index_t) sizeof(TYPE);
+    const pywt_index_t d_stride = (output_d != NULL) ?
+        d_info->strides[axis] / (pywt_index_t) sizeof(TYPE) : 0;
+    const CAT(TYPE, _rows_kernel) kernel = CAT(TYPE, _simd_rows_kernel)();
+
+    /* Output o is centered on input row start + 2*o, as in the convolution.
+     * Rows outside [0, N) are taken from the extended input, which is
+     * evaluated once per tile for the n_left rows [first, 0) and n_right rows
+     * [N, last]. */
+    const pywt_index_t start = (mode == MODE_PERIODIZATION) ? (pywt_index_t) F/2 : 1;
+    const pywt_index_t first = start - (pywt_index_t) F + 1;
+    const pywt_index_t last = start + 2 * ((pywt_index_t) O - 1);
+    const size_t n_left = (first < 0) ? (size_t) -first : 0;
+    const size_t n_right = (last >= N) ? (size_t) (last - N + 1) : 0;
+
+    size_t i, num_loops = 1;
+    int retval = 0;
+
+    if (O == 0)
+        return 0;
+
+    for (i = 0; i < input_info->ndim; ++i){
+        if (i != axis && i != inner)
+            num_loops *= input_info->shape[i];
+    }
+
+    // Tiles are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops * n_tiles)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * ext = NULL, * tile = NULL;
+        const TYPE ** rows = NULL;
+        size_t q, q_first, q_last;
+
+        parallel_range(num_loops * n_tiles, &q_first, &q_last);
+        if ((rows = malloc(F * sizeof(const TYPE *))) == NULL ||
+            (n_left + n_right > 0 &&
+             (ext = malloc((n_left + n_right) * AXIS_TILE_SIZE * sizeof(TYPE))) == NULL) ||
+            (input_type != INPUT_NATIVE &&
+             (tile = malloc((size_t) N * tile_len * sizeof(TYPE))) == NULL))
+            retval = 2;
+        else
+            for (q = q_first; q < q_last; ++q){
+                const size_t t = (q % n_tiles) * AXIS_TILE_SIZE;
+                const size_t w = (W - t < AXIS_TILE_SIZE) ? W - t : AXIS_TILE_SIZE;
+                pywt_index_t offsets[3];
+                const TYPE * in;
+                TYPE * out_a, * out_d;
+                size_t r, o;
+
+                CAT(TYPE, _tile_offsets)(q / n_tiles, infos, n_infos, axis, inner, offsets);
+                if (input_type != INPUT_NATIVE){
+                    const char * const first_row = (const char *) input + offsets[0] + t * in_size;
+                    pywt_index_t k;
+                    for (k = 0; k < N; ++k)
+                        CAT(TYPE, _cast)(first_row + k * input_info->strides[axis], input_type,
+                                         (pywt_index_t) in_size, tile + (size_t) k * tile_len, w);
+                    in = tile;
+                } else {
+                    in = (const TYPE *)((const char *) input + offsets[0]) + t;
+                }
+                out_a = (TYPE *)((char *) output_a + offsets[1]) + t;
+                out_d = (output_d != NULL) ? (TYPE *)((char *) output_d + offsets[2]) + t : NULL;
+
+                for (r = 0; r < n_left + n_right; ++r){
+                    const pywt_index_t idx = (r < n_left) ? first + (pywt_index_t) r
+                        : N + (pywt_index_t) (r - n_left);
+                    size_t l;
+                    for (l = 0; l < w; ++l)
+                        ext[r * AXIS_TILE_SIZE + l] = CAT(TYPE, _extended_value_strided)
+                            (in + l, N, in_stride, idx, mode);
+                }
+
+                for (o = 0; o < O; ++o){
+                    const pywt_index_t idx = start + 2 * (pywt_index_t) o;
+                    size_t j;
+                    for (j = 0; j < F; ++j){
+                        const pywt_index_t k = idx - (pywt_index_t) j;
+                        if (k < 0)
+                            rows[j] = ext + (size_t) (k + (pywt_index_t) n_left) * AXIS_TILE_SIZE;
+                        else if (k >= N)
+                            rows[j] = ext + (n_left + (size_t) (k - N)) * AXIS_TILE_SIZE;
+                        else
+                            rows[j] = in + k * in_stride;
+                    }
+                    CAT(TYPE, _sum_rows)(rows, filter_a, F, out_a + (pywt_index_t) o * a_stride,
+                                         w, kernel);
+                    if (out_d != NULL)
+                        CAT(TYPE, _sum_rows)(rows, filter_d, F,
+                                             out_d + (pywt_index_t) o * d_stride, w, kernel);
+                }
+            }
+
+        free(rows);
+        free(ext);
+        free(tile);
+    }
+    return retval;
+}
+
+
+/* Reconstruction along axis from coefs_a with filter_a and/or coefs_d with
+ * filter_d (either may be NULL), as _upsampling_convolution_valid_sf_dual
+ * does for a single row. */
+static int CAT(TYPE, _rec_axis_tiled)(const TYPE * const coefs_a, const ArrayInfo * const a_info,
+                                      const TYPE * const coefs_d, const ArrayInfo * const d_info,
+                                      TYPE * const output, const ArrayInfo * const output_info,
+                                      const TYPE * const filter_a, const TYPE * const filter_d,
+                                      const size_t F, const size_t axis, const size_t inner,
+                                      const MODE mode, const unsigned int workers){
+    const int have_a = (coefs_a != NULL), have_d = (coefs_d != NULL);
+    const ArrayInfo * const infos[3] = {output_info, have_a ? a_info : d_info, d_info};
+    const size_t n_infos = (have_a && have_d) ? 3 : 2;
+    const pywt_index_t N = (pywt_index_t) (have_a ? a_info : d_info)->shape[axis];
+    const size_t O = output_info->shape[axis], W = output_info->shape[inner];
+    const size_t n_tiles = (W + AXIS_TILE_SIZE - 1) / AXIS_TILE_SIZE;
+    const size_t K = (size_t) (have_a + have_d) * (F/2);
+    const pywt_index_t out_stride = output_info->strides[axis] / (pywt_index_t) sizeof(TYPE);
+    const pywt_index_t a_stride = have_a ? a_info->strides[axis] / (pywt_index_t) sizeof(TYPE) : 0;
+    const pywt_index_t d_stride = have_d ? d_info->strides[axis] / (pywt_index_t) sizeof(TYPE) : 0;
+    const CAT(TYPE, _rows_kernel) kernel = CAT(TYPE, _simd_rows_kernel)();
+
+    /* Input row i contributes to the output pair (o, o+1) with the even and
+     * odd filter taps respectively. In MODE_PERIODIZATION the coefficients
+     * are periodic, the pairs start at F/4 and the outputs are shifted by
+     * one (wrapping around) for (F/2)%2 == 0. Otherwise only the pairs for
+     * which all taps lie within the coefficients are computed. */
+    const int periodization = (mode == MODE_PERIODIZATION);
+    const pywt_index_t start = periodization ? (pywt_index_t) F/4 : (pywt_index_t) F/2 - 1;
+    const size_t shift = (periodization && (F/2)%2 == 0) ? 1 : 0;
+    const size_t n_pairs = periodization ? (size_t) N
+        : (N >= (pywt_index_t) F/2) ? (size_t) N - F/2 + 1 : 0;
+
+    TYPE * weights = NULL;
+    size_t i, num_loops = 1;
+    int retval = 0;
+
+    if (K == 0 || n_pairs == 0)
+        return 0;
+    if ((weights = malloc(2 * K * sizeof(TYPE))) == NULL)
+        return 2;
+
+    // even taps in weights[0..K), odd taps in weights[K..2K), a before d
+    for (i = 0; i < F/2; ++i){
+        const size_t m = have_a ? F/2 : 0;
+        if (have_a){
+            weights[i] = filter_a[2*i];
+            weights[K + i] = filter_a[2*i+1];
+        }
+        if (have_d){
+            weights[m + i] = filter_d[2*i];
+            weights[K + m + i] = filter_d[2*i+1];
+        }
+    }
+
+    for (i = 0; i < output_info->ndim; ++i){
+        if (i != axis && i != inner)
+            num_loops *= output_info->shape[i];
+    }
+
+    // Tiles are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops * n_tiles)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        const TYPE ** rows = NULL;
+        size_t q, q_first, q_last;
+
+        parallel_range(num_loops * n_tiles, &q_first, &q_last);
+        if ((rows = malloc(K * sizeof(const TYPE *))) == NULL)
+            retval = 2;
+        else
+            for (q = q_first; q < q_last; ++q){
+                const size_t t = (q % n_tiles) * AXIS_TILE_SIZE;
+                const size_t w = (W - t < AXIS_TILE_SIZE) ? W - t : AXIS_TILE_SIZE;
+                pywt_index_t offsets[3];
+                TYPE * out;
+                const TYPE * in_a, * in_d;
+                size_t p;
+
+                CAT(TYPE, _tile_offsets)(q / n_tiles, infos, n_infos, axis, inner, offsets);
+                out = (TYPE *)((char *) output + offsets[0]) + t;
+                in_a = have_a ? (const TYPE *)((const char *) coefs_a + offsets[1]) + t : NULL;
+                in_d = have_d ?
+                    (const TYPE *)((const char *) coefs_d + offsets[n_infos - 1]) + t : NULL;
+
+                for (p = 0; p < n_pairs; ++p){
+                    const pywt_index_t idx = start + (pywt_index_t) p;
+                    const size_t o = (shift + 2*p) % O;
+                    size_t j;
+                    for (j = 0; j < F/2; ++j){
+                        pywt_index_t k = idx - (pywt_index_t) j;
+                        if (periodization){
+                            k %= N;
+                            if (k < 0)
+                                k += N;
+                        }
+                        // same order as the weights
+                        if (have_a)
+                            rows[j] = in_a + k * a_stride;
+                        if (have_d)
+                            rows[(have_a ? F/2 : 0) + j] = in_d + k * d_stride;
+                    }
+                    CAT(TYPE, _sum_rows)(rows, weights, K, out + (pywt_index_t) o * out_stride,
+                                         w, kernel);
+                    CAT(TYPE, _sum_rows)(rows, weights + K, K,
+                                         out + (pywt_index_t) ((o + 1) % O) * out_stride,
+                                         w, kernel);
+                }
+            }
+
+        free(rows);
+    }
+    free(weights);
+    return retval;
+}
+
+
 /* Decomposition of input with lowpass filter */
 
 int CAT(TYPE, _downcoef_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
                               TYPE * const restrict output, const ArrayInfo output_info,
                               const Wavelet * const restrict wavelet, const size_t axis,
-                              const Coefficient coef, const MODE mode){
+                              const Coefficient coef, const MODE mode,
+                              const unsigned int workers){
     size_t i;
     size_t num_loops = 1;
-    TYPE * temp_input = NULL, * temp_output = NULL;
+    int retval = 0;
 
     // These are boolean values, but MSVC does not have <stdbool.h>
     int make_temp_input, make_temp_output;
@@ -44,82 +415,248 @@ int CAT(TYPE, _downcoef_axis)(const TYPE * const restrict input, const ArrayInfo
         }
     }
 
+    if (input_info.strides[axis] != sizeof(TYPE)){
+        const ArrayInfo * const infos[2] = {&input_info, &output_info};
+        size_t inner;
+        if (CAT(TYPE, _tile_axis)(infos, 2, sizeof(TYPE), axis, &inner))
+            return CAT(TYPE, _dec_axis_tiled)(input, INPUT_NATIVE, &input_info,
+                                              output, &output_info,
+                                              NULL, NULL,
+                                              coef == COEF_APPROX ? wavelet->CAT(dec_lo_, TYPE)
+                                                                  : wavelet->CAT(dec_hi_, TYPE),
+                                              NULL, wavelet->dec_len, axis, inner, mode,
+                                              workers);
+    }
+
     make_temp_input = input_info.strides[axis] != sizeof(TYPE);
     make_temp_output = output_info.strides[axis] != sizeof(TYPE);
-    if (make_temp_input)
-        if ((temp_input = malloc(input_info.shape[axis] * sizeof(TYPE))) == NULL)
-            goto cleanup;
-    if (make_temp_output)
-        if ((temp_output = malloc(output_info.shape[axis] * sizeof(TYPE))) == NULL)
-            goto cleanup;
 
     for (i = 0; i < output_info.ndim; ++i){
         if (i != axis)
             num_loops *= output_info.shape[i];
     }
 
-    for (i = 0; i < num_loops; ++i){
-        size_t j;
-        size_t input_offset = 0, output_offset = 0;
-        const TYPE * input_row;
-        TYPE * output_row;
-
-        // Calculate offset into linear buffer
-        {
-            size_t reduced_idx = i;
-            for (j = 0; j < output_info.ndim; ++j){
-                size_t j_rev = output_info.ndim - 1 - j;
-                if (j_rev != axis){
-                    size_t axis_idx = reduced_idx % output_info.shape[j_rev];
-                    reduced_idx /= output_info.shape[j_rev];
+    // Rows are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * temp_input = NULL, * temp_output = NULL;
+        size_t row, first, last;
+
+        parallel_range(num_loops, &first, &last);
+        if ((make_temp_input &&
+             (temp_input = malloc(input_info.shape[axis] * sizeof(TYPE))) == NULL) ||
+            (make_temp_output &&
+             (temp_output = malloc(output_info.shape[axis] * sizeof(TYPE))) == NULL))
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                size_t j;
+                size_t input_offset = 0, output_offset = 0;
+                const TYPE * input_row;
+                TYPE * output_row;
+
+                // Calculate offset into linear buffer
+                {
+                    size_t reduced_idx = row;
+                    for (j = 0; j < output_info.ndim; ++j){
+                        size_t j_rev = output_info.ndim - 1 - j;
+                        if (j_rev != axis){
+                            size_t axis_idx = reduced_idx % output_info.shape[j_rev];
+                            reduced_idx /= output_info.shape[j_rev];
+
+                            input_offset += (axis_idx * input_info.strides[j_rev]);
+                            output_offset += (axis_idx * output_info.strides[j_rev]);
+                        }
+                    }
+                }
 
-                    input_offset += (axis_idx * input_info.strides[j_rev]);
-                    output_offset += (axis_idx * output_info.strides[j_rev]);
+                // Copy to temporary input if necessary
+                if (make_temp_input)
+                    for (j = 0; j < input_info.shape[axis]; ++j)
+                        // Offsets are byte offsets, to need to cast to char and back
+                        temp_input[j] = *(TYPE *)(((char *) input) + input_offset
+                                                  + j * input_info.strides[axis]);
+
+                // Select temporary or direct output and input
+                input_row = make_temp_input ? temp_input
+                    : (const TYPE *)((const char *) input + input_offset);
+                output_row = make_temp_output ? temp_output
+                    : (TYPE *)((char *) output + output_offset);
+
+                // Apply along axis
+                switch (coef){
+                case COEF_APPROX:
+                    CAT(TYPE, _dec_a)(input_row, input_info.shape[axis], wavelet,
+                                      output_row, output_info.shape[axis], mode);
+                    break;
+                case COEF_DETAIL:
+                    CAT(TYPE, _dec_d)(input_row, input_info.shape[axis], wavelet,
+                                      output_row, output_info.shape[axis], mode);
+                    break;
                 }
+
+                // Copy from temporary output if necessary
+                if (make_temp_output)
+                    for (j = 0; j < output_info.shape[axis]; ++j)
+                        // Offsets are byte offsets, to need to cast to char and back
+                        *(TYPE *)((char *) output + output_offset
+                                  + j * output_info.strides[axis]) = output_row[j];
             }
-        }
 
-        // Copy to temporary input if necessary
-        if (make_temp_input)
-            for (j = 0; j < input_info.shape[axis]; ++j)
-                // Offsets are byte offsets, to need to cast to char and back
-                temp_input[j] = *(TYPE *)(((char *) input) + input_offset
-                                          + j * input_info.strides[axis]);
-
-        // Select temporary or direct output and input
-        input_row = make_temp_input ? temp_input
-            : (const TYPE *)((const char *) input + input_offset);
-        output_row = make_temp_output ? temp_output
-            : (TYPE *)((char *) output + output_offset);
-
-        // Apply along axis
-        switch (coef){
-        case COEF_APPROX:
-            CAT(TYPE, _dec_a)(input_row, input_info.shape[axis], wavelet,
-                              output_row, output_info.shape[axis], mode);
-            break;
-        case COEF_DETAIL:
-            CAT(TYPE, _dec_d)(input_row, input_info.shape[axis], wavelet,
-                              output_row, output_info.shape[axis], mode);
-            break;
+        free(temp_input);
+        free(temp_output);
+    }
+    return retval;
+}
+
+
+/* Decomposition of input with both lowpass and highpass filters */
+
+int CAT(TYPE, _dwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                         TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                         TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                         const Wavelet * const restrict wavelet, const size_t axis,
+                         const MODE mode, const METHOD method, const unsigned int workers){
+    return CAT(TYPE, _dwt_axis_cast)(input, INPUT_NATIVE, input_info, coefs_a, a_info,
+                                     coefs_d, d_info, wavelet, axis, mode, method, workers);
+}
+
+
+int CAT(TYPE, _dwt_axis_cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                              const ArrayInfo input_info,
+                              TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                              TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                              const Wavelet * const restrict wavelet, const size_t axis,
+                              const MODE mode, const METHOD method,
+                              const unsigned int workers){
+    const size_t in_size = input_itemsize(input_type, sizeof(TYPE));
+    size_t i;
+    size_t num_loops = 1;
+    int retval = 0;
+
+    // These are boolean values, but MSVC does not have <stdbool.h>
+    int make_temp_input, make_temp_a, make_temp_d;
+
+    if (input_info.ndim != a_info.ndim || input_info.ndim != d_info.ndim)
+        return 1;
+    if (axis >= input_info.ndim)
+        return 1;
+    if (method == METHOD_LIFTING && wavelet->lifting == NULL)
+        return 1;
+
+    for (i = 0; i < input_info.ndim; ++i){
+        if (a_info.shape[i] != d_info.shape[i])
+            return 1;
+        if (i == axis){
+            if (dwt_buffer_length(input_info.shape[i], wavelet->dec_len, mode)
+                != a_info.shape[i])
+                return 1;
+        } else {
+            if (input_info.shape[i] != a_info.shape[i])
+                return 1;
         }
+    }
+
+    if (input_type < INPUT_NATIVE || input_type >= INPUT_MAX)
+        return 1;
 
-        // Copy from temporary output if necessary
-        if (make_temp_output)
-            for (j = 0; j < output_info.shape[axis]; ++j)
-                // Offsets are byte offsets, to need to cast to char and back
-                *(TYPE *)((char *) output + output_offset
-                          + j * output_info.strides[axis]) = output_row[j];
+    if (method == METHOD_CONVOLUTION && input_info.strides[axis] != (pywt_index_t) in_size){
+        const ArrayInfo * const infos[3] = {&input_info, &a_info, &d_info};
+        size_t inner;
+        if (CAT(TYPE, _tile_axis)(infos, 3, in_size, axis, &inner))
+            return CAT(TYPE, _dec_axis_tiled)(input, input_type, &input_info, coefs_a, &a_info,
+                                              coefs_d, &d_info,
+                                              wavelet->CAT(dec_lo_, TYPE),
+                                              wavelet->CAT(dec_hi_, TYPE),
+                                              wavelet->dec_len, axis, inner, mode, workers);
     }
 
-    free(temp_input);
-    free(temp_output);
-    return 0;
+    make_temp_input = (input_type != INPUT_NATIVE || input_info.strides[axis] != sizeof(TYPE));
+    make_temp_a = a_info.strides[axis] != sizeof(TYPE);
+    make_temp_d = d_info.strides[axis] != sizeof(TYPE);
+
+    for (i = 0; i < a_info.ndim; ++i){
+        if (i != axis)
+            num_loops *= a_info.shape[i];
+    }
 
- cleanup:
-    free(temp_input);
-    free(temp_output);
-    return 2;
+    // Rows are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * temp_input = NULL, * temp_a = NULL, * temp_d = NULL;
+        size_t row, first, last;
+
+        parallel_range(num_loops, &first, &last);
+        if ((make_temp_input &&
+             (temp_input = malloc(input_info.shape[axis] * sizeof(TYPE))) == NULL) ||
+            (make_temp_a && (temp_a = malloc(a_info.shape[axis] * sizeof(TYPE))) == NULL) ||
+            (make_temp_d && (temp_d = malloc(d_info.shape[axis] * sizeof(TYPE))) == NULL))
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                size_t j;
+                size_t input_offset = 0, a_offset = 0, d_offset = 0;
+                const TYPE * input_row;
+                TYPE * a_row, * d_row;
+
+                // Calculate offset into linear buffer
+                {
+                    size_t reduced_idx = row;
+                    for (j = 0; j < a_info.ndim; ++j){
+                        size_t j_rev = a_info.ndim - 1 - j;
+                        if (j_rev != axis){
+                            size_t axis_idx = reduced_idx % a_info.shape[j_rev];
+                            reduced_idx /= a_info.shape[j_rev];
+
+                            input_offset += (axis_idx * input_info.strides[j_rev]);
+                            a_offset += (axis_idx * a_info.strides[j_rev]);
+                            d_offset += (axis_idx * d_info.strides[j_rev]);
+                        }
+                    }
+                }
+
+                // Copy (and convert) to temporary input if necessary
+                if (make_temp_input)
+                    CAT(TYPE, _cast)((const char *) input + input_offset, input_type,
+                                     input_info.strides[axis], temp_input,
+                                     input_info.shape[axis]);
+
+                // Select temporary or direct output and input
+                input_row = make_temp_input ? temp_input
+                    : (const TYPE *)((const char *) input + input_offset);
+                a_row = make_temp_a ? temp_a : (TYPE *)((char *) coefs_a + a_offset);
+                d_row = make_temp_d ? temp_d : (TYPE *)((char *) coefs_d + d_offset);
+
+                // Apply along axis
+                if (CAT(TYPE, _dec)(input_row, input_info.shape[axis], wavelet,
+                                    a_row, d_row, a_info.shape[axis], mode, method) < 0){
+                    retval = 2;
+                    break;
+                }
+
+                // Copy from temporary output if necessary
+                if (make_temp_a)
+                    for (j = 0; j < a_info.shape[axis]; ++j)
+                        // Offsets are byte offsets, to need to cast to char and back
+                        *(TYPE *)((char *) coefs_a + a_offset
+                                  + j * a_info.strides[axis]) = a_row[j];
+                if (make_temp_d)
+                    for (j = 0; j < d_info.shape[axis]; ++j)
+                        *(TYPE *)((char *) coefs_d + d_offset
+                                  + j * d_info.strides[axis]) = d_row[j];
+            }
+
+        free(temp_input);
+        free(temp_a);
+        free(temp_d);
+    }
+    return retval;
 }
 
 
@@ -127,10 +664,11 @@ int CAT(TYPE, _idwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo *
                           const TYPE * const restrict coefs_d, const ArrayInfo * const d_info,
                           TYPE * const restrict output, const ArrayInfo output_info,
                           const Wavelet * const restrict wavelet,
-                          const size_t axis, const MODE mode){
+                          const size_t axis, const MODE mode, const METHOD method,
+                          const unsigned int workers){
     size_t i;
     size_t num_loops = 1;
-    TYPE * temp_coefs_a = NULL, * temp_coefs_d = NULL, * temp_output = NULL;
+    int retval = 0;
 
     // These are boolean values, but MSVC does not have <stdbool.h>
     int make_temp_coefs_a, make_temp_coefs_d, make_temp_output;
@@ -146,6 +684,8 @@ int CAT(TYPE, _idwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo *
         return 1;
     if (axis >= output_info.ndim)
         return 1;
+    if (method == METHOD_LIFTING && wavelet->lifting == NULL)
+        return 1;
 
     for (i = 0; i < output_info.ndim; ++i){
         if (i == axis){
@@ -168,105 +708,394 @@ int CAT(TYPE, _idwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo *
         }
     }
 
+    if (method == METHOD_CONVOLUTION && output_info.strides[axis] != sizeof(TYPE) &&
+        wavelet->rec_len % 2 == 0){
+        const ArrayInfo * infos[3] = {&output_info, NULL, NULL};
+        size_t n_infos = 1, inner;
+        if (have_a)
+            infos[n_infos++] = a_info;
+        if (have_d)
+            infos[n_infos++] = d_info;
+        if (CAT(TYPE, _tile_axis)(infos, n_infos, sizeof(TYPE), axis, &inner))
+            return CAT(TYPE, _rec_axis_tiled)(have_a ? coefs_a : NULL, a_info,
+                                              have_d ? coefs_d : NULL, d_info,
+                                              output, &output_info,
+                                              wavelet->CAT(rec_lo_, TYPE),
+                                              wavelet->CAT(rec_hi_, TYPE),
+                                              wavelet->rec_len, axis, inner, mode, workers);
+    }
+
     make_temp_coefs_a = have_a && a_info->strides[axis] != sizeof(TYPE);
     make_temp_coefs_d = have_d && d_info->strides[axis] != sizeof(TYPE);
     make_temp_output = output_info.strides[axis] != sizeof(TYPE);
-    if (make_temp_coefs_a)
-        if ((temp_coefs_a = malloc(a_info->shape[axis] * sizeof(TYPE))) == NULL)
-            goto cleanup;
-    if (make_temp_coefs_d)
-        if ((temp_coefs_d = malloc(d_info->shape[axis] * sizeof(TYPE))) == NULL)
-            goto cleanup;
-    if (make_temp_output)
-        if ((temp_output = malloc(output_info.shape[axis] * sizeof(TYPE))) == NULL)
-            goto cleanup;
 
     for (i = 0; i < output_info.ndim; ++i){
         if (i != axis)
             num_loops *= output_info.shape[i];
     }
 
-    for (i = 0; i < num_loops; ++i){
-        size_t j;
-        size_t a_offset = 0, d_offset = 0, output_offset = 0;
-        TYPE * output_row;
-
-        // Calculate offset into linear buffer
-        {
-            size_t reduced_idx = i;
-            for (j = 0; j < output_info.ndim; ++j){
-                size_t j_rev = output_info.ndim - 1 - j;
-                if (j_rev != axis){
-                    size_t axis_idx = reduced_idx % output_info.shape[j_rev];
-                    reduced_idx /= output_info.shape[j_rev];
-
-                    if (have_a)
-                        a_offset += (axis_idx * a_info->strides[j_rev]);
-                    if (have_d)
-                        d_offset += (axis_idx * d_info->strides[j_rev]);
-                    output_offset += (axis_idx * output_info.strides[j_rev]);
+    // Rows are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * temp_coefs_a = NULL, * temp_coefs_d = NULL, * temp_output = NULL;
+        size_t row, first, last;
+
+        parallel_range(num_loops, &first, &last);
+        if ((make_temp_coefs_a &&
+             (temp_coefs_a = malloc(a_info->shape[axis] * sizeof(TYPE))) == NULL) ||
+            (make_temp_coefs_d &&
+             (temp_coefs_d = malloc(d_info->shape[axis] * sizeof(TYPE))) == NULL) ||
+            (make_temp_output &&
+             (temp_output = malloc(output_info.shape[axis] * sizeof(TYPE))) == NULL))
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                size_t j;
+                size_t a_offset = 0, d_offset = 0, output_offset = 0;
+                TYPE * output_row;
+
+                // Calculate offset into linear buffer
+                {
+                    size_t reduced_idx = row;
+                    for (j = 0; j < output_info.ndim; ++j){
+                        size_t j_rev = output_info.ndim - 1 - j;
+                        if (j_rev != axis){
+                            size_t axis_idx = reduced_idx % output_info.shape[j_rev];
+                            reduced_idx /= output_info.shape[j_rev];
+
+                            if (have_a)
+                                a_offset += (axis_idx * a_info->strides[j_rev]);
+                            if (have_d)
+                                d_offset += (axis_idx * d_info->strides[j_rev]);
+                            output_offset += (axis_idx * output_info.strides[j_rev]);
+                        }
+                    }
                 }
+
+                // Copy to temporary input if necessary
+                if (make_temp_coefs_a)
+                    for (j = 0; j < a_info->shape[axis]; ++j)
+                        // Offsets are byte offsets, to need to cast to char and back
+                        temp_coefs_a[j] = *(TYPE *)((char *) coefs_a + a_offset
+                                                    + j * a_info->strides[axis]);
+                if (make_temp_coefs_d)
+                    for (j = 0; j < d_info->shape[axis]; ++j)
+                        // Offsets are byte offsets, to need to cast to char and back
+                        temp_coefs_d[j] = *(TYPE *)((char *) coefs_d + d_offset
+                                                    + j * d_info->strides[axis]);
+
+                // Select temporary or direct output
+                output_row = make_temp_output ? temp_output
+                    : (TYPE *)((char *) output + output_offset);
+
+                if (method == METHOD_LIFTING){
+                    // Pointer arithmetic on NULL is undefined
+                    const TYPE * a_row = !have_a ? NULL : make_temp_coefs_a ? temp_coefs_a
+                        : (const TYPE *)((const char *) coefs_a + a_offset);
+                    const TYPE * d_row = !have_d ? NULL : make_temp_coefs_d ? temp_coefs_d
+                        : (const TYPE *)((const char *) coefs_d + d_offset);
+                    if (CAT(TYPE, _lifting_rec)(a_row, d_row,
+                                                have_a ? a_info->shape[axis]
+                                                       : d_info->shape[axis],
+                                                wavelet->lifting,
+                                                wavelet->rec_len, output_row,
+                                                output_info.shape[axis], mode) < 0){
+                        retval = 2;
+                        break;
+                    }
+                } else if (have_a && have_d){
+                    // Both subbands in one pass, writing each output once
+                    const TYPE * a_row = make_temp_coefs_a ? temp_coefs_a
+                        : (const TYPE *)((const char *) coefs_a + a_offset);
+                    const TYPE * d_row = make_temp_coefs_d ? temp_coefs_d
+                        : (const TYPE *)((const char *) coefs_d + d_offset);
+                    CAT(TYPE, _upsampling_convolution_valid_sf_dual)
+                        (a_row, d_row, a_info->shape[axis],
+                         wavelet->CAT(rec_lo_, TYPE), wavelet->CAT(rec_hi_, TYPE),
+                         wavelet->rec_len, wavelet->rec_lo_symmetry,
+                         wavelet->rec_hi_symmetry, wavelet->CAT(rec_lo_polyphase_, TYPE),
+                         wavelet->CAT(rec_hi_polyphase_, TYPE), output_row,
+                         output_info.shape[axis], mode);
+                } else {
+                    // upsampling_convolution adds to input, so zero
+                    memset(output_row, 0, output_info.shape[axis] * sizeof(TYPE));
+                }
+
+                if (method != METHOD_LIFTING && have_a && !have_d){
+                    // Pointer arithmetic on NULL is undefined
+                    const TYPE * a_row = make_temp_coefs_a ? temp_coefs_a
+                        : (const TYPE *)((const char *) coefs_a + a_offset);
+                    CAT(TYPE, _upsampling_convolution_valid_sf)
+                        (a_row, a_info->shape[axis],
+                         wavelet->CAT(rec_lo_, TYPE), wavelet->rec_len,
+                         wavelet->rec_lo_symmetry, wavelet->CAT(rec_lo_polyphase_, TYPE),
+                         output_row, output_info.shape[axis], mode);
+                }
+                if (method != METHOD_LIFTING && have_d && !have_a){
+                    // Pointer arithmetic on NULL is undefined
+                    const TYPE * d_row = make_temp_coefs_d ? temp_coefs_d
+                        : (const TYPE *)((const char *) coefs_d + d_offset);
+                    CAT(TYPE, _upsampling_convolution_valid_sf)
+                        (d_row, d_info->shape[axis],
+                         wavelet->CAT(rec_hi_, TYPE), wavelet->rec_len,
+                         wavelet->rec_hi_symmetry, wavelet->CAT(rec_hi_polyphase_, TYPE),
+                         output_row, output_info.shape[axis], mode);
+                }
+
+                // Copy from temporary output if necessary
+                if (make_temp_output)
+                    for (j = 0; j < output_info.shape[axis]; ++j)
+                        // Offsets are byte offsets, to need to cast to char and back
+                        *(TYPE *)((char *) output + output_offset
+                                  + j * output_info.strides[axis]) = output_row[j];
             }
-        }
 
-        // Copy to temporary input if necessary
-        if (make_temp_coefs_a)
-            for (j = 0; j < a_info->shape[axis]; ++j)
-                // Offsets are byte offsets, to need to cast to char and back
-                temp_coefs_a[j] = *(TYPE *)((char *) coefs_a + a_offset
-                                            + j * a_info->strides[axis]);
-        if (make_temp_coefs_d)
-            for (j = 0; j < d_info->shape[axis]; ++j)
-                // Offsets are byte offsets, to need to cast to char and back
-                temp_coefs_d[j] = *(TYPE *)((char *) coefs_d + d_offset
-                                            + j * d_info->strides[axis]);
-
-        // Select temporary or direct output
-        output_row = make_temp_output ? temp_output
-            : (TYPE *)((char *) output + output_offset);
-
-        // upsampling_convolution adds to input, so zero
-        memset(output_row, 0, output_info.shape[axis] * sizeof(TYPE));
+        free(temp_coefs_a);
+        free(temp_coefs_d);
+        free(temp_output);
+    }
+    return retval;
+}
 
-        if (have_a){
-            // Pointer arithmetic on NULL is undefined
-            const TYPE * a_row = make_temp_coefs_a ? temp_coefs_a
-                : (const TYPE *)((const char *) coefs_a + a_offset);
-            CAT(TYPE, _upsampling_convolution_valid_sf)
-                (a_row, a_info->shape[axis],
-                 wavelet->CAT(rec_lo_, TYPE), wavelet->rec_len,
-                 output_row, output_info.shape[axis],
-                 mode);
-        }
-        if (have_d){
-            // Pointer arithmetic on NULL is undefined
-            const TYPE * d_row = make_temp_coefs_d ? temp_coefs_d
-                : (const TYPE *)((const char *) coefs_d + d_offset);
-            CAT(TYPE, _upsampling_convolution_valid_sf)
-                (d_row, d_info->shape[axis],
-                 wavelet->CAT(rec_hi_, TYPE), wavelet->rec_len,
-                 output_row, output_info.shape[axis],
-                 mode);
+
+/* Complex data
+ *
+ * Complex values are stored as interleaved real and imaginary parts of type
+ * TYPE, and the filters are real: the array transforms as a real array with
+ * an additional axis of length 2 selecting the part. The tiled transforms
+ * then compute both parts in a single pass along any axis. If all arrays are
+ * contiguous along another axis, it is merged with the additional one into
+ * a single contiguous axis of twice the length, so that the tiles span
+ * several rows of complex values.
+ */
+
+/* Fills real_infos[k] with the real view of the complex array described by
+ * infos[k], for the infos that are not NULL, which must all have the same
+ * number of dimensions. Returns the memory to free once the real views are
+ * no longer needed, or NULL if it could not be allocated. */
+static void * CAT(TYPE, _complex_infos)(const ArrayInfo * const * const infos,
+                                        const size_t n_infos, const size_t axis,
+                                        ArrayInfo * const real_infos){
+    const ArrayInfo * first = NULL;
+    size_t c, k, ndim, merged = 0;
+    size_t * shapes;
+    pywt_index_t * strides;
+
+    for (k = 0; k < n_infos && first == NULL; ++k)
+        first = infos[k];
+    if (first == NULL)
+        return NULL;
+    ndim = first->ndim;
+
+    // last axes first, being contiguous for C-ordered arrays
+    for (c = ndim; c-- > 0; ){
+        if (c == axis || first->shape[c] < 2)
+            continue;
+        merged = 1;
+        for (k = 0; k < n_infos; ++k)
+            if (infos[k] != NULL && infos[k]->strides[c] != 2 * (pywt_index_t) sizeof(TYPE))
+                merged = 0;
+        if (merged)
+            break;
+    }
+
+    // a single allocation for the shapes and strides of all views
+    if ((strides = malloc(n_infos * (ndim + 1) * (sizeof(pywt_index_t) + sizeof(size_t))))
+        == NULL)
+        return NULL;
+    shapes = (size_t *) (strides + n_infos * (ndim + 1));
+    for (k = 0; k < n_infos; ++k){
+        ArrayInfo * const real = &real_infos[k];
+        if (infos[k] == NULL)
+            continue;
+        real->shape = shapes + k * (ndim + 1);
+        real->strides = strides + k * (ndim + 1);
+        memcpy(real->shape, infos[k]->shape, ndim * sizeof(size_t));
+        memcpy(real->strides, infos[k]->strides, ndim * sizeof(pywt_index_t));
+        if (merged){
+            real->ndim = ndim;
+            real->shape[c] *= 2;
+            real->strides[c] = sizeof(TYPE);
+        } else {
+            real->ndim = ndim + 1;
+            real->shape[ndim] = 2;
+            real->strides[ndim] = sizeof(TYPE);
         }
+    }
+    return strides;
+}
+
+
+int CAT(TYPE, _complex_dwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                                 TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                 TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                                 const Wavelet * const restrict wavelet, const size_t axis,
+                                 const MODE mode, const METHOD method,
+                                 const unsigned int workers){
+    const ArrayInfo * const infos[3] = {&input_info, &a_info, &d_info};
+    ArrayInfo real_infos[3];
+    void * buffer;
+    int retval;
+
+    if (input_info.ndim != a_info.ndim || input_info.ndim != d_info.ndim)
+        return 1;
+    if (axis >= input_info.ndim)
+        return 1;
+    if ((buffer = CAT(TYPE, _complex_infos)(infos, 3, axis, real_infos)) == NULL)
+        return 2;
+    retval = CAT(TYPE, _dwt_axis)(input, real_infos[0], coefs_a, real_infos[1],
+                                  coefs_d, real_infos[2], wavelet, axis, mode, method,
+                                  workers);
+    free(buffer);
+    return retval;
+}
+
+
+int CAT(TYPE, _complex_idwt_axis)(const TYPE * const restrict coefs_a,
+                                  const ArrayInfo * const a_info,
+                                  const TYPE * const restrict coefs_d,
+                                  const ArrayInfo * const d_info,
+                                  TYPE * const restrict output, const ArrayInfo output_info,
+                                  const Wavelet * const restrict wavelet,
+                                  const size_t axis, const MODE mode, const METHOD method,
+                                  const unsigned int workers){
+    const int have_a = ((coefs_a != NULL) && (a_info != NULL));
+    const int have_d = ((coefs_d != NULL) && (d_info != NULL));
+    const ArrayInfo * const infos[3] = {&output_info, have_a ? a_info : NULL,
+                                        have_d ? d_info : NULL};
+    ArrayInfo real_infos[3];
+    void * buffer;
+    int retval;
+
+    if (!have_a && !have_d)
+        return 3;
+    if ((have_a && (a_info->ndim != output_info.ndim)) ||
+        (have_d && (d_info->ndim != output_info.ndim)))
+        return 1;
+    if (axis >= output_info.ndim)
+        return 1;
+    if ((buffer = CAT(TYPE, _complex_infos)(infos, 3, axis, real_infos)) == NULL)
+        return 2;
+    retval = CAT(TYPE, _idwt_axis)(have_a ? coefs_a : NULL, have_a ? &real_infos[1] : NULL,
+                                   have_d ? coefs_d : NULL, have_d ? &real_infos[2] : NULL,
+                                   output, real_infos[0], wavelet, axis, mode, method,
+                                   workers);
+    free(buffer);
+    return retval;
+}
 
-        // Copy from temporary output if necessary
-        if (make_temp_output)
-            for (j = 0; j < output_info.shape[axis]; ++j)
-                // Offsets are byte offsets, to need to cast to char and back
-                *(TYPE *)((char *) output + output_offset
-                          + j * output_info.strides[axis]) = output_row[j];
+
+/* Offset in the padded output of the element with index (left[d] + i_d) for
+ * d = [0..n), and 0 for the remaining dimensions, where i is the index of
+ * the element in the input of shape[0..n) in C order */
+static size_t CAT(TYPE, _pad_offset)(size_t i, const size_t n, const size_t * const shape,
+                                     const size_t * const pad_widths,
+                                     const size_t * const output_strides){
+    size_t d, offset = 0;
+    for (d = n; d-- > 0; ){
+        offset += (pad_widths[2*d] + i % shape[d]) * output_strides[d];
+        i /= shape[d];
     }
+    return offset;
+}
 
-    free(temp_coefs_a);
-    free(temp_coefs_d);
-    free(temp_output);
-    return 0;
 
- cleanup:
-    free(temp_coefs_a);
-    free(temp_coefs_d);
-    free(temp_output);
-    return 2;
+int CAT(TYPE, _pad)(const TYPE * const restrict input, const size_t ndim,
+                    const size_t * const input_shape, TYPE * const restrict output,
+                    const size_t * const pad_widths, const MODE mode){
+    size_t d, n_rows = 1, * output_strides;
+    pywt_index_t a;
+
+    if (ndim == 0)
+        return 1;
+    for (d = 0; d < ndim; ++d)
+        if (input_shape[d] == 0 && pad_widths[2*d] + pad_widths[2*d + 1] > 0)
+            return 1;
+    if ((output_strides = malloc(ndim * sizeof(size_t))) == NULL)
+        return 2;
+    output_strides[ndim - 1] = 1;
+    for (d = ndim - 1; d > 0; --d)
+        output_strides[d - 1] = output_strides[d]
+            * (input_shape[d] + pad_widths[2*d] + pad_widths[2*d + 1]);
+    for (d = 0; d + 1 < ndim; ++d)
+        n_rows *= input_shape[d];
+
+    // Copy the input to the center of the output
+    if (input_shape[ndim - 1] > 0){
+        size_t row;
+        for (row = 0; row < n_rows; ++row)
+            memcpy(output + CAT(TYPE, _pad_offset)(row, ndim - 1, input_shape, pad_widths,
+                                                   output_strides)
+                   + pad_widths[2*(ndim - 1)],
+                   input + row * input_shape[ndim - 1],
+                   input_shape[ndim - 1] * sizeof(TYPE));
+    }
+
+    /* Extend along each axis, the last one first, so that the slabs copied
+     * along axis a are complete along the axes after it. Only the slabs
+     * within the input along the axes before a are extended now, the rest
+     * are copies of them made later. */
+    for (a = (pywt_index_t) ndim - 1; a >= 0; --a){
+        const size_t N = input_shape[a], left = pad_widths[2*a];
+        const size_t n_edge = left + pad_widths[2*a + 1];
+        const size_t inner = output_strides[a];
+        size_t outer = 1, o, e;
+        /* For each edge position, the number of terms, offsets of x0 and x1
+         * and t, see extended_indices */
+        pywt_index_t * map;
+
+        if (n_edge == 0)
+            continue;
+        if ((map = malloc(n_edge * 4 * sizeof(pywt_index_t))) == NULL){
+            free(output_strides);
+            return 2;
+        }
+        for (e = 0; e < n_edge; ++e){
+            const size_t k = e < left ? e : e + N;
+            pywt_index_t indices[2] = {0, 0}, coefs[2] = {1, 0};
+            pywt_index_t * const m = map + 4*e;
+            m[0] = (pywt_index_t) extended_indices((pywt_index_t) k - (pywt_index_t) left, N,
+                                                   mode, indices, coefs);
+            m[1] = (indices[0] + (pywt_index_t) left) * (pywt_index_t) inner;
+            m[2] = (indices[1] + (pywt_index_t) left) * (pywt_index_t) inner;
+            m[3] = -coefs[1];
+        }
+        for (d = 0; d < (size_t) a; ++d)
+            outer *= input_shape[d];
+
+        for (o = 0; o < outer; ++o){
+            TYPE * const out = output + CAT(TYPE, _pad_offset)(o, a, input_shape, pad_widths,
+                                                               output_strides);
+            for (e = 0; e < n_edge; ++e){
+                const pywt_index_t * const m = map + 4*e;
+                TYPE * const slab = out + (e < left ? e : e + N) * inner;
+                const TYPE * const x0 = out + m[1];
+                size_t l;
+
+                if (m[0] == 0){
+                    for (l = 0; l < inner; ++l)
+                        slab[l] = 0;
+                } else if (m[0] == 1){
+                    if (inner == 1)
+                        *slab = *x0;
+                    else
+                        memcpy(slab, x0, inner * sizeof(TYPE));
+                } else {
+                    // evaluated as in _extended_value, x0 + t * (x0 - x1)
+                    const TYPE * const x1 = out + m[2];
+                    const TYPE t = (TYPE) m[3];
+                    for (l = 0; l < inner; ++l)
+                        slab[l] = x0[l] + t * (x0[l] - x1[l]);
+                }
+            }
+        }
+        free(map);
+    }
+    free(output_strides);
+    return 0;
 }
 
 
@@ -282,7 +1111,8 @@ int CAT(TYPE, _dec_a)(const TYPE * const restrict input, const size_t input_len,
 
     return CAT(TYPE, _downsampling_convolution)(input, input_len,
                                                 wavelet->CAT(dec_lo_, TYPE),
-                                                wavelet->dec_len, output,
+                                                wavelet->dec_len,
+                                                &wavelet->dec_lo_symmetry, output,
                                                 2, mode);
 }
 
@@ -300,11 +1130,41 @@ int CAT(TYPE, _dec_d)(const TYPE * const restrict input, const size_t input_len,
 
     return CAT(TYPE, _downsampling_convolution)(input, input_len,
                                                 wavelet->CAT(dec_hi_, TYPE),
-                                                wavelet->dec_len, output,
+                                                wavelet->dec_len,
+                                                &wavelet->dec_hi_symmetry, output,
                                                 2, mode);
 }
 
 
+/* Decomposition of input with lowpass and highpass filters in one pass */
+
+int CAT(TYPE, _dec)(const TYPE * const restrict input, const size_t input_len,
+                    const Wavelet * const restrict wavelet,
+                    TYPE * const restrict output_a, TYPE * const restrict output_d,
+                    const size_t output_len, const MODE mode, const METHOD method){
+
+    /* check output length */
+    if(output_len != dwt_buffer_length(input_len, wavelet->dec_len, mode))
+        return -1;
+
+    if(method == METHOD_LIFTING){
+        if(wavelet->lifting == NULL)
+            return -1;
+        return CAT(TYPE, _lifting_dec)(input, input_len, wavelet->lifting,
+                                       wavelet->dec_len, output_a, output_d,
+                                       output_len, mode);
+    }
+
+    return CAT(TYPE, _downsampling_convolution_dual)(input, input_len,
+                                                     wavelet->CAT(dec_lo_, TYPE),
+                                                     wavelet->CAT(dec_hi_, TYPE),
+                                                     wavelet->dec_len,
+                                                     &wavelet->dec_lo_symmetry,
+                                                     &wavelet->dec_hi_symmetry,
+                                                     output_a, output_d, mode);
+}
+
+
 /* Direct reconstruction with lowpass reconstruction filter */
 
 int CAT(TYPE, _rec_a)(const TYPE * const restrict coeffs_a, const size_t coeffs_len,
@@ -317,8 +1177,9 @@ int CAT(TYPE, _rec_a)(const TYPE * const restrict coeffs_a, const size_t coeffs_
 
     return CAT(TYPE, _upsampling_convolution_full)(coeffs_a, coeffs_len,
                                                    wavelet->CAT(rec_lo_, TYPE),
-                                                   wavelet->rec_len, output,
-                                                   output_len);
+                                                   wavelet->rec_len,
+                                                   wavelet->CAT(rec_lo_polyphase_, TYPE),
+                                                   output, output_len);
 }
 
 
@@ -334,8 +1195,9 @@ int CAT(TYPE, _rec_d)(const TYPE * const restrict coeffs_d, const size_t coeffs_
 
     return CAT(TYPE, _upsampling_convolution_full)(coeffs_d, coeffs_len,
                                                    wavelet->CAT(rec_hi_, TYPE),
-                                                   wavelet->rec_len, output,
-                                                   output_len);
+                                                   wavelet->rec_len,
+                                                   wavelet->CAT(rec_hi_polyphase_, TYPE),
+                                                   output, output_len);
 }
 
 
@@ -343,12 +1205,13 @@ int CAT(TYPE, _rec_d)(const TYPE * const restrict coeffs_d, const size_t coeffs_
  * IDWT reconstruction from approximation and detail coeffs, either of which may
  * be NULL.
  *
- * Requires zero-filled output buffer.
+ * The output is overwritten.
  */
 int CAT(TYPE, _idwt)(const TYPE * const restrict coeffs_a, const size_t coeffs_a_len,
                      const TYPE * const restrict coeffs_d, const size_t coeffs_d_len,
                      TYPE * const restrict output, const size_t output_len,
-                     const Wavelet * const restrict wavelet, const MODE mode){
+                     const Wavelet * const restrict wavelet, const MODE mode,
+                     const METHOD method){
     size_t input_len;
     if(coeffs_a != NULL && coeffs_d != NULL){
         if(coeffs_a_len != coeffs_d_len)
@@ -366,17 +1229,42 @@ int CAT(TYPE, _idwt)(const TYPE * const restrict coeffs_a, const size_t coeffs_a
     if(output_len != idwt_buffer_length(input_len, wavelet->rec_len, mode))
         goto error;
 
-    /*
-     * Set output to zero (this can be omitted if output array is already
-     * cleared) memset(output, 0, output_len * sizeof(TYPE));
-     */
+    if(method == METHOD_LIFTING){
+        if(wavelet->lifting == NULL)
+            goto error;
+        if(CAT(TYPE, _lifting_rec)(coeffs_a, coeffs_d, input_len, wavelet->lifting,
+                                   wavelet->rec_len, output, output_len, mode) < 0)
+            goto error;
+        return 0;
+    }
+
+    /* reconstruct both in a single pass, writing each output once */
+    if(coeffs_a && coeffs_d){
+        if(CAT(TYPE, _upsampling_convolution_valid_sf_dual)(coeffs_a, coeffs_d, input_len,
+                                                           wavelet->CAT(rec_lo_, TYPE),
+                                                           wavelet->CAT(rec_hi_, TYPE),
+                                                           wavelet->rec_len,
+                                                           wavelet->rec_lo_symmetry,
+                                                           wavelet->rec_hi_symmetry,
+                                                           wavelet->CAT(rec_lo_polyphase_, TYPE),
+                                                           wavelet->CAT(rec_hi_polyphase_, TYPE),
+                                                           output, output_len, mode) < 0){
+            goto error;
+        }
+        return 0;
+    }
+
+    /* otherwise the convolutions add to the output, so zero it first */
+    memset(output, 0, output_len * sizeof(TYPE));
 
     /* reconstruct approximation coeffs with lowpass reconstruction filter */
     if(coeffs_a){
         if(CAT(TYPE, _upsampling_convolution_valid_sf)(coeffs_a, input_len,
                                                   wavelet->CAT(rec_lo_, TYPE),
-                                                  wavelet->rec_len, output,
-                                                  output_len, mode) < 0){
+                                                  wavelet->rec_len,
+                                                  wavelet->rec_lo_symmetry,
+                                                  wavelet->CAT(rec_lo_polyphase_, TYPE),
+                                                  output, output_len, mode) < 0){
             goto error;
         }
     }
@@ -387,8 +1275,10 @@ int CAT(TYPE, _idwt)(const TYPE * const restrict coeffs_a, const size_t coeffs_a
     if(coeffs_d){
         if(CAT(TYPE, _upsampling_convolution_valid_sf)(coeffs_d, input_len,
                                                   wavelet->CAT(rec_hi_, TYPE),
-                                                  wavelet->rec_len, output,
-                                                  output_len, mode) < 0){
+                                                  wavelet->rec_len,
+                                                  wavelet->rec_hi_symmetry,
+                                                  wavelet->CAT(rec_hi_polyphase_, TYPE),
+                                                  output, output_len, mode) < 0){
             goto error;
         }
     }
@@ -399,47 +1289,358 @@ int CAT(TYPE, _idwt)(const TYPE * const restrict coeffs_a, const size_t coeffs_a
         return -1;
 }
 
-/* basic SWT step (TODO: optimize) */
+
+/* Multilevel transforms, running all levels for one row before the next */
+
+int CAT(TYPE, _wavedec)(const TYPE * const restrict input, const size_t n_rows,
+                        const size_t input_len, const Wavelet * const restrict wavelet,
+                        TYPE * const * const coefs, const size_t * const coefs_lens,
+                        const unsigned int level, const MODE mode, const METHOD method,
+                        const unsigned int workers){
+    return CAT(TYPE, _wavedec_cast)(input, INPUT_NATIVE, n_rows, input_len, wavelet, coefs,
+                                    coefs_lens, level, mode, method, workers);
+}
+
+
+int CAT(TYPE, _wavedec_cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                             const size_t n_rows, const size_t input_len,
+                             const Wavelet * const restrict wavelet,
+                             TYPE * const * const coefs, const size_t * const coefs_lens,
+                             const unsigned int level, const MODE mode, const METHOD method,
+                             const unsigned int workers){
+    const size_t in_size = input_itemsize(input_type, sizeof(TYPE));
+    size_t n = input_len, temp_len = 0;
+    unsigned int l;
+    int retval = 0;
+
+    if (level < 1 || input_type < INPUT_NATIVE || input_type >= INPUT_MAX)
+        return 1;
+    if (method == METHOD_LIFTING && wavelet->lifting == NULL)
+        return 1;
+
+    // the approximations of all but the last level go to temporary buffers
+    for (l = 1; l <= level; ++l){
+        n = dwt_buffer_length(n, wavelet->dec_len, mode);
+        if (n == 0 || coefs_lens[level + 1 - l] != n)
+            return 1;
+        if (l < level && n > temp_len)
+            temp_len = n;
+    }
+    if (coefs_lens[0] != n)
+        return 1;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, n_rows)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * temp = NULL, * converted = NULL;
+        size_t row, first, last;
+
+        parallel_range(n_rows, &first, &last);
+        if ((temp_len > 0 && (temp = malloc(2 * temp_len * sizeof(TYPE))) == NULL) ||
+            (input_type != INPUT_NATIVE &&
+             (converted = malloc(input_len * sizeof(TYPE))) == NULL))
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                const void * const input_row = (const char *) input + row * input_len * in_size;
+                const TYPE * a = input_row;
+                size_t a_len = input_len;
+                unsigned int k;
+                if (input_type != INPUT_NATIVE){
+                    CAT(TYPE, _cast)(input_row, input_type, (pywt_index_t) in_size, converted,
+                                     input_len);
+                    a = converted;
+                }
+                for (k = level; k > 0; --k){
+                    // k indexes the details of level (level + 1 - k)
+                    TYPE * const output_a = (k == 1) ? coefs[0] + row * coefs_lens[0]
+                        : temp + (k % 2) * temp_len;
+                    if (CAT(TYPE, _dec)(a, a_len, wavelet, output_a,
+                                        coefs[k] + row * coefs_lens[k], coefs_lens[k],
+                                        mode, method) < 0){
+                        retval = 2;
+                        break;
+                    }
+                    a = output_a;
+                    a_len = coefs_lens[k];
+                }
+                if (retval)
+                    break;
+            }
+        free(temp);
+        free(converted);
+    }
+    return retval;
+}
+
+
+int CAT(TYPE, _waverec)(const TYPE * const * const coefs, const size_t * const coefs_lens,
+                        const size_t n_rows, const Wavelet * const restrict wavelet,
+                        TYPE * const restrict output, const size_t output_len,
+                        const unsigned int level, const MODE mode, const METHOD method,
+                        const unsigned int workers){
+    size_t n = coefs_lens[0], temp_len = 0;
+    unsigned int k;
+    int retval = 0;
+
+    if (level < 1)
+        return 1;
+    if (method == METHOD_LIFTING && wavelet->lifting == NULL)
+        return 1;
+
+    // the reconstructions of all but the last level go to temporary buffers
+    for (k = 1; k <= level; ++k){
+        if (n != coefs_lens[k] && n != coefs_lens[k] + 1)
+            return 1;
+        n = idwt_buffer_length(coefs_lens[k], wavelet->rec_len, mode);
+        if (n == 0)
+            return 1;
+        if (k < level && n > temp_len)
+            temp_len = n;
+    }
+    if (n != output_len)
+        return 1;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, n_rows)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * temp = NULL;
+        size_t row, first, last;
+
+        parallel_range(n_rows, &first, &last);
+        if (temp_len > 0 && (temp = malloc(2 * temp_len * sizeof(TYPE))) == NULL)
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                const TYPE * a = coefs[0] + row * coefs_lens[0];
+                unsigned int j;
+                for (j = 1; j <= level; ++j){
+                    const size_t rec_len = idwt_buffer_length(coefs_lens[j],
+                                                              wavelet->rec_len, mode);
+                    TYPE * const rec = (j == level) ? output + row * output_len
+                        : temp + (j % 2) * temp_len;
+                    if (CAT(TYPE, _idwt)(a, coefs_lens[j],
+                                         coefs[j] + row * coefs_lens[j], coefs_lens[j],
+                                         rec, rec_len, wavelet, mode, method) < 0){
+                        retval = 2;
+                        break;
+                    }
+                    a = rec;
+                }
+                if (retval)
+                    break;
+            }
+        free(temp);
+    }
+    return retval;
+}
+
+
+/* The real and imaginary parts of n complex values, and back */
+static void CAT(TYPE, _complex_split)(const TYPE * const restrict input, const size_t n,
+                                      TYPE * const restrict real, TYPE * const restrict imag){
+    size_t i;
+    for (i = 0; i < n; ++i){
+        real[i] = input[2*i];
+        imag[i] = input[2*i + 1];
+    }
+}
+
+
+static void CAT(TYPE, _complex_join)(const TYPE * const restrict real,
+                                     const TYPE * const restrict imag, const size_t n,
+                                     TYPE * const restrict output){
+    size_t i;
+    for (i = 0; i < n; ++i){
+        output[2*i] = real[i];
+        output[2*i + 1] = imag[i];
+    }
+}
+
+
+/* Multilevel transforms of complex rows: each row is split into its real and
+ * imaginary parts once, both are transformed level by level as in _wavedec
+ * and _waverec, and the coefficients of each level are joined again. */
+int CAT(TYPE, _complex_wavedec)(const TYPE * const restrict input, const size_t n_rows,
+                                const size_t input_len, const Wavelet * const restrict wavelet,
+                                TYPE * const * const coefs, const size_t * const coefs_lens,
+                                const unsigned int level, const MODE mode,
+                                const METHOD method, const unsigned int workers){
+    size_t n = input_len, max_len = 0;
+    unsigned int l;
+    int retval = 0;
+
+    if (level < 1)
+        return 1;
+    if (method == METHOD_LIFTING && wavelet->lifting == NULL)
+        return 1;
+
+    // the coefficients may be longer than the input for long filters
+    for (l = 1; l <= level; ++l){
+        n = dwt_buffer_length(n, wavelet->dec_len, mode);
+        if (n == 0 || coefs_lens[level + 1 - l] != n)
+            return 1;
+        if (n > max_len)
+            max_len = n;
+    }
+    if (coefs_lens[0] != n)
+        return 1;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, n_rows)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        /* the two parts of the input row, then for each part two buffers
+         * for the approximations (alternating between levels) and one for
+         * the details */
+        TYPE * const buffer = malloc((2 * input_len + 6 * max_len) * sizeof(TYPE));
+        TYPE * const temp = buffer + 2 * input_len;
+        size_t row, first, last;
+
+        parallel_range(n_rows, &first, &last);
+        if (buffer == NULL)
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                const TYPE * a[2];
+                size_t a_len = input_len;
+                unsigned int k, p;
+
+                CAT(TYPE, _complex_split)(input + 2 * row * input_len, input_len,
+                                          buffer, buffer + input_len);
+                a[0] = buffer;
+                a[1] = buffer + input_len;
+                for (k = level; k > 0; --k){
+                    // k indexes the details of level (level + 1 - k)
+                    for (p = 0; p < 2; ++p){
+                        TYPE * const output_a = temp + (2*p + k % 2) * max_len;
+                        if (CAT(TYPE, _dec)(a[p], a_len, wavelet, output_a,
+                                            temp + (4 + p) * max_len, coefs_lens[k],
+                                            mode, method) < 0){
+                            retval = 2;
+                            break;
+                        }
+                        a[p] = output_a;
+                    }
+                    if (retval)
+                        break;
+                    CAT(TYPE, _complex_join)(temp + 4 * max_len, temp + 5 * max_len,
+                                             coefs_lens[k], coefs[k] + 2 * row * coefs_lens[k]);
+                    a_len = coefs_lens[k];
+                }
+                if (retval)
+                    break;
+                CAT(TYPE, _complex_join)(a[0], a[1], coefs_lens[0],
+                                         coefs[0] + 2 * row * coefs_lens[0]);
+            }
+        free(buffer);
+    }
+    return retval;
+}
+
+
+int CAT(TYPE, _complex_waverec)(const TYPE * const * const coefs,
+                                const size_t * const coefs_lens, const size_t n_rows,
+                                const Wavelet * const restrict wavelet,
+                                TYPE * const restrict output, const size_t output_len,
+                                const unsigned int level, const MODE mode,
+                                const METHOD method, const unsigned int workers){
+    size_t n = coefs_lens[0], max_len = coefs_lens[0];
+    unsigned int k;
+    int retval = 0;
+
+    if (level < 1)
+        return 1;
+    if (method == METHOD_LIFTING && wavelet->lifting == NULL)
+        return 1;
+
+    for (k = 1; k <= level; ++k){
+        if (n != coefs_lens[k] && n != coefs_lens[k] + 1)
+            return 1;
+        n = idwt_buffer_length(coefs_lens[k], wavelet->rec_len, mode);
+        if (n == 0)
+            return 1;
+        if (n > max_len)
+            max_len = n;
+    }
+    if (n != output_len)
+        return 1;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, n_rows)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        /* for each part, one buffer for the details and two for the
+         * approximations (alternating between levels) */
+        TYPE * const buffer = malloc(6 * max_len * sizeof(TYPE));
+        size_t row, first, last;
+
+        parallel_range(n_rows, &first, &last);
+        if (buffer == NULL)
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                const TYPE * a[2];
+                unsigned int j, p;
+
+                CAT(TYPE, _complex_split)(coefs[0] + 2 * row * coefs_lens[0], coefs_lens[0],
+                                          buffer, buffer + 2 * max_len);
+                a[0] = buffer;
+                a[1] = buffer + 2 * max_len;
+                for (j = 1; j <= level; ++j){
+                    const size_t rec_len = idwt_buffer_length(coefs_lens[j],
+                                                              wavelet->rec_len, mode);
+                    CAT(TYPE, _complex_split)(coefs[j] + 2 * row * coefs_lens[j],
+                                              coefs_lens[j], buffer + 4 * max_len,
+                                              buffer + 5 * max_len);
+                    for (p = 0; p < 2; ++p){
+                        TYPE * const rec = buffer + (2*p + j % 2) * max_len;
+                        if (CAT(TYPE, _idwt)(a[p], coefs_lens[j],
+                                             buffer + (4 + p) * max_len, coefs_lens[j],
+                                             rec, rec_len, wavelet, mode, method) < 0){
+                            retval = 2;
+                            break;
+                        }
+                        a[p] = rec;
+                    }
+                    if (retval)
+                        break;
+                }
+                if (retval)
+                    break;
+                CAT(TYPE, _complex_join)(a[0], a[1], output_len,
+                                         output + 2 * row * output_len);
+            }
+        free(buffer);
+    }
+    return retval;
+}
+
+/* basic SWT step, convolution with the filter upsampled by 2**(level-1) */
 int CAT(TYPE, _swt_)(TYPE input[], pywt_index_t input_len,
                      const TYPE filter[], pywt_index_t filter_len,
                      TYPE output[], pywt_index_t output_len, int level){
 
-    TYPE * e_filter;
-    pywt_index_t i, e_filter_len;
-    int ret;
-
     if(level < 1)
         return -1;
 
     if(level > swt_max_level(input_len))
         return -2;
 
-    if(output_len != swt_buffer_length(input_len))
+    if(output_len != (pywt_index_t)swt_buffer_length(input_len))
         return -1;
 
-    /* TODO: quick hack, optimize */
-    if(level > 1){
-        /* allocate filter first */
-        e_filter_len = filter_len << (level-1);
-        e_filter = wtcalloc(e_filter_len, sizeof(TYPE));
-        if(e_filter == NULL)
-            return -1;
-
-        /* compute upsampled filter values */
-        for(i = 0; i < filter_len; ++i){
-            e_filter[i << (level-1)] = filter[i];
-        }
-        ret = CAT(TYPE, _downsampling_convolution)(input, input_len, e_filter,
-                                                   e_filter_len, output, 1,
-                                                   MODE_PERIODIZATION);
-        wtfree(e_filter);
-        return ret;
-
-    } else {
-        return CAT(TYPE, _downsampling_convolution)(input, input_len, filter,
-                                                    filter_len, output, 1,
+    return CAT(TYPE, _upsampled_filter_convolution)(input, input_len, filter,
+                                                    filter_len, output,
+                                                    (size_t) 1 << (level-1),
+                                                    ((size_t) 1 << (level-1)) * (filter_len/2),
                                                     MODE_PERIODIZATION);
-    }
 }
 
 /*
@@ -461,5 +1662,726 @@ int CAT(TYPE, _swt_d)(TYPE input[], pywt_index_t input_len, Wavelet* wavelet,
                             wavelet->dec_len, output, output_len, level);
 }
 
+/* Reconstruction of the approximation at level - 1 from the approximation
+ * and details at specified level
+ */
+int CAT(TYPE, _iswt)(TYPE coeffs_a[], TYPE coeffs_d[], pywt_index_t coeffs_len,
+                     Wavelet* wavelet, TYPE output[], pywt_index_t output_len,
+                     int level){
+
+    if(level < 1)
+        return -1;
+
+    if(level > swt_max_level(coeffs_len))
+        return -2;
+
+    if(output_len != (pywt_index_t)swt_buffer_length(coeffs_len))
+        return -1;
+
+    return CAT(TYPE, _upsampled_filter_convolution_dual)(coeffs_a, coeffs_d, coeffs_len,
+                                                         wavelet->CAT(rec_lo_, TYPE),
+                                                         wavelet->CAT(rec_hi_, TYPE),
+                                                         wavelet->rec_len, output,
+                                                         (size_t) 1 << (level-1),
+                                                         ((size_t) 1 << (level-1))
+                                                         * (wavelet->rec_len/2 - 1),
+                                                         MODE_PERIODIZATION);
+}
+
+int CAT(TYPE, _swt_multilevel)(const TYPE * const restrict input, const size_t input_len,
+                               const Wavelet * const restrict wavelet,
+                               TYPE * const * const coefs_a, TYPE * const * const coefs_d,
+                               const unsigned int level, const unsigned int start_level){
+    const TYPE * a = input;
+    unsigned int l;
+
+    if (level < 1 || input_len % 2)
+        return 1;
+    if (start_level + level > swt_max_level(input_len))
+        return 1;
+
+    // the approximation of each level, in its output, is the input of the next
+    for (l = start_level + 1; l <= start_level + level; ++l){
+        const size_t k = start_level + level - l;
+        const size_t step = (size_t) 1 << (l - 1), offset = step * (wavelet->dec_len/2);
+        if (CAT(TYPE, _upsampled_filter_convolution)(a, input_len,
+                                                     wavelet->CAT(dec_hi_, TYPE),
+                                                     wavelet->dec_len, coefs_d[k],
+                                                     step, offset, MODE_PERIODIZATION) < 0
+            || CAT(TYPE, _upsampled_filter_convolution)(a, input_len,
+                                                        wavelet->CAT(dec_lo_, TYPE),
+                                                        wavelet->dec_len, coefs_a[k],
+                                                        step, offset,
+                                                        MODE_PERIODIZATION) < 0)
+            return 1;
+        a = coefs_a[k];
+    }
+    return 0;
+}
+
+
+int CAT(TYPE, _iswt_multilevel)(const TYPE * const restrict coefs_a,
+                                const TYPE * const * const coefs_d, const size_t coefs_len,
+                                const Wavelet * const restrict wavelet,
+                                TYPE * const restrict output, const unsigned int level){
+    TYPE * temp = NULL;
+    const TYPE * a = coefs_a;
+    unsigned int l;
+    int retval = 0;
+
+    if (level < 1 || coefs_len % 2 || level > swt_max_level(coefs_len))
+        return 1;
+
+    /* the levels alternate between output and temp, so that the last one
+     * writes to output */
+    if (level > 1 && (temp = malloc(coefs_len * sizeof(TYPE))) == NULL)
+        return 2;
+    for (l = level; l >= 1; --l){
+        TYPE * const rec = (level - l) % 2 == (level - 1) % 2 ? output : temp;
+        const size_t step = (size_t) 1 << (l - 1);
+        if (CAT(TYPE, _upsampled_filter_convolution_dual)(a, coefs_d[level - l], coefs_len,
+                                                          wavelet->CAT(rec_lo_, TYPE),
+                                                          wavelet->CAT(rec_hi_, TYPE),
+                                                          wavelet->rec_len, rec, step,
+                                                          step * (wavelet->rec_len/2 - 1),
+                                                          MODE_PERIODIZATION) < 0){
+            retval = 1;
+            break;
+        }
+        a = rec;
+    }
+    free(temp);
+    return retval;
+}
+
+/* Stationary transforms along an axis
+ *
+ * The periodic convolutions of CAT(TYPE, _upsampled_filter_convolution),
+ * along an axis of arrays that all have the same shape. Non-contiguous axes
+ * are transformed a tile of rows at a time, as the decimating transforms.
+ */
+
+/* Output k is the sum of the periodic convolutions of the n_in inputs with
+ * the filters upsampled by step, the F taps for input m in filters[k][m*F..]:
+ *   outputs[k][o] = sum(filters[k][m*F + j] * inputs[m][(o + shift - step*j) mod N])
+ * for a tile of rows at a time. infos holds the n_in inputs, then the n_out
+ * outputs (at most three arrays). */
+static int CAT(TYPE, _upsampled_axis_tiled)(const TYPE * const * const inputs,
+                                            const size_t n_in,
+                                            TYPE * const * const outputs,
+                                            const size_t n_out,
+                                            const ArrayInfo * const * const infos,
+                                            const TYPE * const * const filters,
+                                            const size_t F, const size_t shift,
+                                            const size_t step, const size_t axis,
+                                            const size_t inner, const unsigned int workers){
+    const size_t n_infos = n_in + n_out;
+    const size_t N = infos[0]->shape[axis], W = infos[0]->shape[inner];
+    const size_t n_tiles = (W + AXIS_TILE_SIZE - 1) / AXIS_TILE_SIZE;
+    const CAT(TYPE, _rows_kernel) kernel = CAT(TYPE, _simd_rows_kernel)();
+    pywt_index_t strides[3];
+    size_t i, num_loops = 1;
+    int retval = 0;
+
+    if (N == 0)
+        return 0;
+    for (i = 0; i < n_infos; ++i)
+        strides[i] = infos[i]->strides[axis] / (pywt_index_t) sizeof(TYPE);
+    for (i = 0; i < infos[0]->ndim; ++i){
+        if (i != axis && i != inner)
+            num_loops *= infos[0]->shape[i];
+    }
+
+    // Tiles are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops * n_tiles)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        const TYPE ** rows = NULL;
+        size_t q, q_first, q_last;
+
+        parallel_range(num_loops * n_tiles, &q_first, &q_last);
+        if ((rows = malloc(n_in * F * sizeof(const TYPE *))) == NULL)
+            retval = 2;
+        else
+            for (q = q_first; q < q_last; ++q){
+                const size_t t = (q % n_tiles) * AXIS_TILE_SIZE;
+                const size_t w = (W - t < AXIS_TILE_SIZE) ? W - t : AXIS_TILE_SIZE;
+                pywt_index_t offsets[3];
+                size_t o, j, k;
+
+                CAT(TYPE, _tile_offsets)(q / n_tiles, infos, n_infos, axis, inner, offsets);
+                for (o = 0; o < N; ++o){
+                    for (k = 0; k < n_in; ++k){
+                        const TYPE * const in =
+                            (const TYPE *)((const char *) inputs[k] + offsets[k]) + t;
+                        for (j = 0; j < F; ++j){
+                            const size_t idx = (o + shift % N + N - (step * j) % N) % N;
+                            rows[k * F + j] = in + (pywt_index_t) idx * strides[k];
+                        }
+                    }
+                    for (k = 0; k < n_out; ++k){
+                        TYPE * const out =
+                            (TYPE *)((char *) outputs[k] + offsets[n_in + k]) + t;
+                        CAT(TYPE, _sum_rows)(rows, filters[k], n_in * F,
+                                             out + (pywt_index_t) o * strides[n_in + k],
+                                             w, kernel);
+                    }
+                }
+            }
+
+        free(rows);
+    }
+    return retval;
+}
+
+
+/* Checks that the arrays of a transform along axis have the same shape */
+static int CAT(TYPE, _same_shape_check)(const ArrayInfo * const * const infos,
+                                        const size_t n_infos, const size_t axis){
+    size_t i, k;
+
+    if (axis >= infos[0]->ndim)
+        return 1;
+    for (k = 1; k < n_infos; ++k){
+        if (infos[k]->ndim != infos[0]->ndim)
+            return 1;
+        for (i = 0; i < infos[0]->ndim; ++i)
+            if (infos[k]->shape[i] != infos[0]->shape[i])
+                return 1;
+    }
+    return 0;
+}
+
+
+/* Checks the arrays of a stationary transform along axis at level: the same
+ * shape, with a length along axis divisible by 2**level */
+static int CAT(TYPE, _swt_axis_check)(const ArrayInfo * const * const infos,
+                                      const size_t n_infos, const size_t axis,
+                                      const unsigned int level){
+    if (level < 1 || CAT(TYPE, _same_shape_check)(infos, n_infos, axis))
+        return 1;
+    return level > swt_max_level(infos[0]->shape[axis]);
+}
+
+
+/* The approximation and detail coefficients of one level of a stationary
+ * transform along axis: the periodic convolutions of input with filter_a and
+ * filter_d upsampled by step, see CAT(TYPE, _upsampled_filter_convolution).
+ * The arrays are checked by the caller. */
+static int CAT(TYPE, _upsampled_dec_axis)(const TYPE * const restrict input,
+                                          const ArrayInfo input_info,
+                                          TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                          TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                                          const TYPE * const restrict filter_a,
+                                          const TYPE * const restrict filter_d,
+                                          const size_t F, const size_t step,
+                                          const size_t offset, const size_t axis,
+                                          const unsigned int workers){
+    const ArrayInfo * const infos[3] = {&input_info, &a_info, &d_info};
+    const size_t N = input_info.shape[axis];
+    size_t i, num_loops = 1;
+    int retval = 0;
+    int make_temp_input, make_temp_a, make_temp_d;
+
+    if (input_info.strides[axis] != sizeof(TYPE)){
+        size_t inner;
+        if (CAT(TYPE, _tile_axis)(infos, 3, sizeof(TYPE), axis, &inner)){
+            const TYPE * const filters[2] = {filter_a, filter_d};
+            const TYPE * const inputs[1] = {input};
+            TYPE * const outputs[2] = {coefs_a, coefs_d};
+            return CAT(TYPE, _upsampled_axis_tiled)(inputs, 1, outputs, 2, infos, filters,
+                                                    F, offset, step, axis, inner, workers);
+        }
+    }
+
+    make_temp_input = input_info.strides[axis] != sizeof(TYPE);
+    make_temp_a = a_info.strides[axis] != sizeof(TYPE);
+    make_temp_d = d_info.strides[axis] != sizeof(TYPE);
+
+    for (i = 0; i < input_info.ndim; ++i){
+        if (i != axis)
+            num_loops *= input_info.shape[i];
+    }
+
+    // Rows are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * temp_input = NULL, * temp_a = NULL, * temp_d = NULL;
+        size_t row, first, last;
+
+        parallel_range(num_loops, &first, &last);
+        if ((make_temp_input && (temp_input = malloc(N * sizeof(TYPE))) == NULL) ||
+            (make_temp_a && (temp_a = malloc(N * sizeof(TYPE))) == NULL) ||
+            (make_temp_d && (temp_d = malloc(N * sizeof(TYPE))) == NULL))
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                pywt_index_t offsets[3];
+                const TYPE * input_row;
+                TYPE * a_row, * d_row;
+                size_t j;
+
+                // inner == axis: the offsets of the rows along axis
+                CAT(TYPE, _tile_offsets)(row, infos, 3, axis, axis, offsets);
+
+                if (make_temp_input)
+                    CAT(TYPE, _cast)((const char *) input + offsets[0], INPUT_NATIVE,
+                                     input_info.strides[axis], temp_input, N);
+                input_row = make_temp_input ? temp_input
+                    : (const TYPE *)((const char *) input + offsets[0]);
+                a_row = make_temp_a ? temp_a : (TYPE *)((char *) coefs_a + offsets[1]);
+                d_row = make_temp_d ? temp_d : (TYPE *)((char *) coefs_d + offsets[2]);
+
+                if (CAT(TYPE, _upsampled_filter_convolution)(input_row, N, filter_a, F,
+                                                             a_row, step, offset,
+                                                             MODE_PERIODIZATION) < 0 ||
+                    CAT(TYPE, _upsampled_filter_convolution)(input_row, N, filter_d, F,
+                                                             d_row, step, offset,
+                                                             MODE_PERIODIZATION) < 0){
+                    retval = 1;
+                    break;
+                }
+
+                // Copy from temporary output if necessary
+                if (make_temp_a)
+                    for (j = 0; j < N; ++j)
+                        *(TYPE *)((char *) coefs_a + offsets[1]
+                                  + (pywt_index_t) j * a_info.strides[axis]) = a_row[j];
+                if (make_temp_d)
+                    for (j = 0; j < N; ++j)
+                        *(TYPE *)((char *) coefs_d + offsets[2]
+                                  + (pywt_index_t) j * d_info.strides[axis]) = d_row[j];
+            }
+
+        free(temp_input);
+        free(temp_a);
+        free(temp_d);
+    }
+    return retval;
+}
+
+
+/* The inverse of one level of a stationary transform along axis, see
+ * CAT(TYPE, _upsampled_filter_convolution_dual). The arrays are checked by
+ * the caller. */
+static int CAT(TYPE, _upsampled_rec_axis)(const TYPE * const restrict coefs_a,
+                                          const ArrayInfo a_info,
+                                          const TYPE * const restrict coefs_d,
+                                          const ArrayInfo d_info,
+                                          TYPE * const restrict output,
+                                          const ArrayInfo output_info,
+                                          const TYPE * const restrict filter_a,
+                                          const TYPE * const restrict filter_d,
+                                          const size_t F, const size_t step,
+                                          const size_t offset, const size_t axis,
+                                          const unsigned int workers){
+    const ArrayInfo * const infos[3] = {&a_info, &d_info, &output_info};
+    const size_t N = a_info.shape[axis];
+    size_t i, num_loops = 1;
+    int retval = 0;
+    int make_temp_a, make_temp_d, make_temp_output;
+
+    if (output_info.strides[axis] != sizeof(TYPE)){
+        size_t inner;
+        if (CAT(TYPE, _tile_axis)(infos, 3, sizeof(TYPE), axis, &inner)){
+            // the average of the reconstructions from the even and odd samples
+            TYPE * const weights = malloc(2 * F * sizeof(TYPE));
+            const TYPE * const inputs[2] = {coefs_a, coefs_d};
+            TYPE * const outputs[1] = {output};
+            if (weights == NULL)
+                return 2;
+            for (i = 0; i < F; ++i){
+                weights[i] = filter_a[i] / 2;
+                weights[F + i] = filter_d[i] / 2;
+            }
+            retval = CAT(TYPE, _upsampled_axis_tiled)(inputs, 2, outputs, 1, infos,
+                                                      (const TYPE * const *) &weights, F,
+                                                      offset, step, axis, inner, workers);
+            free(weights);
+            return retval;
+        }
+    }
+
+    make_temp_a = a_info.strides[axis] != sizeof(TYPE);
+    make_temp_d = d_info.strides[axis] != sizeof(TYPE);
+    make_temp_output = output_info.strides[axis] != sizeof(TYPE);
+
+    for (i = 0; i < output_info.ndim; ++i){
+        if (i != axis)
+            num_loops *= output_info.shape[i];
+    }
+
+    // Rows are distributed over the threads, each with its own buffers
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * temp_a = NULL, * temp_d = NULL, * temp_output = NULL;
+        size_t row, first, last;
+
+        parallel_range(num_loops, &first, &last);
+        if ((make_temp_a && (temp_a = malloc(N * sizeof(TYPE))) == NULL) ||
+            (make_temp_d && (temp_d = malloc(N * sizeof(TYPE))) == NULL) ||
+            (make_temp_output && (temp_output = malloc(N * sizeof(TYPE))) == NULL))
+            retval = 2;
+        else
+            for (row = first; row < last; ++row){
+                pywt_index_t offsets[3];
+                const TYPE * a_row, * d_row;
+                TYPE * output_row;
+                size_t j;
+
+                // inner == axis: the offsets of the rows along axis
+                CAT(TYPE, _tile_offsets)(row, infos, 3, axis, axis, offsets);
+
+                if (make_temp_a)
+                    CAT(TYPE, _cast)((const char *) coefs_a + offsets[0], INPUT_NATIVE,
+                                     a_info.strides[axis], temp_a, N);
+                if (make_temp_d)
+                    CAT(TYPE, _cast)((const char *) coefs_d + offsets[1], INPUT_NATIVE,
+                                     d_info.strides[axis], temp_d, N);
+                a_row = make_temp_a ? temp_a : (const TYPE *)((const char *) coefs_a + offsets[0]);
+                d_row = make_temp_d ? temp_d : (const TYPE *)((const char *) coefs_d + offsets[1]);
+                output_row = make_temp_output ? temp_output
+                    : (TYPE *)((char *) output + offsets[2]);
+
+                if (CAT(TYPE, _upsampled_filter_convolution_dual)(a_row, d_row, N,
+                                                                  filter_a, filter_d, F,
+                                                                  output_row, step, offset,
+                                                                  MODE_PERIODIZATION) < 0){
+                    retval = 1;
+                    break;
+                }
+
+                // Copy from temporary output if necessary
+                if (make_temp_output)
+                    for (j = 0; j < N; ++j)
+                        *(TYPE *)((char *) output + offsets[2]
+                                  + (pywt_index_t) j * output_info.strides[axis]) = output_row[j];
+            }
+
+        free(temp_a);
+        free(temp_d);
+        free(temp_output);
+    }
+    return retval;
+}
+
+
+int CAT(TYPE, _swt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                         TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                         TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                         const Wavelet * const restrict wavelet, const size_t axis,
+                         const unsigned int level, const unsigned int workers){
+    const ArrayInfo * const infos[3] = {&input_info, &a_info, &d_info};
+    size_t step;
+
+    if (CAT(TYPE, _swt_axis_check)(infos, 3, axis, level))
+        return 1;
+    step = (size_t) 1 << (level - 1);
+    return CAT(TYPE, _upsampled_dec_axis)(input, input_info, coefs_a, a_info, coefs_d, d_info,
+                                          wavelet->CAT(dec_lo_, TYPE),
+                                          wavelet->CAT(dec_hi_, TYPE), wavelet->dec_len,
+                                          step, step * (wavelet->dec_len / 2), axis, workers);
+}
+
+
+int CAT(TYPE, _iswt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                          const TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                          TYPE * const restrict output, const ArrayInfo output_info,
+                          const Wavelet * const restrict wavelet, const size_t axis,
+                          const unsigned int level, const unsigned int workers){
+    const ArrayInfo * const infos[3] = {&a_info, &d_info, &output_info};
+    const size_t F = wavelet->rec_len;
+    size_t step;
+
+    if (CAT(TYPE, _swt_axis_check)(infos, 3, axis, level) || F < 2)
+        return 1;
+    step = (size_t) 1 << (level - 1);
+    return CAT(TYPE, _upsampled_rec_axis)(coefs_a, a_info, coefs_d, d_info, output, output_info,
+                                          wavelet->CAT(rec_lo_, TYPE),
+                                          wavelet->CAT(rec_hi_, TYPE), F,
+                                          step, step * (F/2 - 1), axis, workers);
+}
+
+
+/* Maximal overlap transforms along an axis
+ *
+ * The MODWT is the SWT with the filters rescaled by 1/sqrt(2) and causal
+ * circular filtering (offset 0), which is defined for any length along axis.
+ * Its inverse uses the reconstruction filters rescaled by sqrt(2) (halved
+ * again by the dual convolution) with offset step*(F - 1), which undoes the
+ * forward transform for biorthogonal wavelets as well.
+ */
+
+/* The filters of a wavelet multiplied by scale, lo followed by hi */
+static TYPE * CAT(TYPE, _scaled_filters)(const TYPE * const restrict lo,
+                                         const TYPE * const restrict hi,
+                                         const size_t F, const TYPE scale){
+    TYPE * const filters = malloc(2 * F * sizeof(TYPE));
+    size_t j;
+
+    if (filters == NULL)
+        return NULL;
+    for (j = 0; j < F; ++j){
+        filters[j] = lo[j] * scale;
+        filters[F + j] = hi[j] * scale;
+    }
+    return filters;
+}
+
+
+/* Checks the arrays of a maximal overlap transform along axis to level: the
+ * same shape, with 2**level not exceeding the length along axis */
+static int CAT(TYPE, _modwt_axis_check)(const ArrayInfo * const * const infos,
+                                        const size_t n_infos, const size_t axis,
+                                        const unsigned int level){
+    if (level < 1 || CAT(TYPE, _same_shape_check)(infos, n_infos, axis))
+        return 1;
+    return level > modwt_max_level(infos[0]->shape[axis]);
+}
+
+
+int CAT(TYPE, _modwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                           TYPE * const * const coefs_a, TYPE * const * const coefs_d,
+                           const ArrayInfo * const coefs_infos,
+                           const Wavelet * const restrict wavelet, const size_t axis,
+                           const unsigned int level, const unsigned int workers){
+    const size_t F = wavelet->dec_len;
+    const ArrayInfo ** infos;
+    TYPE * filters;
+    const TYPE * a = input;
+    const ArrayInfo * a_info = &input_info;
+    unsigned int l, k;
+    int retval = 0;
+
+    if (level < 1)
+        return 1;
+    if ((infos = malloc((2 * (size_t) level + 1) * sizeof(const ArrayInfo *))) == NULL)
+        return 2;
+    infos[0] = &input_info;
+    for (k = 0; k < 2 * level; ++k)
+        infos[k + 1] = &coefs_infos[k];
+    retval = CAT(TYPE, _modwt_axis_check)(infos, 2 * (size_t) level + 1, axis, level);
+    free(infos);
+    if (retval)
+        return retval;
+
+    if ((filters = CAT(TYPE, _scaled_filters)(wavelet->CAT(dec_lo_, TYPE),
+                                              wavelet->CAT(dec_hi_, TYPE), F,
+                                              (TYPE) 0.70710678118654752440)) == NULL)
+        return 2;
+
+    // each level transforms the approximation of the previous (finer) one
+    for (l = 1; l <= level && retval == 0; ++l){
+        k = level - l;
+        retval = CAT(TYPE, _upsampled_dec_axis)(a, *a_info, coefs_a[k], coefs_infos[k],
+                                                coefs_d[k], coefs_infos[level + k],
+                                                filters, filters + F, F,
+                                                (size_t) 1 << (l - 1), 0, axis, workers);
+        a = coefs_a[k];
+        a_info = &coefs_infos[k];
+    }
+    free(filters);
+    return retval;
+}
+
+
+int CAT(TYPE, _imodwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                            const TYPE * const * const coefs_d, const ArrayInfo * const d_infos,
+                            TYPE * const restrict output, const ArrayInfo output_info,
+                            const Wavelet * const restrict wavelet, const size_t axis,
+                            const unsigned int level, const unsigned int workers){
+    const size_t F = wavelet->rec_len;
+    const ArrayInfo ** infos;
+    ArrayInfo temp_info;
+    TYPE * filters = NULL, * temp = NULL;
+    size_t i, size = 1;
+    unsigned int k;
+    int retval = 0;
+
+    if (level < 1 || F < 2)
+        return 1;
+    if ((infos = malloc(((size_t) level + 2) * sizeof(const ArrayInfo *))) == NULL)
+        return 2;
+    infos[0] = &output_info;
+    infos[1] = &a_info;
+    for (k = 0; k < level; ++k)
+        infos[k + 2] = &d_infos[k];
+    retval = CAT(TYPE, _modwt_axis_check)(infos, (size_t) level + 2, axis, level);
+    free(infos);
+    if (retval)
+        return retval;
+
+    // the levels alternate between output and a contiguous temporary, such
+    // that the last one is written to output
+    temp_info.ndim = output_info.ndim;
+    temp_info.shape = output_info.shape;
+    if ((temp_info.strides = malloc(output_info.ndim * sizeof(pywt_index_t))) == NULL)
+        return 2;
+    for (i = output_info.ndim; i > 0; --i){
+        temp_info.strides[i - 1] = (pywt_index_t) (size * sizeof(TYPE));
+        size *= output_info.shape[i - 1];
+    }
+    if ((level > 1 && (temp = malloc(size * sizeof(TYPE))) == NULL) ||
+        (filters = CAT(TYPE, _scaled_filters)(wavelet->CAT(rec_lo_, TYPE),
+                                              wavelet->CAT(rec_hi_, TYPE), F,
+                                              (TYPE) 1.41421356237309504880)) == NULL){
+        retval = 2;
+    } else {
+        const TYPE * a = coefs_a;
+        const ArrayInfo * a_info_l = &a_info;
+
+        for (k = 0; k < level && retval == 0; ++k){
+            const size_t step = (size_t) 1 << (level - 1 - k);
+            const int to_output = (level - 1 - k) % 2 == 0;
+            TYPE * const out = to_output ? output : temp;
+            const ArrayInfo * const out_info = to_output ? &output_info : &temp_info;
+
+            retval = CAT(TYPE, _upsampled_rec_axis)(a, *a_info_l, coefs_d[k], d_infos[k],
+                                                    out, *out_info, filters, filters + F, F,
+                                                    step, step * (F - 1), axis, workers);
+            a = out;
+            a_info_l = out_info;
+        }
+    }
+    free(temp_info.strides);
+    free(temp);
+    free(filters);
+    return retval;
+}
+
+
+int CAT(TYPE, _complex_swt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                                 TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                 TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                                 const Wavelet * const restrict wavelet, const size_t axis,
+                                 const unsigned int level, const unsigned int workers){
+    const ArrayInfo * const infos[3] = {&input_info, &a_info, &d_info};
+    ArrayInfo real_infos[3];
+    void * buffer;
+    int retval;
+
+    if (CAT(TYPE, _swt_axis_check)(infos, 3, axis, level))
+        return 1;
+    if ((buffer = CAT(TYPE, _complex_infos)(infos, 3, axis, real_infos)) == NULL)
+        return 2;
+    retval = CAT(TYPE, _swt_axis)(input, real_infos[0], coefs_a, real_infos[1],
+                                  coefs_d, real_infos[2], wavelet, axis, level, workers);
+    free(buffer);
+    return retval;
+}
+
+
+int CAT(TYPE, _complex_iswt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                  const TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                                  TYPE * const restrict output, const ArrayInfo output_info,
+                                  const Wavelet * const restrict wavelet, const size_t axis,
+                                  const unsigned int level, const unsigned int workers){
+    const ArrayInfo * const infos[3] = {&output_info, &a_info, &d_info};
+    ArrayInfo real_infos[3];
+    void * buffer;
+    int retval;
+
+    if (CAT(TYPE, _swt_axis_check)(infos, 3, axis, level))
+        return 1;
+    if ((buffer = CAT(TYPE, _complex_infos)(infos, 3, axis, real_infos)) == NULL)
+        return 2;
+    retval = CAT(TYPE, _iswt_axis)(coefs_a, real_infos[1], coefs_d, real_infos[2],
+                                   output, real_infos[0], wavelet, axis, level, workers);
+    free(buffer);
+    return retval;
+}
+
+
+int CAT(TYPE, _complex_modwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                                   TYPE * const * const coefs_a, TYPE * const * const coefs_d,
+                                   const ArrayInfo * const coefs_infos,
+                                   const Wavelet * const restrict wavelet, const size_t axis,
+                                   const unsigned int level, const unsigned int workers){
+    const size_t n = 2 * (size_t) level + 1;
+    const ArrayInfo ** infos;
+    ArrayInfo * real_infos;
+    void * buffer = NULL;
+    size_t k;
+    int retval;
+
+    if (level < 1)
+        return 1;
+    infos = malloc(n * sizeof(const ArrayInfo *));
+    real_infos = malloc(n * sizeof(ArrayInfo));
+    if (infos == NULL || real_infos == NULL){
+        retval = 2;
+        goto cleanup;
+    }
+    infos[0] = &input_info;
+    for (k = 1; k < n; ++k)
+        infos[k] = &coefs_infos[k - 1];
+    if (CAT(TYPE, _modwt_axis_check)(infos, n, axis, level)){
+        retval = 1;
+        goto cleanup;
+    }
+    if ((buffer = CAT(TYPE, _complex_infos)(infos, n, axis, real_infos)) == NULL){
+        retval = 2;
+        goto cleanup;
+    }
+    retval = CAT(TYPE, _modwt_axis)(input, real_infos[0], coefs_a, coefs_d, real_infos + 1,
+                                    wavelet, axis, level, workers);
+cleanup:
+    free(buffer);
+    free(real_infos);
+    free(infos);
+    return retval;
+}
+
+
+int CAT(TYPE, _complex_imodwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                    const TYPE * const * const coefs_d,
+                                    const ArrayInfo * const d_infos,
+                                    TYPE * const restrict output, const ArrayInfo output_info,
+                                    const Wavelet * const restrict wavelet, const size_t axis,
+                                    const unsigned int level, const unsigned int workers){
+    const size_t n = (size_t) level + 2;
+    const ArrayInfo ** infos;
+    ArrayInfo * real_infos;
+    void * buffer = NULL;
+    size_t k;
+    int retval;
+
+    if (level < 1)
+        return 1;
+    infos = malloc(n * sizeof(const ArrayInfo *));
+    real_infos = malloc(n * sizeof(ArrayInfo));
+    if (infos == NULL || real_infos == NULL){
+        retval = 2;
+        goto cleanup;
+    }
+    infos[0] = &output_info;
+    infos[1] = &a_info;
+    for (k = 2; k < n; ++k)
+        infos[k] = &d_infos[k - 2];
+    if (CAT(TYPE, _modwt_axis_check)(infos, n, axis, level)){
+        retval = 1;
+        goto cleanup;
+    }
+    if ((buffer = CAT(TYPE, _complex_infos)(infos, n, axis, real_infos)) == NULL){
+        retval = 2;
+        goto cleanup;
+    }
+    retval = CAT(TYPE, _imodwt_axis)(coefs_a, real_infos[1], coefs_d, real_infos + 2,
+                                     output, real_infos[0], wavelet, axis, level, workers);
+cleanup:
+    free(buffer);
+    free(real_infos);
+    free(infos);
+    return retval;
+}
+
 #endif /* TYPE */
 #undef restrict
@@ -1,7 +1,8 @@
 /* Copyright (c) 2006-2012 Filip Wasilewski <http://en.ig.ma/> */
 /* See COPYING for license details. */
 
-/* Wavelet transforms using convolution functions defined in convolution.h */
+/* Wavelet transforms using convolution functions defined in convolution.h,
+ * or the lifting schemes defined in lifting.h */
 
 #include "templating.h"
 
@@ -20,17 +21,81 @@
 /* _a suffix - wavelet transform approximations */
 /* _d suffix - wavelet transform details */
 
+/* output[l] = sum(weights[k] * rows[k][l] for k = [0..K)) for l = [0..n),
+ * using kernel (see simd.h) if not NULL */
+void CAT(TYPE, _sum_rows)(const TYPE * const * const rows, const TYPE * const weights,
+                          const size_t K, TYPE * const restrict output, const size_t n,
+                          const CAT(TYPE, _rows_kernel) kernel);
+
+/* output[i] = input[i * stride] for i = [0..n), with the elements of
+ * input_type (stride bytes apart) converted to TYPE */
+void CAT(TYPE, _cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                      const pywt_index_t stride, TYPE * const restrict output, const size_t n);
+
+/* The _axis functions transform all rows along axis, using up to workers
+ * threads if built with OpenMP. Each row is computed the same way regardless
+ * of the number of threads, so the results do not depend on it. */
+
 int CAT(TYPE, _downcoef_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
                               TYPE * const restrict output, const ArrayInfo output_info,
                               const Wavelet * const restrict wavelet, const size_t axis,
-                              const Coefficient detail, const MODE mode);
+                              const Coefficient detail, const MODE mode,
+                              const unsigned int workers);
+
+/* Approximation and detail coefficients along axis, in a single pass */
+int CAT(TYPE, _dwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                         TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                         TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                         const Wavelet * const restrict wavelet, const size_t axis,
+                         const MODE mode, const METHOD method,
+                         const unsigned int workers);
+
+/* _dwt_axis of input with elements of input_type, converted to TYPE as they
+ * are read instead of in a copy of the whole array */
+int CAT(TYPE, _dwt_axis_cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                              const ArrayInfo input_info,
+                              TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                              TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                              const Wavelet * const restrict wavelet, const size_t axis,
+                              const MODE mode, const METHOD method,
+                              const unsigned int workers);
 
 // a_info and d_info are pointers, as they may be NULL
 int CAT(TYPE, _idwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo * a_info,
                           const TYPE * const restrict coefs_d, const ArrayInfo * d_info,
                           TYPE * const restrict output, const ArrayInfo output_info,
                           const Wavelet * const restrict wavelet,
-                          const size_t axis, const MODE mode);
+                          const size_t axis, const MODE mode, const METHOD method,
+                          const unsigned int workers);
+
+/* The _complex_axis functions transform arrays of complex values, stored as
+ * interleaved real and imaginary parts of type TYPE, with the real filters
+ * of wavelet. The ArrayInfo describe the complex arrays (strides in bytes,
+ * as for the other _axis functions). Both parts are computed in a single
+ * pass along axis. */
+int CAT(TYPE, _complex_dwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                                 TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                 TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                                 const Wavelet * const restrict wavelet, const size_t axis,
+                                 const MODE mode, const METHOD method,
+                                 const unsigned int workers);
+
+int CAT(TYPE, _complex_idwt_axis)(const TYPE * const restrict coefs_a,
+                                  const ArrayInfo * a_info,
+                                  const TYPE * const restrict coefs_d,
+                                  const ArrayInfo * d_info,
+                                  TYPE * const restrict output, const ArrayInfo output_info,
+                                  const Wavelet * const restrict wavelet,
+                                  const size_t axis, const MODE mode, const METHOD method,
+                                  const unsigned int workers);
+
+/* Extends the C-contiguous input of ndim > 0 dimensions by
+ * pad_widths[2*d] values before and pad_widths[2*d + 1] values after along
+ * each axis d, with mode, into the C-contiguous output. Returns 1 for
+ * invalid arguments and 2 if memory could not be allocated. */
+int CAT(TYPE, _pad)(const TYPE * const restrict input, const size_t ndim,
+                    const size_t * const input_shape, TYPE * const restrict output,
+                    const size_t * const pad_widths, const MODE mode);
 
 /* Single level decomposition */
 int CAT(TYPE, _dec_a)(const TYPE * const restrict input, const size_t input_len,
@@ -43,6 +108,13 @@ int CAT(TYPE, _dec_d)(const TYPE * const restrict input, const size_t input_len,
                       TYPE * const restrict output, const size_t output_len,
                       const MODE mode);
 
+/* Approximation and detail coefficients, in a single pass. METHOD_LIFTING
+ * fails (returns -1) if the wavelet has no lifting scheme. */
+int CAT(TYPE, _dec)(const TYPE * const restrict input, const size_t input_len,
+                    const Wavelet * const restrict wavelet,
+                    TYPE * const restrict output_a, TYPE * const restrict output_d,
+                    const size_t output_len, const MODE mode, const METHOD method);
+
 /* Single level reconstruction */
 int CAT(TYPE, _rec_a)(const TYPE * const restrict coeffs_a, const size_t coeffs_len,
                       const Wavelet * const restrict wavelet,
@@ -56,7 +128,51 @@ int CAT(TYPE, _rec_d)(const TYPE * const restrict coeffs_d, const size_t coeffs_
 int CAT(TYPE, _idwt)(const TYPE * const restrict coeffs_a, const size_t coeffs_a_len,
                      const TYPE * const restrict coeffs_d, const size_t coeffs_d_len,
                      TYPE * const restrict output, const size_t output_len,
-                     const Wavelet * const wavelet, const MODE mode);
+                     const Wavelet * const wavelet, const MODE mode,
+                     const METHOD method);
+
+/* Multilevel DWT of n_rows signals of length input_len, stored one after
+ * the other. coefs[0] receives the approximation at the last level and
+ * coefs[k] the details at level (level + 1 - k), for k = [1..level], each
+ * n_rows rows of coefs_lens[k] coefficients. */
+int CAT(TYPE, _wavedec)(const TYPE * const restrict input, const size_t n_rows,
+                        const size_t input_len, const Wavelet * const restrict wavelet,
+                        TYPE * const * const coefs, const size_t * const coefs_lens,
+                        const unsigned int level, const MODE mode, const METHOD method,
+                        const unsigned int workers);
+
+/* _wavedec of input with elements of input_type, each row converted to TYPE
+ * before its first level */
+int CAT(TYPE, _wavedec_cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                             const size_t n_rows, const size_t input_len,
+                             const Wavelet * const restrict wavelet,
+                             TYPE * const * const coefs, const size_t * const coefs_lens,
+                             const unsigned int level, const MODE mode, const METHOD method,
+                             const unsigned int workers);
+
+/* Multilevel IDWT, the inverse of _wavedec. As in waverec, the
+ * approximation input to each level may be one coefficient longer than the
+ * details, the last approximation coefficient is then ignored. */
+int CAT(TYPE, _waverec)(const TYPE * const * const coefs, const size_t * const coefs_lens,
+                        const size_t n_rows, const Wavelet * const restrict wavelet,
+                        TYPE * const restrict output, const size_t output_len,
+                        const unsigned int level, const MODE mode, const METHOD method,
+                        const unsigned int workers);
+
+/* _wavedec and _waverec of rows of complex values, stored as interleaved
+ * real and imaginary parts (the lengths count complex values) */
+int CAT(TYPE, _complex_wavedec)(const TYPE * const restrict input, const size_t n_rows,
+                                const size_t input_len, const Wavelet * const restrict wavelet,
+                                TYPE * const * const coefs, const size_t * const coefs_lens,
+                                const unsigned int level, const MODE mode,
+                                const METHOD method, const unsigned int workers);
+
+int CAT(TYPE, _complex_waverec)(const TYPE * const * const coefs,
+                                const size_t * const coefs_lens, const size_t n_rows,
+                                const Wavelet * const restrict wavelet,
+                                TYPE * const restrict output, const size_t output_len,
+                                const unsigned int level, const MODE mode,
+                                const METHOD method, const unsigned int workers);
 
 /* SWT decomposition at given level */
 int CAT(TYPE, _swt_a)(TYPE input[], pywt_index_t input_len,
@@ -69,5 +185,97 @@ int CAT(TYPE, _swt_d)(TYPE input[], pywt_index_t input_len,
                       TYPE output[], pywt_index_t output_len,
                       int level);
 
+/* SWT reconstruction of the approximation at level - 1 */
+int CAT(TYPE, _iswt)(TYPE coeffs_a[], TYPE coeffs_d[], pywt_index_t coeffs_len,
+                     Wavelet* wavelet,
+                     TYPE output[], pywt_index_t output_len,
+                     int level);
+
+/* Multilevel SWT of the levels start_level + 1 to start_level + level of a
+ * signal of even length, in the order of pywt.swt: the approximation and
+ * details of level start_level + level - k are written to coefs_a[k] and
+ * coefs_d[k], each of input_len samples and not overlapping the input. The
+ * approximations are the input of the next level, so no temporary buffer is
+ * needed. */
+int CAT(TYPE, _swt_multilevel)(const TYPE * const restrict input, const size_t input_len,
+                               const Wavelet * const restrict wavelet,
+                               TYPE * const * const coefs_a, TYPE * const * const coefs_d,
+                               const unsigned int level, const unsigned int start_level);
+
+/* Multilevel ISWT of the approximation at level `level` and the details
+ * coefs_d[k] of level `level - k` (as returned with start_level 0), all of
+ * coefs_len samples. Uses one temporary buffer of coefs_len samples for more
+ * than one level. */
+int CAT(TYPE, _iswt_multilevel)(const TYPE * const restrict coefs_a,
+                                const TYPE * const * const coefs_d, const size_t coefs_len,
+                                const Wavelet * const restrict wavelet,
+                                TYPE * const restrict output, const unsigned int level);
+
+/* Single level SWT along an axis of input at level `level`: the periodic
+ * convolutions with the decomposition filters upsampled by 2**(level-1). All
+ * arrays have the same shape, of a length along axis divisible by
+ * 2**level, and any strides. */
+int CAT(TYPE, _swt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                         TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                         TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                         const Wavelet * const restrict wavelet, const size_t axis,
+                         const unsigned int level, const unsigned int workers);
+
+/* Single level ISWT along an axis, the inverse of CAT(TYPE, _swt_axis) */
+int CAT(TYPE, _iswt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                          const TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                          TYPE * const restrict output, const ArrayInfo output_info,
+                          const Wavelet * const restrict wavelet, const size_t axis,
+                          const unsigned int level, const unsigned int workers);
+
+/* Multilevel MODWT along an axis of input: level l (from 1) is the causal
+ * circular filtering of the approximation of level l - 1 with the
+ * decomposition filters rescaled by 1/sqrt(2) and upsampled by 2**(l-1), for
+ * any length along axis of at least 2**level. coefs_a[k] and coefs_d[k] are
+ * level `level - k`, coefs_infos[k] describes coefs_a[k] and
+ * coefs_infos[level + k] coefs_d[k]. All arrays have the same shape and any
+ * strides. */
+int CAT(TYPE, _modwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                           TYPE * const * const coefs_a, TYPE * const * const coefs_d,
+                           const ArrayInfo * const coefs_infos,
+                           const Wavelet * const restrict wavelet, const size_t axis,
+                           const unsigned int level, const unsigned int workers);
+
+/* Multilevel IMODWT along an axis of the approximation at level `level` and
+ * the details coefs_d[k] of level `level - k`, the inverse of
+ * CAT(TYPE, _modwt_axis). Uses one temporary array of the shape of output for
+ * more than one level. */
+int CAT(TYPE, _imodwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                            const TYPE * const * const coefs_d, const ArrayInfo * const d_infos,
+                            TYPE * const restrict output, const ArrayInfo output_info,
+                            const Wavelet * const restrict wavelet, const size_t axis,
+                            const unsigned int level, const unsigned int workers);
+
+/* The stationary and maximal overlap transforms of complex arrays, see CAT(TYPE, _complex_dwt_axis) */
+int CAT(TYPE, _complex_swt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                                 TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                 TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                                 const Wavelet * const restrict wavelet, const size_t axis,
+                                 const unsigned int level, const unsigned int workers);
+
+int CAT(TYPE, _complex_iswt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                  const TYPE * const restrict coefs_d, const ArrayInfo d_info,
+                                  TYPE * const restrict output, const ArrayInfo output_info,
+                                  const Wavelet * const restrict wavelet, const size_t axis,
+                                  const unsigned int level, const unsigned int workers);
+
+int CAT(TYPE, _complex_modwt_axis)(const TYPE * const restrict input, const ArrayInfo input_info,
+                                   TYPE * const * const coefs_a, TYPE * const * const coefs_d,
+                                   const ArrayInfo * const coefs_infos,
+                                   const Wavelet * const restrict wavelet, const size_t axis,
+                                   const unsigned int level, const unsigned int workers);
+
+int CAT(TYPE, _complex_imodwt_axis)(const TYPE * const restrict coefs_a, const ArrayInfo a_info,
+                                    const TYPE * const * const coefs_d,
+                                    const ArrayInfo * const d_infos,
+                                    TYPE * const restrict output, const ArrayInfo output_info,
+                                    const Wavelet * const restrict wavelet, const size_t axis,
+                                    const unsigned int level, const unsigned int workers);
+
 #endif /* TYPE */
 #undef restrict
@@ -0,0 +1,122 @@
+/* See COPYING for license details. */
+
+#include "wtn.h"
+
+/* Maximum number of input slabs summed for one output slab, by the
+ * decomposition (per input) or the reconstruction (per subband) */
+static size_t dec_terms(const size_t filter_len){
+    return 2 * filter_len;
+}
+
+static size_t rec_terms(const size_t filter_len){
+    return filter_len / 2;
+}
+
+
+/* Product of shape[first..ndim) */
+static size_t slab_size(const size_t ndim, const size_t * const shape, const size_t first){
+    size_t i, size = 1;
+    for (i = first; i < ndim; ++i)
+        size *= shape[i];
+    return size;
+}
+
+
+static size_t level_threads(const unsigned int workers, const size_t n){
+#ifdef _OPENMP
+    return (size_t) parallel_threads(workers, n);
+#else
+    (void) workers;
+    (void) n;
+    return 1;
+#endif
+}
+
+
+/* Bytes of the plans (see AxisPlan in wtn.template.c) for all but the last
+ * axis, with outputs[d] outputs along axis d of up to K terms each. */
+static size_t plans_size(const size_t ndim, const size_t * const outputs, const size_t K,
+                         const size_t itemsize){
+    size_t d, size = 0;
+    for (d = 0; d + 1 < ndim; ++d)
+        size += outputs[d] * (sizeof(size_t) + K * (sizeof(pywt_index_t) + 2 * itemsize));
+    return size;
+}
+
+
+/* Elements of the buffers of one thread transforming a level, from the
+ * input of in_shape and to a row of row_len */
+static size_t dec_scratch_len(const size_t ndim, const size_t * const in_shape){
+    size_t d, len = 0;
+    for (d = 0; d + 1 < ndim; ++d)
+        len += 2 * slab_size(ndim, in_shape, d + 1);
+    return len;
+}
+
+static size_t rec_scratch_len(const size_t ndim, const size_t * const in_shape,
+                              const size_t row_len){
+    size_t d, len = row_len;
+    for (d = 0; d + 1 < ndim; ++d)
+        len += ((size_t) 1 << (ndim - d - 1)) * slab_size(ndim, in_shape, d + 1);
+    return len;
+}
+
+
+size_t wavedecn_workspace(const size_t ndim, const size_t * const shape,
+                          const size_t * const coefs_shapes, const unsigned int level,
+                          const size_t filter_len, const size_t itemsize,
+                          const int inverse, const unsigned int workers){
+    const size_t n_subbands = (size_t) 1 << ndim;
+    const size_t K = inverse ? rec_terms(filter_len) : dec_terms(filter_len);
+    size_t l, threads = 0, thread_size = 0, size;
+
+    // the shapes and slab sizes of all levels
+    size = (4 * level + 1) * ndim * sizeof(size_t);
+    // the intermediate approximations of levels 1 and 2 (or 2 and 3, ...)
+    if (level > 1)
+        size += slab_size(ndim, coefs_shapes + (level - 1) * ndim, 0) * itemsize;
+    if (level > 2)
+        size += slab_size(ndim, coefs_shapes + (level - 2) * ndim, 0) * itemsize;
+
+    for (l = 0; l < level; ++l){
+        // level l, coarsest first, transforms between these shapes
+        const size_t * const coarse = coefs_shapes + l * ndim;
+        const size_t * const fine = (l + 1 < level) ? coefs_shapes + (l + 1) * ndim : shape;
+        size_t n_threads, level_size;
+
+        if (!inverse){
+            // a single row is transformed in the calling thread
+            n_threads = (ndim > 1) ? level_threads(workers, coarse[0]) : 0;
+            size += plans_size(ndim, coarse, K, itemsize);
+            level_size = dec_scratch_len(ndim, fine) * itemsize;
+        } else {
+            // a reconstructed row is at most one longer than needed
+            const size_t row_len = fine[ndim - 1] + 1;
+            n_threads = (ndim > 1) ? level_threads(workers, fine[0]) : 1;
+            size += plans_size(ndim, fine, K, itemsize);
+            level_size = rec_scratch_len(ndim, coarse, row_len) * itemsize
+                + 2 * K * itemsize + n_subbands * sizeof(void *);
+        }
+        if (n_threads > threads)
+            threads = n_threads;
+        if (level_size > thread_size)
+            thread_size = level_size;
+    }
+    // the buffers of each thread, for the largest level
+    return size + threads * (thread_size + 2 * K * sizeof(void *));
+}
+
+
+#ifdef TYPE
+#error TYPE should not be defined here.
+#else
+
+#define TYPE float
+#include "wtn.template.c"
+#undef TYPE
+
+#define TYPE double
+#include "wtn.template.c"
+#undef TYPE
+
+#endif /* TYPE */
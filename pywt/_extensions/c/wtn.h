@@ -0,0 +1,49 @@
+/* See COPYING for license details. */
+
+/* Multilevel n-dimensional wavelet transforms
+ *
+ * Each level transforms all axes of a C-contiguous array at once, without
+ * the intermediate arrays of one single-axis transform after the other.
+ * Along the first axis, every output slab (a subarray with a fixed index
+ * along it) is a weighted sum of a few input slabs, which is transformed
+ * along the remaining axes the same way before computing the next one. The
+ * last axis is transformed a row at a time by the convolutions of
+ * convolution.h. The subbands are written directly to their final buffers,
+ * and the only other memory used is a few slabs per thread and the
+ * intermediate approximations, see wavedecn_workspace. A plan (TYPE_WtnPlan)
+ * allocates all of it once, for repeated transforms of the same shapes. */
+
+#pragma once
+
+#include "common.h"
+#include "wt.h"
+
+/* Elements of the input slabs converted to TYPE at a time, for input of
+ * another INPUT_TYPE. A multiple of the vector widths, so that the sums are
+ * computed as for a converted copy of the input. */
+#define CAST_CHUNK_SIZE 256
+
+/* Bytes of the workspace allocated by TYPE_wavedecn (if inverse is 0) or
+ * TYPE_waverecn (if inverse is 1) with these arguments, in addition to their
+ * inputs and outputs, which is that of their plan. shape is the shape of the input data (or output) and
+ * coefs_shapes that of the coefficients of each level, as in these
+ * functions, filter_len the length of the wavelet's filters and itemsize
+ * sizeof(TYPE). */
+size_t wavedecn_workspace(const size_t ndim, const size_t * const shape,
+                          const size_t * const coefs_shapes, const unsigned int level,
+                          const size_t filter_len, const size_t itemsize,
+                          const int inverse, const unsigned int workers);
+
+#ifdef TYPE
+#error TYPE should not be defined here.
+#else
+
+#define TYPE float
+#include "wtn.template.h"
+#undef TYPE
+
+#define TYPE double
+#include "wtn.template.h"
+#undef TYPE
+
+#endif /* TYPE */
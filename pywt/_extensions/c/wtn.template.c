@@ -0,0 +1,850 @@
+/* See COPYING for license details. */
+
+#include "templating.h"
+
+#ifndef TYPE
+#error TYPE must be defined here.
+#else
+
+#include "wtn.h"
+
+#if defined _MSC_VER
+#define restrict __restrict
+#elif defined __GNUC__
+#define restrict __restrict__
+#endif
+
+/* Output slab o along an axis is a weighted sum of the input slabs
+ * index[o*K + j] for j = [0..n[o]). The decomposition computes two outputs
+ * (approximation and details) from one input with the weights w[0] and w[1],
+ * the reconstruction one output from two inputs (approximation and details),
+ * weighted by w[0] and w[1] respectively. */
+typedef struct {
+    size_t K;
+    size_t * n;
+    pywt_index_t * index;
+    TYPE * w[2];
+} CAT(TYPE, _AxisPlan);
+
+
+static void CAT(TYPE, _free_plans)(CAT(TYPE, _AxisPlan) * const plans, const size_t n_plans){
+    size_t d;
+
+    if (plans == NULL)
+        return;
+    for (d = 0; d < n_plans; ++d){
+        free(plans[d].n);
+        free(plans[d].index);
+        free(plans[d].w[0]);
+        free(plans[d].w[1]);
+    }
+    free(plans);
+}
+
+
+/* Allocate n_plans plans of O[d] outputs of up to K terms. Returns NULL if
+ * memory could not be allocated. */
+static CAT(TYPE, _AxisPlan) * CAT(TYPE, _alloc_plans)(const size_t n_plans,
+                                                     const size_t * const O,
+                                                     const size_t K){
+    CAT(TYPE, _AxisPlan) * plans;
+    size_t d;
+
+    if ((plans = calloc(n_plans + 1, sizeof(CAT(TYPE, _AxisPlan)))) == NULL)
+        return NULL;
+    for (d = 0; d < n_plans; ++d){
+        plans[d].K = K;
+        if ((plans[d].n = calloc(O[d] + 1, sizeof(size_t))) == NULL ||
+            (plans[d].index = malloc((O[d] * K + 1) * sizeof(pywt_index_t))) == NULL ||
+            (plans[d].w[0] = malloc((O[d] * K + 1) * sizeof(TYPE))) == NULL ||
+            (plans[d].w[1] = malloc((O[d] * K + 1) * sizeof(TYPE))) == NULL){
+            CAT(TYPE, _free_plans)(plans, d + 1);
+            return NULL;
+        }
+    }
+    return plans;
+}
+
+
+/* The decimating convolution of N inputs, as _downsampling_convolution_dual
+ * computes it, with the extended input expressed by extended_indices */
+static void CAT(TYPE, _dec_plan)(CAT(TYPE, _AxisPlan) * const plan, const size_t N,
+                                 const size_t O, const TYPE * const filter_lo,
+                                 const TYPE * const filter_hi, const size_t F,
+                                 const MODE mode){
+    const pywt_index_t start = (mode == MODE_PERIODIZATION) ? (pywt_index_t) F/2 : 1;
+    size_t o, j, t;
+
+    for (o = 0; o < O; ++o){
+        const pywt_index_t idx = start + 2 * (pywt_index_t) o;
+        size_t n = 0;
+        for (j = 0; j < F; ++j){
+            pywt_index_t indices[2], coefs[2];
+            const size_t terms = extended_indices(idx - (pywt_index_t) j, N, mode,
+                                                  indices, coefs);
+            for (t = 0; t < terms; ++t, ++n){
+                plan->index[o * plan->K + n] = indices[t];
+                plan->w[0][o * plan->K + n] = (TYPE) coefs[t] * filter_lo[j];
+                plan->w[1][o * plan->K + n] = (TYPE) coefs[t] * filter_hi[j];
+            }
+        }
+        plan->n[o] = n;
+    }
+}
+
+
+/* The reconstruction of the first R of O outputs from N coefficients, as
+ * _rec_axis_tiled computes it (see there, F is even) */
+static void CAT(TYPE, _rec_plan)(CAT(TYPE, _AxisPlan) * const plan, const size_t N,
+                                 const size_t O, const size_t R,
+                                 const TYPE * const filter_lo, const TYPE * const filter_hi,
+                                 const size_t F, const MODE mode){
+    const int periodization = (mode == MODE_PERIODIZATION);
+    const pywt_index_t start = periodization ? (pywt_index_t) F/4 : (pywt_index_t) F/2 - 1;
+    const size_t shift = (periodization && (F/2)%2 == 0) ? 1 : 0;
+    const size_t n_pairs = periodization ? N : (N >= F/2) ? N - F/2 + 1 : 0;
+    size_t p, e, j;
+
+    for (p = 0; p < R; ++p)
+        plan->n[p] = 0;
+    for (p = 0; p < n_pairs; ++p){
+        const pywt_index_t idx = start + (pywt_index_t) p;
+        for (e = 0; e < 2; ++e){
+            // even taps for output o, odd ones for o + 1
+            const size_t o = (shift + 2*p + e) % O;
+            if (o >= R)
+                continue;
+            for (j = 0; j < F/2; ++j){
+                pywt_index_t k = idx - (pywt_index_t) j;
+                if (periodization){
+                    k %= (pywt_index_t) N;
+                    if (k < 0)
+                        k += (pywt_index_t) N;
+                }
+                plan->index[o * plan->K + j] = k;
+                plan->w[0][o * plan->K + j] = filter_lo[2*j + e];
+                plan->w[1][o * plan->K + j] = filter_hi[2*j + e];
+            }
+            plan->n[o] = F/2;
+        }
+    }
+}
+
+
+/* Shared state of a level of the transform. in_slab[d] and out_slab[d] are
+ * the sizes of the slabs along axis d of the input and output arrays. For
+ * the reconstruction, out_shape is the part of the reconstruction (of shape
+ * full_shape) that is kept. */
+typedef struct {
+    size_t ndim;
+    const size_t * in_shape;
+    const size_t * out_shape;
+    size_t * full_shape;
+    size_t * in_slab;
+    size_t * out_slab;
+    CAT(TYPE, _AxisPlan) * plans;
+    const Wavelet * wavelet;
+    MODE mode;
+    CAT(TYPE, _rows_kernel) kernel;
+    // the type of the input of the decomposition, see _dec_cast_slabs
+    INPUT_TYPE input_type;
+    size_t scratch_len;
+    // the threads transforming the level
+    size_t n_threads;
+} CAT(TYPE, _LevelInfo);
+
+
+/* The weighted sums of _dec_slab along the first axis of input of another
+ * input_type, converting CAST_CHUNK_SIZE elements of each of the n input
+ * slabs to buffer at a time */
+static void CAT(TYPE, _dec_cast_slabs)(const CAT(TYPE, _LevelInfo) * const info,
+                                       const void * const in, const pywt_index_t * const index,
+                                       const TYPE * const w_a, const TYPE * const w_d,
+                                       const size_t n, TYPE * const slab_a,
+                                       TYPE * const slab_d, TYPE * const buffer,
+                                       const TYPE ** const rows){
+    const size_t M = info->in_slab[0];
+    const size_t in_size = input_itemsize(info->input_type, sizeof(TYPE));
+    size_t m, j;
+
+    for (m = 0; m < M; m += CAST_CHUNK_SIZE){
+        const size_t c = (M - m < CAST_CHUNK_SIZE) ? M - m : CAST_CHUNK_SIZE;
+        for (j = 0; j < n; ++j){
+            CAT(TYPE, _cast)((const char *) in + ((size_t) index[j] * M + m) * in_size,
+                             info->input_type, (pywt_index_t) in_size,
+                             buffer + j * CAST_CHUNK_SIZE, c);
+            rows[j] = buffer + j * CAST_CHUNK_SIZE;
+        }
+        CAT(TYPE, _sum_rows)(rows, w_a, n, slab_a + m, c, info->kernel);
+        CAT(TYPE, _sum_rows)(rows, w_d, n, slab_d + m, c, info->kernel);
+    }
+}
+
+
+/* Transform the slab in of shape in_shape[d..ndim) along axes [d..ndim),
+ * adding outputs [first, last) along axis d to the subbands with key prefix
+ * key, at offset. scratch holds 2 * in_slab[d] elements for each remaining
+ * axis, followed by CAST_CHUNK_SIZE for each term if the input (at d = 0) is
+ * of another type. */
+static int CAT(TYPE, _dec_slab)(const CAT(TYPE, _LevelInfo) * const info, const size_t d,
+                                const void * const in, TYPE * const * const outputs,
+                                const size_t key, const size_t offset,
+                                TYPE * const scratch, const TYPE ** const rows,
+                                const size_t first, const size_t last){
+    const CAT(TYPE, _AxisPlan) * plan;
+    size_t M, o, j;
+
+    if (d + 1 == info->ndim){
+        if (CAT(TYPE, _dec)(in, info->in_shape[d], info->wavelet,
+                            outputs[2 * key] + offset, outputs[2 * key + 1] + offset,
+                            info->out_shape[d], info->mode, METHOD_CONVOLUTION) < 0)
+            return 2;
+        return 0;
+    }
+
+    plan = info->plans + d;
+    M = info->in_slab[d];
+    for (o = first; o < last; ++o){
+        TYPE * const slab_a = scratch, * const slab_d = scratch + M;
+        const size_t n = plan->n[o];
+        const size_t next_offset = offset + o * info->out_slab[d];
+        int retval;
+
+        if (n == 0){
+            memset(slab_a, 0, 2 * M * sizeof(TYPE));
+        } else if (d == 0 && info->input_type != INPUT_NATIVE){
+            CAT(TYPE, _dec_cast_slabs)(info, in, plan->index + o * plan->K,
+                                       plan->w[0] + o * plan->K, plan->w[1] + o * plan->K, n,
+                                       slab_a, slab_d, scratch + info->scratch_len, rows);
+        } else {
+            for (j = 0; j < n; ++j)
+                rows[j] = (const TYPE *) in + (size_t) plan->index[o * plan->K + j] * M;
+            CAT(TYPE, _sum_rows)(rows, plan->w[0] + o * plan->K, n, slab_a, M, info->kernel);
+            CAT(TYPE, _sum_rows)(rows, plan->w[1] + o * plan->K, n, slab_d, M, info->kernel);
+        }
+
+        if ((retval = CAT(TYPE, _dec_slab)(info, d + 1, slab_a, outputs, 2 * key, next_offset,
+                                           scratch + 2 * M, rows,
+                                           0, info->out_shape[d + 1])) ||
+            (retval = CAT(TYPE, _dec_slab)(info, d + 1, slab_d, outputs, 2 * key + 1,
+                                           next_offset, scratch + 2 * M, rows,
+                                           0, info->out_shape[d + 1])))
+            return retval;
+    }
+    return 0;
+}
+
+
+/* Reconstruct outputs [first, last) along axis d of the slab out of shape
+ * out_shape[d..ndim) from the 2**(ndim - d) subbands in (NULL for zeros) of
+ * shape in_shape[d..ndim). The first half of in are the approximations
+ * along axis d. scratch holds 2**(ndim - d' - 1) * in_slab[d'] elements for
+ * each remaining axis d' but the last, and full_shape[ndim - 1] for the
+ * last. */
+static int CAT(TYPE, _rec_slab)(const CAT(TYPE, _LevelInfo) * const info, const size_t d,
+                                const TYPE * const * const in, TYPE * const out,
+                                TYPE * const scratch, const TYPE ** const rows,
+                                TYPE * const weights, const TYPE ** const slabs,
+                                const size_t first, const size_t last){
+    const CAT(TYPE, _AxisPlan) * const plan = info->plans + d;
+    const size_t half = (size_t) 1 << (info->ndim - d - 1);
+    const size_t M = info->in_slab[d];
+    // the slabs of each depth d use slabs[half - 1 .. 2*half - 1)
+    const TYPE ** const next = slabs + half - 1;
+    size_t o, s, j;
+
+    if (d + 1 == info->ndim){
+        const size_t R = info->out_shape[d], full = info->full_shape[d];
+        TYPE * const target = (R == full) ? out : scratch;
+        if (in[0] == NULL && in[1] == NULL){
+            memset(out, 0, R * sizeof(TYPE));
+            return 0;
+        }
+        if (CAT(TYPE, _idwt)(in[0], info->in_shape[d], in[1], info->in_shape[d],
+                             target, full, info->wavelet, info->mode,
+                             METHOD_CONVOLUTION) < 0)
+            return 2;
+        if (target != out)
+            memcpy(out, target, R * sizeof(TYPE));
+        return 0;
+    }
+
+    for (o = first; o < last; ++o){
+        const size_t n = plan->n[o];
+        int retval;
+
+        for (s = 0; s < half; ++s){
+            const TYPE * const a = in[s], * const dd = in[half + s];
+            TYPE * const slab = scratch + s * M;
+            size_t K = 0;
+
+            // all approximation taps first, as in _rec_axis_tiled
+            for (j = 0; a != NULL && j < n; ++j, ++K){
+                rows[K] = a + (size_t) plan->index[o * plan->K + j] * M;
+                weights[K] = plan->w[0][o * plan->K + j];
+            }
+            for (j = 0; dd != NULL && j < n; ++j, ++K){
+                rows[K] = dd + (size_t) plan->index[o * plan->K + j] * M;
+                weights[K] = plan->w[1][o * plan->K + j];
+            }
+            if (K > 0){
+                CAT(TYPE, _sum_rows)(rows, weights, K, slab, M, info->kernel);
+                next[s] = slab;
+            } else {
+                next[s] = NULL;
+            }
+        }
+
+        if ((retval = CAT(TYPE, _rec_slab)(info, d + 1, next, out + o * info->out_slab[d],
+                                           scratch + half * M, rows, weights, slabs,
+                                           0, info->out_shape[d + 1])))
+            return retval;
+    }
+    return 0;
+}
+
+
+/* Strides in elements of the slabs along each axis of a C-contiguous array */
+static void CAT(TYPE, _slab_sizes)(const size_t ndim, const size_t * const shape,
+                                   size_t * const slab){
+    size_t d;
+
+    for (d = ndim; d-- > 0; )
+        slab[d] = (d + 1 < ndim) ? slab[d + 1] * shape[d + 1] : 1;
+}
+
+/* The buffers of one thread of a plan, for the largest of its levels, see
+ * _dec_slab and _rec_slab */
+typedef struct {
+    TYPE * scratch;
+    TYPE * weights;
+    const TYPE ** rows;
+    const TYPE ** slabs;
+} CAT(TYPE, _ThreadBuffers);
+
+
+struct CAT(TYPE, _WtnPlan) {
+    size_t ndim;
+    unsigned int level;
+    int inverse;
+    unsigned int workers;
+    // the shapes of the coefficients of each level and of the data, followed
+    // by the slab sizes and full shapes of each level
+    size_t * sizes;
+    // coarsest level first
+    CAT(TYPE, _LevelInfo) * levels;
+    // the intermediate approximations
+    TYPE * temp[2];
+    // a single row of input of another type, converted at once
+    INPUT_TYPE input_type;
+    TYPE * converted;
+    size_t n_threads;
+    CAT(TYPE, _ThreadBuffers) * threads;
+    // the subbands of the level being transformed
+    TYPE ** outputs;
+    const TYPE ** inputs;
+};
+
+
+void CAT(TYPE, _wtn_plan_free)(CAT(TYPE, _WtnPlan) * const plan){
+    size_t i;
+
+    if (plan == NULL)
+        return;
+    if (plan->levels != NULL){
+        for (i = 0; i < plan->level; ++i)
+            CAT(TYPE, _free_plans)(plan->levels[i].plans, plan->ndim - 1);
+    }
+    if (plan->threads != NULL){
+        for (i = 0; i < plan->n_threads; ++i){
+            free(plan->threads[i].scratch);
+            free(plan->threads[i].weights);
+            free(plan->threads[i].rows);
+            free(plan->threads[i].slabs);
+        }
+    }
+    free(plan->threads);
+    free(plan->temp[0]);
+    free(plan->temp[1]);
+    free(plan->converted);
+    free(plan->outputs);
+    free(plan->inputs);
+    free(plan->levels);
+    free(plan->sizes);
+    free(plan);
+}
+
+
+/* Check the shapes of the coefficients of a transform of data of shape */
+static int CAT(TYPE, _check_shapes)(const size_t ndim, const size_t * const shape,
+                                    const size_t * const coefs_shapes,
+                                    const Wavelet * const wavelet, const unsigned int level,
+                                    const MODE mode, const int inverse){
+    size_t i, d;
+
+    for (i = 0; i < level; ++i){
+        const int last = (i + 1 == level);
+        const size_t * const fine = last ? shape : coefs_shapes + (i + 1) * ndim;
+        for (d = 0; d < ndim; ++d){
+            if (!inverse){
+                const size_t len = dwt_buffer_length(fine[d], wavelet->dec_len, mode);
+                if (len == 0 || coefs_shapes[i * ndim + d] != len)
+                    return 1;
+            } else {
+                const size_t len = idwt_buffer_length(coefs_shapes[i * ndim + d],
+                                                      wavelet->rec_len, mode);
+                if (len == 0 || (len != fine[d] && (last || len != fine[d] + 1)))
+                    return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+
+/* Set up level i (coarsest first) of plan: its shapes, slab sizes and axis
+ * plans. Returns the elements of scratch its threads need, 0 if memory
+ * could not be allocated. */
+static size_t CAT(TYPE, _init_level)(CAT(TYPE, _WtnPlan) * const plan, const size_t i,
+                                     const Wavelet * const wavelet, const MODE mode,
+                                     const INPUT_TYPE input_type){
+    const size_t ndim = plan->ndim;
+    const size_t * const coarse = plan->sizes + i * ndim;
+    // the data shape follows the coefficients shapes
+    const size_t * const fine = plan->sizes + (i + 1) * ndim;
+    size_t * const level_sizes = plan->sizes + (plan->level + 1) * ndim + 3 * i * ndim;
+    CAT(TYPE, _LevelInfo) * const info = plan->levels + i;
+    size_t d, K;
+
+    info->ndim = ndim;
+    info->in_shape = plan->inverse ? coarse : fine;
+    info->out_shape = plan->inverse ? fine : coarse;
+    info->in_slab = level_sizes;
+    info->out_slab = level_sizes + ndim;
+    info->full_shape = plan->inverse ? level_sizes + 2 * ndim : NULL;
+    info->wavelet = wavelet;
+    info->mode = mode;
+    info->kernel = CAT(TYPE, _simd_rows_kernel)();
+    info->input_type = input_type;
+    CAT(TYPE, _slab_sizes)(ndim, info->in_shape, info->in_slab);
+    CAT(TYPE, _slab_sizes)(ndim, info->out_shape, info->out_slab);
+
+    if (!plan->inverse){
+        K = dec_terms(wavelet->dec_len);
+        info->scratch_len = dec_scratch_len(ndim, info->in_shape);
+        // a single row is transformed in the calling thread
+        info->n_threads = (ndim > 1) ? level_threads(plan->workers, info->out_shape[0]) : 0;
+        if ((info->plans = CAT(TYPE, _alloc_plans)(ndim - 1, info->out_shape, K)) == NULL)
+            return 0;
+        for (d = 0; d + 1 < ndim; ++d)
+            CAT(TYPE, _dec_plan)(info->plans + d, info->in_shape[d], info->out_shape[d],
+                                 wavelet->CAT(dec_lo_, TYPE), wavelet->CAT(dec_hi_, TYPE),
+                                 wavelet->dec_len, mode);
+        return info->scratch_len + ((input_type != INPUT_NATIVE) ? K * CAST_CHUNK_SIZE : 0) + 1;
+    }
+
+    K = rec_terms(wavelet->rec_len);
+    for (d = 0; d < ndim; ++d)
+        info->full_shape[d] = idwt_buffer_length(info->in_shape[d], wavelet->rec_len, mode);
+    // a reconstructed row is at most one longer than needed
+    info->scratch_len = rec_scratch_len(ndim, info->in_shape, info->out_shape[ndim - 1] + 1);
+    info->n_threads = (ndim > 1) ? level_threads(plan->workers, info->out_shape[0]) : 1;
+    if ((info->plans = CAT(TYPE, _alloc_plans)(ndim - 1, info->out_shape, K)) == NULL)
+        return 0;
+    for (d = 0; d + 1 < ndim; ++d)
+        CAT(TYPE, _rec_plan)(info->plans + d, info->in_shape[d], info->full_shape[d],
+                             info->out_shape[d], wavelet->CAT(rec_lo_, TYPE),
+                             wavelet->CAT(rec_hi_, TYPE), wavelet->rec_len, mode);
+    return info->scratch_len + 1;
+}
+
+
+int CAT(TYPE, _wtn_plan_create)(const size_t ndim, const size_t * const shape,
+                                const size_t * const coefs_shapes,
+                                const Wavelet * const wavelet, const unsigned int level,
+                                const MODE mode, const INPUT_TYPE input_type,
+                                const int inverse, const unsigned int workers,
+                                CAT(TYPE, _WtnPlan) ** const plan){
+    CAT(TYPE, _WtnPlan) * p;
+    size_t n_subbands, scratch_len = 0, K, i, d, k;
+
+    *plan = NULL;
+    if (ndim < 1 || ndim >= 8 * sizeof(size_t) - 1 || level < 1 ||
+        input_type < INPUT_NATIVE || input_type >= INPUT_MAX ||
+        (inverse && (wavelet->rec_len % 2 || input_type != INPUT_NATIVE)) ||
+        CAT(TYPE, _check_shapes)(ndim, shape, coefs_shapes, wavelet, level, mode, inverse))
+        return 1;
+    n_subbands = (size_t) 1 << ndim;
+    K = inverse ? rec_terms(wavelet->rec_len) : dec_terms(wavelet->dec_len);
+
+    if ((p = calloc(1, sizeof(CAT(TYPE, _WtnPlan)))) == NULL)
+        return 2;
+    p->ndim = ndim;
+    p->level = level;
+    p->inverse = inverse;
+    p->workers = workers;
+    p->input_type = input_type;
+    if ((p->sizes = malloc((level + 1 + 3 * level) * ndim * sizeof(size_t))) == NULL ||
+        (p->levels = calloc(level, sizeof(CAT(TYPE, _LevelInfo)))) == NULL)
+        goto fail;
+    memcpy(p->sizes, coefs_shapes, level * ndim * sizeof(size_t));
+    memcpy(p->sizes + level * ndim, shape, ndim * sizeof(size_t));
+
+    for (i = 0; i < level; ++i){
+        // the finest level of the decomposition reads the input
+        const INPUT_TYPE level_type = (i + 1 == level && ndim > 1) ? input_type : INPUT_NATIVE;
+        const size_t len = CAT(TYPE, _init_level)(p, i, wavelet, mode, level_type);
+        if (len == 0)
+            goto fail;
+        if (len > scratch_len)
+            scratch_len = len;
+        if (p->levels[i].n_threads > p->n_threads)
+            p->n_threads = p->levels[i].n_threads;
+    }
+
+    if (!inverse && ndim == 1 && input_type != INPUT_NATIVE &&
+        (p->converted = malloc(shape[0] * sizeof(TYPE))) == NULL)
+        goto fail;
+
+    // the approximations of all but the last level go to temporary buffers
+    for (k = 0; k < 2 && k + 1 < level; ++k){
+        const size_t * const temp_shape = coefs_shapes + (level - 1 - k) * ndim;
+        size_t size = 1;
+        for (d = 0; d < ndim; ++d)
+            size *= temp_shape[d];
+        if ((p->temp[k] = malloc(size * sizeof(TYPE))) == NULL)
+            goto fail;
+    }
+
+    if ((inverse && (p->inputs = malloc(n_subbands * sizeof(const TYPE *))) == NULL) ||
+        (!inverse && (p->outputs = malloc(n_subbands * sizeof(TYPE *))) == NULL))
+        goto fail;
+    if (p->n_threads > 0 &&
+        (p->threads = calloc(p->n_threads, sizeof(CAT(TYPE, _ThreadBuffers)))) == NULL)
+        goto fail;
+    for (i = 0; i < p->n_threads; ++i){
+        CAT(TYPE, _ThreadBuffers) * const buffers = p->threads + i;
+        if ((buffers->scratch = malloc(scratch_len * sizeof(TYPE))) == NULL ||
+            (buffers->rows = malloc((2 * K + 1) * sizeof(const TYPE *))) == NULL)
+            goto fail;
+        if (inverse &&
+            ((buffers->weights = malloc((2 * K + 1) * sizeof(TYPE))) == NULL ||
+             (buffers->slabs = malloc(n_subbands * sizeof(const TYPE *))) == NULL))
+            goto fail;
+    }
+
+    *plan = p;
+    return 0;
+
+fail:
+    CAT(TYPE, _wtn_plan_free)(p);
+    return 2;
+}
+
+
+/* Single level of _wavedecn_execute, from input to plan->outputs */
+static int CAT(TYPE, _dwtn_level)(const CAT(TYPE, _WtnPlan) * const plan,
+                                  const CAT(TYPE, _LevelInfo) * const info,
+                                  const void * const input){
+    TYPE * const * const outputs = plan->outputs;
+    int retval = 0;
+
+    if (info->ndim == 1)
+        return CAT(TYPE, _dec_slab)(info, 0, input, outputs, 0, 0, NULL, NULL, 0, 0);
+
+    // The outputs along the first axis are distributed over the threads
+#ifdef _OPENMP
+#pragma omp parallel num_threads((int) info->n_threads) if (plan->workers > 1) \
+    reduction(|:retval)
+#endif
+    {
+        const CAT(TYPE, _ThreadBuffers) * const buffers = plan->threads + parallel_thread();
+        size_t first, last;
+
+        parallel_range(info->out_shape[0], &first, &last);
+        retval = CAT(TYPE, _dec_slab)(info, 0, input, outputs, 0, 0, buffers->scratch,
+                                      buffers->rows, first, last);
+    }
+    return retval;
+}
+
+
+/* Single level of _waverecn_execute, from plan->inputs to output */
+static int CAT(TYPE, _idwtn_level)(const CAT(TYPE, _WtnPlan) * const plan,
+                                   const CAT(TYPE, _LevelInfo) * const info,
+                                   TYPE * const output){
+    const TYPE * const * const inputs = plan->inputs;
+    int retval = 0;
+
+    // The outputs along the first axis are distributed over the threads
+#ifdef _OPENMP
+#pragma omp parallel num_threads((int) info->n_threads) if (plan->workers > 1) \
+    reduction(|:retval)
+#endif
+    {
+        const CAT(TYPE, _ThreadBuffers) * const buffers = plan->threads + parallel_thread();
+        size_t first, last;
+
+        parallel_range(info->out_shape[0], &first, &last);
+        if (info->ndim > 1 || first == 0)
+            retval = CAT(TYPE, _rec_slab)(info, 0, inputs, output, buffers->scratch,
+                                          buffers->rows, buffers->weights, buffers->slabs,
+                                          first, last);
+    }
+    return retval;
+}
+
+
+int CAT(TYPE, _wavedecn_execute)(CAT(TYPE, _WtnPlan) * const plan,
+                                 const void * const restrict input,
+                                 TYPE * const * const coefs){
+    const size_t n_subbands = (size_t) 1 << plan->ndim;
+    const unsigned int level = plan->level;
+    const void * in = input;
+    size_t i, k;
+    int retval;
+
+    if (plan->inverse)
+        return 1;
+    if (plan->converted != NULL){
+        CAT(TYPE, _cast)(input, plan->input_type,
+                         (pywt_index_t) input_itemsize(plan->input_type, sizeof(TYPE)),
+                         plan->converted, plan->sizes[level]);
+        in = plan->converted;
+    }
+
+    // finest level first
+    for (i = level; i-- > 0; ){
+        plan->outputs[0] = (i == 0) ? coefs[0] : plan->temp[(level - 1 - i) % 2];
+        for (k = 1; k < n_subbands; ++k)
+            plan->outputs[k] = coefs[1 + i * (n_subbands - 1) + (k - 1)];
+        if ((retval = CAT(TYPE, _dwtn_level)(plan, plan->levels + i, in)))
+            return retval;
+        // the coarser levels transform the approximations of TYPE
+        in = plan->outputs[0];
+    }
+    return 0;
+}
+
+
+int CAT(TYPE, _waverecn_execute)(CAT(TYPE, _WtnPlan) * const plan,
+                                 const TYPE * const * const coefs,
+                                 TYPE * const restrict output){
+    const size_t n_subbands = (size_t) 1 << plan->ndim;
+    const unsigned int level = plan->level;
+    const TYPE * a = coefs[0];
+    size_t i, k;
+    int retval;
+
+    if (!plan->inverse)
+        return 1;
+
+    // coarsest level first
+    for (i = 0; i < level; ++i){
+        TYPE * const out = (i + 1 == level) ? output : plan->temp[(level - 2 - i) % 2];
+        plan->inputs[0] = a;
+        for (k = 1; k < n_subbands; ++k)
+            plan->inputs[k] = coefs[1 + i * (n_subbands - 1) + (k - 1)];
+        if ((retval = CAT(TYPE, _idwtn_level)(plan, plan->levels + i, out)))
+            return retval;
+        a = out;
+    }
+    return 0;
+}
+
+
+int CAT(TYPE, _wavedecn)(const TYPE * const restrict input, const size_t ndim,
+                         const size_t * const input_shape, const Wavelet * const restrict wavelet,
+                         TYPE * const * const coefs, const size_t * const coefs_shapes,
+                         const unsigned int level, const MODE mode,
+                         const unsigned int workers){
+    return CAT(TYPE, _wavedecn_cast)(input, INPUT_NATIVE, ndim, input_shape, wavelet, coefs,
+                                     coefs_shapes, level, mode, workers);
+}
+
+
+int CAT(TYPE, _wavedecn_cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                              const size_t ndim, const size_t * const input_shape,
+                              const Wavelet * const restrict wavelet,
+                              TYPE * const * const coefs, const size_t * const coefs_shapes,
+                              const unsigned int level, const MODE mode,
+                              const unsigned int workers){
+    CAT(TYPE, _WtnPlan) * plan;
+    int retval;
+
+    if ((retval = CAT(TYPE, _wtn_plan_create)(ndim, input_shape, coefs_shapes, wavelet, level,
+                                              mode, input_type, 0, workers, &plan)))
+        return retval;
+    retval = CAT(TYPE, _wavedecn_execute)(plan, input, coefs);
+    CAT(TYPE, _wtn_plan_free)(plan);
+    return retval;
+}
+
+
+int CAT(TYPE, _waverecn)(const TYPE * const * const coefs, const size_t ndim,
+                         const size_t * const coefs_shapes, const Wavelet * const restrict wavelet,
+                         TYPE * const restrict output, const size_t * const output_shape,
+                         const unsigned int level, const MODE mode,
+                         const unsigned int workers){
+    CAT(TYPE, _WtnPlan) * plan;
+    int retval;
+
+    if ((retval = CAT(TYPE, _wtn_plan_create)(ndim, output_shape, coefs_shapes, wavelet, level,
+                                              mode, INPUT_NATIVE, 1, workers, &plan)))
+        return retval;
+    retval = CAT(TYPE, _waverecn_execute)(plan, coefs, output);
+    CAT(TYPE, _wtn_plan_free)(plan);
+    return retval;
+}
+
+
+/* One level along axis of all lines of the block of shape at data, in place,
+ * or its inverse. Tiles of up to AXIS_TILE_SIZE lines along the contiguous
+ * axis inner (single lines if inner == ndim) are copied to a buffer, from
+ * which _dwt_axis (or _idwt_axis, or for contiguous lines _dec or _idwt)
+ * writes them back transformed. */
+static int CAT(TYPE, _inplace_axis)(TYPE * const data, const size_t * const shape,
+                                    const pywt_index_t * const strides, const size_t ndim,
+                                    const size_t axis, const size_t inner,
+                                    const Wavelet * const wavelet, const METHOD method,
+                                    const int inverse, const unsigned int workers){
+    const size_t N = shape[axis], H = N / 2;
+    const size_t W = (inner < ndim) ? shape[inner] : 1;
+    const size_t n_tiles = (W + AXIS_TILE_SIZE - 1) / AXIS_TILE_SIZE;
+    const size_t tile_len = (W < AXIS_TILE_SIZE) ? W : AXIS_TILE_SIZE;
+    const pywt_index_t stride = strides[axis] / (pywt_index_t) sizeof(TYPE);
+    size_t i, num_loops = 1;
+    int retval = 0;
+
+    for (i = 0; i < ndim; ++i){
+        if (i != axis && i != inner)
+            num_loops *= shape[i];
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(parallel_threads(workers, num_loops * n_tiles)) \
+    if (workers > 1) reduction(|:retval)
+#endif
+    {
+        TYPE * const buffer = malloc(N * tile_len * sizeof(TYPE));
+        size_t q, q_first, q_last;
+
+        parallel_range(num_loops * n_tiles, &q_first, &q_last);
+        if (buffer == NULL)
+            retval = 2;
+        else
+            for (q = q_first; q < q_last && retval == 0; ++q){
+                const size_t t = (q % n_tiles) * AXIS_TILE_SIZE;
+                const size_t w = (W - t < AXIS_TILE_SIZE) ? W - t : AXIS_TILE_SIZE;
+                TYPE * const lines = (TYPE *) ((char *) data
+                    + line_offset(q / n_tiles, shape, strides, ndim, axis, inner)) + t;
+                // the tile is axis 0 of (rows, w) arrays, in the buffer or data
+                size_t full_shape[2] = {N, w}, half_shape[2] = {H, w};
+                pywt_index_t buffer_strides[2] = {(pywt_index_t) (w * sizeof(TYPE)),
+                                                  sizeof(TYPE)};
+                pywt_index_t data_strides[2] = {strides[axis], sizeof(TYPE)};
+                ArrayInfo buffer_info = {full_shape, buffer_strides, 2};
+                ArrayInfo data_info = {half_shape, data_strides, 2};
+                size_t k, l;
+
+                for (k = 0; k < N; ++k){
+                    const TYPE * const row = lines + (pywt_index_t) k * stride;
+                    for (l = 0; l < w; ++l)
+                        buffer[k * w + l] = row[l];
+                }
+                if (w == 1 && stride == 1){
+                    // a contiguous line
+                    retval = (inverse ? CAT(TYPE, _idwt)(buffer, H, buffer + H, H, lines, N,
+                                                         wavelet, MODE_PERIODIZATION, method)
+                              : CAT(TYPE, _dec)(buffer, N, wavelet, lines, lines + H, H,
+                                                MODE_PERIODIZATION, method)) ? 1 : 0;
+                } else if (!inverse){
+                    retval = CAT(TYPE, _dwt_axis)(buffer, buffer_info, lines, data_info,
+                                                  lines + (pywt_index_t) H * stride, data_info,
+                                                  wavelet, 0, MODE_PERIODIZATION, method, 1)
+                        ? 1 : 0;
+                } else {
+                    buffer_info.shape = half_shape;
+                    data_info.shape = full_shape;
+                    retval = CAT(TYPE, _idwt_axis)(buffer, &buffer_info, buffer + H * w,
+                                                   &buffer_info, lines, data_info, wavelet, 0,
+                                                   MODE_PERIODIZATION, method, 1) ? 1 : 0;
+                }
+            }
+        free(buffer);
+    }
+    return retval;
+}
+
+
+static int CAT(TYPE, _inplace_levels)(TYPE * const data, const ArrayInfo info,
+                                      const size_t * const axes, const size_t n_axes,
+                                      const Wavelet * const wavelet,
+                                      const unsigned int level, const METHOD method,
+                                      const int inverse, const unsigned int workers){
+    size_t * shape;
+    size_t d, c;
+    unsigned int l;
+    int retval = 0;
+
+    if (info.ndim < 1 || level >= 8 * sizeof(size_t) ||
+        (method == METHOD_LIFTING && wavelet->lifting == NULL))
+        return 1;
+    for (d = 0; d < info.ndim; ++d){
+        if (info.strides[d] % (pywt_index_t) sizeof(TYPE))
+            return 1;
+        if (info.shape[d] == 0)
+            return 0;
+    }
+    for (d = 0; d < n_axes; ++d){
+        if (axes[d] >= info.ndim || info.shape[axes[d]] % ((size_t) 1 << level))
+            return 1;
+    }
+    if ((shape = malloc(info.ndim * sizeof(size_t))) == NULL)
+        return 2;
+    memcpy(shape, info.shape, info.ndim * sizeof(size_t));
+
+    /* The block of each level is transformed along every axis, the inverse
+     * undoes the levels and axes in reverse order */
+    for (l = 0; l < level && retval == 0; ++l){
+        const unsigned int j = inverse ? level - 1 - l : l;
+        for (d = 0; d < n_axes; ++d)
+            shape[axes[d]] = info.shape[axes[d]] >> j;
+        for (d = 0; d < n_axes && retval == 0; ++d){
+            const size_t a = axes[inverse ? n_axes - 1 - d : d];
+            // last axes first, being contiguous for C-ordered arrays
+            for (c = info.ndim; c-- > 0; )
+                if (c != a && shape[c] >= AXIS_TILE_MIN_WIDTH &&
+                    info.strides[c] == (pywt_index_t) sizeof(TYPE))
+                    break;
+            if (c > info.ndim)
+                c = info.ndim;
+            retval = CAT(TYPE, _inplace_axis)(data, shape, info.strides, info.ndim, a, c,
+                                              wavelet, method, inverse, workers);
+        }
+    }
+
+    free(shape);
+    return retval;
+}
+
+
+int CAT(TYPE, _wavedecn_inplace)(TYPE * const data, const ArrayInfo info,
+                                 const size_t * const axes, const size_t n_axes,
+                                 const Wavelet * const wavelet, const unsigned int level,
+                                 const METHOD method, const unsigned int workers){
+    return CAT(TYPE, _inplace_levels)(data, info, axes, n_axes, wavelet, level, method, 0,
+                                      workers);
+}
+
+
+int CAT(TYPE, _waverecn_inplace)(TYPE * const data, const ArrayInfo info,
+                                 const size_t * const axes, const size_t n_axes,
+                                 const Wavelet * const wavelet, const unsigned int level,
+                                 const METHOD method, const unsigned int workers){
+    return CAT(TYPE, _inplace_levels)(data, info, axes, n_axes, wavelet, level, method, 1,
+                                      workers);
+}
+
+#undef restrict
+#endif /* TYPE */
@@ -0,0 +1,115 @@
+/* See COPYING for license details. */
+
+#include "templating.h"
+
+#ifndef TYPE
+#error TYPE must be defined here.
+#else
+
+#include "wtn.h"
+
+#if defined _MSC_VER
+#define restrict __restrict
+#elif defined __GNUC__
+#define restrict __restrict__
+#endif
+
+/* Multilevel DWT of all axes of the C-contiguous array input of ndim > 0
+ * dimensions, using the convolutions.
+ *
+ * The coefficients of each level are C-contiguous arrays with shape
+ * coefs_shapes[l * ndim .. (l + 1) * ndim) for l = [0..level), coarsest
+ * level first. coefs[0] receives the approximation at the coarsest level,
+ * and coefs[1 + l * (2**ndim - 1) + (k - 1)] the details of subband k of
+ * level l, k = [1..2**ndim). Bit (ndim - 1 - i) of k is set for the details
+ * along axis i, so the subbands are in the order of itertools.product('ad',
+ * repeat=ndim).
+ *
+ * Uses up to workers threads if built with OpenMP. Returns 0 on success, 1
+ * for invalid shapes and 2 if memory could not be allocated. */
+int CAT(TYPE, _wavedecn)(const TYPE * const restrict input, const size_t ndim,
+                         const size_t * const input_shape, const Wavelet * const restrict wavelet,
+                         TYPE * const * const coefs, const size_t * const coefs_shapes,
+                         const unsigned int level, const MODE mode,
+                         const unsigned int workers);
+
+/* _wavedecn of input with elements of input_type, converted to TYPE as the
+ * first level reads them */
+int CAT(TYPE, _wavedecn_cast)(const void * const restrict input, const INPUT_TYPE input_type,
+                              const size_t ndim, const size_t * const input_shape,
+                              const Wavelet * const restrict wavelet,
+                              TYPE * const * const coefs, const size_t * const coefs_shapes,
+                              const unsigned int level, const MODE mode,
+                              const unsigned int workers);
+
+/* Multilevel IDWT, the inverse of _wavedecn with the same arrangement of
+ * coefs (any of which may be NULL, for zeros). As in waverecn, the
+ * reconstructed approximation of a level may be one coefficient longer
+ * along each axis than the details of the next, the last coefficient is
+ * then ignored. output has shape output_shape. */
+int CAT(TYPE, _waverecn)(const TYPE * const * const coefs, const size_t ndim,
+                         const size_t * const coefs_shapes, const Wavelet * const restrict wavelet,
+                         TYPE * const restrict output, const size_t * const output_shape,
+                         const unsigned int level, const MODE mode,
+                         const unsigned int workers);
+
+/* A plan of _wavedecn_cast or _waverecn for arrays of fixed shapes: the
+ * axis plans of all levels, the intermediate approximations and the buffers
+ * of the threads, so that executing it allocates no memory (but that of the
+ * FFT convolutions of long filters). A plan must not be executed by several
+ * threads at once, and wavelet must outlive it. */
+typedef struct CAT(TYPE, _WtnPlan) CAT(TYPE, _WtnPlan);
+
+/* Create the plan of _wavedecn_cast (if inverse is 0) of input of shape and
+ * input_type, or of _waverecn (if inverse is 1, with input_type
+ * INPUT_NATIVE) to output of shape, with the other arguments as there.
+ * Returns 0 on success, 1 for invalid arguments and 2 if memory could not
+ * be allocated, leaving *plan NULL. */
+int CAT(TYPE, _wtn_plan_create)(const size_t ndim, const size_t * const shape,
+                                const size_t * const coefs_shapes,
+                                const Wavelet * const wavelet, const unsigned int level,
+                                const MODE mode, const INPUT_TYPE input_type,
+                                const int inverse, const unsigned int workers,
+                                CAT(TYPE, _WtnPlan) ** const plan);
+
+void CAT(TYPE, _wtn_plan_free)(CAT(TYPE, _WtnPlan) * const plan);
+
+/* Execute a plan of _wavedecn_cast (or _waverecn), with the arrays as there.
+ * Returns 0 on success, 1 for a plan of the other direction and 2 if memory
+ * could not be allocated. */
+int CAT(TYPE, _wavedecn_execute)(CAT(TYPE, _WtnPlan) * const plan,
+                                 const void * const restrict input,
+                                 TYPE * const * const coefs);
+
+int CAT(TYPE, _waverecn_execute)(CAT(TYPE, _WtnPlan) * const plan,
+                                 const TYPE * const * const coefs,
+                                 TYPE * const restrict output);
+
+/* Multilevel DWT along the n_axes axes of data, in place, with
+ * MODE_PERIODIZATION and method. At each level, every line along these axes
+ * of the approximation block left by the previous level (all of data at the
+ * first level) is replaced by its N/2 approximation coefficients followed
+ * by its N/2 detail coefficients, so the approximation block of the next
+ * level is the first half along each of the axes. The lengths along them
+ * must be multiples of 2**level. The strides of info are in bytes.
+ *
+ * Lines are copied to a buffer, a tile of up to AXIS_TILE_SIZE neighbouring
+ * lines at a time along a contiguous axis, and transformed by _dec, so only
+ * two tiles of memory are allocated per thread.
+ *
+ * Uses up to workers threads if built with OpenMP. Returns 0 on success, 1
+ * for invalid arguments (or METHOD_LIFTING without a lifting scheme) and 2
+ * if memory could not be allocated. */
+int CAT(TYPE, _wavedecn_inplace)(TYPE * const data, const ArrayInfo info,
+                                 const size_t * const axes, const size_t n_axes,
+                                 const Wavelet * const wavelet, const unsigned int level,
+                                 const METHOD method, const unsigned int workers);
+
+/* The inverse of _wavedecn_inplace, in place, with the same arguments */
+int CAT(TYPE, _waverecn_inplace)(TYPE * const data, const ArrayInfo info,
+                                 const size_t * const axes, const size_t n_axes,
+                                 const Wavelet * const wavelet, const unsigned int level,
+                                 const METHOD method, const unsigned int workers);
+
+#undef restrict
+#endif /* TYPE */
@@ -1,7 +1,8 @@
 # Copyright (c) 2006-2012 Filip Wasilewski <http://en.ig.ma/>
 # See COPYING for license details.
 
-from common cimport MODE, pywt_index_t, ArrayInfo, Coefficient
+from common cimport (MODE, METHOD, INPUT_TYPE, pywt_index_t, ArrayInfo,
+                    Coefficient)
 from wavelet cimport Wavelet
 
 
@@ -10,12 +11,42 @@ cdef extern from "c/wt.h":
     cdef int double_downcoef_axis(const double * const input, const ArrayInfo input_info,
                                   double * const output, const ArrayInfo output_info,
                                   const Wavelet * const wavelet, const size_t axis,
-                                  const Coefficient detail, const MODE mode) nogil
+                                  const Coefficient detail, const MODE mode,
+                                  const unsigned int workers) nogil
+    cdef int double_dwt_axis(const double * const input, const ArrayInfo input_info,
+                             double * const coefs_a, const ArrayInfo a_info,
+                             double * const coefs_d, const ArrayInfo d_info,
+                             const Wavelet * const wavelet, const size_t axis,
+                             const MODE mode, const METHOD method,
+                             const unsigned int workers) nogil
+    cdef int double_dwt_axis_cast(const void * const input, const INPUT_TYPE input_type,
+                                  const ArrayInfo input_info,
+                                  double * const coefs_a, const ArrayInfo a_info,
+                                  double * const coefs_d, const ArrayInfo d_info,
+                                  const Wavelet * const wavelet, const size_t axis,
+                                  const MODE mode, const METHOD method,
+                                  const unsigned int workers) nogil
     cdef int double_idwt_axis(const double * const coefs_a, const ArrayInfo * const a_info,
                               const double * const coefs_d, const ArrayInfo * const d_info,
                               double * const output, const ArrayInfo output_info,
                               const Wavelet * const wavelet, const size_t axis,
-                              const MODE mode) nogil
+                              const MODE mode, const METHOD method,
+                              const unsigned int workers) nogil
+    cdef int double_complex_dwt_axis(const double * const input, const ArrayInfo input_info,
+                                     double * const coefs_a, const ArrayInfo a_info,
+                                     double * const coefs_d, const ArrayInfo d_info,
+                                     const Wavelet * const wavelet, const size_t axis,
+                                     const MODE mode, const METHOD method,
+                                     const unsigned int workers) nogil
+    cdef int double_complex_idwt_axis(const double * const coefs_a, const ArrayInfo * const a_info,
+                                      const double * const coefs_d, const ArrayInfo * const d_info,
+                                      double * const output, const ArrayInfo output_info,
+                                      const Wavelet * const wavelet, const size_t axis,
+                                      const MODE mode, const METHOD method,
+                                      const unsigned int workers) nogil
+    cdef int double_pad(const double * const input, const size_t ndim,
+                        const size_t * const input_shape, double * const output,
+                        const size_t * const pad_widths, const MODE mode) nogil
     cdef int double_dec_a(const double * const input, const size_t input_len,
                           const Wavelet * const wavelet,
                           double * const output, const size_t output_len,
@@ -24,6 +55,11 @@ cdef extern from "c/wt.h":
                           const Wavelet * const wavelet,
                           double * const output, const size_t output_len,
                           const MODE mode) nogil
+    cdef int double_dec(const double * const input, const size_t input_len,
+                        const Wavelet * const wavelet,
+                        double * const output_a, double * const output_d,
+                        const size_t output_len, const MODE mode,
+                        const METHOD method) nogil
 
     cdef int double_rec_a(const double * const coeffs_a, const size_t coeffs_len,
                           const Wavelet * const wavelet,
@@ -35,23 +71,132 @@ cdef extern from "c/wt.h":
     cdef int double_idwt(double * const coeffs_a, const size_t coeffs_a_len,
                          double * const coeffs_d, const size_t coeffs_d_len,
                          double * const output, const size_t output_len,
-                         const Wavelet * const wavelet, const MODE mode) nogil
+                         const Wavelet * const wavelet, const MODE mode,
+                         const METHOD method) nogil
+
+    cdef int double_wavedec(const double * const input, const size_t n_rows,
+                            const size_t input_len, const Wavelet * const wavelet,
+                            double * const * const coefs, const size_t * const coefs_lens,
+                            const unsigned int level, const MODE mode, const METHOD method,
+                            const unsigned int workers) nogil
+    cdef int double_wavedec_cast(const void * const input, const INPUT_TYPE input_type,
+                                 const size_t n_rows, const size_t input_len,
+                                 const Wavelet * const wavelet,
+                                 double * const * const coefs, const size_t * const coefs_lens,
+                                 const unsigned int level, const MODE mode, const METHOD method,
+                                 const unsigned int workers) nogil
+    cdef int double_waverec(const double * const * const coefs, const size_t * const coefs_lens,
+                            const size_t n_rows, const Wavelet * const wavelet,
+                            double * const output, const size_t output_len,
+                            const unsigned int level, const MODE mode, const METHOD method,
+                            const unsigned int workers) nogil
 
+    cdef int double_complex_wavedec(const double * const input, const size_t n_rows,
+                                    const size_t input_len, const Wavelet * const wavelet,
+                                    double * const * const coefs, const size_t * const coefs_lens,
+                                    const unsigned int level, const MODE mode, const METHOD method,
+                                    const unsigned int workers) nogil
+    cdef int double_complex_waverec(const double * const * const coefs, const size_t * const coefs_lens,
+                                    const size_t n_rows, const Wavelet * const wavelet,
+                                    double * const output, const size_t output_len,
+                                    const unsigned int level, const MODE mode, const METHOD method,
+                                    const unsigned int workers) nogil
     cdef int double_swt_a(double input[], pywt_index_t input_len, Wavelet* wavelet,
                           double output[], pywt_index_t output_len, int level) nogil
     cdef int double_swt_d(double input[], pywt_index_t input_len, Wavelet* wavelet,
                           double output[], pywt_index_t output_len, int level) nogil
+    cdef int double_iswt(double coeffs_a[], double coeffs_d[], pywt_index_t coeffs_len,
+                         Wavelet* wavelet, double output[], pywt_index_t output_len,
+                         int level) nogil
+    cdef int double_swt_multilevel(const double * const input, const size_t input_len,
+                                   const Wavelet * const wavelet,
+                                   double * const * const coefs_a, double * const * const coefs_d,
+                                   const unsigned int level, const unsigned int start_level) nogil
+    cdef int double_iswt_multilevel(const double * const coefs_a,
+                                    const double * const * const coefs_d, const size_t coefs_len,
+                                    const Wavelet * const wavelet,
+                                    double * const output, const unsigned int level) nogil
+    cdef int double_swt_axis(const double * const input, const ArrayInfo input_info,
+                             double * const coefs_a, const ArrayInfo a_info,
+                             double * const coefs_d, const ArrayInfo d_info,
+                             const Wavelet * const wavelet, const size_t axis,
+                             const unsigned int level, const unsigned int workers) nogil
+    cdef int double_complex_swt_axis(const double * const input, const ArrayInfo input_info,
+                                     double * const coefs_a, const ArrayInfo a_info,
+                                     double * const coefs_d, const ArrayInfo d_info,
+                                     const Wavelet * const wavelet, const size_t axis,
+                                     const unsigned int level, const unsigned int workers) nogil
+    cdef int double_iswt_axis(const double * const coefs_a, const ArrayInfo a_info,
+                              const double * const coefs_d, const ArrayInfo d_info,
+                              double * const output, const ArrayInfo output_info,
+                              const Wavelet * const wavelet, const size_t axis,
+                              const unsigned int level, const unsigned int workers) nogil
+    cdef int double_complex_iswt_axis(const double * const coefs_a, const ArrayInfo a_info,
+                                      const double * const coefs_d, const ArrayInfo d_info,
+                                      double * const output, const ArrayInfo output_info,
+                                      const Wavelet * const wavelet, const size_t axis,
+                                      const unsigned int level, const unsigned int workers) nogil
+    cdef int double_modwt_axis(const double * const input, const ArrayInfo input_info,
+                               double * const * const coefs_a, double * const * const coefs_d,
+                               const ArrayInfo * const coefs_infos,
+                               const Wavelet * const wavelet, const size_t axis,
+                               const unsigned int level, const unsigned int workers) nogil
+    cdef int double_imodwt_axis(const double * const coefs_a, const ArrayInfo a_info,
+                                const double * const * const coefs_d, const ArrayInfo * const d_infos,
+                                double * const output, const ArrayInfo output_info,
+                                const Wavelet * const wavelet, const size_t axis,
+                                const unsigned int level, const unsigned int workers) nogil
+    cdef int double_complex_modwt_axis(const double * const input, const ArrayInfo input_info,
+                                       double * const * const coefs_a, double * const * const coefs_d,
+                                       const ArrayInfo * const coefs_infos,
+                                       const Wavelet * const wavelet, const size_t axis,
+                                       const unsigned int level, const unsigned int workers) nogil
+    cdef int double_complex_imodwt_axis(const double * const coefs_a, const ArrayInfo a_info,
+                                        const double * const * const coefs_d, const ArrayInfo * const d_infos,
+                                        double * const output, const ArrayInfo output_info,
+                                        const Wavelet * const wavelet, const size_t axis,
+                                        const unsigned int level, const unsigned int workers) nogil
 
 
     cdef int float_downcoef_axis(const float * const input, const ArrayInfo input_info,
                                  float * const output, const ArrayInfo output_info,
                                  const Wavelet * const wavelet, const size_t axis,
-                                 const Coefficient detail, const MODE mode) nogil
+                                 const Coefficient detail, const MODE mode,
+                                 const unsigned int workers) nogil
+    cdef int float_dwt_axis(const float * const input, const ArrayInfo input_info,
+                            float * const coefs_a, const ArrayInfo a_info,
+                            float * const coefs_d, const ArrayInfo d_info,
+                            const Wavelet * const wavelet, const size_t axis,
+                            const MODE mode, const METHOD method,
+                            const unsigned int workers) nogil
+    cdef int float_dwt_axis_cast(const void * const input, const INPUT_TYPE input_type,
+                                 const ArrayInfo input_info,
+                                 float * const coefs_a, const ArrayInfo a_info,
+                                 float * const coefs_d, const ArrayInfo d_info,
+                                 const Wavelet * const wavelet, const size_t axis,
+                                 const MODE mode, const METHOD method,
+                                 const unsigned int workers) nogil
     cdef int float_idwt_axis(const float * const coefs_a, const ArrayInfo * const a_info,
                              const float * const coefs_d, const ArrayInfo * const d_info,
                              float * const output, const ArrayInfo output_info,
                              const Wavelet * const wavelet, const size_t axis,
-                             const MODE mode) nogil
+                             const MODE mode, const METHOD method,
+                             const unsigned int workers) nogil
+    cdef int float_complex_dwt_axis(const float * const input, const ArrayInfo input_info,
+                                    float * const coefs_a, const ArrayInfo a_info,
+                                    float * const coefs_d, const ArrayInfo d_info,
+                                    const Wavelet * const wavelet, const size_t axis,
+                                    const MODE mode, const METHOD method,
+                                    const unsigned int workers) nogil
+    cdef int float_complex_idwt_axis(const float * const coefs_a, const ArrayInfo * const a_info,
+                                     const float * const coefs_d, const ArrayInfo * const d_info,
+                                     float * const output, const ArrayInfo output_info,
+                                     const Wavelet * const wavelet, const size_t axis,
+                                     const MODE mode, const METHOD method,
+                                     const unsigned int workers) nogil
+    cdef int float_pad(const float * const input, const size_t ndim,
+                       const size_t * const input_shape, float * const output,
+                       const size_t * const pad_widths, const MODE mode) nogil
     cdef int float_dec_a(const float * const input, const size_t input_len,
                          const Wavelet * const wavelet,
                          float * const output, const size_t output_len,
@@ -60,6 +205,11 @@ cdef extern from "c/wt.h":
                          const Wavelet * const wavelet,
                          float * const output, const size_t output_len,
                          const MODE mode) nogil
+    cdef int float_dec(const float * const input, const size_t input_len,
+                       const Wavelet * const wavelet,
+                       float * const output_a, float * const output_d,
+                       const size_t output_len, const MODE mode,
+                       const METHOD method) nogil
 
     cdef int float_rec_a(const float * const coeffs_a, const size_t coeffs_len,
                          const Wavelet * const wavelet,
@@ -71,9 +221,198 @@ cdef extern from "c/wt.h":
     cdef int float_idwt(const float * const coeffs_a, const size_t coeffs_a_len,
                         const float * const coeffs_d, const size_t coeffs_d_len,
                         float * const output, const size_t output_len,
-                        const Wavelet * const wavelet, const MODE mode) nogil
+                        const Wavelet * const wavelet, const MODE mode,
+                        const METHOD method) nogil
+
+    cdef int float_wavedec(const float * const input, const size_t n_rows,
+                           const size_t input_len, const Wavelet * const wavelet,
+                           float * const * const coefs, const size_t * const coefs_lens,
+                           const unsigned int level, const MODE mode, const METHOD method,
+                           const unsigned int workers) nogil
+    cdef int float_wavedec_cast(const void * const input, const INPUT_TYPE input_type,
+                                const size_t n_rows, const size_t input_len,
+                                const Wavelet * const wavelet,
+                                float * const * const coefs, const size_t * const coefs_lens,
+                                const unsigned int level, const MODE mode, const METHOD method,
+                                const unsigned int workers) nogil
+    cdef int float_waverec(const float * const * const coefs, const size_t * const coefs_lens,
+                           const size_t n_rows, const Wavelet * const wavelet,
+                           float * const output, const size_t output_len,
+                           const unsigned int level, const MODE mode, const METHOD method,
+                           const unsigned int workers) nogil
 
+    cdef int float_complex_wavedec(const float * const input, const size_t n_rows,
+                                   const size_t input_len, const Wavelet * const wavelet,
+                                   float * const * const coefs, const size_t * const coefs_lens,
+                                   const unsigned int level, const MODE mode, const METHOD method,
+                                   const unsigned int workers) nogil
+    cdef int float_complex_waverec(const float * const * const coefs, const size_t * const coefs_lens,
+                                   const size_t n_rows, const Wavelet * const wavelet,
+                                   float * const output, const size_t output_len,
+                                   const unsigned int level, const MODE mode, const METHOD method,
+                                   const unsigned int workers) nogil
     cdef int float_swt_a(float input[], pywt_index_t input_len, Wavelet* wavelet,
                          float output[], pywt_index_t output_len, int level) nogil
     cdef int float_swt_d(float input[], pywt_index_t input_len, Wavelet* wavelet,
                          float output[], pywt_index_t output_len, int level) nogil
+    cdef int float_iswt(float coeffs_a[], float coeffs_d[], pywt_index_t coeffs_len,
+                        Wavelet* wavelet, float output[], pywt_index_t output_len,
+                        int level) nogil
+    cdef int float_swt_multilevel(const float * const input, const size_t input_len,
+                                  const Wavelet * const wavelet,
+                                  float * const * const coefs_a, float * const * const coefs_d,
+                                  const unsigned int level, const unsigned int start_level) nogil
+    cdef int float_iswt_multilevel(const float * const coefs_a,
+                                   const float * const * const coefs_d, const size_t coefs_len,
+                                   const Wavelet * const wavelet,
+                                   float * const output, const unsigned int level) nogil
+    cdef int float_swt_axis(const float * const input, const ArrayInfo input_info,
+                            float * const coefs_a, const ArrayInfo a_info,
+                            float * const coefs_d, const ArrayInfo d_info,
+                            const Wavelet * const wavelet, const size_t axis,
+                            const unsigned int level, const unsigned int workers) nogil
+    cdef int float_complex_swt_axis(const float * const input, const ArrayInfo input_info,
+                                    float * const coefs_a, const ArrayInfo a_info,
+                                    float * const coefs_d, const ArrayInfo d_info,
+                                    const Wavelet * const wavelet, const size_t axis,
+                                    const unsigned int level, const unsigned int workers) nogil
+    cdef int float_iswt_axis(const float * const coefs_a, const ArrayInfo a_info,
+                             const float * const coefs_d, const ArrayInfo d_info,
+                             float * const output, const ArrayInfo output_info,
+                             const Wavelet * const wavelet, const size_t axis,
+                             const unsigned int level, const unsigned int workers) nogil
+    cdef int float_complex_iswt_axis(const float * const coefs_a, const ArrayInfo a_info,
+                                     const float * const coefs_d, const ArrayInfo d_info,
+                                     float * const output, const ArrayInfo output_info,
+                                     const Wavelet * const wavelet, const size_t axis,
+                                     const unsigned int level, const unsigned int workers) nogil
+    cdef int float_modwt_axis(const float * const input, const ArrayInfo input_info,
+                              float * const * const coefs_a, float * const * const coefs_d,
+                              const ArrayInfo * const coefs_infos,
+                              const Wavelet * const wavelet, const size_t axis,
+                              const unsigned int level, const unsigned int workers) nogil
+    cdef int float_imodwt_axis(const float * const coefs_a, const ArrayInfo a_info,
+                               const float * const * const coefs_d, const ArrayInfo * const d_infos,
+                               float * const output, const ArrayInfo output_info,
+                               const Wavelet * const wavelet, const size_t axis,
+                               const unsigned int level, const unsigned int workers) nogil
+    cdef int float_complex_modwt_axis(const float * const input, const ArrayInfo input_info,
+                                      float * const * const coefs_a, float * const * const coefs_d,
+                                      const ArrayInfo * const coefs_infos,
+                                      const Wavelet * const wavelet, const size_t axis,
+                                      const unsigned int level, const unsigned int workers) nogil
+    cdef int float_complex_imodwt_axis(const float * const coefs_a, const ArrayInfo a_info,
+                                       const float * const * const coefs_d, const ArrayInfo * const d_infos,
+                                       float * const output, const ArrayInfo output_info,
+                                       const Wavelet * const wavelet, const size_t axis,
+                                       const unsigned int level, const unsigned int workers) nogil
+
+
+cdef extern from "c/wtn.h":
+    cdef size_t wavedecn_workspace(const size_t ndim, const size_t * const shape,
+                                   const size_t * const coefs_shapes, const unsigned int level,
+                                   const size_t filter_len, const size_t itemsize,
+                                   const int inverse, const unsigned int workers) nogil
+
+    cdef int double_wavedecn(const double * const input, const size_t ndim,
+                             const size_t * const input_shape, const Wavelet * const wavelet,
+                             double * const * const coefs, const size_t * const coefs_shapes,
+                             const unsigned int level, const MODE mode,
+                             const unsigned int workers) nogil
+    cdef int double_wavedecn_cast(const void * const input, const INPUT_TYPE input_type,
+                                  const size_t ndim, const size_t * const input_shape,
+                                  const Wavelet * const wavelet,
+                                  double * const * const coefs, const size_t * const coefs_shapes,
+                                  const unsigned int level, const MODE mode,
+                                  const unsigned int workers) nogil
+    cdef int double_waverecn(const double * const * const coefs, const size_t ndim,
+                             const size_t * const coefs_shapes, const Wavelet * const wavelet,
+                             double * const output, const size_t * const output_shape,
+                             const unsigned int level, const MODE mode,
+                             const unsigned int workers) nogil
+
+    cdef int float_wavedecn(const float * const input, const size_t ndim,
+                            const size_t * const input_shape, const Wavelet * const wavelet,
+                            float * const * const coefs, const size_t * const coefs_shapes,
+                            const unsigned int level, const MODE mode,
+                            const unsigned int workers) nogil
+    cdef int float_wavedecn_cast(const void * const input, const INPUT_TYPE input_type,
+                                 const size_t ndim, const size_t * const input_shape,
+                                 const Wavelet * const wavelet,
+                                 float * const * const coefs, const size_t * const coefs_shapes,
+                                 const unsigned int level, const MODE mode,
+                                 const unsigned int workers) nogil
+    cdef int float_waverecn(const float * const * const coefs, const size_t ndim,
+                            const size_t * const coefs_shapes, const Wavelet * const wavelet,
+                            float * const output, const size_t * const output_shape,
+                            const unsigned int level, const MODE mode,
+                            const unsigned int workers) nogil
+
+    ctypedef struct double_WtnPlan:
+        pass
+    ctypedef struct float_WtnPlan:
+        pass
+
+    cdef int double_wtn_plan_create(const size_t ndim, const size_t * const shape,
+                                    const size_t * const coefs_shapes,
+                                    const Wavelet * const wavelet, const unsigned int level,
+                                    const MODE mode, const INPUT_TYPE input_type,
+                                    const int inverse, const unsigned int workers,
+                                    double_WtnPlan ** const plan) nogil
+    cdef void double_wtn_plan_free(double_WtnPlan * const plan) nogil
+    cdef int double_wavedecn_execute(double_WtnPlan * const plan, const void * const input,
+                                     double * const * const coefs) nogil
+    cdef int double_waverecn_execute(double_WtnPlan * const plan,
+                                     const double * const * const coefs,
+                                     double * const output) nogil
+
+    cdef int float_wtn_plan_create(const size_t ndim, const size_t * const shape,
+                                   const size_t * const coefs_shapes,
+                                   const Wavelet * const wavelet, const unsigned int level,
+                                   const MODE mode, const INPUT_TYPE input_type,
+                                   const int inverse, const unsigned int workers,
+                                   float_WtnPlan ** const plan) nogil
+    cdef void float_wtn_plan_free(float_WtnPlan * const plan) nogil
+    cdef int float_wavedecn_execute(float_WtnPlan * const plan, const void * const input,
+                                    float * const * const coefs) nogil
+    cdef int float_waverecn_execute(float_WtnPlan * const plan,
+                                    const float * const * const coefs,
+                                    float * const output) nogil
+
+    cdef int double_wavedecn_inplace(double * const data, const ArrayInfo info,
+                                     const size_t * const axes, const size_t n_axes,
+                                     const Wavelet * const wavelet, const unsigned int level,
+                                     const METHOD method, const unsigned int workers) nogil
+    cdef int double_waverecn_inplace(double * const data, const ArrayInfo info,
+                                     const size_t * const axes, const size_t n_axes,
+                                     const Wavelet * const wavelet, const unsigned int level,
+                                     const METHOD method, const unsigned int workers) nogil
+    cdef int float_wavedecn_inplace(float * const data, const ArrayInfo info,
+                                    const size_t * const axes, const size_t n_axes,
+                                    const Wavelet * const wavelet, const unsigned int level,
+                                    const METHOD method, const unsigned int workers) nogil
+    cdef int float_waverecn_inplace(float * const data, const ArrayInfo info,
+                                    const size_t * const axes, const size_t n_axes,
+                                    const Wavelet * const wavelet, const unsigned int level,
+                                    const METHOD method, const unsigned int workers) nogil
+
+
+cdef extern from "c/int_lifting.h":
+    ctypedef enum INT_LIFTING:
+        INT_LIFTING_53 = 0
+        INT_LIFTING_97M
+        INT_LIFTING_MAX
+
+    cdef int short_int_wavedecn(short * const data, const ArrayInfo info,
+                                const INT_LIFTING lifting, const unsigned int level,
+                                const unsigned int workers) nogil
+    cdef int short_int_waverecn(short * const data, const ArrayInfo info,
+                                const INT_LIFTING lifting, const unsigned int level,
+                                const unsigned int workers) nogil
+
+    cdef int int_int_wavedecn(int * const data, const ArrayInfo info,
+                              const INT_LIFTING lifting, const unsigned int level,
+                              const unsigned int workers) nogil
+    cdef int int_int_waverecn(int * const data, const ArrayInfo info,
+                              const INT_LIFTING lifting, const unsigned int level,
+                              const unsigned int workers) nogil
@@ -25,6 +25,21 @@ cdef extern from "c/common.h":
         MODE_REFLECT
         MODE_MAX
 
+    ctypedef enum METHOD:
+        METHOD_INVALID = -1
+        METHOD_CONVOLUTION = 0
+        METHOD_LIFTING
+        METHOD_MAX
+
+    ctypedef enum INPUT_TYPE:
+        INPUT_NATIVE = 0
+        INPUT_UINT8
+        INPUT_INT16
+        INPUT_UINT16
+        INPUT_INT32
+        INPUT_FLOAT16
+        INPUT_MAX
+
     # buffers lengths
     cdef size_t dwt_buffer_length(size_t input_len, size_t filter_len, MODE mode)
     cdef size_t upsampling_buffer_length(size_t coeffs_len, size_t filter_len,
@@ -36,3 +51,4 @@ cdef extern from "c/common.h":
     # max dec levels
     cdef unsigned char dwt_max_level(size_t input_len, size_t filter_len)
     cdef unsigned char swt_max_level(size_t input_len)
+    cdef unsigned char modwt_max_level(size_t input_len)
@@ -0,0 +1,13 @@
+cdef extern from "c/convolution.h":
+    ctypedef enum BOUNDARY:
+        BOUNDARY_INVALID = -1
+        BOUNDARY_INLINE = 0
+        BOUNDARY_PADDED
+        BOUNDARY_MAX
+
+    cdef BOUNDARY boundary_get()
+    cdef int boundary_set(BOUNDARY boundary)
+
+    cdef int fft_threshold_set(size_t taps)
+    cdef size_t fft_threshold_get()
+    cdef size_t fft_threshold()
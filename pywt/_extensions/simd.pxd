@@ -0,0 +1,13 @@
+cdef extern from "c/simd.h":
+    ctypedef enum SIMD:
+        SIMD_INVALID = -1
+        SIMD_NONE = 0
+        SIMD_SSE2
+        SIMD_AVX2
+        SIMD_AVX512
+        SIMD_MAX
+
+    cdef SIMD simd_detect()
+    cdef int simd_supported(SIMD simd)
+    cdef SIMD simd_get()
+    cdef int simd_set(SIMD simd)
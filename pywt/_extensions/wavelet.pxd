@@ -1,5 +1,20 @@
 from common cimport pywt_index_t
 
+cdef extern from "c/lifting.h":
+    ctypedef struct LiftingScheme:
+        size_t n_steps
+        double scale_double[2]
+        float scale_float[2]
+        pywt_index_t shift[2]
+        size_t source[2]
+        pywt_index_t delay
+
+    cdef LiftingScheme* blank_lifting_scheme(size_t n_steps)
+    cdef int set_lifting_step(LiftingScheme* scheme, size_t i, size_t target,
+                              pywt_index_t offset, const double* coefs, size_t len)
+    cdef void free_lifting_scheme(LiftingScheme* scheme)
+
+
 cdef extern from "c/wavelets.h":
     ctypedef enum SYMMETRY:
         ASYMMETRIC
@@ -35,9 +50,12 @@ cdef extern from "c/wavelets.h":
         char* family_name
         char* short_name
 
+        LiftingScheme* lifting
+
 
 cdef extern from "wavelets.h":
     cdef Wavelet* wavelet(char name, int type)
     cdef Wavelet* blank_wavelet(size_t filter_length)
     cdef void free_wavelet(Wavelet* wavelet)
+    cdef void wavelet_update_filters(Wavelet* wavelet)
 
@@ -0,0 +1,401 @@
+# -*- coding: utf-8 -*-
+
+# See COPYING for license details.
+
+"""
+Lifting factorization of two-channel filter banks.
+
+The polyphase matrix of the analysis filter bank is factored into a sequence
+of lifting steps, each updating one of the even and odd input channels with a
+short filter applied to the other, followed by a scaling and shift of each
+channel. Applying the steps costs about half the multiplications of the
+direct convolution.
+
+Two factorizations are tried:
+
+* The Euclidean algorithm (Daubechies & Sweldens, 1998). At each step the
+  quotient is chosen among the possible Laurent polynomial divisions to keep
+  its coefficients small. This gives the shortest schemes, but is badly
+  conditioned for some long filters.
+* For orthogonal filter banks, the paraunitary lattice (Vaidyanathan, 1993),
+  with each rotation written as three lifting steps. This always stays well
+  conditioned, but needs about 1.5 times as many multiplications.
+
+Every factorization is checked against the original filters, and the
+synthesis filters against its inverse, before being used.
+
+Conventions
+-----------
+The decomposition of ``x`` computes (see ``_downsampling_convolution``)::
+
+    cA[o] = sum(dec_lo[j] * y[2*o + 1 - j])
+    cD[o] = sum(dec_hi[j] * y[2*o + 1 - j])
+
+where ``y`` is the (extended) input shifted to start at the first output.
+Channel 0 is ``y[2*m]`` and channel 1 is ``y[2*m + 1]``.
+
+A step ``(target, offset, coefs)`` performs::
+
+    channel[target][m] += sum(coefs[i] * channel[1 - target][m - offset - i])
+
+and the outputs are ``out[k][o] = scales[k] * channel[sources[k]][o - shifts[k]]``
+for ``k = 0`` (approximation) and ``k = 1`` (detail).
+
+The full (not cropped) reconstruction from the synthesis filters equals
+``y[n - delay]``.
+"""
+
+from __future__ import division, print_function, absolute_import
+
+from collections import namedtuple, OrderedDict
+
+import numpy as np
+
+__all__ = ['LiftingScheme', 'lifting_scheme']
+
+
+LiftingScheme = namedtuple('LiftingScheme',
+                           ['steps', 'scales', 'shifts', 'sources', 'delay'])
+
+# Coefficients smaller than this are considered to be zero
+_ZERO_TOL = 1e-9
+# Maximum deviation of the factorization from the filters
+_CHECK_TOL = 1e-9
+# Euclidean factorizations with larger coefficients are rejected, as they
+# amplify rounding errors too much
+_MAX_COEF = 8.
+
+# Number of filter banks whose factorization is cached, more than the built-in
+# wavelets. The least recently used ones are dropped first.
+_CACHE_SIZE = 256
+
+_cache = OrderedDict()
+
+
+###############################################################################
+# Laurent polynomials, as (coefs, offset) for sum(coefs[i] * z**-(offset + i))
+
+_ZERO = (np.zeros(0), 0)
+
+
+def _trim(p, tol=_ZERO_TOL):
+    coefs, offset = p
+    nonzero = np.flatnonzero(np.abs(coefs) > tol)
+    if len(nonzero) == 0:
+        return _ZERO
+    return (coefs[nonzero[0]:nonzero[-1] + 1], offset + nonzero[0])
+
+
+def _mul(p, q):
+    if len(p[0]) == 0 or len(q[0]) == 0:
+        return _ZERO
+    return (np.convolve(p[0], q[0]), p[1] + q[1])
+
+
+def _add(p, q, scale=1.):
+    """p + scale * q"""
+    if len(q[0]) == 0:
+        return p
+    if len(p[0]) == 0:
+        return (scale * q[0], q[1])
+    lo = min(p[1], q[1])
+    hi = max(p[1] + len(p[0]), q[1] + len(q[0]))
+    coefs = np.zeros(hi - lo)
+    coefs[p[1] - lo:p[1] - lo + len(p[0])] += p[0]
+    coefs[q[1] - lo:q[1] - lo + len(q[0])] += scale * q[0]
+    return (coefs, lo)
+
+
+def _max_abs(p):
+    return np.max(np.abs(p[0])) if len(p[0]) else 0.
+
+
+def _divisions(a, b):
+    """All quotients q of a by b such that a - q*b is shorter than b.
+
+    The terms of a are cancelled from the top, from the bottom, and from both
+    ends.
+    """
+    la, lb = len(a[0]), len(b[0])
+    n = la - lb + 1
+    for top in range(n + 1):
+        r = a[0].copy()
+        q = np.zeros(n)
+        for t in range(top):
+            k = n - 1 - t
+            f = r[k + lb - 1] / b[0][-1]
+            q[k] += f
+            r[k:k + lb] -= f * b[0]
+        for k in range(n - top):
+            f = r[k] / b[0][0]
+            q[k] += f
+            r[k:k + lb] -= f * b[0]
+        yield (q, a[1] - b[1])
+
+
+###############################################################################
+# Factorizations
+
+def _polyphase(dec_lo, dec_hi):
+    """Analysis polyphase matrix, columns are the even and odd channels"""
+    return [[(dec_lo[1::2], 0), (dec_lo[0::2], 0)],
+            [(dec_hi[1::2], 0), (dec_hi[0::2], 0)]]
+
+
+def _euclid(dec_lo, dec_hi, score):
+    """Factorization using the Euclidean algorithm.
+
+    Column operations reduce the first row of the polyphase matrix to a
+    single monomial, ``score(quotient, remainder)`` selects the division
+    used at each step.
+    """
+    (a, b), (c, d) = [[_trim(p) for p in row]
+                      for row in _polyphase(dec_lo, dec_hi)]
+    steps = []
+    while len(a[0]) and len(b[0]):
+        if len(a[0]) >= len(b[0]):
+            q = min(_divisions(a, b),
+                    key=lambda q: score(q, _trim(_add(a, _mul(q, b), -1))))
+            a = _trim(_add(a, _mul(q, b), -1))
+            c = _trim(_add(c, _mul(q, d), -1))
+            steps.append((1, q))
+        else:
+            q = min(_divisions(b, a),
+                    key=lambda q: score(q, _trim(_add(b, _mul(q, a), -1))))
+            b = _trim(_add(b, _mul(q, a), -1))
+            d = _trim(_add(d, _mul(q, c), -1))
+            steps.append((0, q))
+
+    # one element of the first row is now zero, the other a monomial
+    swap = int(len(a[0]) == 0)
+    if swap:
+        a, b, c, d = b, a, d, c
+    if len(a[0]) != 1 or len(d[0]) != 1:
+        return None
+    last = (c[0] / d[0][0], c[1] - d[1])
+    if len(last[0]):
+        steps.append((1 - swap, last))
+    return LiftingScheme(
+        steps=[(target, q[1], q[0]) for target, q in steps],
+        scales=(a[0][0], d[0][0]), shifts=(a[1], d[1]),
+        sources=(swap, 1 - swap), delay=None)
+
+
+def _score_quotient(q, r):
+    return _max_abs(q)
+
+
+def _score_remainder(q, r):
+    # avoid small leading and trailing coefficients in the remainder, which
+    # lead to large quotients later
+    if len(r[0]) == 0:
+        return _max_abs(q)
+    return _max_abs(q) / min(abs(r[0][0]), abs(r[0][-1]))
+
+
+def _lattice(dec_lo, dec_hi):
+    """Factorization of a paraunitary polyphase matrix into rotations"""
+    n = max(len(dec_lo), len(dec_hi))
+    n += n % 2
+    taps = np.zeros((n // 2, 2, 2))
+    for i, f in enumerate((dec_lo, dec_hi)):
+        taps[:len(f[1::2]), i, 0] = f[1::2]
+        taps[:len(f[0::2]), i, 1] = f[0::2]
+
+    # drop zero leading and trailing taps
+    norms = np.sqrt(np.sum(taps**2, axis=(1, 2)))
+    nonzero = np.flatnonzero(norms > _ZERO_TOL)
+    if len(nonzero) == 0:
+        return None
+    offset = nonzero[0]
+    taps = taps[nonzero[0]:nonzero[-1] + 1]
+
+    # det(R_0) must be 1, negate the detail channel otherwise
+    sign_d = 1.
+    if np.linalg.det(np.sum(taps, axis=0)) < 0:
+        taps[:, 1, :] *= -1
+        sign_d = -1.
+
+    # P(z) = R_{K-1} L(z) ... L(z) R_0, with L(z) = diag(1, z**-1)
+    rotations = []
+    while len(taps) > 1:
+        last = taps[-1]
+        u = last[:, np.argmax(np.sum(last**2, axis=0))]
+        u = u / np.sqrt(np.sum(u**2))
+        # first row of R^T * taps[-1] is zero
+        rotation = np.array([[-u[1], -u[0]], [u[0], -u[1]]])
+        rotated = np.einsum('ji,njk->nik', rotation, taps)
+        if (np.max(np.abs(rotated[-1, 0])) > _ZERO_TOL or
+                np.max(np.abs(rotated[0, 1])) > _ZERO_TOL):
+            # not paraunitary, or too badly conditioned
+            return None
+        taps = np.empty((len(taps) - 1, 2, 2))
+        taps[:, 0] = rotated[:-1, 0]
+        taps[:, 1] = rotated[1:, 1]
+        rotations.append(rotation)
+    rotations.append(taps[0])
+    if not np.allclose(np.dot(taps[0].T, taps[0]), np.eye(2),
+                       atol=_CHECK_TOL):
+        return None
+
+    # Each rotation [[c, -s], [s, c]] with c >= 0 is the lifting steps
+    # (even += a*odd, odd += s*even, even += a*odd) with a = -s/(1 + c).
+    # The odd channel is delayed by one after each rotation but the last,
+    # which is tracked as an offset instead of moving data.
+    sign = 1.
+    delay = 0
+    steps = []
+    for k, rotation in enumerate(rotations[::-1]):
+        c, s = rotation[0, 0], rotation[1, 0]
+        if c < 0:
+            c, s, sign = -c, -s, -sign
+        a = -s / (1 + c)
+        steps += [(0, delay, np.array([a])), (1, -delay, np.array([s])),
+                  (0, delay, np.array([a]))]
+        if k < len(rotations) - 1:
+            delay += 1
+    return LiftingScheme(steps=steps, scales=(sign, sign * sign_d),
+                         shifts=(offset, offset + delay), sources=(0, 1),
+                         delay=None)
+
+
+def _merge(steps):
+    """Combine consecutive steps updating the same channel"""
+    merged = []
+    for target, offset, coefs in steps:
+        if merged and merged[-1][0] == target:
+            q = _add((merged[-1][2], merged[-1][1]), (coefs, offset))
+            merged[-1] = (target, q[1], q[0])
+        else:
+            merged.append((target, offset, coefs))
+    return [(t, q[1], q[0]) for t, q in
+            ((t, _trim((c, o), 0)) for t, o, c in merged) if len(q[0])]
+
+
+###############################################################################
+# Verification
+
+def _analysis(scheme):
+    """Polyphase matrix of a lifting scheme"""
+    channels = [[(np.ones(1), 0), _ZERO], [_ZERO, (np.ones(1), 0)]]
+    for target, offset, coefs in scheme.steps:
+        source = channels[1 - target]
+        channels[target] = [_add(t, _mul((coefs, offset), s))
+                            for t, s in zip(channels[target], source)]
+    return [[(scale * p[0], p[1] + shift) for p in channels[source]]
+            for scale, shift, source in zip(scheme.scales, scheme.shifts,
+                                            scheme.sources)]
+
+
+def _distance(p, q):
+    return _max_abs(_add(p, q, -1))
+
+
+def _synthesis_delay(scheme, rec_lo, rec_hi):
+    """Delay of the synthesis filters relative to the lifting inverse.
+
+    Returns None if the filters are not the inverse of the scheme.
+    """
+    analysis = _analysis(scheme)
+    # full reconstruction: z[2*q + r] = sum(rec[2*j + r] * c[q - j])
+    synthesis = [[(rec_lo[0::2], 0), (rec_hi[0::2], 0)],
+                 [(rec_lo[1::2], 0), (rec_hi[1::2], 0)]]
+    product = [[_trim(_add(_mul(synthesis[i][0], analysis[0][j]),
+                           _mul(synthesis[i][1], analysis[1][j])))
+                for j in range(2)] for i in range(2)]
+
+    def monomial(p):
+        if len(p[0]) == 1 and abs(p[0][0] - 1) < _CHECK_TOL:
+            return p[1]
+        return None
+
+    if len(product[0][1][0]) == 0 and len(product[1][0][0]) == 0:
+        # z = y[n - 2*k]
+        k = monomial(product[0][0])
+        if k is not None and monomial(product[1][1]) == k:
+            return 2 * k
+    elif len(product[0][0][0]) == 0 and len(product[1][1][0]) == 0:
+        # z[2*q] = y[2*(q - k) - 1], z[2*q + 1] = y[2*(q - k)]
+        k = monomial(product[1][0])
+        if k is not None and monomial(product[0][1]) == k + 1:
+            return 2 * k + 1
+    return None
+
+
+def _factorize(dec_lo, dec_hi, rec_lo, rec_hi):
+    polyphase = _polyphase(dec_lo, dec_hi)
+    candidates = [_euclid(dec_lo, dec_hi, _score_quotient),
+                  _euclid(dec_lo, dec_hi, _score_remainder)]
+    candidates = [s for s in candidates if s is not None and
+                  max(_max_abs((c, 0)) for t, o, c in s.steps) <= _MAX_COEF]
+    # the lattice is only used if no Euclidean factorization is usable
+    candidates.sort(key=lambda s: sum(len(c) for t, o, c in s.steps))
+    candidates.append(_lattice(dec_lo, dec_hi))
+
+    for scheme in candidates:
+        if scheme is None:
+            continue
+        scheme = scheme._replace(steps=_merge(scheme.steps))
+        analysis = _analysis(scheme)
+        error = max(_distance(analysis[i][j], polyphase[i][j])
+                    for i in range(2) for j in range(2))
+        if error > _CHECK_TOL:
+            continue
+        delay = _synthesis_delay(scheme, rec_lo, rec_hi)
+        if delay is None:
+            continue
+        return scheme._replace(delay=delay), error
+    return None, None
+
+
+def lifting_scheme(filter_bank):
+    """
+    lifting_scheme(filter_bank)
+
+    Lifting factorization of a filter bank.
+
+    Parameters
+    ----------
+    filter_bank : sequence of 4 array_like
+        The filters (dec_lo, dec_hi, rec_lo, rec_hi), as in
+        `Wavelet.filter_bank`.
+
+    Returns
+    -------
+    scheme : LiftingScheme or None
+        None if the filter bank does not have perfect reconstruction, or
+        if no numerically stable factorization was found. Results are
+        cached.
+    """
+    return _factorization(filter_bank)[0]
+
+
+def _lifting_error(filter_bank):
+    """
+    Largest deviation of the filters of the lifting scheme of a filter bank
+    from the filters, or None if it has no lifting scheme.
+
+    The lifting scheme is only as accurate as the tabulated filters allow,
+    so it computes slightly different filters. The transforms by lifting
+    differ from the convolutions by about this deviation times 1 to 20
+    (relative).
+    """
+    return _factorization(filter_bank)[1]
+
+
+def _factorization(filter_bank):
+    # the lifting scheme and its deviation from the filters, cached (LRU)
+    filters = [np.asarray(f, dtype=np.float64) for f in filter_bank]
+    key = tuple(f.tobytes() for f in filters)
+    try:
+        result = _cache.pop(key)
+    except KeyError:
+        try:
+            result = _factorize(*filters)
+        except (ValueError, ZeroDivisionError, FloatingPointError,
+                np.linalg.LinAlgError):
+            result = None, None
+        if len(_cache) >= _CACHE_SIZE:
+            _cache.popitem(last=False)
+    _cache[key] = result
+    return result
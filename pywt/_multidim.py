@@ -15,12 +15,14 @@ from itertools import product
 
 import numpy as np
 
-from ._extensions._pywt import Wavelet, Modes
+from ._extensions._pywt import (Wavelet, Modes, _method_from_object,
+                                _workers_from_object, _check_out_overlap)
 from ._extensions._dwt import dwt_axis, idwt_axis
-from ._swt import swt
+from ._swt import swtn
 
 
-def dwt2(data, wavelet, mode='symmetric', axes=(-2, -1)):
+def dwt2(data, wavelet, mode='symmetric', axes=(-2, -1),
+         method='convolution', workers=None, out=None):
     """
     2D Discrete Wavelet Transform.
 
@@ -35,6 +37,13 @@ def dwt2(data, wavelet, mode='symmetric', axes=(-2, -1)):
     axes : 2-tuple of ints, optional
         Axes over which to compute the DWT. Repeated elements mean the DWT will
         be performed multiple times along these axes.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : tuple, optional
+        Arrays ``(cA, (cH, cV, cD))`` the coefficients are written to and
+        returned in, see `dwt`.
 
     Returns
     -------
@@ -65,11 +74,15 @@ def dwt2(data, wavelet, mode='symmetric', axes=(-2, -1)):
         raise ValueError("Input array has fewer dimensions than the specified "
                          "axes")
 
-    coefs = dwtn(data, wavelet, mode, axes)
+    if out is not None:
+        cA, (cH, cV, cD) = out
+        out = {'aa': cA, 'da': cH, 'ad': cV, 'dd': cD}
+    coefs = dwtn(data, wavelet, mode, axes, method, workers, out)
     return coefs['aa'], (coefs['da'], coefs['ad'], coefs['dd'])
 
 
-def idwt2(coeffs, wavelet, mode='symmetric', axes=(-2, -1)):
+def idwt2(coeffs, wavelet, mode='symmetric', axes=(-2, -1),
+          method='convolution', workers=None, out=None):
     """
     2-D Inverse Discrete Wavelet Transform.
 
@@ -87,6 +100,12 @@ def idwt2(coeffs, wavelet, mode='symmetric', axes=(-2, -1)):
     axes : 2-tuple of ints, optional
         Axes over which to compute the IDWT. Repeated elements mean the IDWT
         will be performed multiple times along these axes.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : ndarray, optional
+        Array the reconstruction is written to and returned in, see `dwt`.
 
     Examples
     --------
@@ -110,10 +129,11 @@ def idwt2(coeffs, wavelet, mode='symmetric', axes=(-2, -1)):
     # drop the keys corresponding to value = None
     coeffs = dict((k, v) for k, v in coeffs.items() if v is not None)
 
-    return idwtn(coeffs, wavelet, mode, axes)
+    return idwtn(coeffs, wavelet, mode, axes, method, workers, out)
 
 
-def dwtn(data, wavelet, mode='symmetric', axes=None):
+def dwtn(data, wavelet, mode='symmetric', axes=None, method='convolution',
+         workers=None, out=None):
     """
     Single-level n-dimensional Discrete Wavelet Transform.
 
@@ -134,6 +154,15 @@ def dwtn(data, wavelet, mode='symmetric', axes=None):
         lost if it is not divisible by `2 ** nrepeats`. The reconstruction will
         be larger, with additional values derived according to the `mode`
         parameter. `pywt.wavedecn` should be used for multilevel decomposition.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : dict, optional
+        Arrays the coefficients are written to and returned in, by key as in
+        the result, see `dwt`. Missing keys are allocated. The transforms of
+        all axes but the last still return their results in temporary
+        arrays.
 
     Returns
     -------
@@ -152,16 +181,12 @@ def dwtn(data, wavelet, mode='symmetric', axes=None):
 
     """
     data = np.asarray(data)
-    if np.iscomplexobj(data):
-        keys = (''.join(k) for k in product('ad', repeat=data.ndim))
-        real = dwtn(data.real, wavelet, mode)
-        imag = dwtn(data.imag, wavelet, mode)
-        return dict((k, real[k] + 1j * imag[k]) for k in keys)
-
     if data.dtype == np.dtype('object'):
         raise TypeError("Input must be a numeric array-like")
     if data.ndim < 1:
         raise ValueError("Input data must be at least 1D")
+    if out is not None:
+        _check_out_overlap(out, data)
 
     if axes is None:
         axes = range(data.ndim)
@@ -170,12 +195,19 @@ def dwtn(data, wavelet, mode='symmetric', axes=None):
     mode = Modes.from_object(mode)
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
+    method = _method_from_object(wavelet, method)
+    workers = _workers_from_object(workers)
 
+    axes = list(axes)
     coeffs = [('', data)]
-    for axis in axes:
+    for i, axis in enumerate(axes):
         new_coeffs = []
         for subband, x in coeffs:
-            cA, cD = dwt_axis(x, wavelet, mode, axis)
+            if out is not None and i == len(axes) - 1:
+                pair = (out.get(subband + 'a'), out.get(subband + 'd'))
+            else:
+                pair = None
+            cA, cD = dwt_axis(x, wavelet, mode, axis, method, workers, pair)
             new_coeffs.extend([(subband + 'a', cA),
                                (subband + 'd', cD)])
         coeffs = new_coeffs
@@ -205,7 +237,8 @@ def _fix_coeffs(coeffs):
     return dict((k, np.asarray(v)) for k, v in coeffs.items())
 
 
-def idwtn(coeffs, wavelet, mode='symmetric', axes=None):
+def idwtn(coeffs, wavelet, mode='symmetric', axes=None,
+          method='convolution', workers=None, out=None):
     """
     Single-level n-dimensional Inverse Discrete Wavelet Transform.
 
@@ -226,6 +259,14 @@ def idwtn(coeffs, wavelet, mode='symmetric', axes=None):
 
         For the most accurate reconstruction, the axes should be provided in
         the same order as they were provided to `dwtn`.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : ndarray, optional
+        Array the reconstruction is written to and returned in, see `dwt`.
+        As for `dwtn`, the transforms of all axes but the last (the first
+        of `axes`) still return their results in temporary arrays.
 
     Returns
     -------
@@ -236,16 +277,12 @@ def idwtn(coeffs, wavelet, mode='symmetric', axes=None):
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
     mode = Modes.from_object(mode)
+    method = _method_from_object(wavelet, method, inverse=True)
+    workers = _workers_from_object(workers)
 
     # Raise error for invalid key combinations
     coeffs = _fix_coeffs(coeffs)
 
-    if any(np.iscomplexobj(v) for v in coeffs.values()):
-        real_coeffs = dict((k, v.real) for k, v in coeffs.items())
-        imag_coeffs = dict((k, v.imag) for k, v in coeffs.items())
-        return (idwtn(real_coeffs, wavelet, mode)
-                + 1j * idwtn(imag_coeffs, wavelet, mode))
-
     ndim = max(len(key) for key in coeffs.keys())
 
     try:
@@ -257,6 +294,8 @@ def idwtn(coeffs, wavelet, mode='symmetric', axes=None):
                          "band")
     if any(s != coeff_shape for s in coeff_shapes):
         raise ValueError("`coeffs` must all be of equal size (or None)")
+    if out is not None:
+        _check_out_overlap(out, coeffs)
 
     if axes is None:
         axes = range(ndim)
@@ -270,7 +309,9 @@ def idwtn(coeffs, wavelet, mode='symmetric', axes=None):
             L = coeffs.get(key + 'a', None)
             H = coeffs.get(key + 'd', None)
 
-            new_coeffs[key] = idwt_axis(L, H, wavelet, mode, axis)
+            new_coeffs[key] = idwt_axis(L, H, wavelet, mode, axis, method,
+                                        workers, out if key_length == 0
+                                        else None)
         coeffs = new_coeffs
 
     return coeffs['']
@@ -317,40 +358,6 @@ def swt2(data, wavelet, level, start_level=0):
     if data.ndim != 2:
         raise ValueError("Expected 2D data array")
 
-    if not isinstance(wavelet, Wavelet):
-        wavelet = Wavelet(wavelet)
-
-    ret = []
-    for i in range(start_level, start_level + level):
-        # filter rows
-        H, L = [], []
-        for row in data:
-            cA, cD = swt(row, wavelet, level=1, start_level=i)[0]
-            L.append(cA)
-            H.append(cD)
-
-        # filter columns
-        H = np.transpose(H)
-        L = np.transpose(L)
-
-        LL, LH = [], []
-        for row in L:
-            cA, cD = swt(row, wavelet, level=1, start_level=i)[0]
-            LL.append(cA)
-            LH.append(cD)
-
-        HL, HH = [], []
-        for row in H:
-            cA, cD = swt(row, wavelet, level=1, start_level=i)[0]
-            HL.append(cA)
-            HH.append(cD)
-
-        # build result structure: (approx, (horizontal, vertical, diagonal))
-        approx = np.transpose(LL)
-        ret.append((approx,
-                    (np.transpose(LH), np.transpose(HL), np.transpose(HH))))
-
-        # for next iteration
-        data = approx
-
-    return ret
+    # (approx, (horizontal, vertical, diagonal)) from the first level
+    coeffs = swtn(data, wavelet, level, start_level, axes=(0, 1))
+    return [(c['aa'], (c['da'], c['ad'], c['dd'])) for c in reversed(coeffs)]
@@ -11,15 +11,34 @@ and Inverse Discrete Wavelet Transform.
 from __future__ import division, print_function, absolute_import
 
 from copy import copy
+from itertools import product
 import numpy as np
 
-from ._extensions._pywt import Wavelet
-from ._extensions._dwt import dwt_max_level
+from ._extensions._pywt import (Wavelet, Modes, _check_dtype,
+                                _method_from_object, _method_names,
+                                _workers_from_object, _check_out_overlap)
+from ._extensions._dwt import (dwt_max_level, wavedec as _wavedec,
+                               waverec as _waverec, wavedecn as _wavedecn,
+                               waverecn as _waverecn,
+                               wavedecn_peak_memory as _wavedecn_peak_memory,
+                               cast_dtypes as _cast_dtypes,
+                               dwtn_inplace as _dwtn_inplace,
+                               int_lifting as _int_lifting,
+                               int_liftings as _int_liftings)
+from ._extensions._swt import (iswt as _iswt, iswt_axis, swt_max_level,
+                               imodwt as _imodwt)
 from ._dwt import dwt, idwt
 from ._multidim import dwt2, idwt2, dwtn, idwtn, _fix_coeffs
 
 __all__ = ['wavedec', 'waverec', 'wavedec2', 'waverec2', 'wavedecn',
-           'waverecn', 'iswt', 'iswt2', 'coeffs_to_array', 'array_to_coeffs']
+           'waverecn', 'wavedecn_peak_memory', 'int_wavedecn', 'int_waverecn',
+           'iswt', 'iswt2', 'iswtn', 'imodwt', 'coeffs_to_array',
+           'array_to_coeffs']
+
+# wavedecn and waverecn transform all levels in a single call for this method
+_CONVOLUTION = _method_names.index('convolution')
+# and real data, complex data is transformed a level at a time
+_real_dtypes = (np.dtype('float32'), np.dtype('float64'))
 
 
 def _check_level(size, dec_len, level):
@@ -40,7 +59,8 @@ def _check_level(size, dec_len, level):
     return level
 
 
-def wavedec(data, wavelet, mode='symmetric', level=None):
+def wavedec(data, wavelet, mode='symmetric', level=None,
+            method='convolution', workers=None, inplace=False, out=None):
     """
     Multilevel 1D Discrete Wavelet Transform of data.
 
@@ -55,6 +75,16 @@ def wavedec(data, wavelet, mode='symmetric', level=None):
     level : int, optional
         Decomposition level (must be >= 0). If level is None (default) then it
         will be calculated using the ``dwt_max_level`` function.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    inplace : bool, optional
+        If True, `data` (a float32 or float64 array) is overwritten by the
+        coefficients along its last axis, see `wavedecn`.
+    out : list of ndarray, optional
+        C-contiguous arrays the coefficients are written to and returned in,
+        in the order of the result, see `dwt`.
 
     Returns
     -------
@@ -63,6 +93,7 @@ def wavedec(data, wavelet, mode='symmetric', level=None):
         where `n` denotes the level of decomposition. The first element
         (`cA_n`) of the result is approximation coefficients array and the
         following elements (`cD_n` - `cD_1`) are details coefficients arrays.
+        With `inplace`, these are views of `data`.
 
     Examples
     --------
@@ -77,27 +108,33 @@ def wavedec(data, wavelet, mode='symmetric', level=None):
     array([  5.,  13.])
 
     """
-    data = np.asarray(data)
-
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
 
-    level = _check_level(min(data.shape), wavelet.dec_len, level)
-
-    coeffs_list = []
-
-    a = data
-    for i in range(level):
-        a, d = dwt(a, wavelet, mode)
-        coeffs_list.append(d)
+    if inplace:
+        _check_inplace_out(out)
+        axis = np.ndim(data) - 1
+        coeffs = _wavedec_inplace(data, wavelet, mode, level, [axis], method,
+                                  workers)
+        return [coeffs[0]] + [d['d'] for d in coeffs[1:]]
 
-    coeffs_list.append(a)
-    coeffs_list.reverse()
+    data = np.asarray(data)
+    level = _check_level(min(data.shape), wavelet.dec_len, level)
+    if level == 0:
+        return [_copy_out(data, out[0] if out is not None else None)]
+    if out is not None:
+        _check_out_overlap(out, data)
 
-    return coeffs_list
+    # all levels in a single call, along the last axis
+    if data.dtype not in _cast_dtypes:
+        data = np.asarray(data, dtype=_check_dtype(data))
+    return _wavedec(data, wavelet, Modes.from_object(mode), level,
+                    _method_from_object(wavelet, method),
+                    _workers_from_object(workers), out)
 
 
-def waverec(coeffs, wavelet, mode='symmetric'):
+def waverec(coeffs, wavelet, mode='symmetric', method='convolution',
+            workers=None, inplace=False, out=None):
     """
     Multilevel 1D Inverse Discrete Wavelet Transform.
 
@@ -109,6 +146,19 @@ def waverec(coeffs, wavelet, mode='symmetric'):
         Wavelet to use
     mode : str, optional
         Signal extension mode, see Modes (default: 'symmetric')
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    inplace : bool, optional
+        If True, `coeffs` must be the views returned by `wavedec` with
+        ``inplace=True``, and their array is overwritten by the
+        reconstruction, which is returned.
+    out : ndarray, optional
+        Array the reconstruction is written to and returned in, see `dwt`.
+        It must be C-contiguous if all levels are reconstructed in a single
+        call (as for arrays of the same dtype and shape but for the last
+        axis).
 
     Examples
     --------
@@ -126,19 +176,44 @@ def waverec(coeffs, wavelet, mode='symmetric'):
             "Coefficient list too short (minimum 1 arrays required).")
     elif len(coeffs) == 1:
         # level 0 transform (just returns the approximation coefficients)
-        return coeffs[0]
+        return _copy_out(coeffs[0], out)
 
-    a, ds = coeffs[0], coeffs[1:]
+    if inplace:
+        _check_inplace_out(out)
+        axis = np.ndim(coeffs[0]) - 1
+        return _waverec_inplace([coeffs[0]] + [{'d': d} for d in coeffs[1:]],
+                                wavelet, mode, [axis], method, workers)
 
-    for d in ds:
+    a, ds = coeffs[0], coeffs[1:]
+    if out is not None:
+        _check_out_overlap(out, coeffs)
+
+    if a is not None and all(d is not None for d in ds):
+        coeffs = [np.asarray(c) for c in coeffs]
+        dtypes = set(_check_dtype(c) for c in coeffs)
+        if (len(dtypes) == 1 and
+                all(c.ndim > 0 and c.shape[:-1] == coeffs[0].shape[:-1]
+                    for c in coeffs)):
+            # all levels in a single call, along the last axis
+            if not isinstance(wavelet, Wavelet):
+                wavelet = Wavelet(wavelet)
+            dt = dtypes.pop()
+            return _waverec([c.astype(dt, copy=False) for c in coeffs],
+                            wavelet, Modes.from_object(mode),
+                            _method_from_object(wavelet, method, inverse=True),
+                            _workers_from_object(workers), out)
+
+    for i, d in enumerate(ds):
         if (a is not None) and (d is not None) and (len(a) == len(d) + 1):
             a = a[:-1]
-        a = idwt(a, d, wavelet, mode)
+        a = idwt(a, d, wavelet, mode, method=method, workers=workers,
+                 out=out if i == len(ds) - 1 else None)
 
     return a
 
 
-def wavedec2(data, wavelet, mode='symmetric', level=None):
+def wavedec2(data, wavelet, mode='symmetric', level=None,
+             method='convolution', workers=None, out=None):
     """
     Multilevel 2D Discrete Wavelet Transform.
 
@@ -153,6 +228,13 @@ def wavedec2(data, wavelet, mode='symmetric', level=None):
     level : int, optional
         Decomposition level (must be >= 0). If level is None (default) then it
         will be calculated using the ``dwt_max_level`` function.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : list, optional
+        Arrays the coefficients are written to and returned in, in the
+        format of the result, see `dwt2`.
 
     Returns
     -------
@@ -182,12 +264,21 @@ def wavedec2(data, wavelet, mode='symmetric', level=None):
         wavelet = Wavelet(wavelet)
 
     level = _check_level(min(data.shape), wavelet.dec_len, level)
+    if level == 0:
+        return [_copy_out(data, out[0] if out is not None else None)]
+    if out is not None:
+        _check_out_overlap(out, data)
 
     coeffs_list = []
 
     a = data
     for i in range(level):
-        a, ds = dwt2(a, wavelet, mode)
+        if out is not None:
+            level_out = (out[0] if i == level - 1 else None, out[level - i])
+        else:
+            level_out = None
+        a, ds = dwt2(a, wavelet, mode, method=method, workers=workers,
+                     out=level_out)
         coeffs_list.append(ds)
 
     coeffs_list.append(a)
@@ -196,7 +287,8 @@ def wavedec2(data, wavelet, mode='symmetric', level=None):
     return coeffs_list
 
 
-def waverec2(coeffs, wavelet, mode='symmetric'):
+def waverec2(coeffs, wavelet, mode='symmetric', method='convolution',
+             workers=None, out=None):
     """
     Multilevel 2D Inverse Discrete Wavelet Transform.
 
@@ -206,6 +298,12 @@ def waverec2(coeffs, wavelet, mode='symmetric'):
         Wavelet to use
     mode : str, optional
         Signal extension mode, see Modes (default: 'symmetric')
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : ndarray, optional
+        Array the reconstruction is written to and returned in, see `dwt`.
 
     Returns
     -------
@@ -234,12 +332,14 @@ def waverec2(coeffs, wavelet, mode='symmetric'):
             "Coefficient list too short (minimum 1 array required).")
     elif len(coeffs) == 1:
         # level 0 transform (just returns the approximation coefficients)
-        return coeffs[0]
+        return _copy_out(coeffs[0], out)
 
     a, ds = coeffs[0], coeffs[1:]
     a = np.asarray(a)
+    if out is not None:
+        _check_out_overlap(out, coeffs)
 
-    for d in ds:
+    for i, d in enumerate(ds):
         d = tuple(np.asarray(coeff) if coeff is not None else None
                   for coeff in d)
         d_shapes = (coeff.shape for coeff in d if coeff is not None)
@@ -252,7 +352,8 @@ def waverec2(coeffs, wavelet, mode='symmetric'):
                 raise ValueError("All detail shapes must be the same length.")
             idxs = tuple(slice(None, -1 if a_len == d_len + 1 else None)
                          for a_len, d_len in zip(a.shape, d_shape))
-        a = idwt2((a[idxs], d), wavelet, mode)
+        a = idwt2((a[idxs], d), wavelet, mode, method=method,
+                  workers=workers, out=out if i == len(ds) - 1 else None)
 
     return a
 
@@ -284,40 +385,20 @@ def iswt(coeffs, wavelet):
     array([ 1.,  2.,  3.,  4.,  5.,  6.,  7.,  8.])
     """
 
-    output = coeffs[0][0].copy()  # Avoid modification of input data
+    if any(np.iscomplexobj(c) for cA_cD in coeffs for c in cA_cD):
+        coeffs_real = [(np.real(cA), np.real(cD)) for cA, cD in coeffs]
+        coeffs_imag = [(np.imag(cA), np.imag(cD)) for cA, cD in coeffs]
+        return iswt(coeffs_real, wavelet) + 1j * iswt(coeffs_imag, wavelet)
 
-    # num_levels, equivalent to the decomposition level, n
-    num_levels = len(coeffs)
+    # the reconstruction starts from the approximation at the top level
+    dt = _check_dtype(coeffs[0][0])
+    cA = np.ascontiguousarray(coeffs[0][0], dtype=dt)
+    details = [np.ascontiguousarray(cD, dtype=dt) for _, cD in coeffs]
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
-    for j in range(num_levels, 0, -1):
-        step_size = int(pow(2, j-1))
-        last_index = step_size
-        _, cD = coeffs[num_levels - j]
-        for first in range(last_index):  # 0 to last_index - 1
-
-            # Getting the indices that we will transform
-            indices = np.arange(first, len(cD), step_size)
-
-            # select the even indices
-            even_indices = indices[0::2]
-            # select the odd indices
-            odd_indices = indices[1::2]
-
-            # perform the inverse dwt on the selected indices,
-            # making sure to use periodic boundary conditions
-            x1 = idwt(output[even_indices], cD[even_indices],
-                      wavelet, 'periodization')
-            x2 = idwt(output[odd_indices], cD[odd_indices],
-                      wavelet, 'periodization')
-
-            # perform a circular shift right
-            x2 = np.roll(x2, 1)
-
-            # average and insert into the correct indices
-            output[indices] = (x1 + x2)/2.
-
-    return output
+    # each level convolves with the reconstruction filters upsampled by
+    # 2**(j-1), averaging the reconstructions from the even and odd samples
+    return _iswt(cA, details, wavelet)
 
 
 def iswt2(coeffs, wavelet):
@@ -366,66 +447,157 @@ def iswt2(coeffs, wavelet):
 
     """
 
-    output = coeffs[-1][0].copy()  # Avoid modification of input data
+    # the level at a time ISWT along both axes, see iswtn
+    coeffs_nd = []
+    for cA, (cH, cV, cD) in reversed(coeffs):
+        coeffs_nd.append({'aa': cA, 'da': cH, 'ad': cV, 'dd': cD})
+    return iswtn(coeffs_nd, wavelet, axes=(0, 1))
+
+
+def iswtn(coeffs, wavelet, axes=None, workers=None):
+    """
+    Multilevel nD Inverse Discrete Stationary Wavelet Transform.
+
+    Parameters
+    ----------
+    coeffs : list
+        A list of dicts of coefficients as returned by `swtn` (with
+        ``start_level=0``)::
+
+            [{coeffs_level_n}, ..., {coeffs_level_1}]
+
+        Only the approximation of the first (coarsest) level is used.
+    wavelet : Wavelet object or name string
+        Wavelet to use
+    axes : sequence of ints, optional
+        Axes over which to compute the inverse SWT, as for `swtn`. A value
+        of `None` (the default) selects all axes.
+    workers : int, optional
+        Number of threads, see `dwt`.
+
+    Returns
+    -------
+    nD array of reconstructed data.
+
+    Examples
+    --------
+    >>> import numpy as np
+    >>> import pywt
+    >>> x = np.arange(16.).reshape(4, 4)
+    >>> np.allclose(pywt.iswtn(pywt.swtn(x, 'db2', level=2), 'db2'), x)
+    True
+    """
+    if len(coeffs) < 1:
+        raise ValueError("Coefficient list must not be empty.")
+    coeffs = [_fix_coeffs(c) for c in coeffs]
+    keys = set(coeffs[0])
+    ndim_transform = len(next(iter(keys)))
+    approx = coeffs[0].get('a' * ndim_transform)
+    if approx is None:
+        raise ValueError("The coefficients of the first level must include "
+                         "the approximation.")
+    keys.discard('a' * ndim_transform)
+    arrays = [approx] + [c[k] for c in coeffs for k in keys if k in c]
+    if any(set(c) - set(['a' * ndim_transform]) != keys for c in coeffs[1:]):
+        raise ValueError("All levels must have the same detail "
+                         "coefficients.")
+    if any(a.shape != approx.shape for a in arrays):
+        raise ValueError("All coefficients must have the same shape.")
+    if len(keys) != 2 ** ndim_transform - 1:
+        raise ValueError("The detail coefficients of all subbands are "
+                         "required.")
+
+    if axes is None:
+        axes = range(approx.ndim)
+    axes = [a + approx.ndim if a < 0 else a for a in axes]
+    if len(axes) != ndim_transform:
+        raise ValueError("The number of axes used in iswtn must match the "
+                         "number of dimensions transformed in swtn.")
+    if not isinstance(wavelet, Wavelet):
+        wavelet = Wavelet(wavelet)
+    workers = _workers_from_object(workers)
+    dt = np.result_type(*[_check_dtype(a) for a in arrays])
+
+    # the levels alternate between two arrays, the last writing to output
+    level = len(coeffs)
+    output = np.empty(approx.shape, dt)
+    buffers = [output, np.empty(approx.shape, dt) if level > 1 else None]
+    a = approx
+    for j in range(level, 0, -1):
+        details = coeffs[level - j]
+        subbands = dict((k, details[k]) for k in keys)
+        subbands['a' * ndim_transform] = a
+        # as idwtn, the last axis first
+        for i, axis in reversed(list(enumerate(axes))):
+            pairs = sorted(set(k[:i] for k in subbands))
+            if i == 0:
+                rec = buffers[(level - j) % 2 != (level - 1) % 2]
+            else:
+                rec = None
+            subbands = dict((k, iswt_axis(np.asarray(subbands[k + 'a'], dt),
+                                          np.asarray(subbands[k + 'd'], dt),
+                                          wavelet, j, axis, workers, rec))
+                            for k in pairs)
+        a = subbands['']
+    return output
+
+
+
+def imodwt(coeffs, wavelet, axis=-1, workers=None):
+    """
+    Multilevel Inverse Maximal Overlap Discrete Wavelet Transform along an
+    axis.
+
+    Parameters
+    ----------
+    coeffs : list
+        Coefficients list of pairs as returned by `modwt`::
 
-    # num_levels, equivalent to the decomposition level, n
-    num_levels = len(coeffs)
+            [(cAn, cDn), ..., (cA2, cD2), (cA1, cD1)]
+
+        Only the approximation of the first (coarsest) level is used.
+    wavelet : Wavelet object or name string
+        Wavelet to use
+    axis : int, optional
+        Axis over which to compute the inverse MODWT (default: the last
+        one).
+    workers : int, optional
+        Number of threads, see `dwt`.
+
+    Returns
+    -------
+    Array of reconstructed data, of the shape of the coefficients.
+
+    Examples
+    --------
+    >>> import pywt
+    >>> coeffs = pywt.modwt([1, 2, 3, 4, 5, 6, 7], 'db2', level=2)
+    >>> pywt.imodwt(coeffs, 'db2')
+    array([ 1.,  2.,  3.,  4.,  5.,  6.,  7.])
+    """
+    if len(coeffs) < 1:
+        raise ValueError("Coefficient list must not be empty.")
+    arrays = [np.asarray(coeffs[0][0])] + [np.asarray(cD) for _, cD in coeffs]
+    cA = arrays[0]
+    if cA.ndim < 1:
+        raise ValueError("Coefficients must be at least 1D")
+    if axis < 0:
+        axis = axis + cA.ndim
+    if not 0 <= axis < cA.ndim:
+        raise ValueError("Axis greater than coefficient dimensions")
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
-    for j in range(num_levels, 0, -1):
-        step_size = int(pow(2, j-1))
-        last_index = step_size
-        _, (cH, cV, cD) = coeffs[j-1]
-        # We are going to assume cH, cV, and cD are square and of equal size
-        if (cH.shape != cV.shape) or (cH.shape != cD.shape) or (
-                cH.shape[0] != cH.shape[1]):
-            raise RuntimeError(
-                "Mismatch in shape of intermediate coefficient arrays")
-        for first_h in range(last_index):  # 0 to last_index - 1
-            for first_w in range(last_index):  # 0 to last_index - 1
-                # Getting the indices that we will transform
-                indices_h = slice(first_h, cH.shape[0], step_size)
-                indices_w = slice(first_w, cH.shape[1], step_size)
-
-                even_idx_h = slice(first_h, cH.shape[0], 2*step_size)
-                even_idx_w = slice(first_w, cH.shape[1], 2*step_size)
-                odd_idx_h = slice(first_h + step_size, cH.shape[0], 2*step_size)
-                odd_idx_w = slice(first_w + step_size, cH.shape[1], 2*step_size)
-
-                # perform the inverse dwt on the selected indices,
-                # making sure to use periodic boundary conditions
-                x1 = idwt2((output[even_idx_h, even_idx_w],
-                           (cH[even_idx_h, even_idx_w],
-                            cV[even_idx_h, even_idx_w],
-                            cD[even_idx_h, even_idx_w])),
-                           wavelet, 'periodization')
-                x2 = idwt2((output[even_idx_h, odd_idx_w],
-                           (cH[even_idx_h, odd_idx_w],
-                            cV[even_idx_h, odd_idx_w],
-                            cD[even_idx_h, odd_idx_w])),
-                           wavelet, 'periodization')
-                x3 = idwt2((output[odd_idx_h, even_idx_w],
-                           (cH[odd_idx_h, even_idx_w],
-                            cV[odd_idx_h, even_idx_w],
-                            cD[odd_idx_h, even_idx_w])),
-                           wavelet, 'periodization')
-                x4 = idwt2((output[odd_idx_h, odd_idx_w],
-                           (cH[odd_idx_h, odd_idx_w],
-                            cV[odd_idx_h, odd_idx_w],
-                            cD[odd_idx_h, odd_idx_w])),
-                           wavelet, 'periodization')
-
-                # perform a circular shifts
-                x2 = np.roll(x2, 1, axis=1)
-                x3 = np.roll(x3, 1, axis=0)
-                x4 = np.roll(x4, 1, axis=0)
-                x4 = np.roll(x4, 1, axis=1)
-                output[indices_h, indices_w] = (x1 + x2 + x3 + x4) / 4
+    dt = np.result_type(*[_check_dtype(a) for a in arrays])
 
-    return output
+    # all levels in a single call, alternating between the output and one
+    # temporary array
+    return _imodwt(cA.astype(dt, copy=False),
+                   [cD.astype(dt, copy=False) for cD in arrays[1:]],
+                   wavelet, axis, _workers_from_object(workers))
 
 
-def wavedecn(data, wavelet, mode='symmetric', level=None):
+def wavedecn(data, wavelet, mode='symmetric', level=None,
+             method='convolution', workers=None, inplace=False, out=None):
     """
     Multilevel nD Discrete Wavelet Transform.
 
@@ -440,11 +612,31 @@ def wavedecn(data, wavelet, mode='symmetric', level=None):
     level : int, optional
         Dxecomposition level (must be >= 0). If level is None (default) then it
         will be calculated using the ``dwt_max_level`` function.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    inplace : bool, optional
+        If True, `data` (a float32 or float64 array) is overwritten by the
+        coefficients, without allocating any other array. This requires the
+        ``'periodization'`` mode, with which the coefficients of each level
+        take the space of its input, and lengths divisible by ``2**level``.
+        The default level is then the largest that keeps the lengths even,
+        and odd lengths raise ValueError.
+    out : list, optional
+        Arrays the coefficients are written to and returned in, in the
+        format of the result, see `dwt`. Missing keys are allocated. They
+        must be C-contiguous for real data and the convolutions, which
+        transform all levels in a single call.
 
     Returns
     -------
     [cAn, {details_level_n}, ... {details_level_1}] : list
-        Coefficients list
+        Coefficients list. With `inplace`, the arrays are views of `data`
+        in a packed layout, that of `coeffs_to_array`: at each level, the
+        lines along every axis of the approximation of the previous level
+        are replaced by their approximation followed by their detail
+        coefficients.
 
     Examples
     --------
@@ -473,20 +665,44 @@ def wavedecn(data, wavelet, mode='symmetric', level=None):
             [ 1.,  1.,  1.,  1.]]])
 
     """
+    if not isinstance(wavelet, Wavelet):
+        wavelet = Wavelet(wavelet)
+
+    if inplace:
+        _check_inplace_out(out)
+        return _wavedec_inplace(data, wavelet, mode, level, None, method,
+                                workers)
+
     data = np.asarray(data)
 
     if len(data.shape) < 1:
         raise ValueError("Expected at least 1D input data.")
 
-    if not isinstance(wavelet, Wavelet):
-        wavelet = Wavelet(wavelet)
-
     level = _check_level(min(data.shape), wavelet.dec_len, level)
+    if level == 0:
+        return [_copy_out(data, out[0] if out is not None else None)]
+    if out is not None:
+        _check_out_overlap(out, data)
+
+    if (data.dtype != np.dtype('object') and not np.iscomplexobj(data) and
+            _method_from_object(wavelet, method) == _CONVOLUTION):
+        # all levels in a single call, see wavedecn_peak_memory
+        if data.dtype not in _cast_dtypes:
+            data = np.asarray(data, dtype=_check_dtype(data))
+        return _wavedecn(data, wavelet, Modes.from_object(mode), level,
+                         _workers_from_object(workers), out)
+
     coeffs_list = []
 
     a = data
     for i in range(level):
-        coeffs = dwtn(a, wavelet, mode)
+        if out is not None:
+            level_out = dict(out[level - i])
+            level_out['a' * data.ndim] = out[0] if i == level - 1 else None
+        else:
+            level_out = None
+        coeffs = dwtn(a, wavelet, mode, method=method, workers=workers,
+                      out=level_out)
         a = coeffs.pop('a' * data.ndim)
         coeffs_list.append(coeffs)
 
@@ -508,10 +724,11 @@ def _match_coeff_dims(a_coeff, d_coeff_dict):
     size_diffs = np.subtract(a_coeff.shape, d_coeff.shape)
     if np.any((size_diffs < 0) | (size_diffs > 1)):
         raise ValueError("incompatible coefficient array sizes")
-    return a_coeff[[slice(s) for s in d_coeff.shape]]
+    return a_coeff[tuple(slice(s) for s in d_coeff.shape)]
 
 
-def waverecn(coeffs, wavelet, mode='symmetric'):
+def waverecn(coeffs, wavelet, mode='symmetric', method='convolution',
+             workers=None, inplace=False, out=None):
     """
     Multilevel nD Inverse Discrete Wavelet Transform.
 
@@ -521,6 +738,18 @@ def waverecn(coeffs, wavelet, mode='symmetric'):
         Wavelet to use
     mode : str, optional
         Signal extension mode, see Modes (default: 'symmetric')
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    inplace : bool, optional
+        If True, `coeffs` must be the views returned by `wavedecn` with
+        ``inplace=True``, and their array is overwritten by the
+        reconstruction.
+    out : ndarray, optional
+        Array the reconstruction is written to and returned in, see `dwt`.
+        It must be C-contiguous for real data and the convolutions, as for
+        `wavedecn`.
 
     Returns
     -------
@@ -564,7 +793,12 @@ def waverecn(coeffs, wavelet, mode='symmetric'):
 
     if not ds:
         # level 0 transform (just returns the approximation coefficients)
-        return coeffs[0]
+        return _copy_out(coeffs[0], out)
+    if inplace:
+        _check_inplace_out(out)
+        return _waverec_inplace(coeffs, wavelet, mode, None, method, workers)
+    if out is not None:
+        _check_out_overlap(out, coeffs)
     if a is None and not any(ds):
         raise ValueError("At least one coefficient must contain a valid value.")
 
@@ -583,6 +817,24 @@ def waverecn(coeffs, wavelet, mode='symmetric'):
         raise ValueError(
             "All coefficients must have a matching number of dimensions")
 
+    if not isinstance(wavelet, Wavelet):
+        wavelet = Wavelet(wavelet)
+    arrays = [c for d in ds for c in d.values()]
+    if a is not None:
+        arrays.append(a)
+    dtypes = set(_check_dtype(c) for c in arrays)
+    if (all(ds) and len(dtypes) == 1 and dtypes.issubset(_real_dtypes) and
+            wavelet.rec_len % 2 == 0 and
+            _method_from_object(wavelet, method, inverse=True) == _CONVOLUTION):
+        # all levels in a single call, see wavedecn_peak_memory
+        dt = _check_dtype(arrays[0])
+        return _waverecn(
+            [a.astype(dt, copy=False) if a is not None else None] +
+            [dict((k, v.astype(dt, copy=False)) for k, v in d.items())
+             for d in ds],
+            wavelet, Modes.from_object(mode), _workers_from_object(workers),
+            out)
+
     for idx, d in enumerate(ds):
         if a is None and not d:
             continue
@@ -592,11 +844,374 @@ def waverecn(coeffs, wavelet, mode='symmetric'):
         if idx > 0:
             a = _match_coeff_dims(a, d)
         d['a' * ndim] = a
-        a = idwtn(d, wavelet, mode)
+        a = idwtn(d, wavelet, mode, method=method, workers=workers,
+                  out=out if idx == len(ds) - 1 else None)
 
     return a
 
 
+def wavedecn_peak_memory(shape, wavelet, mode='symmetric', level=None,
+                         dtype=np.float64, inverse=False, workers=None):
+    """
+    Peak memory allocated by `wavedecn` or `waverecn`.
+
+    With the convolution method, `wavedecn` and `waverecn` transform all
+    levels in a single call. Each level is computed a slab (a subarray with
+    a fixed index along the first axis) at a time and written directly to
+    the output arrays, so the only other memory allocated is a few slabs per
+    thread and the approximations between levels.
+
+    Parameters
+    ----------
+    shape : tuple of ints
+        Shape of the data.
+    wavelet : Wavelet object or name string
+        Wavelet to use
+    mode : str, optional
+        Signal extension mode, see Modes (default: 'symmetric')
+    level : int, optional
+        Decomposition level, see `wavedecn`.
+    dtype : dtype, optional
+        Data type of the data (default: float64). Complex data is transformed
+        as its real and imaginary parts, one after the other.
+    inverse : bool, optional
+        If True, the memory allocated by `waverecn` to reconstruct the data
+        from the coefficients of `wavedecn`.
+    workers : int, optional
+        Number of threads, see `dwt`. Each thread has its own buffers.
+
+    Returns
+    -------
+    nbytes : int
+        Bytes of the arrays returned by `wavedecn` for data of `shape` and
+        `dtype` (or `waverecn` of these, if `inverse`) plus the workspace of
+        the transform. C-contiguous input arrays are not copied.
+
+    Examples
+    --------
+    >>> import pywt
+    >>> shape = (256, 256, 256)
+    >>> nbytes = pywt.wavedecn_peak_memory(shape, 'db2', level=3)
+    >>> round(nbytes / (8 * 256**3), 2)
+    1.19
+    """
+    shape = tuple(shape)
+    if len(shape) < 1:
+        raise ValueError("Expected at least 1D data.")
+    if not isinstance(wavelet, Wavelet):
+        wavelet = Wavelet(wavelet)
+    mode = Modes.from_object(mode)
+    level = _check_level(min(shape), wavelet.dec_len, level)
+    itemsize = _check_dtype(np.empty(0, dtype)).itemsize
+    if level == 0:
+        return 0
+    return _wavedecn_peak_memory(shape, wavelet, mode, level, itemsize,
+                                 inverse, _workers_from_object(workers))
+
+
+def _copy_out(a, out):
+    """
+    The result a of a level 0 transform, copied into out if not None.
+    """
+    if out is None:
+        return a
+    out[...] = a
+    return out
+
+
+def _check_inplace_out(out):
+    if out is not None:
+        raise ValueError("out cannot be combined with inplace, the "
+                         "coefficients are written to the input.")
+
+
+def _packed_slices(shape, level, axes=None):
+    """
+    Slices of the subbands in the packed layout of the in-place transforms
+    along axes (default: all) of an array of shape, in the format of the
+    coefficient slices of `coeffs_to_array`.
+    """
+    if axes is None:
+        axes = range(len(shape))
+    # blocks[l] is the approximation block left by level l
+    blocks = [tuple(shape)]
+    for l in range(level):
+        blocks.append(tuple((n + 1) // 2 if i in axes else n
+                            for i, n in enumerate(blocks[-1])))
+    keys = [''.join(key) for key in product('ad', repeat=len(axes))][1:]
+
+    coeff_slices = [tuple(slice(n) for n in blocks[level])]
+    for l in range(level, 0, -1):
+        a, block = blocks[l], blocks[l - 1]
+        details = {}
+        for key in keys:
+            slices = [slice(n) for n in block]
+            for c, i in zip(key, axes):
+                slices[i] = slice(a[i]) if c == 'a' else slice(a[i], block[i])
+            details[key] = tuple(slices)
+        coeff_slices.append(details)
+    return coeff_slices
+
+
+def _packed_array(coeffs, axes=None, inplace=True):
+    """
+    The packed array of the subbands coeffs, [cAn, {details_level_n}, ...]
+    along axes (default: all): the array of which they are views if
+    inplace, otherwise a new array they are copied into.
+    """
+    ndim = np.ndim(coeffs[0])
+    if axes is None:
+        axes = range(ndim)
+    keys = [''.join(key) for key in product('ad', repeat=len(axes))][1:]
+
+    # the shape of the packed array, with the subbands checked against it
+    shape = list(np.shape(coeffs[0]))
+    for details in coeffs[1:]:
+        if not isinstance(details, dict) or sorted(details) != keys:
+            raise ValueError("Expected the {} details {} at every level."
+                             .format(len(keys), keys))
+        d_shape = np.shape(details['d' * len(axes)])
+        if len(d_shape) != ndim or any(
+                (n - m not in (0, 1)) if i in axes else (n != m)
+                for i, (n, m) in enumerate(zip(shape, d_shape))):
+            raise ValueError("incompatible coefficient array sizes")
+        for i in axes:
+            shape[i] += d_shape[i]
+    coeff_slices = _packed_slices(shape, len(coeffs) - 1, axes)
+    pairs = [(coeffs[0], coeff_slices[0])]
+    for details, level_slices in zip(coeffs[1:], coeff_slices[1:]):
+        pairs.extend((details[key], level_slices[key]) for key in keys)
+    for c, slices in pairs:
+        if np.shape(c) != tuple(s.stop - (s.start or 0) for s in slices):
+            raise ValueError("incompatible coefficient array sizes")
+
+    if not inplace:
+        data = np.empty(shape, np.result_type(*[c for c, _ in pairs]))
+        for c, slices in pairs:
+            data[slices] = c
+        return data
+
+    message = ("With inplace, the coefficients must be the views of a "
+               "single array from the in-place decomposition.")
+    a = coeffs[0]
+    if not isinstance(a, np.ndarray):
+        raise ValueError(message)
+    address = a.__array_interface__['data'][0]
+    for c, slices in pairs:
+        offset = sum((s.start or 0) * stride
+                     for s, stride in zip(slices, a.strides))
+        if (not isinstance(c, np.ndarray) or c.dtype != a.dtype or
+                c.strides != a.strides or
+                c.__array_interface__['data'][0] != address + offset):
+            raise ValueError(message)
+    # the subbands cover the packed array, so its elements are all valid
+    return np.lib.stride_tricks.as_strided(a, shape, a.strides)
+
+
+def _wavedec_inplace(data, wavelet, mode, level, axes, method, workers):
+    """
+    Multilevel DWT along axes (default: all) of data in place, returning the
+    subbands as views in the packed layout.
+    """
+    if not isinstance(data, np.ndarray):
+        raise TypeError("inplace requires an ndarray.")
+    if data.ndim < 1:
+        raise ValueError("Expected at least 1D input data.")
+    if Modes.from_object(mode) != Modes.periodization:
+        raise ValueError("inplace requires mode='periodization'.")
+    if axes is None:
+        axes = range(data.ndim)
+    if level is None:
+        # the largest default level at which the lengths are even
+        level = min(min(dwt_max_level(data.shape[i], wavelet.dec_len),
+                        swt_max_level(data.shape[i])) for i in axes)
+        if level == 0 and any(data.shape[i] % 2 for i in axes):
+            # rather than silently leaving the data untransformed
+            raise ValueError("inplace requires lengths divisible by "
+                             "2**level = 2.")
+    else:
+        level = _check_level(min(data.shape[i] for i in axes),
+                             wavelet.dec_len, level)
+        if any(data.shape[i] % 2**level for i in axes):
+            raise ValueError("inplace requires lengths divisible by "
+                             "2**level = {}.".format(2**level))
+
+    _dwtn_inplace(data, wavelet, level, axes,
+                  _method_from_object(wavelet, method), False,
+                  _workers_from_object(workers))
+    return array_to_coeffs(data, _packed_slices(data.shape, level, axes))
+
+
+def _waverec_inplace(coeffs, wavelet, mode, axes, method, workers):
+    """
+    Multilevel IDWT of the views of _wavedec_inplace, in place, returning
+    their array.
+    """
+    if not isinstance(wavelet, Wavelet):
+        wavelet = Wavelet(wavelet)
+    if Modes.from_object(mode) != Modes.periodization:
+        raise ValueError("inplace requires mode='periodization'.")
+    data = _packed_array(coeffs, axes)
+    if axes is None:
+        axes = range(data.ndim)
+    _dwtn_inplace(data, wavelet, len(coeffs) - 1, axes,
+                  _method_from_object(wavelet, method, inverse=True), True,
+                  _workers_from_object(workers))
+    return data
+
+
+# Lengths of the lowpass decomposition filters of the integer wavelets, for
+# the default level of int_wavedecn
+_int_dec_lens = {'5/3': 5, '9/7-M': 9}
+
+
+def _int_lifting_from_object(wavelet):
+    if wavelet not in _int_liftings:
+        raise ValueError("Unknown integer wavelet {!r}, expected one of {}"
+                         .format(wavelet, sorted(_int_liftings)))
+    return _int_liftings[wavelet]
+
+
+def _int_max_level(shape):
+    # levels until the shortest axis is down to a single coefficient
+    return (min(shape) - 1).bit_length() if min(shape) > 0 else 0
+
+
+def int_wavedecn(data, wavelet='5/3', level=None, inplace=False,
+                 workers=None):
+    """
+    Multilevel nD reversible integer-to-integer wavelet transform.
+
+    The filter banks are factored into lifting steps that round to integers,
+    so integer data gives integer coefficients from which `int_waverecn`
+    reconstructs it exactly, as required for lossless compression.
+
+    Parameters
+    ----------
+    data : array_like
+        nD integer input data. Without `inplace`, it is transformed in a
+        copy of dtype int16 (for 8 bit integers) or int32 (for 16 bit
+        unsigned integers) if it is not int16 or int32.
+    wavelet : {'5/3', '9/7-M'}, optional
+        The LeGall 5/3 filter bank of lossless JPEG 2000 (default), or the
+        9/7-M filter bank: the 9 tap lowpass filter of the 5/3 with integer
+        lifting steps, giving smoother approximations at some extra cost.
+    level : int, optional
+        Decomposition level, from 0 to the number of levels halving the
+        shortest axis down to a single coefficient. If level is None
+        (default) then it will be calculated using the ``dwt_max_level``
+        function, with the length of the lowpass filter (5 or 9).
+    inplace : bool, optional
+        If True, `data` must be an int16 or int32 array, which is overwritten
+        by the coefficients. No memory is allocated besides a few rows of
+        buffers per thread.
+    workers : int, optional
+        Number of threads, see `dwt`.
+
+    Returns
+    -------
+    [cAn, {details_level_n}, ... {details_level_1}] : list
+        Coefficients list, as returned by `wavedecn`. The arrays are views
+        of a single array (`data` itself if `inplace`) holding the
+        coefficients in the packed layout of `coeffs_to_array`: at each
+        level, the lines along every axis of the approximation of the
+        previous level are replaced by their ``ceil(n/2)`` approximation
+        followed by their ``floor(n/2)`` detail coefficients.
+
+    Raises
+    ------
+    OverflowError
+        If a coefficient does not fit in the dtype of the array. The
+        approximation coefficients are about the size of the data, the
+        details of each level up to twice as large, so a bit of headroom is
+        needed (e.g. 12 bit images in int16). With `inplace`, `data` is
+        left partially transformed.
+
+    Notes
+    -----
+    The signal is extended symmetrically about its first and last samples
+    (as in the ``'reflect'`` mode) at the edges. The axes of each level are
+    transformed one after the other, the first axis first.
+
+    Examples
+    --------
+    >>> import numpy as np
+    >>> import pywt
+    >>> x = np.arange(64, dtype=np.int16).reshape(8, 8) % 7
+    >>> coeffs = pywt.int_wavedecn(x, '5/3', level=2)
+    >>> coeffs[0].dtype
+    dtype('int16')
+    >>> np.array_equal(pywt.int_waverecn(coeffs, '5/3'), x)
+    True
+    """
+    if inplace:
+        if not isinstance(data, np.ndarray):
+            raise TypeError("inplace requires an ndarray.")
+    else:
+        data = np.asarray(data)
+        dtype = data.dtype
+        if dtype != np.int16 and dtype != np.int32:
+            if dtype.kind not in 'biu' or dtype.itemsize > 2:
+                raise TypeError("Expected int16, int32 or integer data of at "
+                                "most 16 bits, not {}".format(dtype))
+            dtype = np.promote_types(dtype, np.int16)
+        data = np.array(data, dtype=dtype)
+
+    if data.ndim < 1:
+        raise ValueError("Expected at least 1D input data.")
+    lifting = _int_lifting_from_object(wavelet)
+    if level is None:
+        level = dwt_max_level(min(data.shape), _int_dec_lens[wavelet])
+    elif level < 0 or level > _int_max_level(data.shape):
+        raise ValueError("Level value of {} is out of range [0, {}]."
+                         .format(level, _int_max_level(data.shape)))
+
+    _int_lifting(data, lifting, level, False, _workers_from_object(workers))
+    return array_to_coeffs(data, _packed_slices(data.shape, level))
+
+
+def int_waverecn(coeffs, wavelet='5/3', inplace=False, workers=None):
+    """
+    Multilevel nD inverse of `int_wavedecn`.
+
+    Parameters
+    ----------
+    coeffs : list
+        Coefficients list [cAn, {details_level_n}, ... {details_level_1}],
+        with all the details of every level.
+    wavelet : {'5/3', '9/7-M'}, optional
+        Wavelet of the decomposition, see `int_wavedecn`.
+    inplace : bool, optional
+        If True, the arrays of `coeffs` must be the views of a single packed
+        array returned by `int_wavedecn`, which is overwritten by the
+        reconstruction. Otherwise they are copied into a new packed array
+        (default).
+    workers : int, optional
+        Number of threads, see `dwt`.
+
+    Returns
+    -------
+    nD array of the reconstructed data, of the dtype of the coefficients.
+
+    Raises
+    ------
+    OverflowError
+        If the reconstruction does not fit in the dtype of the coefficients,
+        which does not happen for the coefficients of `int_wavedecn`.
+    """
+    if len(coeffs) < 1:
+        raise ValueError(
+            "Coefficient list too short (minimum 1 array required).")
+    lifting = _int_lifting_from_object(wavelet)
+    level = len(coeffs) - 1
+    if level == 0:
+        return coeffs[0] if inplace else np.array(coeffs[0])
+
+    data = _packed_array(coeffs, inplace=inplace)
+    _int_lifting(data, lifting, level, True, _workers_from_object(workers))
+    return data
+
+
 def _coeffs_wavedec_to_wavedecn(coeffs):
     """Convert wavedec coefficients to the wavedecn format."""
     if len(coeffs) == 0:
@@ -0,0 +1,423 @@
+# -*- coding: utf-8 -*-
+
+# See COPYING for license details.
+
+"""
+Multilevel nD transforms planned once for arrays of a fixed shape and dtype.
+"""
+
+from __future__ import division, print_function, absolute_import
+
+import operator
+import threading
+import timeit
+from itertools import product
+
+import numpy as np
+
+from ._extensions._pywt import (Wavelet, Modes, _check_dtype, _check_out,
+                                _method_from_object, _method_names,
+                                _workers_from_object, _check_out_overlap)
+from ._extensions._dwt import (dwt_coeff_len, WtnPlan as _WtnPlan,
+                               cast_dtypes as _cast_dtypes)
+from ._multidim import dwtn, idwtn
+from ._multilevel import _check_level, _match_coeff_dims, _copy_out
+from ._wisdom import _get_wisdom, _add_wisdom
+
+__all__ = ['plan', 'Plan']
+
+# The kernels of a plan: all levels in a single C call, or a level at a time
+# by dwtn and idwtn with one of the methods
+_SINGLE = 'single'
+
+# Minimum time each kernel is run for when tuning, in seconds
+_TUNE_TIME = 0.02
+
+
+def _measure(func):
+    """
+    Shortest time of func() over at least 3 runs and _TUNE_TIME seconds.
+    """
+    timer = timeit.default_timer
+    func()
+    best, total, runs = float('inf'), 0., 0
+    while runs < 3 or (total < _TUNE_TIME and runs < 1000):
+        start = timer()
+        func()
+        elapsed = timer() - start
+        best = min(best, elapsed)
+        total += elapsed
+        runs += 1
+    return best
+
+
+def _mode_name(mode):
+    for name in Modes.modes:
+        if Modes.from_object(name) == mode:
+            return name
+
+
+def plan(shape, dtype, wavelet, mode='symmetric', level=None, axes=None,
+         method='convolution', workers=None, tune=False):
+    """
+    Plan the multilevel nD DWT of arrays of one shape and dtype.
+
+    The wavelet, mode and level are checked, and the coefficient shapes
+    computed, once. For real data transformed along all axes with the
+    convolutions, the plan also holds the filter taps of every level, the
+    approximations between levels and the buffers of its threads, so that
+    `Plan.forward` and `Plan.inverse` with `out` allocate no memory. Other
+    transforms are computed a level at a time by `dwtn` and `idwtn`, into
+    approximations allocated by the plan. With `tune`, the plan instead
+    uses whichever of these kernels is fastest on this machine.
+
+    Parameters
+    ----------
+    shape : tuple of ints
+        Shape of the data.
+    dtype : dtype
+        Data type of the data. The coefficients have the floating point
+        dtype `wavedecn` returns for it.
+    wavelet : Wavelet object or name string
+        Wavelet to use
+    mode : str, optional
+        Signal extension mode, see Modes (default: 'symmetric')
+    level : int, optional
+        Decomposition level (must be >= 0). If level is None (default) then
+        it will be calculated using the ``dwt_max_level`` function, for the
+        shortest of `axes`.
+    axes : sequence of ints, optional
+        Axes over which to compute the DWT, see `dwtn`. A value of `None`
+        (the default) selects all axes.
+    method : {'convolution', 'lifting', 'auto'}, optional
+        Method of computing the transform, see `dwt`. With `tune`, ``'auto'``
+        lets the methods compete.
+    workers : int, optional
+        Number of threads, see `dwt`. With `tune`, the maximum number.
+    tune : bool, optional
+        If True, time the kernels that can compute the transform (all
+        levels in a single call or a level at a time, with each allowed
+        method and 1, 2, 4, ... up to `workers` threads) on random data,
+        and use the fastest for the forward and the inverse transform. The
+        choice is recorded in the wisdom (see `export_wisdom`), which later
+        plans of the same transform use without timing, whether or not they
+        are tuned. Plans of wavelets built from custom filters are not
+        recorded.
+
+    Returns
+    -------
+    plan : Plan
+        A plan of `wavedecn` (`forward`) and `waverecn` (`inverse`) along
+        `axes`. It must not be executed by several threads at once, which
+        it prevents with a lock.
+
+    Examples
+    --------
+    >>> import numpy as np
+    >>> import pywt
+    >>> p = pywt.plan((64, 64), np.float64, 'db2', level=2)
+    >>> p.coeffs_shapes
+    [(18, 18), (33, 33)]
+    >>> coeffs = p.empty_coeffs()
+    >>> y = np.empty(p.inverse_shape)
+    >>> x = np.ones((64, 64))
+    >>> for i in range(3):
+    ...     coeffs = p.forward(x, out=coeffs)
+    ...     x = p.inverse(coeffs, out=y)
+    >>> np.allclose(x, 1)
+    True
+    """
+    return Plan(shape, dtype, wavelet, mode, level, axes, method, workers,
+                tune)
+
+
+class Plan(object):
+    """
+    A multilevel nD DWT and its inverse for arrays of a fixed shape and
+    dtype, see `plan`.
+
+    Attributes
+    ----------
+    shape, dtype : tuple of ints, dtype
+        Shape and dtype of the data.
+    axes : tuple of ints
+        The transformed axes.
+    level : int
+        Decomposition level.
+    coeffs_shapes : list of tuples
+        Shapes of the coefficients of each level, coarsest first.
+    coeffs_dtype : dtype
+        Data type of the coefficients.
+    inverse_shape : tuple of ints
+        Shape of the reconstruction, which as for `waverecn` may be one
+        longer than `shape` along the axes of odd length.
+    forward_kernel, inverse_kernel : str
+        How the transforms are computed: ``'single'`` for all levels in a
+        single call, ``'convolution'`` or ``'lifting'`` for a level at a time
+        with that method.
+    workers : int
+        Number of threads.
+    """
+
+    def __init__(self, shape, dtype, wavelet, mode='symmetric', level=None,
+                 axes=None, method='convolution', workers=None, tune=False):
+        shape = tuple(operator.index(n) for n in shape)
+        ndim = len(shape)
+        if ndim < 1:
+            raise ValueError("Expected at least 1D data.")
+        if axes is None:
+            axes = range(ndim)
+        axes = tuple(a + ndim if a < 0 else a for a in axes)
+        if len(axes) < 1 or any(a < 0 or a >= ndim for a in axes):
+            raise ValueError("Invalid axes {} for data of shape {}."
+                             .format(axes, shape))
+        if not isinstance(wavelet, Wavelet):
+            wavelet = Wavelet(wavelet)
+        self.shape = shape
+        self.dtype = np.dtype(dtype)
+        self.axes = axes
+        self.wavelet = wavelet
+        self.mode = Modes.from_object(mode)
+        self.level = _check_level(min(shape[a] for a in axes),
+                                  wavelet.dec_len, level)
+        self.coeffs_dtype = _check_dtype(np.empty(0, self.dtype))
+        self._lock = threading.Lock()
+        self._keys = [''.join(key) for key in product('ad', repeat=len(axes))]
+
+        self.coeffs_shapes = []
+        a_shape = list(shape)
+        for l in range(self.level):
+            for a in axes:
+                a_shape[a] = dwt_coeff_len(a_shape[a], wavelet.dec_len,
+                                           self.mode)
+            self.coeffs_shapes.insert(0, tuple(a_shape))
+        self._rec_shapes = []
+        for coeffs_shape in self.coeffs_shapes:
+            rec_shape = list(coeffs_shape)
+            for a in axes:
+                if self.mode == Modes.periodization:
+                    rec_shape[a] = 2 * coeffs_shape[a]
+                else:
+                    rec_shape[a] = 2 * coeffs_shape[a] - wavelet.rec_len + 2
+            self._rec_shapes.append(tuple(rec_shape))
+        self.inverse_shape = (self._rec_shapes[-1] if self._rec_shapes
+                              else shape)
+
+        if not isinstance(method, str):
+            method = _method_names[_method_from_object(wavelet, method)]
+        workers = _workers_from_object(workers)
+        kernels = (self._default_kernel(method, False),
+                   self._default_kernel(method, True), workers)
+        key = self._wisdom_key(method, workers)
+        choice = _get_wisdom(key) if key is not None else None
+        if choice is not None and self._valid_choice(choice, method, workers):
+            kernels = (choice['forward'], choice['inverse'], choice['threads'])
+        elif tune and self.level > 0:
+            kernels = self._tune(method, workers)
+            if key is not None:
+                _add_wisdom(key, dict(zip(['forward', 'inverse', 'threads'],
+                                          kernels)))
+        self._setup(*kernels)
+
+    def _single_call(self, inverse):
+        # whether all levels can be computed in a single call, see WtnPlan
+        return (self.level > 0 and self.axes == tuple(range(len(self.shape)))
+                and (self.dtype in _cast_dtypes or
+                     self.dtype == self.coeffs_dtype) and
+                self.coeffs_dtype.kind != 'c' and
+                (not inverse or self.wavelet.rec_len % 2 == 0))
+
+    def _kernels(self, method, inverse):
+        # the kernels allowed by method, see plan
+        kernels = []
+        if method in ('convolution', 'auto'):
+            if self._single_call(inverse):
+                kernels.append(_SINGLE)
+            kernels.append('convolution')
+        if (method in ('lifting', 'auto') and
+                self.wavelet.lifting_scheme is not None):
+            kernels.append('lifting')
+        return kernels
+
+    def _default_kernel(self, method, inverse):
+        method = _method_names[_method_from_object(self.wavelet, method,
+                                                   inverse)]
+        if method == 'convolution' and self._single_call(inverse):
+            return _SINGLE
+        return method
+
+    def _wisdom_key(self, method, workers):
+        # wavelets from custom filters may have the name of another one
+        if not self.wavelet.short_family_name:
+            return None
+        return (self.wavelet.name, _mode_name(self.mode), self.shape,
+                self.dtype.name, self.level, self.axes, method, workers)
+
+    def _valid_choice(self, choice, method, workers):
+        return (choice['forward'] in self._kernels(method, False) and
+                choice['inverse'] in self._kernels(method, True) and
+                isinstance(choice['threads'], int) and
+                1 <= choice['threads'] <= workers)
+
+    def _setup(self, forward_kernel, inverse_kernel, workers):
+        self.forward_kernel = forward_kernel
+        self.inverse_kernel = inverse_kernel
+        self.workers = workers
+        self._c_plan = None
+        if _SINGLE in (forward_kernel, inverse_kernel):
+            self._c_plan = _WtnPlan(self.shape, self.dtype, self.wavelet,
+                                    self.mode, self.level, workers)
+        # the approximations and reconstructions between levels
+        self._approx = ([np.empty(s, self.coeffs_dtype)
+                         for s in self.coeffs_shapes[1:]]
+                        if forward_kernel != _SINGLE else [])
+        self._rec = ([np.empty(s, self.coeffs_dtype)
+                      for s in self._rec_shapes[:-1]]
+                     if inverse_kernel != _SINGLE else [])
+
+    def _tune(self, method, workers):
+        """
+        The fastest forward and inverse kernels and number of threads.
+        """
+        data = (100 * np.random.RandomState(1234).rand(*self.shape)).astype(
+            self.dtype)
+        coeffs = self.empty_coeffs()
+        y = np.empty(self.inverse_shape, self.coeffs_dtype)
+        forward_kernels = self._kernels(method, False)
+        inverse_kernels = self._kernels(method, True)
+        # powers of 2 up to workers
+        threads = [1 << i for i in range(workers.bit_length())
+                   if 1 << i < workers] + [workers]
+
+        best = None
+        for n in threads:
+            forward = []
+            for kernel in forward_kernels:
+                self._setup(kernel, inverse_kernels[0], n)
+                forward.append((_measure(lambda: self.forward(data, coeffs)),
+                                kernel))
+            inverse = []
+            for kernel in inverse_kernels:
+                self._setup(forward_kernels[0], kernel, n)
+                inverse.append((_measure(lambda: self.inverse(coeffs, y)),
+                                kernel))
+            forward, inverse = min(forward), min(inverse)
+            if best is None or forward[0] + inverse[0] < best[0]:
+                best = (forward[0] + inverse[0], forward[1], inverse[1], n)
+        return best[1:]
+
+    def empty_coeffs(self):
+        """
+        New uninitialized coefficient arrays, in the format of `forward`,
+        to reuse as its `out`.
+        """
+        if not self.coeffs_shapes:
+            return [np.empty(self.shape, self.dtype)]
+        coeffs = [np.empty(self.coeffs_shapes[0], self.coeffs_dtype)]
+        for s in self.coeffs_shapes:
+            coeffs.append(dict((key, np.empty(s, self.coeffs_dtype))
+                               for key in self._keys[1:]))
+        return coeffs
+
+    def forward(self, data, out=None):
+        """
+        Multilevel DWT of data, as `wavedecn` (along `axes`).
+
+        Parameters
+        ----------
+        data : ndarray
+            Array of the shape and dtype of the plan.
+        out : list, optional
+            Arrays the coefficients are written to and returned in, in the
+            format of the result, for instance from `empty_coeffs`. Missing
+            keys are allocated. They must be C-contiguous for the
+            transforms of all levels in a single call.
+
+        Returns
+        -------
+        [cAn, {details_level_n}, ... {details_level_1}] : list
+            Coefficients list, `out` if given.
+        """
+        data = np.asarray(data)
+        if data.dtype != self.dtype:
+            raise TypeError("Expected data of dtype {}, not {}."
+                            .format(self.dtype, data.dtype))
+        if data.shape != self.shape:
+            raise ValueError("Expected data of shape {}, not {}."
+                             .format(self.shape, data.shape))
+        if out is None:
+            out = self.empty_coeffs()
+        elif len(out) != self.level + 1:
+            raise ValueError("out must have {} levels.".format(self.level + 1))
+        elif self.forward_kernel != _SINGLE or self.level == 0:
+            # the single call checks the overlap itself
+            _check_out_overlap(out, data)
+        if self.level == 0:
+            out[0] = _copy_out(data, out[0])
+            return out
+
+        with self._lock:
+            if self.forward_kernel == _SINGLE:
+                for l, s in enumerate(self.coeffs_shapes):
+                    details = out[1 + l]
+                    for key in self._keys[1:]:
+                        if key not in details:
+                            details[key] = np.empty(s, self.coeffs_dtype)
+                return self._c_plan.forward(data, out)
+
+            a = data
+            for i in range(self.level):
+                level_out = dict(out[self.level - i])
+                level_out[self._keys[0]] = (out[0] if i == self.level - 1
+                                            else self._approx[-1 - i])
+                coeffs = dwtn(a, self.wavelet, self.mode, self.axes,
+                              self.forward_kernel, self.workers, level_out)
+                a = coeffs.pop(self._keys[0])
+                out[self.level - i].update(coeffs)
+            out[0] = a
+        return out
+
+    def inverse(self, coeffs, out=None):
+        """
+        Multilevel IDWT of coeffs, as `waverecn` (along `axes`).
+
+        Parameters
+        ----------
+        coeffs : list
+            Coefficients list [cAn, {details_level_n}, ...
+            {details_level_1}] with the shapes and dtype of the plan. cAn
+            may be None and details may be missing, for zeros.
+        out : ndarray, optional
+            Array the reconstruction is written to and returned in, of
+            shape `inverse_shape`. It must be C-contiguous for the
+            transforms of all levels in a single call.
+
+        Returns
+        -------
+        data : ndarray
+            The reconstruction, `out` if given.
+        """
+        if len(coeffs) != self.level + 1:
+            raise ValueError("Expected {} levels of coefficients, not {}."
+                             .format(self.level + 1, len(coeffs)))
+        if self.level == 0:
+            return _copy_out(coeffs[0], out)
+        # the single call checks the overlap itself
+        single = self.inverse_kernel == _SINGLE
+        out = _check_out(out, self.inverse_shape, self.coeffs_dtype, single,
+                         () if single else coeffs)
+
+        with self._lock:
+            if single:
+                return self._c_plan.inverse(coeffs, out)
+
+            a = coeffs[0]
+            for i, details in enumerate(coeffs[1:]):
+                if a is not None and i > 0:
+                    a = _match_coeff_dims(a, details)
+                d = dict(details)
+                d[self._keys[0]] = a
+                a = idwtn(d, self.wavelet, self.mode, self.axes,
+                          self.inverse_kernel, self.workers,
+                          out if i == self.level - 1 else self._rec[i])
+        return a
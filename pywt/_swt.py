@@ -1,14 +1,18 @@
-from ._extensions._swt import swt_max_level, swt as _swt
-from ._extensions._pywt import Wavelet, _check_dtype
+from itertools import product
+
+from ._extensions._swt import (swt_max_level, swt as _swt, swt_axis,
+                               modwt_max_level, modwt as _modwt)
+from ._extensions._pywt import (Wavelet, _check_dtype, _check_out,
+                                _workers_from_object, _check_out_overlap)
 
 import numpy as np
 
-__all__ = ["swt", "swt_max_level"]
+__all__ = ["swt", "swt_max_level", "swtn", "modwt", "modwt_max_level"]
 
 
-def swt(data, wavelet, level=None, start_level=0):
+def swt(data, wavelet, level=None, start_level=0, out=None):
     """
-    swt(data, wavelet, level=None, start_level=0)
+    swt(data, wavelet, level=None, start_level=0, out=None)
 
     Performs multilevel Stationary Wavelet Transform.
 
@@ -24,6 +28,10 @@ def swt(data, wavelet, level=None, start_level=0):
         The level at which the decomposition will begin (it allows one to
         skip a given number of transform steps and compute
         coefficients starting from start_level) (default: 0)
+    out : list, optional
+        C-contiguous arrays the coefficients are written to and returned in,
+        as a list of ``(cA, cD)`` pairs in the order of the result, see
+        `dwt`. For complex data, the result is copied into them.
 
     Returns
     -------
@@ -39,23 +47,226 @@ def swt(data, wavelet, level=None, start_level=0):
 
             [(cAm+n, cDm+n), ..., (cAm+1, cDm+1), (cAm, cDm)]
 
+        Without `out`, the arrays are views of a single ``(level, 2, N)``
+        array, in the order of the list.
+
     """
     if np.iscomplexobj(data):
         data = np.asarray(data)
         coeffs_real = swt(data.real, wavelet, level, start_level)
         coeffs_imag = swt(data.imag, wavelet, level, start_level)
+        if out is None:
+            # a single block for all levels, as for real data
+            block = np.empty((len(coeffs_real), 2) + coeffs_real[0][0].shape,
+                             np.result_type(coeffs_real[0][0], np.complex64))
+            out = [(block[k, 0], block[k, 1]) for k in range(len(block))]
+        elif len(out) != len(coeffs_real):
+            raise ValueError("out must have {} pairs of arrays."
+                             .format(len(coeffs_real)))
+        else:
+            _check_out_overlap(out)
         coeffs_cplx = []
-        for (cA_r, cD_r), (cA_i, cD_i) in zip(coeffs_real, coeffs_imag):
-            coeffs_cplx.append((cA_r + 1j*cA_i, cD_r + 1j*cD_i))
+        for pair_r, pair_i, out_pair in zip(coeffs_real, coeffs_imag, out):
+            pair = tuple(_check_out(o, c.shape,
+                                    np.result_type(c, np.complex64), True)
+                         for c, o in zip(pair_r, out_pair))
+            for o, c_r, c_i in zip(pair, pair_r, pair_i):
+                o.real = c_r
+                o.imag = c_i
+            coeffs_cplx.append(pair)
         return coeffs_cplx
 
-    # accept array_like input; make a copy to ensure a contiguous array
+    # accept array_like input; converted to a contiguous array
     dt = _check_dtype(data)
-    data = np.array(data, dtype=dt)
+    data = np.ascontiguousarray(data, dtype=dt)
     if not isinstance(wavelet, Wavelet):
         wavelet = Wavelet(wavelet)
     if level is None:
         level = swt_max_level(len(data))
 
-    ret = _swt(data, wavelet, level, start_level)
-    return [(np.asarray(cA), np.asarray(cD)) for cA, cD in ret]
+    return _swt(data, wavelet, level, start_level, out)
+
+
+def swtn(data, wavelet, level=None, start_level=0, axes=None, workers=None,
+         out=None):
+    """
+    swtn(data, wavelet, level=None, start_level=0, axes=None, workers=None, out=None)
+
+    n-dimensional Stationary Wavelet Transform.
+
+    Parameters
+    ----------
+    data : array_like
+        n-dimensional array with input data.
+    wavelet : Wavelet object or name string
+        Wavelet to use.
+    level : int, optional
+        Transform level, by default the maximum level for the shape of
+        `data` along `axes`, see `swt_max_level`.
+    start_level : int, optional
+        The level at which the decomposition will begin, see `swt`
+        (default: 0).
+    axes : sequence of ints, optional
+        Axes over which to compute the SWT. A value of `None` (the default)
+        selects all axes. The lengths of `data` along these axes must be
+        divisible by ``2 ** (start_level + level)``.
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : list, optional
+        Arrays the coefficients are written to and returned in, as a list of
+        dicts in the format of the result, see `dwt`. Missing keys are
+        allocated. The transforms of all axes but the last still return
+        their results in temporary arrays.
+
+    Returns
+    -------
+    coeffs : list
+        A list of dicts, in order similar to `swt`::
+
+            [{coeffs_level_n}, ..., {coeffs_level_1}]
+
+        where each dict has the keys of `dwtn`, e.g. ``'aa'``, ``'ad'``,
+        ``'da'`` and ``'dd'`` for 2D data, including the approximation
+        (``'aa'``) of that level. All coefficients have the shape of
+        `data`. Without `out`, the arrays are views of a single array of
+        shape ``(level, 2 ** len(axes)) + data.shape``, in the order of the
+        list and of the keys sorted.
+
+    Examples
+    --------
+    >>> import numpy as np
+    >>> import pywt
+    >>> coeffs = pywt.swtn(np.ones((4, 4)), 'db1', level=2)
+    >>> len(coeffs), sorted(coeffs[0])
+    (2, ['aa', 'ad', 'da', 'dd'])
+    >>> coeffs[0]['aa']
+    array([[ 4.,  4.,  4.,  4.],
+           [ 4.,  4.,  4.,  4.],
+           [ 4.,  4.,  4.,  4.],
+           [ 4.,  4.,  4.,  4.]])
+    """
+    data = np.asarray(data)
+    if data.dtype == np.dtype('object'):
+        raise TypeError("Input must be a numeric array-like")
+    if data.ndim < 1:
+        raise ValueError("Input data must be at least 1D")
+
+    if axes is None:
+        axes = range(data.ndim)
+    axes = [a + data.ndim if a < 0 else a for a in axes]
+    if len(axes) == 0 or any(a < 0 or a >= data.ndim for a in axes):
+        raise ValueError("Axes must be valid axes of the data.")
+    if not isinstance(wavelet, Wavelet):
+        wavelet = Wavelet(wavelet)
+    workers = _workers_from_object(workers)
+
+    max_level = min(swt_max_level(data.shape[a]) for a in axes)
+    if level is None:
+        level = max_level - start_level
+    if level < 1:
+        raise ValueError("Level value must be greater than zero.")
+    if start_level + level > max_level:
+        raise ValueError("Level value too high (max level for current data "
+                         "shape and start_level is %d)."
+                         % (max_level - start_level))
+
+    keys = [''.join(k) for k in product('ad', repeat=len(axes))]
+    if out is None:
+        block = np.empty((level, len(keys)) + data.shape, _check_dtype(data))
+        out = [dict(zip(keys, subbands)) for subbands in block]
+    elif len(out) != level:
+        raise ValueError("out must have {} dicts of arrays.".format(level))
+    else:
+        _check_out_overlap(out, data)
+
+    coeffs = [None] * level
+    a = data
+    for j in range(start_level + 1, start_level + level + 1):
+        k = start_level + level - j
+        subbands = [('', a)]
+        for i, axis in enumerate(axes):
+            new_subbands = []
+            for key, x in subbands:
+                if i == len(axes) - 1:
+                    pair = (out[k].get(key + 'a'), out[k].get(key + 'd'))
+                else:
+                    pair = None
+                cA, cD = swt_axis(x, wavelet, j, axis, workers, pair)
+                new_subbands.extend([(key + 'a', cA), (key + 'd', cD)])
+            subbands = new_subbands
+        coeffs[k] = dict(subbands)
+        # the approximation is the input of the next level
+        a = coeffs[k]['a' * len(axes)]
+    return coeffs
+
+
+def modwt(data, wavelet, level=None, axis=-1, workers=None, out=None):
+    """
+    modwt(data, wavelet, level=None, axis=-1, workers=None, out=None)
+
+    Multilevel Maximal Overlap Discrete Wavelet Transform along an axis.
+
+    The MODWT is the stationary wavelet transform with the filters rescaled
+    by ``1/sqrt(2)`` and causal circular filtering. Unlike `swt`, it is
+    defined for any length of `data` along `axis`: level ``j`` filters the
+    approximation of level ``j - 1`` with the filters upsampled by
+    ``2**(j-1)``, wrapping around the ends. For orthogonal wavelets the
+    energy of the coefficients of each level equals that of the data. For
+    lengths divisible by ``2**level`` the coefficients of level ``j`` are
+    those of `swt` divided by ``sqrt(2)**j`` and circularly shifted by
+    ``(2**j - 1) * (dec_len // 2)``.
+
+    Parameters
+    ----------
+    data : array_like
+        Input data.
+    wavelet : Wavelet object or name string
+        Wavelet to use.
+    level : int, optional
+        Transform level, by default the maximum level for the length of
+        `data` along `axis`, see `modwt_max_level`.
+    axis : int, optional
+        Axis over which to compute the MODWT (default: the last one).
+    workers : int, optional
+        Number of threads, see `dwt`.
+    out : list, optional
+        Arrays the coefficients are written to and returned in, as a list of
+        ``(cA, cD)`` pairs in the order of the result, of any strides, see
+        `dwt`.
+
+    Returns
+    -------
+    coeffs : list
+        List of approximation and details coefficients pairs, in the order
+        of `swt`::
+
+            [(cAn, cDn), ..., (cA2, cD2), (cA1, cD1)]
+
+        all of the shape of `data`. Without `out`, the arrays are views of a
+        single ``(level, 2) + data.shape`` array, in the order of the list.
+
+    Examples
+    --------
+    >>> import numpy as np
+    >>> import pywt
+    >>> x = np.arange(7.)
+    >>> coeffs = pywt.modwt(x, 'db2', level=2)
+    >>> np.allclose(pywt.imodwt(coeffs, 'db2'), x)
+    True
+    """
+    data = np.asarray(data)
+    if data.dtype == np.dtype('object'):
+        raise TypeError("Input must be a numeric array-like")
+    if data.ndim < 1:
+        raise ValueError("Input data must be at least 1D")
+    if axis < 0:
+        axis = axis + data.ndim
+    if not 0 <= axis < data.ndim:
+        raise ValueError("Axis greater than data dimensions")
+    if not isinstance(wavelet, Wavelet):
+        wavelet = Wavelet(wavelet)
+    if level is None:
+        level = modwt_max_level(data.shape[axis])
+
+    return _modwt(data, wavelet, level, axis, _workers_from_object(workers),
+                  out)
@@ -0,0 +1,124 @@
+# -*- coding: utf-8 -*-
+
+# See COPYING for license details.
+
+"""
+Wisdom: the kernels `plan` measured to be fastest on this machine.
+"""
+
+from __future__ import division, print_function, absolute_import
+
+import json
+import os
+import warnings
+
+__all__ = ['export_wisdom', 'import_wisdom', 'save_wisdom', 'load_wisdom',
+           'forget_wisdom']
+
+_WISDOM_VERSION = 1
+
+# Transforms are identified by the fields of _KEY_FIELDS, and their kernels
+# by those of _CHOICE_FIELDS
+_KEY_FIELDS = ('wavelet', 'mode', 'shape', 'dtype', 'level', 'axes',
+               'method', 'workers')
+_CHOICE_FIELDS = ('forward', 'inverse', 'threads')
+
+_wisdom = {}
+
+
+def _get_wisdom(key):
+    return _wisdom.get(key)
+
+
+def _add_wisdom(key, choice):
+    _wisdom[key] = choice
+
+
+def _entry_key(entry):
+    key = []
+    for field in _KEY_FIELDS:
+        value = entry[field]
+        key.append(tuple(value) if isinstance(value, list) else value)
+    return tuple(key)
+
+
+def export_wisdom():
+    """
+    The wisdom accumulated by `plan` with ``tune=True``, as a JSON string.
+
+    Each entry records, for a transform (wavelet, mode, shape, dtype, level,
+    axes, method and workers), the kernels that were fastest for the forward
+    and inverse transforms and the number of threads they use.
+
+    See Also
+    --------
+    import_wisdom, save_wisdom
+    """
+    entries = []
+    for key in sorted(_wisdom, key=repr):
+        entry = dict(zip(_KEY_FIELDS, key))
+        entry.update(_wisdom[key])
+        entries.append(entry)
+    return json.dumps({'version': _WISDOM_VERSION, 'entries': entries},
+                      indent=1, sort_keys=True)
+
+
+def import_wisdom(wisdom):
+    """
+    Add the entries of a JSON string of `export_wisdom` to the wisdom,
+    replacing those for the same transforms.
+
+    Raises ValueError if the string is not wisdom of this version of pywt,
+    without importing any of it.
+    """
+    try:
+        data = json.loads(wisdom)
+        if data['version'] != _WISDOM_VERSION:
+            raise ValueError("Unsupported wisdom version {}."
+                             .format(data['version']))
+        entries = dict((_entry_key(entry),
+                        dict((field, entry[field])
+                             for field in _CHOICE_FIELDS))
+                       for entry in data['entries'])
+    except (TypeError, KeyError) as e:
+        raise ValueError("Invalid wisdom: {}".format(e))
+    _wisdom.update(entries)
+
+
+def save_wisdom(filename):
+    """
+    Write the wisdom to a file, see `export_wisdom`.
+    """
+    with open(filename, 'w') as f:
+        f.write(export_wisdom())
+
+
+def load_wisdom(filename):
+    """
+    Add the wisdom of a file of `save_wisdom`, see `import_wisdom`.
+
+    The file named by the environment variable ``PYWT_WISDOM`` is loaded
+    when pywt is imported, if it exists.
+    """
+    with open(filename) as f:
+        import_wisdom(f.read())
+
+
+def forget_wisdom():
+    """
+    Forget all wisdom.
+    """
+    _wisdom.clear()
+
+
+def _load_environment_wisdom():
+    filename = os.environ.get('PYWT_WISDOM')
+    if filename and os.path.exists(filename):
+        try:
+            load_wisdom(filename)
+        except (ValueError, IOError) as e:
+            warnings.warn("Could not load the wisdom of PYWT_WISDOM={}: {}"
+                          .format(filename, e))
+
+
+_load_environment_wisdom()
@@ -3,14 +3,16 @@ from __future__ import division, print_function, absolute_import
 
 import numpy as np
 from numpy.testing import (run_module_suite, assert_allclose, assert_,
-                           assert_raises)
+                           assert_raises, assert_equal)
 
 import pywt
 
-# Check that float32 and complex64 are preserved.  Other real types get
-# converted to float64.
-dtypes_in = [np.int8, np.float32, np.float64, np.complex64, np.complex128]
-dtypes_out = [np.float64, np.float32, np.float64, np.complex64, np.complex128]
+# Check that float32 and complex64 are preserved and float16 gives float32.
+# Other real types get converted to float64.
+dtypes_in = [np.int8, np.uint8, np.int16, np.float16, np.float32, np.float64,
+             np.complex64, np.complex128]
+dtypes_out = [np.float64, np.float64, np.float64, np.float32, np.float32,
+              np.float64, np.complex64, np.complex128]
 
 
 def test_dwt_idwt_basic():
@@ -80,6 +82,62 @@ def test_dwt_idwt_partial_complex():
     assert_allclose(cA_rec + cD_rec, x)
 
 
+def test_dwt_idwt_complex_parts():
+    # complex data is transformed natively, along any axis and for any
+    # layout, as the real and imaginary parts would be
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(6, 9, 33) + 1j * rstate.randn(6, 9, 33)
+    layouts = [x, x[:, ::2], np.asfortranarray(x), x.transpose(2, 0, 1)]
+    for dtype, rtol in [(np.complex128, 1e-12), (np.complex64, 1e-5)]:
+        for y in layouts:
+            y = y.astype(dtype)
+            for axis in range(y.ndim):
+                for wavelet in ['haar', 'db3', 'bior3.5']:
+                    cA, cD = pywt.dwt(y, wavelet, axis=axis)
+                    assert_(cA.dtype == cD.dtype == dtype)
+                    for c, r, i in zip((cA, cD),
+                                       pywt.dwt(y.real, wavelet, axis=axis),
+                                       pywt.dwt(y.imag, wavelet, axis=axis)):
+                        assert_allclose(c, r + 1j * i, rtol=rtol, atol=rtol)
+                    for a, d in [(cA, cD), (cA, None), (None, cD),
+                                 (cA, cD.real)]:
+                        rec = pywt.idwt(a, d, wavelet, axis=axis)
+                        assert_(rec.dtype == dtype)
+                        parts = [pywt.idwt(None if a is None else a.real,
+                                           None if d is None else
+                                           np.real(d), wavelet, axis=axis),
+                                 pywt.idwt(None if a is None else a.imag,
+                                           None if d is None else
+                                           np.imag(d), wavelet, axis=axis)]
+                        assert_allclose(rec, parts[0] + 1j * parts[1],
+                                        rtol=rtol, atol=rtol)
+
+
+def test_dwt_cast_dtypes():
+    # narrow integer and float16 data is read directly, converting each
+    # element as the transform reads it, with the results of a converted copy
+    rstate = np.random.RandomState(1234)
+    for dtype in [np.uint8, np.int16, np.uint16, np.int32, np.float16, '>u2']:
+        dtype = np.dtype(dtype)
+        if dtype.kind == 'f':
+            x = (100 * rstate.randn(12, 9, 17)).astype(dtype)
+        else:
+            info = np.iinfo(dtype)
+            x = rstate.randint(info.min, info.max, (12, 9, 17)).astype(dtype)
+        x_float = x.astype(np.float32 if dtype.kind == 'f' else np.float64)
+        for y, y_float in [(x, x_float), (x[:, ::2], x_float[:, ::2]),
+                           (x.transpose(2, 0, 1), x_float.transpose(2, 0, 1))]:
+            for axis in range(y.ndim):
+                for wavelet in ['haar', 'db3']:
+                    for mode in ['symmetric', 'periodization']:
+                        cA, cD = pywt.dwt(y, wavelet, mode, axis=axis)
+                        cA_f, cD_f = pywt.dwt(y_float, wavelet, mode,
+                                              axis=axis)
+                        assert_(cA.dtype == cD.dtype == x_float.dtype)
+                        assert_equal(cA, cA_f)
+                        assert_equal(cD, cD_f)
+
+
 def test_dwt_wavelet_kwd():
     x = np.array([3, 7, 1, 1, -2, 5, 4, 6])
     w = pywt.Wavelet('sym3')
@@ -174,6 +232,49 @@ def test_idwt_axis_arg():
     assert_allclose(x_, x)
 
 
+def test_dwt_matches_downcoef():
+    # dwt computes both coefficients in one pass, downcoef one at a time, but
+    # results should be identical. Along a strided axis dwt works on tiles of
+    # rows, which only agrees up to rounding.
+    rstate = np.random.RandomState(1234)
+    for N in [1, 2, 5, 16, 41]:
+        for dtype, tol in [(np.float32, 1e-5), (np.float64, 1e-12)]:
+            x = rstate.randn(3, N).astype(dtype)
+            for wavelet in ['haar', 'db3', 'sym8']:
+                for mode in pywt.Modes.modes:
+                    if mode == 'reflect' and N == 1:
+                        continue
+                    cA, cD = pywt.dwt(x, wavelet, mode, axis=-1)
+                    cA_T, cD_T = pywt.dwt(x.T, wavelet, mode, axis=0)
+                    for row in range(x.shape[0]):
+                        a = pywt.downcoef('a', x[row], wavelet, mode)
+                        d = pywt.downcoef('d', x[row], wavelet, mode)
+                        assert_equal(cA[row], a)
+                        assert_equal(cD[row], d)
+                        assert_allclose(cA_T[:, row], a, rtol=tol, atol=tol)
+                        assert_allclose(cD_T[:, row], d, rtol=tol, atol=tol)
+
+
+def test_idwt_matches_partial_sums():
+    # idwt combines both subbands in one pass; this must match reconstructing
+    # each subband separately and adding the results
+    rstate = np.random.RandomState(1234)
+    for N in [1, 2, 5, 16, 41]:
+        x = rstate.randn(3, N)
+        for wavelet in ['haar', 'db2', 'db3', 'sym8']:
+            for mode in pywt.Modes.modes:
+                if mode == 'reflect' and N == 1:
+                    continue
+                cA, cD = pywt.dwt(x, wavelet, mode, axis=-1)
+                for axis, (a, d) in [(1, (cA, cD)), (0, (cA.T, cD.T))]:
+                    rec = pywt.idwt(a, d, wavelet, mode, axis=axis)
+                    expected = (pywt.idwt(a, None, wavelet, mode, axis=axis) +
+                                pywt.idwt(None, d, wavelet, mode, axis=axis))
+                    assert_allclose(rec, expected, rtol=1e-12, atol=1e-12)
+                    rec_1d = pywt.idwt(cA[0], cD[0], wavelet, mode)
+                    assert_allclose(rec_1d, np.take(rec, 0, axis=1 - axis))
+
+
 def test_dwt_idwt_axis_excess():
     x = [[3, 7, 1, 1],
          [-2, 5, 4, 6]]
@@ -185,5 +286,92 @@ def test_dwt_idwt_axis_excess():
                   pywt.idwt, [1, 2, 4], [4, 1, 3], 'db2', 'symmetric', axis=1)
 
 
+def test_dwt_idwt_out():
+    rstate = np.random.RandomState(1234)
+    for x in [rstate.randn(20), rstate.randn(6, 20).astype(np.float32),
+              rstate.randn(20, 6) + 1j * rstate.randn(20, 6)]:
+        for axis in range(x.ndim):
+            cA, cD = pywt.dwt(x, 'db2', axis=axis)
+            # the transposed arrays are not C-contiguous in 2D
+            out = (np.empty(cA.shape[::-1], cA.dtype).T,
+                   np.empty(cD.shape[::-1], cD.dtype).T)
+            cA_out, cD_out = pywt.dwt(x, 'db2', axis=axis, out=out)
+            assert_(cA_out is out[0] and cD_out is out[1])
+            assert_allclose(cA_out, cA, rtol=1e-6)
+            assert_allclose(cD_out, cD, rtol=1e-6)
+            # a None array is allocated
+            cA_out, cD_out = pywt.dwt(x, 'db2', axis=axis, out=(None, out[1]))
+            assert_allclose(cA_out, cA, rtol=1e-6)
+
+            rec = pywt.idwt(cA, cD, 'db2', axis=axis)
+            out = np.empty_like(rec)
+            assert_(pywt.idwt(cA, cD, 'db2', axis=axis, out=out) is out)
+            assert_allclose(out, rec, rtol=1e-6)
+            assert_(pywt.idwt(None, cD, 'db2', axis=axis, out=out) is out)
+            assert_allclose(out, pywt.idwt(None, cD, 'db2', axis=axis))
+
+    cA, cD = pywt.dwt(np.ones(8), 'db2')
+    assert_raises(ValueError, pywt.dwt, np.ones(8), 'db2',
+                  out=(np.empty(4), cD))
+    assert_raises(TypeError, pywt.dwt, np.ones(8), 'db2',
+                  out=(cA.astype(np.float32), cD))
+    assert_raises(ValueError, pywt.idwt, cA, cD, 'db2', out=np.empty(7))
+    out = np.empty(8)
+    out.flags.writeable = False
+    assert_raises(ValueError, pywt.idwt, cA, cD, 'db2', out=out)
+
+
+def test_dwt_idwt_out_overlap():
+    # the transforms would overwrite samples they have not read yet
+    buf = np.random.RandomState(1234).randn(64)
+    x = buf.copy()
+    assert_raises(ValueError, pywt.dwt, buf, 'db2', 'periodization',
+                  out=(buf[:32], buf[32:]))
+    assert_equal(buf, x)
+    out = np.empty(64)
+    assert_raises(ValueError, pywt.dwt, x, 'db2', 'periodization',
+                  out=(out[:32], out[16:48]))
+    data = np.ones((4, 64))
+    assert_raises(ValueError, pywt.dwt, data, 'db2', 'periodization',
+                  axis=1, out=(data[:, :32], data[:, 32:]))
+
+    cA, cD = pywt.dwt(x, 'db2', 'periodization')
+    buf = np.zeros(64)
+    buf[:32] = cA
+    assert_raises(ValueError, pywt.idwt, buf[:32], cD, 'db2',
+                  'periodization', out=buf)
+    assert_raises(ValueError, pywt.idwt, buf[None, :32], cD[None], 'db2',
+                  'periodization', axis=1, out=buf[None])
+    # separate arrays are accepted
+    out = (np.empty_like(cA), np.empty_like(cD))
+    assert_(pywt.dwt(x, 'db2', 'periodization', out=out)[0] is out[0])
+    assert_allclose(pywt.idwt(cA, cD, 'db2', 'periodization', out=buf), x,
+                    atol=1e-12)
+
+
+def test_downcoef_upcoef_out():
+    x = np.random.RandomState(1234).randn(50)
+    for level in [1, 3]:
+        for part in 'ad':
+            c = pywt.downcoef(part, x, 'db3', level=level)
+            out = np.empty_like(c)
+            assert_(pywt.downcoef(part, x, 'db3', level=level, out=out) is out)
+            assert_equal(out, c)
+
+            for take in [0, 40]:
+                rec = pywt.upcoef(part, c, 'db3', level=level, take=take)
+                out = np.full_like(rec, np.nan)
+                assert_(pywt.upcoef(part, c, 'db3', level=level, take=take,
+                                    out=out) is out)
+                assert_equal(out, rec)
+
+    c = pywt.downcoef('a', x + 1j * x, 'db3')
+    out = np.empty_like(c)
+    assert_(pywt.downcoef('a', x + 1j * x, 'db3', out=out) is out)
+    assert_equal(out, c)
+    assert_raises(ValueError, pywt.downcoef, 'a', x, 'db3',
+                  out=np.empty((c.size, 2))[:, 0])
+
+
 if __name__ == '__main__':
     run_module_suite()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python
+from __future__ import division, print_function, absolute_import
+
+import numpy as np
+from numpy.testing import (assert_raises, run_module_suite, assert_equal,
+                           assert_, assert_raises_regex)
+
+import pywt
+
+
+def _lift_1d(x, wavelet):
+    # the lifting steps of int_wavedecn, on the signal extended with
+    # np.pad(mode='reflect'), as [approximations, details]
+    N = x.size
+    if N < 2:
+        return x
+    xe = np.pad(x.astype(np.int64), 8, mode='reflect')
+    E, D = xe[0::2].copy(), xe[1::2].copy()
+    for m in range(1, D.size - 2):
+        if wavelet == '5/3':
+            D[m] -= (E[m] + E[m + 1]) >> 1
+        else:
+            D[m] -= (9 * (E[m] + E[m + 1]) - (E[m - 1] + E[m + 2]) + 8) >> 4
+    for m in range(2, E.size - 2):
+        E[m] += (D[m - 1] + D[m] + 2) >> 2
+    return np.concatenate([E[4:4 + (N + 1) // 2], D[4:4 + N // 2]])
+
+
+def _int_wavedecn_reference(x, wavelet, level):
+    # the packed array of int_wavedecn
+    x = x.astype(np.int64)
+    for l in range(level):
+        block = x[tuple(slice(-(-n // 2**l)) for n in x.shape)]
+        for axis in range(x.ndim):
+            block[...] = np.apply_along_axis(_lift_1d, axis, block, wavelet)
+    return x
+
+
+def test_int_wavedecn_reference():
+    rng = np.random.RandomState(1234)
+    for wavelet in ['5/3', '9/7-M']:
+        for shape in [(2,), (3,), (17,), (64,), (7, 9), (16, 33), (5, 12, 3),
+                      (3, 1, 40)]:
+            x = rng.randint(-2000, 2000, shape).astype(np.int16)
+            level = (min(shape) - 1).bit_length()
+            coeffs = pywt.int_wavedecn(x, wavelet, level=level)
+            assert_equal(len(coeffs), level + 1)
+            assert_equal(coeffs[0].base,
+                         _int_wavedecn_reference(x, wavelet, level))
+
+
+def test_int_wavedecn_constant():
+    # the lowpass filters have unit DC gain, the highpass filters none
+    x = np.full((12, 10), 100, dtype=np.int32)
+    for wavelet in ['5/3', '9/7-M']:
+        coeffs = pywt.int_wavedecn(x, wavelet, level=2)
+        assert_equal(coeffs[0], np.full((3, 3), 100))
+        for details in coeffs[1:]:
+            for c in details.values():
+                assert_equal(c, 0)
+
+
+def test_int_waverecn_exact():
+    rng = np.random.RandomState(1234)
+    for wavelet in ['5/3', '9/7-M']:
+        for dtype, high in [(np.int16, 2**12), (np.int32, 2**28)]:
+            for shape in [(1,), (31,), (64, 65), (9, 10, 11)]:
+                x = rng.randint(-high, high, shape).astype(dtype)
+                coeffs = pywt.int_wavedecn(x, wavelet)
+                assert_equal(coeffs[0].dtype, dtype)
+                y = pywt.int_waverecn(coeffs, wavelet)
+                assert_equal(y.dtype, dtype)
+                assert_equal(y, x)
+
+
+def test_int_wavedecn_dtypes():
+    # narrower integers are transformed in int16, uint16 in int32
+    for dtype_in, dtype_out in [(np.uint8, np.int16), (np.int8, np.int16),
+                                (np.bool_, np.int16), (np.uint16, np.int32)]:
+        x = (np.arange(60) % 7).astype(dtype_in).reshape(6, 10)
+        coeffs = pywt.int_wavedecn(x, level=2)
+        assert_equal(coeffs[0].dtype, dtype_out)
+        assert_equal(pywt.int_waverecn(coeffs), x)
+    for dtype in [np.float32, np.float64, np.int64, np.uint32]:
+        assert_raises(TypeError, pywt.int_wavedecn, np.ones(8, dtype))
+        assert_raises(TypeError, pywt.int_wavedecn, np.ones(8, dtype),
+                      inplace=True)
+    # the message names what is accepted, which excludes 32 bit unsigned
+    for dtype in [np.int64, np.uint32]:
+        assert_raises_regex(TypeError, "Expected int16, int32 or integer data "
+                            "of at most 16 bits", pywt.int_wavedecn,
+                            np.ones(8, dtype))
+
+
+def test_int_wavedecn_inplace():
+    rng = np.random.RandomState(1234)
+    x = rng.randint(-1000, 1000, (40, 30)).astype(np.int16)
+    for order in ['C', 'F']:
+        data = np.array(x, order=order)
+        coeffs = pywt.int_wavedecn(data, '9/7-M', level=3, inplace=True)
+        assert_(coeffs[0].base is data)
+        assert_equal(data, _int_wavedecn_reference(x, '9/7-M', 3))
+        y = pywt.int_waverecn(coeffs, '9/7-M', inplace=True)
+        assert_(np.shares_memory(y, data))
+        assert_equal(data, x)
+
+    # copies of the coefficients are not views of a packed array
+    coeffs = pywt.int_wavedecn(x, level=2)
+    coeffs[1] = dict((key, c.copy()) for key, c in coeffs[1].items())
+    assert_raises(ValueError, pywt.int_waverecn, coeffs, inplace=True)
+    assert_equal(pywt.int_waverecn(coeffs), x)
+
+
+def test_int_wavedecn_overflow():
+    x = np.full((16, 16), 32000, dtype=np.int16)
+    x[::2] = -32000
+    assert_raises(OverflowError, pywt.int_wavedecn, x, level=1)
+    # the same values fit in int32
+    coeffs = pywt.int_wavedecn(x.astype(np.int32), level=1)
+    assert_equal(pywt.int_waverecn(coeffs), x)
+
+
+def test_int_wavedecn_invalid():
+    x = np.ones((8, 8), dtype=np.int16)
+    assert_raises(ValueError, pywt.int_wavedecn, x, 'db2')
+    assert_raises(ValueError, pywt.int_wavedecn, x, level=4)
+    assert_raises(ValueError, pywt.int_wavedecn, x, level=-1)
+    assert_raises(ValueError, pywt.int_wavedecn, np.int16(1))
+    coeffs = pywt.int_wavedecn(x, level=2)
+    del coeffs[1]['dd']
+    assert_raises(ValueError, pywt.int_waverecn, coeffs)
+    coeffs = pywt.int_wavedecn(x, level=2)
+    coeffs[2]['ad'] = coeffs[2]['ad'][:, :3]
+    assert_raises(ValueError, pywt.int_waverecn, coeffs)
+
+
+def test_int_wavedecn_workers():
+    x = np.random.RandomState(1234).randint(-500, 500, (33, 70, 20))
+    x = x.astype(np.int32)
+    coeffs = pywt.int_wavedecn(x, level=3)
+    coeffs_threads = pywt.int_wavedecn(x, level=3, workers=4)
+    assert_equal(coeffs_threads[0].base, coeffs[0].base)
+    assert_equal(pywt.int_waverecn(coeffs_threads, workers=4), x)
+
+
+if __name__ == '__main__':
+    run_module_suite()
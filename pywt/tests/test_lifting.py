@@ -0,0 +1,178 @@
+#!/usr/bin/env python
+from __future__ import division, print_function, absolute_import
+
+import numpy as np
+from numpy.testing import (assert_raises, run_module_suite,
+                           assert_allclose, assert_)
+
+import pywt
+
+
+def _assert_close(actual, desired, rtol):
+    # the lifting schemes are as accurate as the tabulated filters, so compare
+    # relative to the largest coefficient
+    assert_allclose(actual, desired, rtol=0,
+                    atol=rtol * max(np.abs(desired).max(), 1))
+
+
+def test_lifting_scheme_families():
+    # the factorization of the longest filters is not numerically stable
+    unavailable = (['db%d' % n for n in range(19, 39)] +
+                   ['coif%d' % n for n in range(15, 18)])
+    for family in ['haar', 'db', 'sym', 'coif', 'bior', 'rbio']:
+        for name in pywt.wavelist(family):
+            scheme = pywt.Wavelet(name).lifting_scheme
+            assert_((scheme is None) == (name in unavailable), name)
+
+
+def test_lifting_scheme_unavailable():
+    assert_(pywt.Wavelet('dmey').lifting_scheme is None)
+    assert_(pywt.Wavelet('db20').lifting_scheme is None)
+    assert_raises(ValueError, pywt.dwt, np.ones(32), 'db20',
+                  method='lifting')
+    assert_raises(ValueError, pywt.idwt, np.ones(32), None, 'db20',
+                  method='lifting')
+    # 'auto' falls back to the convolution
+    cA, cD = pywt.dwt(np.ones(32), 'db20', method='auto')
+    assert_allclose(pywt.idwt(cA, cD, 'db20', method='auto')[:32],
+                    np.ones(32), rtol=1e-10)
+
+
+def test_lifting_scheme_cache():
+    # the cache of factorizations is bounded
+    from pywt._lifting import _cache, _CACHE_SIZE
+    dec_lo, dec_hi, rec_lo, rec_hi = pywt.Wavelet('db2').filter_bank
+    for i in range(_CACHE_SIZE + 10):
+        s = 1 + i / 1000
+        scheme = pywt.lifting_scheme([np.multiply(dec_lo, s),
+                                      np.multiply(dec_hi, s),
+                                      np.divide(rec_lo, s),
+                                      np.divide(rec_hi, s)])
+        assert_(scheme is not None)
+        assert_(len(_cache) <= _CACHE_SIZE)
+    # recently used schemes are kept
+    assert_(pywt.lifting_scheme([np.multiply(dec_lo, s),
+                                 np.multiply(dec_hi, s),
+                                 np.divide(rec_lo, s),
+                                 np.divide(rec_hi, s)]) is scheme)
+
+
+def test_lifting_invalid_method():
+    assert_raises(ValueError, pywt.dwt, np.ones(8), 'db2', method='unknown')
+    assert_raises(ValueError, pywt.idwtn, {'a': np.ones(8)}, 'db2',
+                  method='unknown')
+
+
+def test_lifting_dwt_idwt_matches_convolution():
+    rstate = np.random.RandomState(1234)
+    for dtype, rtol in [(np.float64, 1e-7), (np.float32, 1e-4)]:
+        # short inputs exercise the boundary handling on both sides at once
+        for N in [1, 2, 5, 16, 37, 600]:
+            x = rstate.randn(N).astype(dtype)
+            for wavelet in ['haar', 'db3', 'db10', 'sym7', 'coif4', 'bior1.3',
+                            'bior3.9', 'rbio2.8', 'rbio6.8']:
+                for mode in pywt.Modes.modes:
+                    cA, cD = pywt.dwt(x, wavelet, mode)
+                    cA_l, cD_l = pywt.dwt(x, wavelet, mode, method='lifting')
+                    assert_(cA_l.dtype == cA.dtype)
+                    _assert_close(cA_l, cA, rtol)
+                    _assert_close(cD_l, cD, rtol)
+
+                    if len(cA) < pywt.Wavelet(wavelet).rec_len // 2:
+                        continue
+                    for coeffs in [(cA, cD), (cA, None), (None, cD)]:
+                        expected = pywt.idwt(coeffs[0], coeffs[1], wavelet,
+                                             mode)
+                        rec = pywt.idwt(coeffs[0], coeffs[1], wavelet, mode,
+                                        method='lifting')
+                        assert_(rec.dtype == expected.dtype)
+                        _assert_close(rec, expected, rtol)
+
+
+def test_lifting_auto_accuracy():
+    # 'auto' reconstructs the long filters by lifting only with the scalar
+    # kernels, and only where it agrees with the convolution to within 1e-10
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(600)
+    default = pywt.get_simd()
+    try:
+        # the vectorized convolutions are faster
+        for variant in pywt.simd_variants():
+            if variant == 'none':
+                continue
+            pywt.set_simd(variant)
+            for name in ['sym12', 'coif4']:
+                cA, cD = pywt.dwt(x, name)
+                assert_(np.array_equal(pywt.idwt(cA, cD, name, method='auto'),
+                                       pywt.idwt(cA, cD, name)), name)
+        pywt.set_simd('none')
+        n_lifting = 0
+        for family in ['db', 'sym', 'coif']:
+            for name in pywt.wavelist(family):
+                cA, cD = pywt.dwt(x, name, 'smooth')
+                rec = pywt.idwt(cA, cD, name, 'smooth', method='auto')
+                expected = pywt.idwt(cA, cD, name, 'smooth')
+                if name in ['db14', 'db16']:
+                    # the lifting schemes differ by about 1e-8
+                    assert_(np.array_equal(rec, expected), name)
+                if np.array_equal(rec, expected):
+                    continue
+                n_lifting += 1
+                for mode in pywt.Modes.modes:
+                    cA, cD = pywt.dwt(x, name, mode)
+                    for coeffs in [(cA, cD), (cA, None), (None, cD)]:
+                        _assert_close(
+                            pywt.idwt(coeffs[0], coeffs[1], name, mode,
+                                      method='auto'),
+                            pywt.idwt(coeffs[0], coeffs[1], name, mode),
+                            1e-10)
+        assert_(n_lifting > 0)
+    finally:
+        pywt.set_simd(default)
+
+
+def test_lifting_axis():
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(24, 17, 30)
+    for axis in range(x.ndim):
+        for mode in ['periodization', 'symmetric']:
+            cA, cD = pywt.dwt(x, 'sym5', mode, axis=axis)
+            cA_l, cD_l = pywt.dwt(x, 'sym5', mode, axis=axis,
+                                  method='lifting')
+            _assert_close(cA_l, cA, 1e-8)
+            _assert_close(cD_l, cD, 1e-8)
+            _assert_close(pywt.idwt(cA, cD, 'sym5', mode, axis=axis,
+                                    method='lifting'),
+                          pywt.idwt(cA, cD, 'sym5', mode, axis=axis), 1e-8)
+
+
+def test_lifting_multilevel():
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(128, 128)
+    for method in ['lifting', 'auto']:
+        for wavelet in ['db2', 'db12', 'bior2.4']:
+            coeffs = pywt.wavedec2(x, wavelet, 'periodization', level=2,
+                                   method=method)
+            expected = pywt.wavedec2(x, wavelet, 'periodization', level=2)
+            _assert_close(coeffs[0], expected[0], 1e-8)
+            rec = pywt.waverec2(coeffs, wavelet, 'periodization',
+                                method=method)
+            assert_allclose(rec, x, atol=1e-8)
+
+            coeffs = pywt.wavedec(x[0], wavelet, 'symmetric', level=2,
+                                  method=method)
+            rec = pywt.waverec(coeffs, wavelet, 'symmetric', method=method)
+            assert_allclose(rec, x[0], atol=1e-8)
+
+
+def test_lifting_complex():
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(32) + 1j * rstate.randn(32)
+    cA, cD = pywt.dwt(x, 'db4', method='lifting')
+    expected = pywt.dwt(x, 'db4')
+    _assert_close(cA, expected[0], 1e-8)
+    assert_allclose(pywt.idwt(cA, cD, 'db4', method='lifting'), x, atol=1e-8)
+
+
+if __name__ == '__main__':
+    run_module_suite()
@@ -3,7 +3,7 @@ from __future__ import division, print_function, absolute_import
 
 import numpy as np
 from numpy.testing import (assert_raises, run_module_suite,
-                           assert_equal, assert_allclose)
+                           assert_equal, assert_allclose, assert_)
 
 import pywt
 
@@ -100,5 +100,93 @@ def test_default_mode():
     assert_allclose(pywt.idwt(cA, cD, 'db2'), x)
 
 
+def test_pad_matches_numpy():
+    numpy_modes = {'zero': 'constant', 'constant': 'edge',
+                   'symmetric': 'symmetric', 'reflect': 'reflect'}
+    rstate = np.random.RandomState(1234)
+    for shape in [(7, ), (5, 6), (3, 4, 5), (2, 3, 1, 4)]:
+        x = rstate.randn(*shape)
+        pad_widths = [(i % 3, (2*i + 5) % 7) for i in range(len(shape))]
+        for mode, numpy_mode in numpy_modes.items():
+            assert_equal(pywt.pad(x, pad_widths, mode),
+                         np.pad(x, pad_widths, numpy_mode))
+    assert_equal(pywt.pad(x, 2, 'symmetric'), np.pad(x, 2, 'symmetric'))
+    assert_equal(pywt.pad(x, (1, 2), 'zero'), np.pad(x, (1, 2), 'constant'))
+
+
+def test_pad_modes():
+    x = np.array([1., 2., 4.])
+    assert_allclose(pywt.pad(x, (2, 3), 'smooth'),
+                    [-1, 0, 1, 2, 4, 6, 8, 10])
+    assert_allclose(pywt.pad(x, (4, 4), 'periodic'),
+                    [4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1])
+    # odd lengths are extended with the last value
+    assert_allclose(pywt.pad(x, (2, 3), 'periodization'),
+                    [4, 4, 1, 2, 4, 4, 1, 2])
+
+    # separable: the same as padding along each axis in turn
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(5, 6, 4)
+    pad_widths = [(2, 1), (3, 2), (9, 1)]
+    for mode in pywt.Modes.modes:
+        expected = x
+        for axis, widths in enumerate(pad_widths):
+            expected = np.apply_along_axis(pywt.pad, axis, expected,
+                                           widths, mode)
+        assert_allclose(pywt.pad(x, pad_widths, mode), expected,
+                        rtol=1e-14, atol=1e-14)
+
+
+def test_pad_dtypes():
+    for dtype, expected in [(np.float32, np.float32), (np.int8, np.float64),
+                            (np.complex64, np.complex64)]:
+        x = np.arange(4).astype(dtype)
+        xp = pywt.pad(x, 2, 'periodic')
+        assert_equal(xp.dtype, expected)
+        assert_allclose(xp, [2, 3, 0, 1, 2, 3, 0, 1])
+    xp = pywt.pad([1 + 2j, 3], 1, 'symmetric')
+    assert_allclose(xp, [1 + 2j, 1 + 2j, 3, 3])
+
+
+def test_pad_invalid():
+    assert_raises(ValueError, pywt.pad, 3., 1, 'zero')
+    assert_raises(ValueError, pywt.pad, np.ones((0, 3)), 1, 'zero')
+    assert_raises(ValueError, pywt.pad, [1, 2], -1, 'zero')
+    assert_raises(ValueError, pywt.pad, [1, 2], 1.5, 'zero')
+    assert_raises(ValueError, pywt.pad, [1, 2], 1, 'unknown')
+    # empty axes can be kept as they are
+    assert_equal(pywt.pad(np.ones((0, 3)), [(0, 0), (1, 1)], 'zero').shape,
+                 (0, 5))
+
+
+def test_boundary_strategy():
+    assert_equal(pywt.get_boundary_strategy(), 'inline')
+    assert_raises(ValueError, pywt.set_boundary_strategy, 'unknown')
+    rstate = np.random.RandomState(1234)
+    try:
+        for dtype, rtol in [(np.float64, 1e-12), (np.float32, 1e-5)]:
+            # signals shorter than, and exceeding, the filters
+            for N in [1, 2, 5, 16, 67]:
+                x = rstate.randn(2, N).astype(dtype)
+                for wavelet in ['haar', 'db4', 'bior3.9', 'db20']:
+                    for mode in pywt.Modes.modes:
+                        pywt.set_boundary_strategy('inline')
+                        expected = pywt.dwt(x, wavelet, mode)
+                        expected_d = pywt.downcoef('d', x[0], wavelet, mode)
+                        pywt.set_boundary_strategy('padded')
+                        assert_equal(pywt.get_boundary_strategy(), 'padded')
+                        cA, cD = pywt.dwt(x, wavelet, mode)
+                        # relative to the magnitude of the extended signal
+                        atol = rtol * np.abs(pywt.pad(x, 40, mode)).max()
+                        assert_allclose(cA, expected[0], rtol=rtol, atol=atol)
+                        assert_allclose(cD, expected[1], rtol=rtol, atol=atol)
+                        assert_allclose(
+                            pywt.downcoef('d', x[0], wavelet, mode),
+                            expected_d, rtol=rtol, atol=atol)
+    finally:
+        pywt.set_boundary_strategy('inline')
+    assert_(pywt.get_boundary_strategy() == 'inline')
+
+
 if __name__ == '__main__':
     run_module_suite()
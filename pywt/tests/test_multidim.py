@@ -9,10 +9,12 @@ from numpy.testing import (run_module_suite, assert_allclose, assert_,
 
 import pywt
 
-# Check that float32 and complex64 are preserved.  Other real types get
-# converted to float64.
-dtypes_in = [np.int8, np.float32, np.float64, np.complex64, np.complex128]
-dtypes_out = [np.float64, np.float32, np.float64, np.complex64, np.complex128]
+# Check that float32 and complex64 are preserved and float16 gives float32.
+# Other real types get converted to float64.
+dtypes_in = [np.int8, np.uint8, np.int16, np.float16, np.float32, np.float64,
+             np.complex64, np.complex128]
+dtypes_out = [np.float64, np.float64, np.float64, np.float32, np.float32,
+              np.float64, np.complex64, np.complex128]
 
 
 def test_dwtn_input():
@@ -318,6 +320,38 @@ def test_dwtn_idwtn_dtypes():
         assert_(x_roundtrip.dtype == dt_out, "idwtn: " + errmsg)
 
 
+def test_dwtn_idwtn_out():
+    x = np.random.RandomState(1234).randn(9, 12, 5)
+    for axes in [None, (0, 2), (1, )]:
+        coeffs = pywt.dwtn(x, 'db2', axes=axes)
+        out = dict((k, np.empty_like(v)) for k, v in coeffs.items())
+        # missing keys are allocated
+        key_a = 'a' * len(next(iter(coeffs)))
+        del out[key_a]
+        coeffs_out = pywt.dwtn(x, 'db2', axes=axes, out=out)
+        for k, v in coeffs.items():
+            assert_equal(coeffs_out[k], v)
+            assert_(k == key_a or coeffs_out[k] is out[k])
+        assert_raises(ValueError, pywt.dwtn, x, 'db2', axes=axes,
+                      out={key_a: coeffs[key_a][:-1]})
+
+        rec = pywt.idwtn(coeffs, 'db2', axes=axes)
+        out = np.empty(rec.shape[::-1]).T
+        assert_(pywt.idwtn(coeffs, 'db2', axes=axes, out=out) is out)
+        assert_allclose(out, rec, rtol=1e-12)
+
+    # dwt2 and idwt2 write to arrays in the format of their results
+    x = x[:8, :, 0]
+    cA, (cH, cV, cD) = pywt.dwt2(x, 'db2')
+    out = (np.empty_like(cA), tuple(np.empty_like(c) for c in (cH, cV, cD)))
+    coeffs_out = pywt.dwt2(x, 'db2', out=out)
+    assert_(coeffs_out[0] is out[0] and coeffs_out[1][2] is out[1][2])
+    assert_equal(out[1][0], cH)
+    rec = np.empty_like(x)
+    assert_(pywt.idwt2(out, 'db2', out=rec) is rec)
+    assert_allclose(rec, x, rtol=1e-12)
+
+
 def test_idwt2_size_mismatch_error():
     LL = np.zeros((6, 6))
     LH = HL = HH = np.zeros((5, 5))
@@ -2,6 +2,8 @@
 
 from __future__ import division, print_function, absolute_import
 
+from itertools import product
+
 import numpy as np
 from numpy.testing import (run_module_suite, assert_almost_equal,
                            assert_allclose, assert_, assert_equal,
@@ -9,10 +11,12 @@ from numpy.testing import (run_module_suite, assert_almost_equal,
 
 import pywt
 
-# Check that float32 and complex64 are preserved.  Other real types get
-# converted to float64.
-dtypes_in = [np.int8, np.float32, np.float64, np.complex64, np.complex128]
-dtypes_out = [np.float64, np.float32, np.float64, np.complex64, np.complex128]
+# Check that float32 and complex64 are preserved and float16 gives float32.
+# Other real types get converted to float64.
+dtypes_in = [np.int8, np.uint8, np.int16, np.float16, np.float32, np.float64,
+             np.complex64, np.complex128]
+dtypes_out = [np.float64, np.float64, np.float64, np.float32, np.float32,
+              np.float64, np.complex64, np.complex128]
 
 
 # tolerances used in accuracy comparisons
@@ -86,6 +90,51 @@ def test_waverec_complex():
     assert_allclose(pywt.waverec(coeffs, 'db1'), x, rtol=1e-12)
 
 
+def test_wavedec_complex_parts():
+    # all levels of complex data in a single call, as for the real and
+    # imaginary parts
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(101) + 1j * rstate.randn(101)
+    for dtype, rtol in [(np.complex128, 1e-12), (np.complex64, 1e-5)]:
+        y = x.astype(dtype)
+        for wavelet, level in [('db2', 4), ('sym9', 2), ('db20', 1)]:
+            for mode in ['symmetric', 'periodization']:
+                coeffs = pywt.wavedec(y, wavelet, mode, level=level)
+                real = pywt.wavedec(y.real, wavelet, mode, level=level)
+                imag = pywt.wavedec(y.imag, wavelet, mode, level=level)
+                for c, r, i in zip(coeffs, real, imag):
+                    assert_(c.dtype == dtype)
+                    assert_allclose(c, r + 1j * i, rtol=rtol, atol=rtol)
+                rec = pywt.waverec(coeffs, wavelet, mode)
+                assert_(rec.dtype == dtype)
+                assert_allclose(rec, pywt.waverec(real, wavelet, mode) +
+                                1j * pywt.waverec(imag, wavelet, mode),
+                                rtol=rtol, atol=rtol)
+
+
+def test_wavedec_cast_dtypes():
+    # narrow integer and float16 data is read directly by the first level,
+    # with the results of a converted copy
+    rstate = np.random.RandomState(1234)
+    for dtype in [np.uint8, np.int16, np.uint16, np.int32, np.float16]:
+        x = (100 * rstate.randn(40, 300)).astype(dtype)
+        x_float = x.astype(np.float32 if dtype == np.float16 else np.float64)
+        for wavelet, level in [('db2', 3), ('sym8', 1)]:
+            coeffs = pywt.wavedec(x, wavelet, level=level)
+            for c, c_f in zip(coeffs, pywt.wavedec(x_float, wavelet,
+                                                   level=level)):
+                assert_(c.dtype == x_float.dtype)
+                assert_equal(c, c_f)
+            for y, y_float in [(x, x_float), (x[0], x_float[0])]:
+                coeffs = pywt.wavedecn(y, wavelet, level=level)
+                coeffs_f = pywt.wavedecn(y_float, wavelet, level=level)
+                assert_equal(coeffs[0], coeffs_f[0])
+                for d, d_f in zip(coeffs[1:], coeffs_f[1:]):
+                    for key in d:
+                        assert_(d[key].dtype == x_float.dtype)
+                        assert_equal(d[key], d_f[key])
+
+
 def test_multilevel_dtypes_1d():
     # only checks that the result is of the expected type
     wavelet = pywt.Wavelet('haar')
@@ -111,6 +160,38 @@ def test_waverec_all_wavelets_modes():
             assert_allclose(pywt.waverec(coeffs, wavelet, mode=mode),
                             r, rtol=tol_single, atol=tol_single)
 
+def test_wavedec_waverec_match_dwt_loop():
+    # all levels run in a single call, which must give the same results as
+    # applying dwt/idwt one level at a time
+    rstate = np.random.RandomState(1234)
+    for N in [5, 37, 100]:
+        for dtype in [np.float32, np.float64]:
+            x = rstate.randn(2, N).astype(dtype)
+            for wavelet in ['haar', 'db3', 'bior2.2']:
+                for mode in pywt.Modes.modes:
+                    for method in ['convolution', 'lifting']:
+                        coeffs = pywt.wavedec(x, wavelet, mode,
+                                              method=method)
+                        a = x
+                        for d in coeffs[:0:-1]:
+                            a, d_expect = pywt.dwt(a, wavelet, mode,
+                                                   method=method)
+                            assert_equal(d, d_expect)
+                        assert_equal(coeffs[0], a)
+
+                        rec = pywt.waverec(coeffs, wavelet, mode,
+                                           method=method)
+                        a = coeffs[0]
+                        for d in coeffs[1:]:
+                            if a.shape[-1] == d.shape[-1] + 1:
+                                a = a[..., :-1]
+                            a = pywt.idwt(a, d, wavelet, mode, method=method)
+                        assert_equal(rec, a)
+                        if mode != 'periodization':
+                            assert_allclose(rec[:, :N], x, rtol=1e-4,
+                                            atol=1e-4)
+
+
 ####
 # 1d multilevel swt tests
 ####
@@ -169,6 +250,44 @@ def test_swt_iswt_integration():
         assert_allclose(Y, X, rtol=1e-5, atol=1e-7)
 
 
+def test_swt_upsampled_filters():
+    # swt at level j is the periodic convolution with the filters upsampled
+    # by 2**(j-1), also when these are longer than the signal
+    rstate = np.random.RandomState(1234)
+    for wavelet in ['haar', 'db3', 'sym6', 'bior2.8']:
+        w = pywt.Wavelet(wavelet)
+        for N in [8, 48, 128]:
+            x = rstate.randn(N)
+            level = pywt.swt_max_level(N)
+            coeffs = pywt.swt(x, w, level)
+            cA = x
+            for j in range(1, level + 1):
+                step = 2**(j - 1)
+                expected = []
+                for filt in [w.dec_lo, w.dec_hi]:
+                    F = len(filt)
+                    taps = [(filt[k], step * (F // 2 - k)) for k in range(F)]
+                    expected.append([sum(f * cA[(o + s) % N] for f, s in taps)
+                                     for o in range(N)])
+                assert_allclose(coeffs[level - j][0], expected[0],
+                                rtol=1e-12, atol=1e-12)
+                assert_allclose(coeffs[level - j][1], expected[1],
+                                rtol=1e-12, atol=1e-12)
+                cA = coeffs[level - j][0]
+
+            assert_allclose(pywt.iswt(coeffs, w), x, rtol=1e-10, atol=1e-10)
+
+
+def test_iswt_dtypes():
+    wavelet = pywt.Wavelet('db2')
+    for dt_in, dt_out in zip(dtypes_in, dtypes_out):
+        errmsg = "wrong dtype returned for {0} input".format(dt_in)
+        x = np.arange(16).astype(dt_in)
+        y = pywt.iswt(pywt.swt(x, wavelet, level=2), wavelet)
+        assert_(y.dtype == dt_out, "iswt: " + errmsg)
+        assert_allclose(y, x, rtol=1e-5, atol=1e-5)
+
+
 def test_swt_dtypes():
     wavelet = pywt.Wavelet('haar')
     for dt_in, dt_out in zip(dtypes_in, dtypes_out):
@@ -187,6 +306,44 @@ def test_swt_dtypes():
                 "swt2: " + errmsg)
 
 
+def test_swt_out():
+    x = np.random.RandomState(1234).randn(32)
+    for data in [x, x.astype(np.float32), x + 1j * x[::-1]]:
+        coeffs = pywt.swt(data, 'db2', level=3)
+        out = [tuple(np.empty_like(c) for c in pair) for pair in coeffs]
+        coeffs_out = pywt.swt(data, 'db2', level=3, out=out)
+        for pair, pair_out, pair_expected in zip(coeffs_out, out, coeffs):
+            for c, c_out, c_expected in zip(pair, pair_out, pair_expected):
+                assert_(c is c_out)
+                assert_equal(c, c_expected)
+    assert_raises(ValueError, pywt.swt, x, 'db2', level=3, out=out[:2])
+
+
+def test_swt_single_block():
+    # all levels are written to one (level, 2, N) array in a single call
+    x = np.random.RandomState(1234).randn(64)
+    for data in [x, x.astype(np.float32), x + 1j * x[::-1]]:
+        coeffs = pywt.swt(data, 'sym4', level=3, start_level=1)
+        block = coeffs[0][0].base
+        assert_equal(block.shape, (3, 2, 64))
+        for k, (cA, cD) in enumerate(coeffs):
+            assert_(cA.base is block and cD.base is block)
+            assert_equal(block[k], [cA, cD])
+        # the same levels as decomposing one level at a time
+        a = data
+        for k, j in enumerate(range(1, 4)):
+            expected = pywt.swt(a, 'sym4', level=1, start_level=j)[0]
+            assert_allclose(coeffs[2 - k][0], expected[0], atol=1e-5)
+            assert_allclose(coeffs[2 - k][1], expected[1], atol=1e-5)
+            a = coeffs[2 - k][0]
+
+    coeffs = pywt.swt(x, 'db2', level=4)
+    assert_allclose(pywt.iswt(coeffs, 'db2'), x, atol=1e-12)
+    coeffs[1] = (coeffs[1][0], coeffs[1][1][:32])
+    assert_raises(ValueError, pywt.iswt, coeffs, 'db2')
+    assert_raises(ValueError, pywt.iswt, [(x[:63], x[:63])], 'db2')
+
+
 def test_swt2_ndim_error():
     x = np.ones(8)
     assert_raises(ValueError, pywt.swt2, x, 'haar', level=1)
@@ -223,6 +380,149 @@ def test_swt2_iswt2_integration():
 ####
 
 
+def test_swtn_iswtn():
+    # the separable 1D swt along each axis, at any strides
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(16, 8, 32)
+    for data in [x, np.asfortranarray(x), x.astype(np.float32),
+                 x + 1j * x[::-1]]:
+        for axes in [None, (0,), (2, 0), (-1, 1)]:
+            coeffs = pywt.swtn(data, 'sym3', level=2, axes=axes)
+            n = len(axes) if axes is not None else 3
+            assert_equal(len(coeffs), 2)
+            assert_equal(sorted(coeffs[0]),
+                         sorted(''.join(k) for k in product('ad', repeat=n)))
+            y = pywt.iswtn(coeffs, 'sym3', axes=axes)
+            assert_equal(y.dtype, coeffs[0]['a' * n].dtype)
+            assert_allclose(y, data, atol=1e-5)
+
+    coeffs = pywt.swtn(x, 'db2', level=1, start_level=1, axes=(1, 2))
+    rows = pywt.swtn(x, 'db2', level=1, start_level=1, axes=(1,))[0]['d'][4]
+    assert_allclose(coeffs[0]['dd'][4],
+                    [pywt.swt(row, 'db2', level=1, start_level=1)[0][1]
+                     for row in rows], atol=1e-12)
+    # all levels in one array
+    coeffs = pywt.swtn(x, 'db2', level=2, axes=(1, 2))
+    # all levels in one array
+    block = coeffs[0]['aa'].base
+    assert_equal(block.shape, (2, 4) + x.shape)
+    assert_(all(c.base is block for d in coeffs for c in d.values()))
+
+
+def test_swtn_out():
+    x = np.random.RandomState(1234).randn(16, 24)
+    coeffs = pywt.swtn(x, 'db2', level=3)
+    out = [dict((k, np.empty_like(c)) for k, c in d.items()) for d in coeffs]
+    # arrays of any strides
+    out[1]['ad'] = np.empty((24, 16)).T
+    coeffs_out = pywt.swtn(x, 'db2', level=3, out=out)
+    for d, d_out, d_expected in zip(coeffs_out, out, coeffs):
+        for k in d:
+            assert_(d[k] is d_out[k])
+            assert_allclose(d[k], d_expected[k], atol=1e-12)
+    assert_raises(ValueError, pywt.swtn, x, 'db2', level=3, out=out[:2])
+
+
+def test_swtn_iswtn_errors():
+    x = np.ones((16, 12))
+    # 12 is divisible by 2**2 only
+    assert_raises(ValueError, pywt.swtn, x, 'db1', level=3)
+    assert_raises(ValueError, pywt.swtn, x, 'db1', level=2, start_level=1)
+    assert_raises(ValueError, pywt.swtn, x, 'db1', level=1, axes=(2,))
+    assert_equal(len(pywt.swtn(x, 'db1', axes=(0,))), 4)
+    coeffs = pywt.swtn(x, 'db1', level=2)
+    assert_raises(ValueError, pywt.iswtn, coeffs, 'db1', axes=(0,))
+    bad = [dict(d) for d in coeffs]
+    bad[1]['dd'] = bad[1]['dd'][:8]
+    assert_raises(ValueError, pywt.iswtn, bad, 'db1')
+    bad = [dict(d) for d in coeffs]
+    del bad[1]['ad']
+    assert_raises(ValueError, pywt.iswtn, bad, 'db1')
+    bad = [dict(d) for d in coeffs]
+    del bad[0]['aa']
+    assert_raises(ValueError, pywt.iswtn, bad, 'db1')
+
+
+def test_iswt2_non_square():
+    x = np.random.RandomState(1234).randn(16, 40)
+    coeffs = pywt.swt2(x, 'db2', level=3)
+    assert_allclose(pywt.iswt2(coeffs, 'db2'), x, atol=1e-12)
+
+
+def test_modwt_swt():
+    # for lengths divisible by 2**level, the SWT rescaled and shifted
+    x = np.random.RandomState(1234).randn(64)
+    for wavelet in ['db1', 'db2', 'sym4', 'bior2.2']:
+        F = pywt.Wavelet(wavelet).dec_len
+        coeffs_swt = pywt.swt(x, wavelet, level=3)
+        coeffs = pywt.modwt(x, wavelet, level=3)
+        for j, pair, pair_swt in zip([3, 2, 1], coeffs, coeffs_swt):
+            for c, c_swt in zip(pair, pair_swt):
+                assert_allclose(c, np.roll(c_swt / np.sqrt(2)**j,
+                                           (2**j - 1) * (F // 2)),
+                                atol=1e-12)
+        assert_allclose(pywt.imodwt(coeffs, wavelet), x, atol=1e-12)
+
+
+def test_modwt_imodwt_any_length():
+    rng = np.random.RandomState(1234)
+    for N in [3, 7, 13, 100]:
+        x = rng.randn(N)
+        for wavelet in ['db1', 'db3', 'sym5', 'bior3.5']:
+            coeffs = pywt.modwt(x, wavelet)
+            assert_equal(len(coeffs), pywt.modwt_max_level(N))
+            assert_allclose(pywt.imodwt(coeffs, wavelet), x, atol=1e-12)
+            if pywt.Wavelet(wavelet).orthogonal:
+                # the energy is preserved
+                energy = (np.sum(coeffs[0][0]**2) +
+                          sum(np.sum(cD**2) for _, cD in coeffs))
+                assert_allclose(energy, np.sum(x**2))
+
+
+def test_modwt_axis():
+    x = np.random.RandomState(1234).randn(9, 11, 6)
+    for dtype in [np.float64, np.float32, np.complex128]:
+        data = x.astype(dtype)
+        if np.iscomplexobj(data):
+            data = data + 1j * x[::-1]
+        for axis in [0, 1, -1]:
+            coeffs = pywt.modwt(data, 'db2', level=2, axis=axis, workers=2)
+            assert_equal(coeffs[0][0].dtype, data.dtype)
+            assert_equal(coeffs[0][0].base.shape, (2, 2) + data.shape)
+            expected = np.apply_along_axis(
+                lambda v: pywt.modwt(v, 'db2', level=2)[1][1], axis, data)
+            rtol = 1e-5 if dtype == np.float32 else 1e-7
+            assert_allclose(coeffs[1][1], expected, rtol=rtol, atol=rtol)
+            assert_allclose(pywt.imodwt(coeffs, 'db2', axis=axis), data,
+                            rtol=rtol, atol=rtol)
+
+
+def test_modwt_out():
+    x = np.random.RandomState(1234).randn(15, 10)
+    coeffs = pywt.modwt(x, 'db2', level=3, axis=0)
+    out = [tuple(np.empty_like(c) for c in pair) for pair in coeffs]
+    # arrays of any strides
+    out[1] = (np.empty((10, 15)).T, out[1][1])
+    coeffs_out = pywt.modwt(x, 'db2', level=3, axis=0, out=out)
+    for pair, pair_out, pair_expected in zip(coeffs_out, out, coeffs):
+        for c, c_out, c_expected in zip(pair, pair_out, pair_expected):
+            assert_(c is c_out)
+            assert_allclose(c, c_expected, atol=1e-12)
+    assert_raises(ValueError, pywt.modwt, x, 'db2', level=3, out=out[:2])
+
+
+def test_modwt_imodwt_errors():
+    x = np.ones((7, 4))
+    assert_raises(ValueError, pywt.modwt, x, 'db1', level=3, axis=0)
+    assert_raises(ValueError, pywt.modwt, x, 'db1', level=0)
+    assert_raises(ValueError, pywt.modwt, x, 'db1', axis=2)
+    coeffs = pywt.modwt(x, 'db1', level=2, axis=0)
+    assert_raises(ValueError, pywt.imodwt, [], 'db1')
+    assert_raises(ValueError, pywt.imodwt, coeffs, 'db1', axis=2)
+    bad = [coeffs[0], (coeffs[1][0], coeffs[1][1][:5])]
+    assert_raises(ValueError, pywt.imodwt, bad, 'db1', axis=0)
+
+
 def test_waverec2_accuracies():
     rstate = np.random.RandomState(1234)
     x0 = rstate.randn(4, 4)
@@ -395,6 +695,87 @@ def test_waverecn_accuracies():
         assert_allclose(pywt.waverecn(coeffs, 'db1'), x, atol=tol, rtol=tol)
 
 
+def test_wavedecn_waverecn_match_dwtn_loop():
+    # all axes and levels are transformed in a single call, which must agree
+    # with applying dwtn/idwtn one level at a time
+    rstate = np.random.RandomState(1234)
+    for shape in [(41,), (20, 27), (21, 24, 20), (10, 11, 12, 13)]:
+        for dtype, tol in [(np.float32, 1e-5), (np.float64, 1e-12)]:
+            x = rstate.randn(*shape).astype(dtype)
+            for wavelet in ['haar', 'db3', 'bior2.2']:
+                level = min(2, pywt.dwt_max_level(min(shape),
+                                                  pywt.Wavelet(wavelet).dec_len))
+                for mode in pywt.Modes.modes:
+                    coeffs = pywt.wavedecn(x, wavelet, mode, level=level)
+                    a = x
+                    for d in coeffs[:0:-1]:
+                        d_expect = pywt.dwtn(a, wavelet, mode)
+                        a = d_expect.pop('a' * x.ndim)
+                        for key in d_expect:
+                            assert_equal(d[key].dtype, dtype)
+                            assert_allclose(d[key], d_expect[key], rtol=tol,
+                                            atol=tol * np.abs(a).max())
+                    assert_allclose(coeffs[0], a, rtol=tol,
+                                    atol=tol * np.abs(a).max())
+
+                    rec = pywt.waverecn(coeffs, wavelet, mode)
+                    a = coeffs[0]
+                    for d in coeffs[1:]:
+                        a = a[tuple(slice(s) for s in d['d' * x.ndim].shape)]
+                        d = dict(d, **{'a' * x.ndim: a})
+                        a = pywt.idwtn(d, wavelet, mode)
+                    assert_equal(rec.dtype, dtype)
+                    assert_allclose(rec, a, rtol=tol,
+                                    atol=tol * np.abs(a).max())
+
+
+def test_wavedecn_noncontiguous():
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(24, 20, 16)
+    for xt in [x.T, x[::2, :, 1:]]:
+        coeffs = pywt.wavedecn(xt, 'db2', level=2)
+        coeffs_c = pywt.wavedecn(np.ascontiguousarray(xt), 'db2', level=2)
+        assert_equal(coeffs[0], coeffs_c[0])
+        for d, d_c in zip(coeffs[1:], coeffs_c[1:]):
+            for key in d:
+                assert_equal(d[key], d_c[key])
+
+
+def test_waverecn_missing_details():
+    # missing details are treated as zeros
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(16, 24, 20)
+    coeffs = pywt.wavedecn(x, 'db2', level=2)
+    zeros = [coeffs[0]] + [dict(d) for d in coeffs[1:]]
+    for key in ['ada', 'dda']:
+        del coeffs[1][key]
+        zeros[1][key] = np.zeros_like(zeros[1][key])
+    del coeffs[2]['ddd']
+    zeros[2]['ddd'] = np.zeros_like(zeros[2]['ddd'])
+    assert_allclose(pywt.waverecn(coeffs, 'db2'), pywt.waverecn(zeros, 'db2'),
+                    rtol=1e-12, atol=1e-12)
+
+    # a missing approximation is also zero
+    coeffs[0] = None
+    zeros[0] = np.zeros_like(zeros[0])
+    assert_allclose(pywt.waverecn(coeffs, 'db2'), pywt.waverecn(zeros, 'db2'),
+                    rtol=1e-12, atol=1e-12)
+
+
+def test_wavedecn_peak_memory():
+    shape = (64, 64, 64)
+    nbytes = 8 * np.prod(shape)
+    for inverse in [False, True]:
+        peak = pywt.wavedecn_peak_memory(shape, 'db2', level=3,
+                                         inverse=inverse)
+        # the outputs plus a small workspace
+        assert_(nbytes < peak < 1.5 * nbytes)
+        peak32 = pywt.wavedecn_peak_memory(shape, 'db2', level=3,
+                                           dtype=np.float32, inverse=inverse)
+        assert_(peak32 < peak)
+    assert_raises(ValueError, pywt.wavedecn_peak_memory, (), 'db2')
+
+
 def test_multilevel_dtypes_nd():
     wavelet = pywt.Wavelet('haar')
     for dt_in, dt_out in zip(dtypes_in, dtypes_out):
@@ -424,6 +805,155 @@ def test_waverecn_dtypes():
         assert_allclose(pywt.waverecn(coeffs, 'db1'), x, atol=tol, rtol=tol)
 
 
+def test_wavedecn_inplace():
+    rstate = np.random.RandomState(1234)
+    for dtype, tol in [(np.float32, tol_single), (np.float64, tol_double)]:
+        for method in ['convolution', 'lifting']:
+            for shape in [(64, ), (32, 48), (16, 40, 24)]:
+                x = rstate.randn(*shape).astype(dtype)
+                expected = pywt.wavedecn(x, 'db2', 'periodization', level=2,
+                                         method=method)
+                data = np.asfortranarray(x) if len(shape) > 2 else x.copy()
+                coeffs = pywt.wavedecn(data, 'db2', 'periodization',
+                                       level=2, method=method, inplace=True)
+                # views of data, in the layout of coeffs_to_array
+                assert_(coeffs[0].base is data)
+                assert_allclose(coeffs[0], expected[0], atol=tol)
+                for details, details_expected in zip(coeffs[1:],
+                                                     expected[1:]):
+                    for key, c in details.items():
+                        assert_(c.base is data)
+                        assert_allclose(c, details_expected[key], atol=tol)
+                y = pywt.waverecn(coeffs, 'db2', 'periodization',
+                                  method=method, inplace=True)
+                assert_(np.shares_memory(y, data))
+                assert_allclose(data, x, atol=4*tol)
+
+
+def test_wavedec_inplace():
+    # along the last axis
+    x = np.random.RandomState(1234).randn(64, 128)
+    data = x.copy()
+    coeffs = pywt.wavedec(data, 'sym4', 'periodization', level=3,
+                          inplace=True)
+    expected = pywt.wavedec(x, 'sym4', 'periodization', level=3)
+    assert_equal(len(coeffs), len(expected))
+    for c, c_expected in zip(coeffs, expected):
+        assert_(c.base is data)
+        assert_allclose(c, c_expected, atol=tol_double)
+    pywt.waverec(coeffs, 'sym4', 'periodization', inplace=True)
+    assert_allclose(data, x, atol=tol_double)
+
+
+def test_wavedecn_inplace_invalid():
+    x = np.ones((16, 24))
+    # the coefficients only fit in place with periodization
+    assert_raises(ValueError, pywt.wavedecn, x, 'db1', inplace=True)
+    # and even lengths at each level
+    assert_raises(ValueError, pywt.wavedecn, x, 'db1', 'periodization',
+                  level=4, inplace=True)
+    assert_raises(TypeError, pywt.wavedecn, x.astype(np.int32), 'db1',
+                  'periodization', inplace=True)
+    assert_raises(TypeError, pywt.wavedecn, x.tolist(), 'db1',
+                  'periodization', inplace=True)
+    # the default level keeps the lengths even
+    assert_equal(len(pywt.wavedecn(x, 'db1', 'periodization',
+                                   inplace=True)), 4)
+    # and odd lengths are not left untransformed at level 0
+    assert_raises(ValueError, pywt.wavedec, np.ones(63), 'db1',
+                  'periodization', inplace=True)
+    assert_raises(ValueError, pywt.wavedecn, np.ones((16, 63)), 'db1',
+                  'periodization', inplace=True)
+    # copies are not views of a single array
+    coeffs = pywt.wavedecn(x, 'db1', 'periodization', level=2, inplace=True)
+    coeffs[0] = coeffs[0].copy()
+    assert_raises(ValueError, pywt.waverecn, coeffs, 'db1', 'periodization',
+                  inplace=True)
+
+
+def test_wavedec_waverec_out():
+    x = np.random.RandomState(1234).randn(50)
+    for method in ['convolution', 'lifting']:
+        coeffs = pywt.wavedec(x, 'db2', level=3, method=method)
+        out = [np.empty_like(c) for c in coeffs]
+        coeffs_out = pywt.wavedec(x, 'db2', level=3, method=method, out=out)
+        for c, c_out, c_expected in zip(coeffs_out, out, coeffs):
+            assert_(c is c_out)
+            assert_equal(c, c_expected)
+        rec = np.empty_like(x)
+        assert_(pywt.waverec(out, 'db2', method=method, out=rec) is rec)
+        assert_allclose(rec, x, atol=1e-12)
+
+    x2 = x[:48].reshape(6, 8)
+    coeffs = pywt.wavedec2(x2, 'db2', level=1)
+    out = [np.empty_like(coeffs[0]),
+           tuple(np.empty_like(c) for c in coeffs[1])]
+    coeffs_out = pywt.wavedec2(x2, 'db2', level=1, out=out)
+    assert_(coeffs_out[0] is out[0] and coeffs_out[1][1] is out[1][1])
+    assert_equal(out[1][1], coeffs[1][1])
+    rec = np.empty_like(x2)
+    assert_(pywt.waverec2(out, 'db2', out=rec) is rec)
+    assert_allclose(rec, x2, atol=1e-12)
+
+    # the coefficients are written to the input with inplace
+    assert_raises(ValueError, pywt.wavedec, x[:48], 'db2',
+                  'periodization', inplace=True, out=out)
+
+
+def test_multilevel_out_overlap():
+    x = np.random.RandomState(1234).randn(16, 16)
+    for method in ['convolution', 'lifting']:
+        coeffs = pywt.wavedecn(x, 'db1', level=2, method=method)
+        # the details of both levels written to the same arrays
+        out = [np.empty_like(coeffs[0]), {},
+               dict((k, np.empty((8, 8))) for k in coeffs[2])]
+        out[1] = dict((k, v[:4, :4]) for k, v in out[2].items())
+        assert_raises(ValueError, pywt.wavedecn, x, 'db1', level=2,
+                      method=method, out=out)
+        buf = np.zeros((16, 16))
+        buf[:8, :8] = coeffs[2]['dd']
+        coeffs[2]['dd'] = buf[:8, :8]
+        assert_raises(ValueError, pywt.waverecn, coeffs, 'db1',
+                      method=method, out=buf)
+    assert_raises(ValueError, pywt.wavedec, x[0], 'db1', level=2,
+                  out=[x[0, :4], x[0, 4:8], x[0, 8:]])
+    assert_raises(ValueError, pywt.swtn, x, 'db1', level=1,
+                  out=[{'aa': x}])
+    assert_raises(ValueError, pywt.modwt, x, 'db1', level=1,
+                  out=[(x.T, None)])
+
+
+def test_wavedecn_waverecn_out():
+    x = np.random.RandomState(1234).randn(20, 30)
+    for data, method in [(x, 'convolution'), (x.astype(np.float32),
+                                              'convolution'),
+                         (x, 'lifting'), (x + 1j * x.T[:20, :20].sum(),
+                                          'convolution')]:
+        coeffs = pywt.wavedecn(data, 'db2', level=2, method=method)
+        out = [np.empty_like(coeffs[0])] + [
+            dict((k, np.empty_like(v)) for k, v in d.items() if k != 'dd')
+            for d in coeffs[1:]]
+        coeffs_out = pywt.wavedecn(data, 'db2', level=2, method=method,
+                                   out=out)
+        assert_(coeffs_out[0] is out[0])
+        assert_equal(coeffs_out[0], coeffs[0])
+        for d, d_out, d_expected in zip(coeffs_out[1:], out[1:], coeffs[1:]):
+            for k in d_expected:
+                assert_(k == 'dd' or d[k] is d_out[k])
+                assert_equal(d[k], d_expected[k])
+
+        rec = np.empty_like(pywt.waverecn(coeffs, 'db2', method=method))
+        assert_(pywt.waverecn(coeffs, 'db2', method=method, out=rec) is rec)
+        assert_allclose(rec, data, rtol=1e-5, atol=1e-5)
+
+    # all levels of the convolutions are written to C-contiguous arrays
+    out = [np.empty(c.shape[::-1]).T if i == 0 else c
+           for i, c in enumerate(pywt.wavedecn(x, 'db2', level=2))]
+    assert_raises(ValueError, pywt.wavedecn, x, 'db2', level=2, out=out)
+    assert_raises(ValueError, pywt.wavedecn, x, 'db2', level=2,
+                  out=out[:2])
+
+
 @dec.slow
 def test_waverecn_all_wavelets_modes():
     # test 2D case using all wavelets and modes
@@ -0,0 +1,204 @@
+#!/usr/bin/env python
+from __future__ import division, print_function, absolute_import
+
+import json
+import os
+import tempfile
+
+import numpy as np
+from numpy.testing import (assert_raises, run_module_suite, assert_equal,
+                           assert_allclose, assert_)
+
+import pywt
+
+try:
+    import tracemalloc
+except ImportError:
+    # Python 2
+    tracemalloc = None
+
+
+def _assert_coeffs_equal(coeffs, expected):
+    assert_equal(len(coeffs), len(expected))
+    assert_equal(coeffs[0], expected[0])
+    for details, expected_details in zip(coeffs[1:], expected[1:]):
+        assert_equal(sorted(details), sorted(expected_details))
+        for key in details:
+            assert_equal(details[key], expected_details[key])
+
+
+def test_plan_wavedecn():
+    # a single call for all levels, as wavedecn and waverecn
+    rng = np.random.RandomState(1234)
+    for shape, dtype, mode in [((30, 17, 12), np.float64, 'symmetric'),
+                               ((64,), np.float32, 'periodization'),
+                               ((20, 21), np.uint8, 'zero'),
+                               ((50, 12), np.int16, 'reflect')]:
+        x = (100 * rng.rand(*shape)).astype(dtype)
+        p = pywt.plan(shape, dtype, 'db2', mode, level=2)
+        coeffs = pywt.wavedecn(x, 'db2', mode, level=2)
+        assert_equal(p.coeffs_shapes, [c.shape for c in
+                                       [coeffs[0], coeffs[2]['d' * x.ndim]]])
+        _assert_coeffs_equal(p.forward(x), coeffs)
+        y = pywt.waverecn(coeffs, 'db2', mode)
+        assert_equal(p.inverse_shape, y.shape)
+        assert_equal(p.inverse(coeffs), y)
+
+
+def test_plan_level_at_a_time():
+    # the transforms dwtn and idwtn compute a level at a time
+    rng = np.random.RandomState(1234)
+    for shape, dtype, axes, method in [((40, 8, 12), np.float64, (0, 2),
+                                        'convolution'),
+                                       ((31, 20), np.float32, (1,),
+                                        'convolution'),
+                                       ((16, 20), np.complex128, None,
+                                        'convolution'),
+                                       ((32, 24), np.float64, None,
+                                        'lifting')]:
+        x = rng.rand(*shape).astype(dtype)
+        p = pywt.plan(shape, dtype, 'db2', level=2, axes=axes, method=method)
+        a, expected = x, []
+        for l in range(2):
+            details = pywt.dwtn(a, 'db2', axes=axes, method=method)
+            a = details.pop('a' * len(axes or shape))
+            expected.insert(0, details)
+        coeffs = p.forward(x)
+        _assert_coeffs_equal(coeffs, [a] + expected)
+        y = p.inverse(coeffs)
+        assert_equal(y.shape, p.inverse_shape)
+        assert_allclose(y[tuple(slice(n) for n in shape)], x, atol=1e-5)
+
+
+def test_plan_out():
+    x = np.random.RandomState(1234).rand(64, 64)
+    for axes in [None, (1,)]:
+        p = pywt.plan(x.shape, x.dtype, 'db2', level=3, axes=axes)
+        coeffs = p.empty_coeffs()
+        y = np.empty(p.inverse_shape)
+        # the first calls may still allocate, e.g. caches of numpy
+        p.forward(x, out=coeffs)
+        p.inverse(coeffs, out=y)
+
+        arrays = [coeffs[0]] + [d[k] for d in coeffs[1:] for k in sorted(d)]
+        if tracemalloc is not None:
+            tracemalloc.start()
+        assert_(p.forward(x, out=coeffs) is coeffs)
+        assert_(p.inverse(coeffs, out=y) is y)
+        if tracemalloc is not None:
+            peak = tracemalloc.get_traced_memory()[1]
+            tracemalloc.stop()
+            if axes is None:
+                # no array was allocated
+                assert_(peak < 1024)
+        assert_(all(c is c_out for c, c_out in
+                    zip(arrays, [coeffs[0]] + [d[k] for d in coeffs[1:]
+                                               for k in sorted(d)])))
+        assert_allclose(y, x, atol=1e-12)
+
+
+def test_plan_workers():
+    x = np.random.RandomState(1234).rand(33, 40, 20)
+    p = pywt.plan(x.shape, x.dtype, 'db3', level=2)
+    p_threads = pywt.plan(x.shape, x.dtype, 'db3', level=2, workers=4)
+    coeffs = p.forward(x)
+    _assert_coeffs_equal(p_threads.forward(x), coeffs)
+    assert_equal(p_threads.inverse(coeffs), p.inverse(coeffs))
+
+
+def test_plan_invalid():
+    p = pywt.plan((16, 16), np.float64, 'db1', level=2)
+    assert_raises(TypeError, p.forward, np.ones((16, 16), np.float32))
+    assert_raises(ValueError, p.forward, np.ones((16, 15)))
+    assert_raises(ValueError, p.forward, np.ones((16, 16)),
+                  out=p.empty_coeffs()[:2])
+    coeffs = p.empty_coeffs()
+    coeffs[1]['da'] = np.ones((4, 5))
+    assert_raises(ValueError, p.forward, np.ones((16, 16)), out=coeffs)
+    coeffs = p.forward(np.ones((16, 16)))
+    assert_raises(ValueError, p.inverse, coeffs, out=np.empty((16, 17)))
+    coeffs[2]['xx'] = coeffs[2]['dd']
+    assert_raises(ValueError, p.inverse, coeffs)
+    assert_raises(ValueError, pywt.plan, (16, 16), np.float64, 'db1',
+                  level=5)
+    assert_raises(ValueError, pywt.plan, (16, 16), np.float64, 'db1',
+                  axes=(2,))
+    assert_raises(ValueError, pywt.plan, (), np.float64, 'db1')
+
+
+def test_plan_tune():
+    x = np.random.RandomState(1234).rand(40, 24)
+    pywt.forget_wisdom()
+    try:
+        p = pywt.plan(x.shape, x.dtype, 'bior2.2', level=2, method='auto',
+                      workers=2, tune=True)
+        assert_(p.forward_kernel in ['single', 'convolution', 'lifting'])
+        assert_(p.inverse_kernel in ['single', 'convolution', 'lifting'])
+        assert_(p.workers in [1, 2])
+        coeffs = p.forward(x)
+        _assert_coeffs_equal(coeffs, pywt.wavedecn(x, 'bior2.2', level=2))
+        assert_allclose(p.inverse(coeffs), x, atol=1e-12)
+
+        # later plans of the same transform use the wisdom
+        entries = json.loads(pywt.export_wisdom())['entries']
+        assert_equal(len(entries), 1)
+        assert_equal(entries[0]['shape'], [40, 24])
+        assert_equal(entries[0]['forward'], p.forward_kernel)
+        p2 = pywt.plan(x.shape, x.dtype, 'bior2.2', level=2, method='auto',
+                       workers=2)
+        assert_equal((p2.forward_kernel, p2.inverse_kernel, p2.workers),
+                     (p.forward_kernel, p.inverse_kernel, p.workers))
+
+        # wavelets from custom filters are not recorded
+        w = pywt.Wavelet('custom', filter_bank=pywt.Wavelet('db2').filter_bank)
+        pywt.plan(x.shape, x.dtype, w, level=2, tune=True)
+        assert_equal(len(json.loads(pywt.export_wisdom())['entries']), 1)
+    finally:
+        pywt.forget_wisdom()
+
+
+def test_wisdom_import_export():
+    entry = {'wavelet': 'db2', 'mode': 'symmetric', 'shape': [32, 32],
+             'dtype': 'float64', 'level': 2, 'axes': [0, 1],
+             'method': 'convolution', 'workers': 1,
+             'forward': 'convolution', 'inverse': 'single', 'threads': 1}
+    wisdom = json.dumps({'version': 1, 'entries': [entry]})
+    pywt.forget_wisdom()
+    try:
+        pywt.import_wisdom(wisdom)
+        p = pywt.plan((32, 32), np.float64, 'db2', level=2)
+        assert_equal((p.forward_kernel, p.inverse_kernel),
+                     ('convolution', 'single'))
+        x = np.random.RandomState(1234).rand(32, 32)
+        _assert_coeffs_equal(p.forward(x), pywt.wavedecn(x, 'db2', level=2))
+        # the wisdom of another transform does not apply
+        p = pywt.plan((32, 32), np.float64, 'db2', level=1)
+        assert_equal(p.forward_kernel, 'single')
+
+        filename = os.path.join(tempfile.mkdtemp(), 'wisdom.json')
+        pywt.save_wisdom(filename)
+        pywt.forget_wisdom()
+        assert_equal(json.loads(pywt.export_wisdom())['entries'], [])
+        pywt.load_wisdom(filename)
+        assert_equal(json.loads(pywt.export_wisdom())['entries'], [entry])
+        os.remove(filename)
+
+        # choices that cannot compute the transform are ignored
+        pywt.import_wisdom(json.dumps({'version': 1, 'entries': [
+            dict(entry, forward='lifting', threads=8)]}))
+        p = pywt.plan((32, 32), np.float64, 'db2', level=2)
+        assert_equal(p.forward_kernel, 'single')
+    finally:
+        pywt.forget_wisdom()
+
+    assert_raises(ValueError, pywt.import_wisdom, 'not json')
+    assert_raises(ValueError, pywt.import_wisdom,
+                  json.dumps({'version': 0, 'entries': []}))
+    del entry['threads']
+    assert_raises(ValueError, pywt.import_wisdom,
+                  json.dumps({'version': 1, 'entries': [entry]}))
+    assert_equal(json.loads(pywt.export_wisdom())['entries'], [])
+
+
+if __name__ == '__main__':
+    run_module_suite()
@@ -0,0 +1,291 @@
+#!/usr/bin/env python
+from __future__ import division, print_function, absolute_import
+
+import sys
+
+import numpy as np
+from numpy.testing import (assert_raises, run_module_suite,
+                           assert_equal, assert_allclose, assert_)
+
+import pywt
+
+
+def test_simd_variants():
+    variants = pywt.simd_variants()
+    assert_equal(variants[0], 'none')
+    assert_(pywt.get_simd() in variants)
+    assert_raises(ValueError, pywt.set_simd, 'unknown')
+
+
+def test_set_simd():
+    default = pywt.get_simd()
+    try:
+        for variant in pywt.simd_variants():
+            pywt.set_simd(variant)
+            assert_equal(pywt.get_simd(), variant)
+    finally:
+        pywt.set_simd()
+    assert_equal(pywt.get_simd(), default)
+
+
+def test_simd_dwt_matches_scalar():
+    rstate = np.random.RandomState(1234)
+    try:
+        for dtype, rtol in [(np.float64, 1e-12), (np.float32, 1e-5)]:
+            # lengths chosen to exercise both vector blocks and scalar tails
+            for N in [2, 7, 32, 65, 130]:
+                x = rstate.randn(N).astype(dtype)
+                for wavelet in ['haar', 'db4', 'sym9', 'coif5']:
+                    for mode in pywt.Modes.modes:
+                        pywt.set_simd('none')
+                        expected = pywt.dwt(x, wavelet, mode)
+                        for variant in pywt.simd_variants()[1:]:
+                            pywt.set_simd(variant)
+                            cA, cD = pywt.dwt(x, wavelet, mode)
+                            if variant == 'sse2':
+                                assert_equal(cA, expected[0])
+                                assert_equal(cD, expected[1])
+                            else:
+                                assert_allclose(cA, expected[0], rtol=rtol,
+                                                atol=rtol)
+                                assert_allclose(cD, expected[1], rtol=rtol,
+                                                atol=rtol)
+    finally:
+        pywt.set_simd()
+
+
+def test_simd_filter_lengths():
+    # kernels are specialized for even filter lengths up to 20, all lengths
+    # must give the full convolution (zero mode), decimated
+    rstate = np.random.RandomState(1234)
+    try:
+        for variant in pywt.simd_variants():
+            pywt.set_simd(variant)
+            for dtype, rtol in [(np.float64, 1e-12), (np.float32, 1e-5)]:
+                x = rstate.randn(67).astype(dtype)
+                for F in range(2, 25):
+                    lo, hi = rstate.randn(2, F)
+                    w = pywt.Wavelet('custom', filter_bank=(lo, hi, lo, hi))
+                    # odd lengths are padded by Wavelet
+                    expected_a = np.convolve(x, w.dec_lo)[1::2]
+                    expected_d = np.convolve(x, w.dec_hi)[1::2]
+                    cA, cD = pywt.dwt(x, w, 'zero')
+                    assert_allclose(cA, expected_a, rtol=rtol, atol=rtol)
+                    assert_allclose(cD, expected_d, rtol=rtol, atol=rtol)
+                    assert_allclose(pywt.downcoef('a', x, w, 'zero'),
+                                    expected_a, rtol=rtol, atol=rtol)
+                    for mode in ['symmetric', 'periodization']:
+                        pywt.set_simd('none')
+                        expected = pywt.dwt(x, w, mode)
+                        pywt.set_simd(variant)
+                        cA, cD = pywt.dwt(x, w, mode)
+                        assert_allclose(cA, expected[0], rtol=rtol, atol=rtol)
+                        assert_allclose(cD, expected[1], rtol=rtol, atol=rtol)
+    finally:
+        pywt.set_simd()
+
+
+def test_simd_idwt_filter_lengths():
+    # reconstruction kernels are specialized for up to 10 taps per polyphase
+    # component; sse2 sums in the scalar order
+    rstate = np.random.RandomState(1234)
+    try:
+        for dtype, rtol in [(np.float64, 1e-12), (np.float32, 1e-5)]:
+            a, d = rstate.randn(2, 67).astype(dtype)
+            for F in range(2, 27):
+                lo, hi = rstate.randn(2, F)
+                w = pywt.Wavelet('custom', filter_bank=(lo, hi, lo, hi))
+                ua = np.zeros(2 * len(a))
+                ua[::2] = a
+                pywt.set_simd('none')
+                assert_allclose(pywt.upcoef('a', a, w),
+                                np.convolve(ua, w.rec_lo)[:-1],
+                                rtol=rtol, atol=rtol)
+                for mode in ['zero', 'symmetric', 'periodization']:
+                    pywt.set_simd('none')
+                    expected = [pywt.idwt(a, d, w, mode),
+                                pywt.idwt(a, None, w, mode),
+                                pywt.idwt(None, d, w, mode),
+                                pywt.upcoef('d', d, w)]
+                    for variant in pywt.simd_variants()[1:]:
+                        pywt.set_simd(variant)
+                        result = [pywt.idwt(a, d, w, mode),
+                                  pywt.idwt(a, None, w, mode),
+                                  pywt.idwt(None, d, w, mode),
+                                  pywt.upcoef('d', d, w)]
+                        for r, e in zip(result, expected):
+                            if variant == 'sse2':
+                                assert_equal(r, e)
+                            else:
+                                assert_allclose(r, e, rtol=rtol, atol=rtol)
+    finally:
+        pywt.set_simd()
+
+
+def test_fft_threshold():
+    assert_(pywt.get_fft_threshold() > 2)
+    assert_raises(ValueError, pywt.set_fft_threshold, 0)
+    pywt.set_fft_threshold(100)
+    assert_equal(pywt.get_fft_threshold(), 100)
+    pywt.set_fft_threshold()
+    assert_(pywt.get_fft_threshold() != 100)
+
+
+def test_fft_convolution():
+    # the FFT backend must match the direct convolution in all modes, also
+    # for signals shorter than the filters and across several blocks
+    rstate = np.random.RandomState(1234)
+    wavelets = ['db4', 'sym20', 'db38',
+                pywt.Wavelet('custom', filter_bank=rstate.randn(4, 201))]
+    try:
+        for dtype, rtol in [(np.float64, 1e-12), (np.float32, 1e-5)]:
+            for N in [1, 6, 67, 1500]:
+                x = rstate.randn(N).astype(dtype)
+                for wavelet in wavelets:
+                    for mode in pywt.Modes.modes:
+                        pywt.set_fft_threshold(sys.maxsize)
+                        expected = pywt.dwt(x, wavelet, mode)
+                        expected_a = pywt.downcoef('a', x, wavelet, mode)
+                        pywt.set_fft_threshold(4)
+                        cA, cD = pywt.dwt(x, wavelet, mode)
+                        # relative to the magnitude of the extended signal
+                        atol = rtol * np.abs(pywt.pad(x, 200, mode)).max()
+                        assert_allclose(cA, expected[0], rtol=rtol, atol=atol)
+                        assert_allclose(cD, expected[1], rtol=rtol, atol=atol)
+                        assert_allclose(pywt.downcoef('a', x, wavelet, mode),
+                                        expected_a, rtol=rtol, atol=atol)
+                        assert_equal(cA.dtype, x.dtype)
+    finally:
+        pywt.set_fft_threshold()
+
+
+def test_simd_symmetric_filters():
+    # only the nonzero taps of symmetric and antisymmetric filters (and of
+    # their even and odd taps for the reconstruction) are summed, folded;
+    # filters with more than 20 nonzero taps are not specialized
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(67)
+    a, d = rstate.randn(2, 40)
+    ua = np.zeros(2 * len(a))
+    ud = np.zeros(2 * len(d))
+    ua[::2] = a
+    ud[::2] = d
+    wavelets = [pywt.Wavelet(name) for name in ['bior2.2', 'bior4.4',
+                                                 'rbio6.8', 'bior3.5']]
+    for half, zeros in [(2, 1), (5, 0), (6, 3), (13, 2)]:
+        h = rstate.randn(half)
+        for sign in [1, -1]:
+            for middle in [[], [1.5 if sign == 1 else 0]]:
+                taps = np.concatenate([np.zeros(zeros), h, middle,
+                                       sign * h[::-1], np.zeros(zeros)])
+                if len(taps) % 2:
+                    taps = np.append(taps, 0)
+                wavelets.append(pywt.Wavelet('custom', filter_bank=(
+                    taps, taps[::-1], np.append(taps[1:], 0), taps)))
+    try:
+        for variant in pywt.simd_variants():
+            pywt.set_simd(variant)
+            for w in wavelets:
+                F = w.dec_len
+                cA, cD = pywt.dwt(x, w, 'zero')
+                assert_allclose(cA, np.convolve(x, w.dec_lo)[1::2],
+                                rtol=1e-12, atol=1e-12)
+                assert_allclose(cD, np.convolve(x, w.dec_hi)[1::2],
+                                rtol=1e-12, atol=1e-12)
+                assert_allclose(pywt.downcoef('a', x, w, 'zero'), cA,
+                                rtol=1e-12, atol=1e-12)
+                expected = (np.convolve(ua, w.rec_lo) +
+                            np.convolve(ud, w.rec_hi))[F - 2:2 * len(a)]
+                assert_allclose(pywt.idwt(a, d, w, 'zero'), expected,
+                                rtol=1e-12, atol=1e-12)
+                assert_allclose(pywt.idwt(a, None, w, 'zero'),
+                                np.convolve(ua, w.rec_lo)[F - 2:2 * len(a)],
+                                rtol=1e-12, atol=1e-12)
+                if w.name != 'custom':
+                    for mode in pywt.Modes.modes:
+                        for dtype, rtol in [(np.float64, 1e-10),
+                                            (np.float32, 1e-5)]:
+                            xt = x.astype(dtype)
+                            r = pywt.idwt(*pywt.dwt(xt, w, mode), wavelet=w,
+                                          mode=mode)
+                            assert_allclose(r[:len(x)], xt, rtol=rtol,
+                                            atol=rtol)
+    finally:
+        pywt.set_simd()
+
+
+def test_simd_haar():
+    # two tap filters skip the general boundary handling, only the last
+    # output for odd-length input reads the extended signal
+    rstate = np.random.RandomState(1234)
+    w = pywt.Wavelet('haar')
+    dec_lo, dec_hi = np.asarray(w.dec_lo), np.asarray(w.dec_hi)
+    rec_lo, rec_hi = np.asarray(w.rec_lo), np.asarray(w.rec_hi)
+    try:
+        for variant in pywt.simd_variants():
+            pywt.set_simd(variant)
+            for dtype, rtol in [(np.float64, 1e-12), (np.float32, 1e-5)]:
+                for N in [1, 2, 3, 8, 37, 64]:
+                    x = rstate.randn(N).astype(dtype)
+                    for mode in pywt.Modes.modes:
+                        xe = pywt.pad(x, (0, N % 2), mode)
+                        cA, cD = pywt.dwt(x, w, mode)
+                        assert_allclose(cA, dec_lo[0] * xe[1::2] +
+                                        dec_lo[1] * xe[::2], rtol=rtol,
+                                        atol=rtol)
+                        assert_allclose(cD, dec_hi[0] * xe[1::2] +
+                                        dec_hi[1] * xe[::2], rtol=rtol,
+                                        atol=rtol)
+                        assert_equal(pywt.downcoef('d', x, w, mode), cD)
+                        expected = np.empty(2 * len(cA))
+                        expected[::2] = rec_lo[0] * cA + rec_hi[0] * cD
+                        expected[1::2] = rec_lo[1] * cA + rec_hi[1] * cD
+                        assert_allclose(pywt.idwt(cA, cD, w, mode), expected,
+                                        rtol=rtol, atol=rtol)
+                x = rstate.randn(64).astype(dtype)
+                pywt.set_simd('none')
+                expected = pywt.swt(x, w, 3)
+                pywt.set_simd(variant)
+                coeffs = pywt.swt(x, w, 3)
+                assert_allclose(coeffs[-1][0], dec_lo[0] * np.roll(x, -1) +
+                                dec_lo[1] * x, rtol=rtol, atol=rtol)
+                for (cA, cD), (eA, eD) in zip(coeffs, expected):
+                    assert_allclose(cA, eA, rtol=rtol, atol=rtol)
+                    assert_allclose(cD, eD, rtol=rtol, atol=rtol)
+                assert_allclose(pywt.iswt(coeffs, w), x, rtol=rtol, atol=rtol)
+    finally:
+        pywt.set_simd()
+
+
+def test_simd_noncontiguous_axis():
+    # transforms along a strided axis work on tiles of rows at a time and
+    # must match the transform of the transposed, contiguous array
+    rstate = np.random.RandomState(1234)
+    try:
+        for variant in pywt.simd_variants():
+            pywt.set_simd(variant)
+            for dtype, rtol in [(np.float64, 1e-12), (np.float32, 1e-5)]:
+                # axis shorter than, and exceeding, the filter lengths
+                for N in [3, 8, 33]:
+                    x = rstate.randn(N, 70).astype(dtype)
+                    xt = np.ascontiguousarray(x.T)
+                    for wavelet in ['haar', 'db4', 'bior3.5']:
+                        for mode in pywt.Modes.modes:
+                            cA, cD = pywt.dwt(x, wavelet, mode, axis=0)
+                            cA_T, cD_T = pywt.dwt(xt, wavelet, mode, axis=1)
+                            assert_allclose(cA, cA_T.T, rtol=rtol, atol=rtol)
+                            assert_allclose(cD, cD_T.T, rtol=rtol, atol=rtol)
+                            # with both subbands and each one alone
+                            for a, d, a_T, d_T in [(cA, cD, cA_T, cD_T),
+                                                   (cA, None, cA_T, None),
+                                                   (None, cD, None, cD_T)]:
+                                r = pywt.idwt(a, d, wavelet, mode, axis=0)
+                                r_T = pywt.idwt(a_T, d_T, wavelet, mode,
+                                                axis=1)
+                                assert_allclose(r, r_T.T, rtol=rtol,
+                                                atol=rtol)
+    finally:
+        pywt.set_simd()
+
+if __name__ == '__main__':
+    run_module_suite()
@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+from __future__ import division, print_function, absolute_import
+
+import numpy as np
+from numpy.testing import (assert_raises, run_module_suite,
+                           assert_equal, assert_)
+
+import pywt
+
+
+def test_set_workers():
+    default = pywt.get_workers()
+    try:
+        pywt.set_workers(3)
+        assert_equal(pywt.get_workers(), 3)
+        pywt.set_workers(-1)
+        assert_(pywt.get_workers() >= 1)
+        assert_raises(ValueError, pywt.set_workers, 0)
+        assert_raises(ValueError, pywt.set_workers, -100000)
+        assert_raises(TypeError, pywt.set_workers, 1.5)
+    finally:
+        pywt.set_workers(default)
+    assert_equal(pywt.get_workers(), default)
+
+
+def test_workers_bit_identical():
+    # each line is transformed the same way whatever thread processes it
+    rstate = np.random.RandomState(1234)
+    for dtype in [np.float64, np.float32]:
+        # contiguous and strided axes, fewer lines than threads
+        for shape in [(37, 129), (5, 300), (3, 2), (6, 11, 70)]:
+            x = rstate.randn(*shape).astype(dtype)
+            for wavelet in ['db2', 'sym5']:
+                for method in ['convolution', 'lifting']:
+                    for mode in ['symmetric', 'periodization']:
+                        c1 = pywt.dwtn(x, wavelet, mode, method=method,
+                                       workers=1)
+                        c4 = pywt.dwtn(x, wavelet, mode, method=method,
+                                       workers=4)
+                        for key in c1:
+                            assert_equal(c4[key], c1[key])
+                        r1 = pywt.idwtn(c1, wavelet, mode, method=method,
+                                        workers=1)
+                        r4 = pywt.idwtn(c1, wavelet, mode, method=method,
+                                        workers=4)
+                        assert_equal(r4, r1)
+
+
+def test_workers_multilevel():
+    rstate = np.random.RandomState(1234)
+    x = rstate.randn(32, 48) + 1j * rstate.randn(32, 48)
+    default = pywt.get_workers()
+    try:
+        c1 = pywt.wavedec2(x, 'db3', workers=1)
+        pywt.set_workers(3)
+        c3 = pywt.wavedec2(x, 'db3')
+        assert_equal(c3[0], c1[0])
+        for d1, d3 in zip(c1[1:], c3[1:]):
+            for a, b in zip(d1, d3):
+                assert_equal(b, a)
+        assert_equal(pywt.waverec2(c1, 'db3'),
+                     pywt.waverec2(c1, 'db3', workers=1))
+        cn1 = pywt.wavedecn(x, 'db3', level=1, workers=1)
+        cn3 = pywt.wavedecn(x, 'db3', level=1)
+        for key in cn1[1]:
+            assert_equal(cn3[1][key], cn1[1][key])
+        assert_equal(pywt.waverecn(cn1, 'db3'),
+                     pywt.waverecn(cn1, 'db3', workers=1))
+        assert_equal(pywt.waverec(pywt.wavedec(x, 'db3'), 'db3'),
+                     pywt.waverec(pywt.wavedec(x, 'db3', workers=1), 'db3',
+                                  workers=1))
+    finally:
+        pywt.set_workers(default)
+
+
+if __name__ == '__main__':
+    run_module_suite()
@@ -3,9 +3,13 @@
 
 import os
 import sys
+import shutil
+import tempfile
 import subprocess
 from functools import partial
-from distutils.sysconfig import get_python_inc
+from distutils.ccompiler import new_compiler
+from distutils.errors import CompileError, LinkError
+from distutils.sysconfig import get_python_inc, customize_compiler
 
 import setuptools
 from setuptools import setup, Extension
@@ -109,21 +113,64 @@ if sys.platform == "darwin":
 
 make_ext_path = partial(os.path.join, "pywt", "_extensions")
 
-sources = ["c/common.c", "c/convolution.c", "c/wt.c", "c/wavelets.c"]
+sources = ["c/common.c", "c/convolution.c", "c/convolution_simd.c", "c/simd.c",
+           "c/fft.c", "c/int_lifting.c", "c/lifting.c", "c/wt.c", "c/wtn.c",
+           "c/wavelets.c"]
 sources = list(map(make_ext_path, sources))
-source_templates = ["c/convolution.template.c", "c/wt.template.c"]
+source_templates = ["c/convolution.template.c", "c/int_lifting.template.c",
+                    "c/lifting.template.c", "c/wt.template.c",
+                    "c/wtn.template.c"]
 source_templates = list(map(make_ext_path, source_templates))
 headers = ["c/templating.h", "c/wavelets_coeffs.h",
-            "c/common.h", "c/convolution.h", "c/wt.h", "c/wavelets.h"]
+            "c/common.h", "c/convolution.h", "c/fft.h", "c/int_lifting.h",
+            "c/lifting.h", "c/simd.h", "c/wt.h", "c/wtn.h", "c/wavelets.h"]
 headers = list(map(make_ext_path, headers))
-header_templates = ["c/convolution.template.h", "c/wt.template.h",
-                    "c/wavelets_coeffs.template.h"]
+header_templates = ["c/convolution.template.h", "c/int_lifting.template.h",
+                    "c/lifting.template.h", "c/wt.template.h",
+                    "c/wtn.template.h", "c/wavelets_coeffs.template.h"]
 header_templates = list(map(make_ext_path, header_templates))
 
 cython_modules = ['_pywt', '_dwt', '_swt']
 cython_sources = [('{0}.pyx' if USE_CYTHON else '{0}.c').format(module)
                   for module in cython_modules]
 
+
+def openmp_flags():
+    """Compiler and linker flags enabling OpenMP, if supported.
+
+    The transforms along an axis of n-dimensional arrays use OpenMP threads
+    when available. Set the environment variable PYWT_NO_OPENMP to build
+    without.
+    """
+    if os.environ.get("PYWT_NO_OPENMP"):
+        return [], []
+    compiler = new_compiler()
+    customize_compiler(compiler)
+    if compiler.compiler_type == 'msvc':
+        compile_flags, link_flags = ['/openmp'], []
+    else:
+        compile_flags, link_flags = ['-fopenmp'], ['-fopenmp']
+
+    tmp_dir = tempfile.mkdtemp()
+    try:
+        source = os.path.join(tmp_dir, 'test_openmp.c')
+        with open(source, 'w') as f:
+            f.write("#include <omp.h>\n"
+                    "int main(void){ return omp_get_max_threads() < 1; }\n")
+        objects = compiler.compile([source], output_dir=tmp_dir,
+                                   extra_postargs=compile_flags)
+        compiler.link_executable(objects, 'test_openmp', output_dir=tmp_dir,
+                                 extra_postargs=link_flags)
+    except (CompileError, LinkError):
+        print("OpenMP not supported by the compiler, building without")
+        return [], []
+    finally:
+        shutil.rmtree(tmp_dir)
+    return compile_flags, link_flags
+
+
+openmp_compile_flags, openmp_link_flags = openmp_flags()
+
 c_macros = [("PY_EXTENSION", None)]
 cython_macros = []
 cythonize_opts = {}
@@ -136,7 +183,8 @@ if os.environ.get("CYTHON_TRACE"):
 c_lib = ('c_wt', {'sources': sources,
                   'depends': source_templates + header_templates + headers,
                   'include_dirs': [make_ext_path("c"), get_python_inc()],
-                  'macros': c_macros,})
+                  'macros': c_macros,
+                  'cflags': openmp_compile_flags,})
 
 ext_modules = [
     Extension('pywt._extensions.{0}'.format(module),
@@ -145,7 +193,8 @@ ext_modules = [
               depends=c_lib[1]['sources'] + c_lib[1]['depends'],
               include_dirs=[make_ext_path("c"), get_numpy_include()],
               define_macros=c_macros + cython_macros,
-              libraries=[c_lib[0]],)
+              libraries=[c_lib[0]],
+              extra_link_args=openmp_link_flags,)
     for module, source, in zip(cython_modules, cython_sources)
 ]
 